@@ -17,11 +17,14 @@ PUBLIC_HEADERS += $$PWD/qknx1bit.h \
     $$PWD/qknx8bitunsignedvalue.h \
     $$PWD/qknxchar.h \
     $$PWD/qknxcharstring.h \
+    $$PWD/qknxcolour.h \
     $$PWD/qknxdatapointtype.h \
     $$PWD/qknxdatapointtypefactory.h \
     $$PWD/qknxdatetime.h \
+    $$PWD/qknxdptcodec.h \
     $$PWD/qknxelectricalenergy.h \
     $$PWD/qknxentranceaccess.h \
+    $$PWD/qknxscalingspeed.h \
     $$PWD/qknxscene.h \
     $$PWD/qknxstatusmode3.h \
     $$PWD/qknxtime.h \
@@ -47,11 +50,13 @@ SOURCES += $$PWD/qknx1bit.cpp \
     $$PWD/qknx8bitunsignedvalue.cpp \
     $$PWD/qknxchar.cpp \
     $$PWD/qknxcharstring.cpp \
+    $$PWD/qknxcolour.cpp \
     $$PWD/qknxdatapointtype.cpp \
     $$PWD/qknxdatapointtypefactory.cpp \
     $$PWD/qknxdatetime.cpp \
     $$PWD/qknxelectricalenergy.cpp \
     $$PWD/qknxentranceaccess.cpp \
+    $$PWD/qknxscalingspeed.cpp \
     $$PWD/qknxscene.cpp \
     $$PWD/qknxstatusmode3.cpp \
     $$PWD/qknxtime.cpp \
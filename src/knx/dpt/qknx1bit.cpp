@@ -29,6 +29,7 @@
 
 #include "qknx1bit.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -110,9 +111,12 @@ QKnx1Bit::QKnx1Bit(bool bit)
 QKnx1Bit::QKnx1Bit(int subType, bool bit)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("1-bit"));
-    setRangeText(tr("false"), tr("true"));
-    setRange(QVariant(0x00), QVariant(0x01));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("1-bit"));
+        setRangeText(tr("false"), tr("true"));
+        setRange(QVariant(0x00), QVariant(0x01));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setBit(bit);
 }
@@ -122,7 +126,7 @@ QKnx1Bit::QKnx1Bit(int subType, bool bit)
 */
 bool QKnx1Bit::bit() const
 {
-    return QKnxDatapointType::testBit(byte(0), 0);
+    return QKnxDptCodec<QKnx1Bit>::decode(constData(), size());
 }
 
 /*!
@@ -132,7 +136,9 @@ bool QKnx1Bit::bit() const
 */
 bool QKnx1Bit::setBit(bool value)
 {
-    return setByte(0, (value ? 0x01 : 0x00));
+    quint8 data[TypeSize];
+    QKnxDptCodec<QKnx1Bit>::encode(value, data);
+    return setByte(0, data[0]);
 }
 
 /*!
@@ -150,8 +156,11 @@ CLASS::CLASS() \
 CLASS::CLASS(State state) \
     : QKnx1Bit(SubType, bool(state)) \
 { \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        setDescription(tr(DESCRIPTION)); \
+        setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::State CLASS::value() const \
 { \
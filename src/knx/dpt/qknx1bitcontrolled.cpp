@@ -30,6 +30,7 @@
 #include "qknx1bit.h"
 #include "qknx1bitcontrolled.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -86,10 +87,13 @@ QKnx1BitControlled::QKnx1BitControlled()
 QKnx1BitControlled::QKnx1BitControlled(int subType, bool state, bool control)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("1-bit controlled"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("1-bit controlled"));
 
-    setRange(QVariant(0x00), QVariant(0x03));
-    setRangeText(tr("No control, false"), tr("Controlled, true"));
+        setRange(QVariant(0x00), QVariant(0x03));
+        setRangeText(tr("No control, false"), tr("Controlled, true"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setValueBit(state);
     setControlBit(control);
 }
@@ -112,7 +116,7 @@ QKnx1BitControlled::QKnx1BitControlled(int subType, const QKnxDatapointType &dpt
 */
 bool QKnx1BitControlled::valueBit() const
 {
-    return QKnxDatapointType::testBit(byte(0), 0);
+    return QKnxDptCodec<QKnx1BitControlled>::decode(constData(), size()).value;
 }
 
 /*!
@@ -128,7 +132,7 @@ void QKnx1BitControlled::setValueBit(bool value)
 */
 bool QKnx1BitControlled::controlBit() const
 {
-    return QKnxDatapointType::testBit(byte(0), 1);
+    return QKnxDptCodec<QKnx1BitControlled>::decode(constData(), size()).control;
 }
 
 /*!
@@ -152,9 +156,15 @@ CLASS::CLASS() \
     : CLASS(State(0), Control::NoControl) \
 {} \
 CLASS::CLASS(State state, Control control) \
-    : QKnx1BitControlled(SubType, CLASS1(), bool(state), bool(control)) \
+    : QKnx1BitControlled(SubType, bool(state), bool(control)) \
 { \
-    setDescription(tr(DESCRIPTION)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        const CLASS1 dpt; \
+        setMinimumText(tr("No control, %1").arg(dpt.minimumText())); \
+        setMaximumText(tr("Controlled, %1").arg(dpt.maximumText())); \
+        setDescription(tr(DESCRIPTION)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::State CLASS::state() const \
 { \
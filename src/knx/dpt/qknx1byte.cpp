@@ -29,6 +29,7 @@
 
 #include "qknx1byte.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -68,9 +69,12 @@ QKnx1Byte::QKnx1Byte(quint8 value)
 QKnx1Byte::QKnx1Byte(int subType, quint8 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("1-byte"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("Value: 0"), tr("Value: 255"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("1-byte"));
+        setRange(QVariant(0x00), QVariant(0xff));
+        setRangeText(tr("Value: 0"), tr("Value: 255"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(value);
 }
@@ -80,7 +84,7 @@ QKnx1Byte::QKnx1Byte(int subType, quint8 value)
 */
 quint8 QKnx1Byte::value() const
 {
-    return byte(0);
+    return QKnxDptCodec<QKnx1Byte>::decode(constData(), size());
 }
 
 /*!
@@ -176,9 +180,12 @@ QKnxScloMode::QKnxScloMode()
 QKnxScloMode::QKnxScloMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("SCLO Mode"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Autonomous, 0"), tr("Master, 2"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("SCLO Mode"));
+        setRange(QVariant(0x00), QVariant(0x02));
+        setRangeText(tr("Autonomous, 0"), tr("Master, 2"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setMode(mode);
 }
 
@@ -256,9 +263,12 @@ QKnxBuildingMode::QKnxBuildingMode()
 QKnxBuildingMode::QKnxBuildingMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Building Mode"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Building in use, 0"), tr("Building protection, 2"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Building Mode"));
+        setRange(QVariant(0x00), QVariant(0x02));
+        setRangeText(tr("Building in use, 0"), tr("Building protection, 2"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setMode(mode);
 }
 
@@ -332,9 +342,12 @@ QKnxOccupyMode::QKnxOccupyMode()
 QKnxOccupyMode::QKnxOccupyMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Occupied"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Occupied, 0"), tr("Not occupied, 2"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Occupied"));
+        setRange(QVariant(0x00), QVariant(0x02));
+        setRangeText(tr("Occupied, 0"), tr("Not occupied, 2"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setMode(mode);
 }
 
@@ -411,9 +424,12 @@ QKnxPriority::QKnxPriority()
 QKnxPriority::QKnxPriority(Priority priority)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Priority"));
-    setRange(QVariant(0x00), QVariant(0x03));
-    setRangeText(tr("High, 0"), tr("void, 3"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Priority"));
+        setRange(QVariant(0x00), QVariant(0x03));
+        setRangeText(tr("High, 0"), tr("void, 3"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setPriority(priority);
 }
 
@@ -486,9 +502,12 @@ QKnxLightApplicationMode::QKnxLightApplicationMode()
 QKnxLightApplicationMode::QKnxLightApplicationMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Light application mode"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Normal, 0"), tr("Night round, 2"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Light application mode"));
+        setRange(QVariant(0x00), QVariant(0x02));
+        setRangeText(tr("Normal, 0"), tr("Night round, 2"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setMode(mode);
 }
 
@@ -591,9 +610,12 @@ QKnxApplicationArea::QKnxApplicationArea()
 QKnxApplicationArea::QKnxApplicationArea(Area area)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Application Area"));
-    setRange(QVariant(0x00), QVariant(0x32));
-    setRangeText(tr("no fault, 0"), tr("Shutters and blinds, 50"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Application Area"));
+        setRange(QVariant(0x00), QVariant(0x32));
+        setRangeText(tr("no fault, 0"), tr("Shutters and blinds, 50"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setArea(area);
 }
 
@@ -706,9 +728,12 @@ QKnxAlarmClassType::QKnxAlarmClassType()
 QKnxAlarmClassType::QKnxAlarmClassType(Type type)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Alarm"));
-    setRange(QVariant(0x01), QVariant(0x03));
-    setRangeText(tr("Simple alarm, 1"), tr("Extended alarm, 3"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Alarm"));
+        setRange(QVariant(0x01), QVariant(0x03));
+        setRangeText(tr("Simple alarm, 1"), tr("Extended alarm, 3"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setType(type);
 }
 
@@ -792,9 +817,12 @@ QKnxPsuMode::QKnxPsuMode()
 QKnxPsuMode::QKnxPsuMode(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("PSU Mode"));
-    setRange(QVariant(0x00), QVariant(0x02));
-    setRangeText(tr("Disabled, 0"), tr("Automatic, 2"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("PSU Mode"));
+        setRange(QVariant(0x00), QVariant(0x02));
+        setRangeText(tr("Disabled, 0"), tr("Automatic, 2"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setMode(mode);
 }
 
@@ -908,9 +936,12 @@ QKnxErrorClassSystem::QKnxErrorClassSystem()
 QKnxErrorClassSystem::QKnxErrorClassSystem(Error error)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("System error class"));
-    setRange(QVariant(0x00), QVariant(0x12));
-    setRangeText(tr("No fault, 0"), tr("Group object type exceeds, 18"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("System error class"));
+        setRange(QVariant(0x00), QVariant(0x12));
+        setRangeText(tr("No fault, 0"), tr("Group object type exceeds, 18"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setError(error);
 }
 
@@ -988,9 +1019,12 @@ QKnxErrorClassHvac::QKnxErrorClassHvac()
 QKnxErrorClassHvac::QKnxErrorClassHvac(Error error)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("HVAC error class"));
-    setRange(QVariant(0x00), QVariant(0x04));
-    setRangeText(tr("No fault, 0"), tr("Other fault, 4"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("HVAC error class"));
+        setRange(QVariant(0x00), QVariant(0x04));
+        setRangeText(tr("No fault, 0"), tr("Other fault, 4"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setError(error);
 }
 
@@ -1084,9 +1118,12 @@ QKnxTimeDelay::QKnxTimeDelay()
 QKnxTimeDelay::QKnxTimeDelay(Delay delay)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Time delay"));
-    setRange(QVariant(0x00), QVariant(0x19));
-    setRangeText(tr("Not active, 0"), tr("Twenty four hours, 25"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Time delay"));
+        setRange(QVariant(0x00), QVariant(0x19));
+        setRangeText(tr("Not active, 0"), tr("Twenty four hours, 25"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setDelay(delay);
 }
 
@@ -1168,9 +1205,12 @@ QKnxBeaufortWindForceScale::QKnxBeaufortWindForceScale()
 QKnxBeaufortWindForceScale::QKnxBeaufortWindForceScale(Force force)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Wind force scale (0..12)"));
-    setRange(QVariant(0x00), QVariant(0x0c));
-    setRangeText(tr("Calm (no wind), 0"), tr("Hurricane, 12"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Wind force scale (0..12)"));
+        setRange(QVariant(0x00), QVariant(0x0c));
+        setRangeText(tr("Calm (no wind), 0"), tr("Hurricane, 12"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setForce(force);
 }
 
@@ -1247,9 +1287,12 @@ QKnxSensorSelect::QKnxSensorSelect()
 QKnxSensorSelect::QKnxSensorSelect(Mode mode)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Sensor mode"));
-    setRange(QVariant(0x00), QVariant(0x04));
-    setRangeText(tr("Inactive, 0"), tr("Temperature sensor input, 12"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Sensor mode"));
+        setRange(QVariant(0x00), QVariant(0x04));
+        setRangeText(tr("Inactive, 0"), tr("Temperature sensor input, 12"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setMode(mode);
 }
 
@@ -1321,9 +1364,12 @@ QKnxActuatorConnectType::QKnxActuatorConnectType()
 QKnxActuatorConnectType::QKnxActuatorConnectType(Type type)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Actuator connect type"));
-    setRange(QVariant(0x01), QVariant(0x02));
-    setRangeText(tr("Sensor connection, 1"), tr("Controller connection, 2"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Actuator connect type"));
+        setRange(QVariant(0x01), QVariant(0x02));
+        setRangeText(tr("Sensor connection, 1"), tr("Controller connection, 2"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setType(type);
 }
 
@@ -1418,9 +1464,12 @@ QKnxCloudCover::QKnxCloudCover()
 QKnxCloudCover::QKnxCloudCover(Scale scale)
     : QKnx1Byte(SubType, 0)
 {
-    setDescription(tr("Cloud cover"));
-    setRange(QVariant(0x00), QVariant(0x09));
-    setRangeText(tr("Cloudless, 0"), tr("Sky is obstructed from view, 9"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Cloud cover"));
+        setRange(QVariant(0x00), QVariant(0x09));
+        setRangeText(tr("Cloudless, 0"), tr("Sky is obstructed from view, 9"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setCloudCover(scale);
 }
 
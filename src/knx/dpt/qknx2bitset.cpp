@@ -29,6 +29,7 @@
 
 #include "qknx2bitset.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 #include "qmath.h"
 
 QT_BEGIN_NAMESPACE
@@ -71,8 +72,11 @@ QKnx2BitSet::QKnx2BitSet(quint8 value)
 QKnx2BitSet::QKnx2BitSet(int subType, quint8 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("2-bit set"));
-    setRange(QVariant(0x00), QVariant(0x03));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("2-bit set"));
+        setRange(QVariant(0x00), QVariant(0x03));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setValue(value);
 }
 
@@ -81,7 +85,7 @@ QKnx2BitSet::QKnx2BitSet(int subType, quint8 value)
 */
 quint8 QKnx2BitSet::value() const
 {
-    return byte(0) & 0x03;
+    return QKnxDptCodec<QKnx2BitSet>::decode(constData(), size());
 }
 
 /*!
@@ -150,8 +154,11 @@ QKnxOnOffAction::QKnxOnOffAction()
 QKnxOnOffAction::QKnxOnOffAction(Action action)
     : QKnx2BitSet(SubType, quint8(action))
 {
-    setDescription(tr("On/Off Action"));
-    setRangeText(tr("Minimum Off, 0"), tr("Maximum On/Off, 3"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("On/Off Action"));
+        setRangeText(tr("Minimum Off, 0"), tr("Maximum On/Off, 3"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 }
 
 /*!
@@ -221,9 +228,12 @@ QKnxAlarmReaction::QKnxAlarmReaction()
 QKnxAlarmReaction::QKnxAlarmReaction(Alarm alarm)
     : QKnx2BitSet(SubType, quint8(alarm))
 {
-    setDescription(tr("Alarm reaction"));
-    setRangeText(tr("No alarm is used, 0"), tr("Alarm position is down, 2"));
-    setRange(QVariant(0x00), QVariant(0x02));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Alarm reaction"));
+        setRangeText(tr("No alarm is used, 0"), tr("Alarm position is down, 2"));
+        setRange(QVariant(0x00), QVariant(0x02));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setAlarm(alarm);
 }
 
@@ -291,8 +301,11 @@ QKnxUpDownAction::QKnxUpDownAction()
 QKnxUpDownAction::QKnxUpDownAction(Action action)
     : QKnx2BitSet(SubType, quint8(action))
 {
-    setDescription(tr("Up/Down Action"));
-    setRangeText(tr("Minimum Up, 0"), tr("Maximum Down/Up, 3"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Up/Down Action"));
+        setRangeText(tr("Minimum Up, 0"), tr("Maximum Down/Up, 3"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 }
 
 /*!
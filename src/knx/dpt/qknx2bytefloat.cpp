@@ -29,9 +29,7 @@
 
 #include "qknx2bytefloat.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
-#include "qmath.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -180,9 +178,12 @@ QKnx2ByteFloat::QKnx2ByteFloat(float value)
 QKnx2ByteFloat::QKnx2ByteFloat(int subType, float value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("2-byte float"));
-    setRangeText(tr("Minimum Value, -671 088.64"), tr("Maximum Value, 670 760.96"));
-    setRange(QVariant::fromValue(-671088.64), QVariant::fromValue(670760.96));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("2-byte float"));
+        setRangeText(tr("Minimum Value, -671 088.64"), tr("Maximum Value, 670 760.96"));
+        setRange(QVariant::fromValue(-671088.64), QVariant::fromValue(670760.96));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(value);
 }
@@ -192,16 +193,7 @@ QKnx2ByteFloat::QKnx2ByteFloat(int subType, float value)
 */
 float QKnx2ByteFloat::value() const
 {
-    quint16 temp = QKnxUtils::QUint16::fromBytes(bytes());
-    quint16 encodedM = (temp & 0x87ff);
-    // Turning on bits reserved for E.
-    // Only needed for reinterpretation of negative values
-    if (encodedM > 2047)
-        encodedM += 0x7800;
-
-    qint16 M = qint16(encodedM);
-    quint8 E = (temp & 0x7800) >> 11;
-    return float(0.01 * (M) * qPow(2, qreal(E)));
+    return QKnxDptCodec<QKnx2ByteFloat>::decode(constData(), size());
 }
 
 /*!
@@ -215,19 +207,10 @@ bool QKnx2ByteFloat::setValue(float value)
     if (value < minimum().toFloat() || value > maximum().toFloat())
         return false;
 
-    quint8 E = 0;
-    if (qAbs(qreal(value)) > 20.48)
-        E = quint8(qFloor(qLn(qAbs(qreal(value) * 100 / 2048.)) / qLn(2) + 1));
-    qint32 M = qint32(qRound((value*float(qPow(2, -E)) * 100)));
-    if (E > 15 || M > 2047 || M < -2048)
+    quint8 data[TypeSize];
+    if (!QKnxDptCodec<QKnx2ByteFloat>::encode(value, data))
         return false; // Should never happen considering the ranges of value.
-
-    quint16 encodedM = quint16(M);
-    if (value < 0)
-        encodedM &= 0x87ff;
-    encodedM |= E << 11;
-    setBytes(QKnxUtils::QUint16::bytes(encodedM), 0, 2);
-    return true;
+    return setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 /*!
@@ -244,10 +227,14 @@ bool QKnx2ByteFloat::isValid() const
 CLASS::CLASS() \
     : QKnx2ByteFloat(SubType, 0.0) \
 { \
-    setUnit(tr(UNIT)); \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
-    setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        setUnit(tr(UNIT)); \
+        setDescription(tr(DESCRIPTION)); \
+        setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
+        setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), \
+            QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::CLASS(float value) \
     : CLASS() \
@@ -29,8 +29,7 @@
 
 #include "qknx2bytesignedvalue.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -90,9 +89,12 @@ QKnx2ByteSignedValue::QKnx2ByteSignedValue(double value)
 QKnx2ByteSignedValue::QKnx2ByteSignedValue(int subType, double value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("2-byte signed value"));
-    setRangeText(tr("Minimum Value, -32 768"), tr("Maximum Value, 32 767"));
-    setRange(QVariant::fromValue(-32768), QVariant::fromValue(32767));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("2-byte signed value"));
+        setRangeText(tr("Minimum Value, -32 768"), tr("Maximum Value, 32 767"));
+        setRange(QVariant::fromValue(-32768), QVariant::fromValue(32767));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(value);
 }
@@ -102,7 +104,7 @@ QKnx2ByteSignedValue::QKnx2ByteSignedValue(int subType, double value)
 */
 double QKnx2ByteSignedValue::value() const
 {
-     return qint16(QKnxUtils::QUint16::fromBytes(bytes())) * coefficient();
+    return QKnxDptCodec<QKnx2ByteSignedValue>::decode(constData(), size()) * coefficient();
 }
 
 /*!
@@ -112,9 +114,12 @@ double QKnx2ByteSignedValue::value() const
 */
 bool QKnx2ByteSignedValue::setValue(double value)
 {
-    if (value <= maximum().toDouble() && value >= minimum().toDouble())
-        return setBytes(QKnxUtils::QUint16::bytes(quint16(qRound(value / coefficient()))), 0, 2);
-    return false;
+    if (value > maximum().toDouble() || value < minimum().toDouble())
+        return false;
+
+    quint8 data[TypeSize];
+    QKnxDptCodec<QKnx2ByteSignedValue>::encode(qint16(qRound(value / coefficient())), data);
+    return setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 /*!
@@ -131,11 +136,15 @@ bool QKnx2ByteSignedValue::isValid() const
 CLASS::CLASS() \
     : QKnx2ByteSignedValue(SubType, 0.0) \
 { \
-    setUnit(tr(UNIT)); \
-    setCoefficient(COEFFICIENT); \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
-    setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        setUnit(tr(UNIT)); \
+        setCoefficient(COEFFICIENT); \
+        setDescription(tr(DESCRIPTION)); \
+        setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
+        setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), \
+            QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::CLASS(double value) \
     : CLASS() \
@@ -29,7 +29,7 @@
 
 #include "qknx2byteunsignedvalue.h"
 #include "qknxdatapointtype_p.h"
-#include "qknxutils.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -97,9 +97,12 @@ QKnx2ByteUnsignedValue::QKnx2ByteUnsignedValue(quint32 value)
 QKnx2ByteUnsignedValue::QKnx2ByteUnsignedValue(int subType, quint32 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("2-byte unsigned value"));
-    setRange(QVariant(0x0000), QVariant(0xffff));
-    setRangeText(tr("0"), tr("65535"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("2-byte unsigned value"));
+        setRange(QVariant(0x0000), QVariant(0xffff));
+        setRangeText(tr("0"), tr("65535"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setValue(value);
 }
 
@@ -108,7 +111,8 @@ QKnx2ByteUnsignedValue::QKnx2ByteUnsignedValue(int subType, quint32 value)
 */
 quint32 QKnx2ByteUnsignedValue::value() const
 {
-    return quint32(QKnxUtils::QUint16::fromBytes(bytes()) * coefficient());
+    return quint32(QKnxDptCodec<QKnx2ByteUnsignedValue>::decode(constData(), size())
+        * coefficient());
 }
 
 /*!
@@ -118,9 +122,12 @@ quint32 QKnx2ByteUnsignedValue::value() const
 */
 bool QKnx2ByteUnsignedValue::setValue(quint32 value)
 {
-    if (value <= maximum().toUInt() && value >= minimum().toUInt())
-        return setBytes(QKnxUtils::QUint16::bytes(quint16(qRound(value / coefficient()))), 0, 2);
-    return false;
+    if (value > maximum().toUInt() || value < minimum().toUInt())
+        return false;
+
+    quint8 data[TypeSize];
+    QKnxDptCodec<QKnx2ByteUnsignedValue>::encode(quint16(qRound(value / coefficient())), data);
+    return setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 /*!
@@ -137,11 +144,15 @@ bool QKnx2ByteUnsignedValue::isValid() const
 CLASS::CLASS() \
     : QKnx2ByteUnsignedValue(SubType, 0) \
 { \
-    setUnit(tr(UNIT)); \
-    setCoefficient(COEFFICIENT); \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
-    setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        setUnit(tr(UNIT)); \
+        setCoefficient(COEFFICIENT); \
+        setDescription(tr(DESCRIPTION)); \
+        setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
+        setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), \
+            QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::CLASS(quint32 value) \
     : CLASS() \
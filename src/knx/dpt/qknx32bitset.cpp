@@ -29,7 +29,7 @@
 
 #include "qknx32bitset.h"
 #include "qknxdatapointtype_p.h"
-#include "qknxutils.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -74,9 +74,12 @@ QKnx32BitSet::QKnx32BitSet(quint32 value)
 QKnx32BitSet::QKnx32BitSet(int subType, quint32 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("32-bit set"));
-    setRange(QVariant(0x00), QVariant(0xffffffff));
-    setRangeText(tr("No bits set"), tr("All bits set"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("32-bit set"));
+        setRange(QVariant(0x00), QVariant(0xffffffff));
+        setRangeText(tr("No bits set"), tr("All bits set"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setValue(value);
 }
 
@@ -85,7 +88,7 @@ QKnx32BitSet::QKnx32BitSet(int subType, quint32 value)
 */
 quint32 QKnx32BitSet::value() const
 {
-    return QKnxUtils::QUint32::fromBytes(bytes());
+    return QKnxDptCodec<QKnx32BitSet>::decode(constData(), size());
 }
 
 /*!
@@ -95,7 +98,9 @@ quint32 QKnx32BitSet::value() const
 */
 bool QKnx32BitSet::setValue(quint32 value)
 {
-    return setBytes(QKnxUtils::QUint32::bytes(value), 0, 4);
+    quint8 data[TypeSize];
+    QKnxDptCodec<QKnx32BitSet>::encode(value, data);
+    return setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 
@@ -187,7 +192,10 @@ QKnxCombinedInfoOnOff::QKnxCombinedInfoOnOff()
 QKnxCombinedInfoOnOff::QKnxCombinedInfoOnOff(const QVector<OutputInfo> &infos)
     : QKnx32BitSet(SubType, 0)
 {
-    setDescription(tr("Bit-combined info On/Off"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Bit-combined info On/Off"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     for (const auto &info : qAsConst(infos))
         setValue(info.Output, info.OutputState, info.OutputValidity);
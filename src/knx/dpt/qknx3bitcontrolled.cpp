@@ -29,7 +29,7 @@
 
 #include "qknx3bitcontrolled.h"
 #include "qknxdatapointtype_p.h"
-#include "qmath.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -93,9 +93,12 @@ QKnx3BitControlled::QKnx3BitControlled(bool control, NumberOfIntervals n)
 QKnx3BitControlled::QKnx3BitControlled(int subType, bool control, NumberOfIntervals n)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("3-bit controlled"));
-    setRange(QVariant(0x00), QVariant(0x0f));
-    setRangeText(tr("No control, Break"), tr("Controlled, 32 intervals"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("3-bit controlled"));
+        setRange(QVariant(0x00), QVariant(0x0f));
+        setRangeText(tr("No control, Break"), tr("Controlled, 32 intervals"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setControlBit(control);
     setNumberOfIntervals(n);
@@ -106,7 +109,7 @@ QKnx3BitControlled::QKnx3BitControlled(int subType, bool control, NumberOfInterv
 */
 bool QKnx3BitControlled::controlBit() const
 {
-    return QKnxDatapointType::testBit(byte(0), 3);
+    return QKnxDptCodec<QKnx3BitControlled>::decode(constData(), size()).control;
 }
 /*!
     Sets the control part of the datapoint type to \a value.
@@ -130,10 +133,10 @@ bool QKnx3BitControlled::setNumberOfIntervals(NumberOfIntervals n)
     if (n > NumberOfIntervals::ThirtyTwo)
         return false;
 
-    quint8 stepCode = 0;
-    if (n != NumberOfIntervals::Break)
-        stepCode = quint8(1 + qLn(quint8(n)) / qLn(2.));
-    return setByte(0, (byte(0) & 0x08) | stepCode);
+    quint8 data[TypeSize];
+    if (!QKnxDptCodec<QKnx3BitControlled>::encode({ controlBit(), quint8(n) }, data))
+        return false;
+    return setByte(0, data[0]);
 }
 
 /*!
@@ -141,8 +144,8 @@ bool QKnx3BitControlled::setNumberOfIntervals(NumberOfIntervals n)
 */
 QKnx3BitControlled::NumberOfIntervals QKnx3BitControlled::numberOfIntervals() const
 {
-    quint8 stepCode = quint8(byte(0) & 0x07);
-    return NumberOfIntervals(quint8(qPow(2, stepCode - 1)));
+    return NumberOfIntervals(QKnxDptCodec<QKnx3BitControlled>::decode(constData(),
+        size()).numberOfIntervals);
 }
 
 /*!
@@ -195,8 +198,11 @@ QKnxControlDimming::QKnxControlDimming()
 QKnxControlDimming::QKnxControlDimming(Control control, NumberOfIntervals interval)
     : QKnx3BitControlled(SubType, bool(control), interval)
 {
-    setDescription(tr("Control Dimming"));
-    setRangeText(tr("Decrease, Break"), tr("Increase, 32 intervals"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Control Dimming"));
+        setRangeText(tr("Decrease, Break"), tr("Increase, 32 intervals"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 }
 
 /*!
@@ -259,8 +265,11 @@ QKnxControlBlinds::QKnxControlBlinds()
 QKnxControlBlinds::QKnxControlBlinds(Control control, NumberOfIntervals interval)
     : QKnx3BitControlled (SubType, bool(control), interval)
 {
-    setDescription(tr("Control Blinds"));
-    setRangeText(tr("Up, Break"), tr("Down, 32 intervals"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Control Blinds"));
+        setRangeText(tr("Up, Break"), tr("Down, 32 intervals"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 }
 
 /*!
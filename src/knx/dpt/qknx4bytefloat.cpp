@@ -29,8 +29,7 @@
 
 #include "qknx4bytefloat.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -158,10 +157,13 @@ QKnx4ByteFloat::QKnx4ByteFloat(float value)
 QKnx4ByteFloat::QKnx4ByteFloat(int subType, float value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("4-byte float value"));
-    setRangeText(tr("Minimum Value, -3.40282e+38"), tr("Maximum Value, 3.40282e+38"));
-    setRange(QVariant::fromValue(std::numeric_limits<float>::lowest()),
-        QVariant::fromValue(std::numeric_limits<float>::max()));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("4-byte float value"));
+        setRangeText(tr("Minimum Value, -3.40282e+38"), tr("Maximum Value, 3.40282e+38"));
+        setRange(QVariant::fromValue(std::numeric_limits<float>::lowest()),
+            QVariant::fromValue(std::numeric_limits<float>::max()));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(value);
 }
@@ -171,10 +173,7 @@ QKnx4ByteFloat::QKnx4ByteFloat(int subType, float value)
 */
 float QKnx4ByteFloat::value() const
 {
-    quint32 temp = QKnxUtils::QUint32::fromBytes(bytes());
-    float value = 0;
-    memcpy(&value, &temp, sizeof(value));
-    return value;
+    return QKnxDptCodec<QKnx4ByteFloat>::decode(constData(), size());
 }
 
 /*!
@@ -185,9 +184,9 @@ float QKnx4ByteFloat::value() const
 */
 void QKnx4ByteFloat::setValue(float value)
 {
-    quint32 tmp;
-    memcpy(&tmp, &value, sizeof(value));
-    setBytes(QKnxUtils::QUint32::bytes(tmp),0,4);
+    quint8 data[TypeSize];
+    QKnxDptCodec<QKnx4ByteFloat>::encode(value, data);
+    setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 /*!
@@ -203,8 +202,11 @@ bool QKnx4ByteFloat::isValid() const
 CLASS::CLASS() \
     : QKnx4ByteFloat(SubType, 0.0) \
 { \
-    setUnit(tr(UNIT)); \
-    setDescription(tr(DESCRIPTION)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        setUnit(tr(UNIT)); \
+        setDescription(tr(DESCRIPTION)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::CLASS(float value) \
     : CLASS() \
@@ -29,8 +29,7 @@
 
 #include "qknx4bytesignedvalue.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -86,9 +85,12 @@ QKnx4ByteSignedValue::QKnx4ByteSignedValue(qint32 value)
 QKnx4ByteSignedValue::QKnx4ByteSignedValue(int subType, qint32 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("4-byte signed value"));
-    setRange(QVariant::fromValue(INT_MIN), QVariant::fromValue(INT_MAX));
-    setRangeText(tr("Minimum Value, -2 147 483 648"), tr("Maximum Value, 2 147 483 647"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("4-byte signed value"));
+        setRange(QVariant::fromValue(INT_MIN), QVariant::fromValue(INT_MAX));
+        setRangeText(tr("Minimum Value, -2 147 483 648"), tr("Maximum Value, 2 147 483 647"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(value);
 }
@@ -98,7 +100,7 @@ QKnx4ByteSignedValue::QKnx4ByteSignedValue(int subType, qint32 value)
 */
 qint32 QKnx4ByteSignedValue::value() const
 {
-    return qint32(QKnxUtils::QUint32::fromBytes(bytes()));
+    return QKnxDptCodec<QKnx4ByteSignedValue>::decode(constData(), size());
 }
 
 /*!
@@ -109,9 +111,12 @@ qint32 QKnx4ByteSignedValue::value() const
 */
 bool QKnx4ByteSignedValue::setValue(qint32 value)
 {
-    if (value <= maximum().toInt() && value >= minimum().toInt())
-        return setBytes(QKnxUtils::QUint32::bytes(quint32(value)), 0, 4);
-    return false;
+    if (value > maximum().toInt() || value < minimum().toInt())
+        return false;
+
+    quint8 data[TypeSize];
+    QKnxDptCodec<QKnx4ByteSignedValue>::encode(value, data);
+    return setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 /*!
@@ -127,8 +132,11 @@ bool QKnx4ByteSignedValue::isValid() const
 CLASS::CLASS() \
     : QKnx4ByteSignedValue(SubType, 0) \
 { \
-    setUnit(tr(UNIT)); \
-    setDescription(tr(DESCRIPTION)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        setUnit(tr(UNIT)); \
+        setDescription(tr(DESCRIPTION)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::CLASS(qint32 value) \
     : CLASS() \
@@ -29,8 +29,7 @@
 
 #include "qknx4byteunsignedvalue.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -72,9 +71,12 @@ QKnx4ByteUnsignedValue::QKnx4ByteUnsignedValue(quint32 value)
 QKnx4ByteUnsignedValue::QKnx4ByteUnsignedValue(int subType, quint32 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("4-byte unsigned value"));
-    setRangeText(tr("Minimum Value, 0"), tr("Maximum Value, 4 294 967 295"));
-    setRange(QVariant::fromValue(0), QVariant::fromValue(4294967295));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("4-byte unsigned value"));
+        setRangeText(tr("Minimum Value, 0"), tr("Maximum Value, 4 294 967 295"));
+        setRange(QVariant::fromValue(0), QVariant::fromValue(4294967295));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setValue(value);
 }
 
@@ -106,7 +108,10 @@ QKnxValue4UCount::QKnxValue4UCount()
 QKnxValue4UCount::QKnxValue4UCount(quint32 value)
     : QKnx4ByteUnsignedValue(SubType, value)
 {
-    setUnit(tr("counter pulses"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setUnit(tr("counter pulses"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 }
 
 /*!
@@ -114,7 +119,7 @@ QKnxValue4UCount::QKnxValue4UCount(quint32 value)
 */
 quint32 QKnx4ByteUnsignedValue::value() const
 {
-    return QKnxUtils::QUint32::fromBytes(bytes());
+    return QKnxDptCodec<QKnx4ByteUnsignedValue>::decode(constData(), size());
 }
 
 /*!
@@ -125,9 +130,12 @@ quint32 QKnx4ByteUnsignedValue::value() const
 */
 bool QKnx4ByteUnsignedValue::setValue(quint32 value)
 {
-    if (value <= maximum().toUInt() && value >= minimum().toUInt())
-        return setBytes(QKnxUtils::QUint32::bytes(value), 0, 4);
-    return false;
+    if (value > maximum().toUInt() || value < minimum().toUInt())
+        return false;
+
+    quint8 data[TypeSize];
+    QKnxDptCodec<QKnx4ByteUnsignedValue>::encode(value, data);
+    return setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 /*!
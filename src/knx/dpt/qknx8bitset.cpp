@@ -29,6 +29,7 @@
 
 #include "qknx8bitset.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -74,9 +75,12 @@ QKnx8BitSet::QKnx8BitSet(quint8 value)
 QKnx8BitSet::QKnx8BitSet(int subType, quint8 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("8-bit set"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("No bits set"), tr("All bits set"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("8-bit set"));
+        setRange(QVariant(0x00), QVariant(0xff));
+        setRangeText(tr("No bits set"), tr("All bits set"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setByte(value);
 }
@@ -102,7 +106,7 @@ void QKnx8BitSet::setBit(bool value, int index)
 */
 quint8 QKnx8BitSet::byte() const
 {
-    return QKnxDatapointType::byte(0);
+    return QKnxDptCodec<QKnx8BitSet>::decode(constData(), size());
 }
 
 /*!
@@ -169,8 +173,11 @@ QKnxGeneralStatus::QKnxGeneralStatus()
 QKnxGeneralStatus::QKnxGeneralStatus(Attributes attributes)
     : QKnx8BitSet(SubType, 0)
 {
-    setDescription(tr("General Status"));
-    setRange(QVariant(0x00), QVariant(0x1f));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("General Status"));
+        setRange(QVariant(0x00), QVariant(0x1f));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setValue(attributes);
 }
 
@@ -275,8 +282,11 @@ QKnxDeviceControl::QKnxDeviceControl()
 QKnxDeviceControl::QKnxDeviceControl(Attributes attributes)
     : QKnx8BitSet(SubType, 0)
 {
-    setDescription(tr("Device Control"));
-    setRange(QVariant(0x00), QVariant(0x15));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Device Control"));
+        setRange(QVariant(0x00), QVariant(0x15));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setValue(attributes);
 }
 
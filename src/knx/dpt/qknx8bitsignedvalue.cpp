@@ -29,6 +29,7 @@
 
 #include "qknx8bitsignedvalue.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -78,9 +79,12 @@ QKnx8BitSignedValue::QKnx8BitSignedValue(qint8 value)
 QKnx8BitSignedValue::QKnx8BitSignedValue(int subType, qint8 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setRangeText(tr("-128"), tr("127"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setDescription(tr("8-bit signed value"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setRangeText(tr("-128"), tr("127"));
+        setRange(QVariant(0x00), QVariant(0xff));
+        setDescription(tr("8-bit signed value"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(value);
 }
@@ -90,7 +94,7 @@ QKnx8BitSignedValue::QKnx8BitSignedValue(int subType, qint8 value)
 */
 qint8 QKnx8BitSignedValue::value() const
 {
-    return qint8(QKnxDatapointType::byte(0));
+    return QKnxDptCodec<QKnx8BitSignedValue>::decode(constData(), size());
 }
 
 /*!
@@ -106,10 +110,14 @@ void QKnx8BitSignedValue::setValue(qint8 value)
 CLASS::CLASS() \
     : QKnx8BitSignedValue(SubType, 0) \
 { \
-    setUnit(tr(UNIT)); \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
-    setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        setUnit(tr(UNIT)); \
+        setDescription(tr(DESCRIPTION)); \
+        setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
+        setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), \
+            QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::CLASS(qint8 value) \
     : CLASS() \
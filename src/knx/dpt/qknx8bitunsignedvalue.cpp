@@ -29,6 +29,7 @@
 
 #include "qknx8bitunsignedvalue.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -82,9 +83,12 @@ QKnx8BitUnsignedValue::QKnx8BitUnsignedValue(double value)
 QKnx8BitUnsignedValue::QKnx8BitUnsignedValue(int subType, double value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("8-bit unsigned value"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("0"), tr("255"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("8-bit unsigned value"));
+        setRange(QVariant(0x00), QVariant(0xff));
+        setRangeText(tr("0"), tr("255"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(value);
 }
@@ -96,7 +100,7 @@ double QKnx8BitUnsignedValue::value() const
 {
     if (!isValid())
         return -1;
-    return byte(0) * coefficient();
+    return QKnxDptCodec<QKnx8BitUnsignedValue>::decode(constData(), size()) * coefficient();
 }
 
 /*!
@@ -125,11 +129,15 @@ bool QKnxTariff::isValid() const
 CLASS::CLASS() \
     : QKnx8BitUnsignedValue(SubType, 0.0) \
 { \
-    setUnit(tr(UNIT)); \
-    setCoefficient(COEFFICIENT); \
-    setDescription(tr(DESCRIPTION)); \
-    setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
-    setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        setUnit(tr(UNIT)); \
+        setCoefficient(COEFFICIENT); \
+        setDescription(tr(DESCRIPTION)); \
+        setRangeText(tr(RANGE_TEXT_MINIMUM), tr(RANGE_TEXT_MAXIMUM)); \
+        setRange(QVariant::fromValue(RANGE_VALUE_MINIMUM), \
+            QVariant::fromValue(RANGE_VALUE_MAXIMUM)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::CLASS(double value) \
     : CLASS() \
@@ -29,6 +29,7 @@
 
 #include "qknxchar.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -74,9 +75,12 @@ QKnxChar::QKnxChar(unsigned char value)
 QKnxChar::QKnxChar(int subType, unsigned char value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("Character"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("0"), tr("255"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Character"));
+        setRange(QVariant(0x00), QVariant(0xff));
+        setRangeText(tr("0"), tr("255"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(value);
 }
@@ -86,7 +90,7 @@ QKnxChar::QKnxChar(int subType, unsigned char value)
 */
 unsigned char QKnxChar::value() const
 {
-    return byte(0);
+    return QKnxDptCodec<QKnxChar>::decode(constData(), size());
 }
 
 /*!
@@ -131,8 +135,11 @@ bool QKnxChar::isValid() const
 QKnxCharASCII::QKnxCharASCII()
     : QKnxChar(SubType, 0)
 {
-    setDescription(tr("Character (ASCII)"));
-    setRange(QVariant(0x00), QVariant(0x7f));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Character (ASCII)"));
+        setRange(QVariant(0x00), QVariant(0x7f));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 }
 
 /*!
@@ -185,8 +192,11 @@ bool QKnxCharASCII::setCharacter(char value)
 QKnxChar88591::QKnxChar88591()
     : QKnxChar(SubType, 0)
 {
-    setDescription(tr("Character (ISO 8859-1)"));
-    setRange(QVariant(0x00), QVariant(0xff));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Character (ISO 8859-1)"));
+        setRange(QVariant(0x00), QVariant(0xff));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 }
 
 /*!
@@ -29,6 +29,7 @@
 
 #include "qknxcharstring.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -94,18 +95,24 @@ QKnxCharString::QKnxCharString(const char *string, int size)
 QKnxCharString::QKnxCharString(int subType, const char* string, int size)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("Fixed length character string"));
-    setRange(QVariant(0x00), QVariant(0xff));
-    setRangeText(tr("Minimum number of characters: 0"), tr("Maximum number of characters: 14"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Fixed length character string"));
+        setRange(QVariant(0x00), QVariant(0xff));
+        setRangeText(tr("Minimum number of characters: 0"), tr("Maximum number of characters: 14"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setString(string, size);
 }
 
 /*!
     Returns the string stored in the datapoint type.
+
+    The returned string refers to the bytes of the datapoint type and stays
+    valid until the datapoint type is modified or destroyed.
 */
 QLatin1String QKnxCharString::string() const
 {
-    return QLatin1String((const char*) constData());
+    return QKnxDptCodec<QKnxCharString>::decode(constData(), size());
 }
 
 /*!
@@ -129,17 +136,10 @@ bool QKnxCharString::setString(QLatin1String string)
 */
 bool QKnxCharString::setString(const char *string, int size)
 {
-    static auto null = QKnxByteArray(TypeSize, 0);
-    if (!string)
-        return setBytes(null, 0, TypeSize);
-
-    size = (size < 0 ? int(strlen(string)) : size);
-    if (size == 0)
-        return setBytes(null, 0, TypeSize);
-
+    size = (!string ? 0 : (size < 0 ? int(strlen(string)) : size));
     if (size > TypeSize || !isAscii(string, size, maximum().toUInt()))
         return false;
-    return setBytes(QKnxByteArray(string, size) + null.mid(0, TypeSize - size), 0, TypeSize);
+    return QKnxDptCodec<QKnxCharString>::encode(QLatin1String(string, size), data());
 }
 
 /*!
@@ -193,8 +193,11 @@ QKnxCharStringASCII::QKnxCharStringASCII(QLatin1String string)
 QKnxCharStringASCII::QKnxCharStringASCII(const char *string, int size)
     : QKnxCharString(SubType, nullptr, 0)
 {
-    setDescription(tr("Fixed length character string (ASCII)"));
-    setRange(QVariant(0x00), QVariant(0x7f));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Fixed length character string (ASCII)"));
+        setRange(QVariant(0x00), QVariant(0x7f));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setString(string, size);
 }
 
@@ -240,7 +243,10 @@ QKnxCharString88591::QKnxCharString88591(QLatin1String string)
 QKnxCharString88591::QKnxCharString88591(const char *string, int size)
     : QKnxCharString(SubType, string, size)
 {
-    setDescription(tr("Fixed length character string (ISO 8859-1)"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Fixed length character string (ISO 8859-1)"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 }
 
 QT_END_NAMESPACE
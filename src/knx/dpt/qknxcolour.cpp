@@ -0,0 +1,322 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxcolour.h"
+#include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxColourRGB
+    \inherits QKnxFixedSizeDatapointType
+    \inmodule QtKnx
+    \ingroup qtknx-datapoint-types
+    \since 5.15
+
+    \brief The QKnxColourRGB class is a datapoint type for an RGB colour value.
+
+    The red, green, and blue components of the colour are stored as values from
+    \c 0 to \c 255. How the value is interpreted depends on the device.
+
+    This is a fixed size datapoint type with the length of 3 bytes.
+
+    \sa QKnxColourRGBW, QKnxDatapointType, {Qt KNX Datapoint Type Classes}
+*/
+
+// -- QKnxColourRGB
+
+/*!
+    Creates a fixed size datapoint type with all colour components set to
+    \c 0.
+*/
+QKnxColourRGB::QKnxColourRGB()
+    : QKnxColourRGB(0, 0, 0)
+{}
+
+/*!
+    Creates a fixed size datapoint type with the colour components set to
+    \a red, \a green, and \a blue.
+*/
+QKnxColourRGB::QKnxColourRGB(quint8 red, quint8 green, quint8 blue)
+    : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
+{
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("RGB value 3x(0..255)"));
+        setRange(QVariant(0x00), QVariant(0xff));
+        setRangeText(tr("Minimum component value, 0"), tr("Maximum component value, 255"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
+
+    setValue(red, green, blue);
+}
+
+/*!
+    Returns the red component of the colour.
+*/
+quint8 QKnxColourRGB::red() const
+{
+    return QKnxDptCodec<QKnxColourRGB>::decode(constData(), size()).red;
+}
+
+/*!
+    Sets the red component of the colour to \a red.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGB::setRed(quint8 red)
+{
+    return setByte(0, red);
+}
+
+/*!
+    Returns the green component of the colour.
+*/
+quint8 QKnxColourRGB::green() const
+{
+    return QKnxDptCodec<QKnxColourRGB>::decode(constData(), size()).green;
+}
+
+/*!
+    Sets the green component of the colour to \a green.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGB::setGreen(quint8 green)
+{
+    return setByte(1, green);
+}
+
+/*!
+    Returns the blue component of the colour.
+*/
+quint8 QKnxColourRGB::blue() const
+{
+    return QKnxDptCodec<QKnxColourRGB>::decode(constData(), size()).blue;
+}
+
+/*!
+    Sets the blue component of the colour to \a blue.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGB::setBlue(quint8 blue)
+{
+    return setByte(2, blue);
+}
+
+/*!
+    Sets the colour components to \a red, \a green, and \a blue.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGB::setValue(quint8 red, quint8 green, quint8 blue)
+{
+    return QKnxDptCodec<QKnxColourRGB>::encode({ red, green, blue }, data());
+}
+
+
+// -- QKnxColourRGBW
+
+/*!
+    \class QKnxColourRGBW
+    \inherits QKnxFixedSizeDatapointType
+    \inmodule QtKnx
+    \ingroup qtknx-datapoint-types
+    \since 5.15
+
+    \brief The QKnxColourRGBW class is a datapoint type for an RGBW colour
+    value.
+
+    The red, green, blue, and white components of the colour are stored as
+    values from \c 0 to \c 255, where \c 255 corresponds to 100%. Only the
+    components marked as valid are meant to be applied by the receiver.
+
+    This is a fixed size datapoint type with the length of 6 bytes.
+
+    \sa QKnxColourRGB, QKnxDatapointType, {Qt KNX Datapoint Type Classes}
+*/
+
+/*!
+    \enum QKnxColourRGBW::Channel
+
+    This enum holds the colour components of the datapoint type.
+
+    \value White
+    The white component.
+    \value Blue
+    The blue component.
+    \value Green
+    The green component.
+    \value Red
+    The red component.
+*/
+
+/*!
+    Creates a fixed size datapoint type with all colour components set to
+    \c 0 and marked as valid.
+*/
+QKnxColourRGBW::QKnxColourRGBW()
+    : QKnxColourRGBW(0, 0, 0, 0)
+{}
+
+/*!
+    Creates a fixed size datapoint type with the colour components set to
+    \a red, \a green, \a blue, and \a white, and the components in
+    \a validChannels marked as valid.
+*/
+QKnxColourRGBW::QKnxColourRGBW(quint8 red, quint8 green, quint8 blue, quint8 white,
+    Channels validChannels)
+    : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
+{
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("RGBW value 4x(0..100%)"));
+        setRange(QVariant(0x00), QVariant(0xff));
+        setRangeText(tr("Minimum component value, 0"), tr("Maximum component value, 255"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
+
+    setValue(red, green, blue, white, validChannels);
+}
+
+/*!
+    Returns the red component of the colour.
+*/
+quint8 QKnxColourRGBW::red() const
+{
+    return QKnxDptCodec<QKnxColourRGBW>::decode(constData(), size()).red;
+}
+
+/*!
+    Sets the red component of the colour to \a red.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGBW::setRed(quint8 red)
+{
+    return setByte(0, red);
+}
+
+/*!
+    Returns the green component of the colour.
+*/
+quint8 QKnxColourRGBW::green() const
+{
+    return QKnxDptCodec<QKnxColourRGBW>::decode(constData(), size()).green;
+}
+
+/*!
+    Sets the green component of the colour to \a green.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGBW::setGreen(quint8 green)
+{
+    return setByte(1, green);
+}
+
+/*!
+    Returns the blue component of the colour.
+*/
+quint8 QKnxColourRGBW::blue() const
+{
+    return QKnxDptCodec<QKnxColourRGBW>::decode(constData(), size()).blue;
+}
+
+/*!
+    Sets the blue component of the colour to \a blue.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGBW::setBlue(quint8 blue)
+{
+    return setByte(2, blue);
+}
+
+/*!
+    Returns the white component of the colour.
+*/
+quint8 QKnxColourRGBW::white() const
+{
+    return QKnxDptCodec<QKnxColourRGBW>::decode(constData(), size()).white;
+}
+
+/*!
+    Sets the white component of the colour to \a white.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGBW::setWhite(quint8 white)
+{
+    return setByte(3, white);
+}
+
+/*!
+    Returns the colour components that are marked as valid.
+*/
+QKnxColourRGBW::Channels QKnxColourRGBW::validChannels() const
+{
+    return Channels(QKnxDptCodec<QKnxColourRGBW>::decode(constData(), size()).validChannels);
+}
+
+/*!
+    Marks the colour components in \a channels as valid and all others as
+    invalid.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGBW::setValidChannels(Channels channels)
+{
+    return setByte(5, quint8(channels) & 0x0f);
+}
+
+/*!
+    \reimp
+*/
+bool QKnxColourRGBW::isValid() const
+{
+    return QKnxDatapointType::isValid() && byte(4) == 0 && (byte(5) & 0xf0) == 0;
+}
+
+/*!
+    Sets the colour components to \a red, \a green, \a blue, and \a white, and
+    marks the components in \a validChannels as valid.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxColourRGBW::setValue(quint8 red, quint8 green, quint8 blue, quint8 white,
+    Channels validChannels)
+{
+    return QKnxDptCodec<QKnxColourRGBW>::encode({ red, green, blue, white,
+        quint8(quint8(validChannels) & 0x0f) }, data());
+}
+
+#include "moc_qknxcolour.cpp"
+
+QT_END_NAMESPACE
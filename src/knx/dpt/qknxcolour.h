@@ -0,0 +1,106 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXCOLOUR_H
+#define QKNXCOLOUR_H
+
+#include <QtKnx/qknxdatapointtype.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxColourRGB : public QKnxFixedSizeDatapointType
+{
+public:
+    QKnxColourRGB();
+    QKnxColourRGB(quint8 red, quint8 green, quint8 blue);
+
+    static const constexpr int TypeSize = 0x03;
+    static const constexpr int MainType = 0xe8;
+    static const constexpr int SubType = 0x258;
+
+    quint8 red() const;
+    bool setRed(quint8 red);
+
+    quint8 green() const;
+    bool setGreen(quint8 green);
+
+    quint8 blue() const;
+    bool setBlue(quint8 blue);
+
+    bool setValue(quint8 red, quint8 green, quint8 blue);
+};
+
+class Q_KNX_EXPORT QKnxColourRGBW : public QKnxFixedSizeDatapointType
+{
+    Q_GADGET
+
+public:
+    enum Channel : quint8
+    {
+        White = 0x01,
+        Blue = 0x02,
+        Green = 0x04,
+        Red = 0x08
+    };
+    Q_ENUM(Channel)
+    Q_DECLARE_FLAGS(Channels, Channel)
+
+    QKnxColourRGBW();
+    QKnxColourRGBW(quint8 red, quint8 green, quint8 blue, quint8 white,
+        Channels validChannels = Channels(Red | Green | Blue | White));
+
+    static const constexpr int TypeSize = 0x06;
+    static const constexpr int MainType = 0xfb;
+    static const constexpr int SubType = 0x258;
+
+    quint8 red() const;
+    bool setRed(quint8 red);
+
+    quint8 green() const;
+    bool setGreen(quint8 green);
+
+    quint8 blue() const;
+    bool setBlue(quint8 blue);
+
+    quint8 white() const;
+    bool setWhite(quint8 white);
+
+    Channels validChannels() const;
+    bool setValidChannels(Channels channels);
+
+    bool isValid() const override;
+    bool setValue(quint8 red, quint8 green, quint8 blue, quint8 white,
+        Channels validChannels = Channels(Red | Green | Blue | White));
+};
+Q_DECLARE_OPERATORS_FOR_FLAGS(QKnxColourRGBW::Channels)
+
+QT_END_NAMESPACE
+
+#endif
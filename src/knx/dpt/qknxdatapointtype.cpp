@@ -620,6 +620,12 @@ QT_BEGIN_NAMESPACE
     \value Dpt225_ScalingSpeed
            A fixed size datapoint type for storing scaling speed. Used in the
            lighting application area, only.
+    \value DptScalingSpeed
+           Stores the time period in milliseconds for fading to a brightness
+           value given in percent.
+    \value DptScalingStepTime
+           Stores the time period in milliseconds between two steps of a
+           brightness fade with the step size given in percent.
     \value Dpt232_3ByteColourRGB
            A fixed size datapoint type for storing an RGB color value.
     \value DptColourRGB
@@ -627,6 +633,11 @@ QT_BEGIN_NAMESPACE
            How RGB is interpreted depends on the device, and therefore this
            coding is only suitable for point-to-point communication, where there
            is only a single receiver.
+    \value Dpt251_6ByteColourRGBW
+           A fixed size datapoint type for storing an RGBW color value.
+    \value DptColourRGBW
+           Stores an RGBW color value and marks which of the red, green, blue,
+           and white components are valid.
 */
 
 /*!
@@ -689,20 +700,12 @@ QKnxDatapointType::~QKnxDatapointType()
 QKnxDatapointType::QKnxDatapointType(Type type, int size)
     : d_ptr(new QKnxDatapointTypePrivate)
 {
-    auto number = QString::number(int(type));
-    if (number.size() < 6)
-        return;
-
-    bool okMain = false, okSub = false;
-
     // Datapoint Type shall be identified by a 16 bit main number separated
     // by a dot from a 16 bit sub number. The assumption being made is that
     // QKnxDatapointType::Type is encoded in that way while omitting the dot.
-    quint16 mainType = number.leftRef(number.size() - 5).toUShort(&okMain);
-    quint16 subType = number.rightRef(5).toUShort(&okSub);
-
-    if (okMain && okSub)
-        d_ptr->setup(mainType, subType, quint32(type), size);
+    const auto number = quint32(type);
+    if (number >= 100000 && (number % 100000) <= 0xffff)
+        d_ptr->setup(number, size);
 }
 
 /*!
@@ -711,20 +714,9 @@ QKnxDatapointType::QKnxDatapointType(Type type, int size)
 QKnxDatapointType::QKnxDatapointType(const QString &dptId, int size)
     : d_ptr(new QKnxDatapointTypePrivate)
 {
-    auto match = d_ptr->m_dpt.match(dptId);
-    if (!match.hasMatch())
-        return;
-
-    QString subType = QStringLiteral("0");
-    auto mainType = match.captured(QStringLiteral("MainOnly"));
-    if (mainType.isEmpty()) {
-        subType = match.captured(QStringLiteral("SubType"));
-        mainType = match.captured(QStringLiteral("MainType"));
-    }
-
     quint32 tmp;
-    if (QKnxDatapointTypePrivate::toType(mainType, subType, &tmp))
-        d_ptr->setup(mainType.toUInt(), subType.toUInt(), tmp, size);
+    if (QKnxDatapointTypePrivate::toType(dptId, &tmp))
+        d_ptr->setup(tmp, size);
 }
 
 /*!
@@ -736,7 +728,7 @@ QKnxDatapointType::QKnxDatapointType(quint16 mainType, quint16 subType, int size
 {
     quint32 tmp;
     if (QKnxDatapointTypePrivate::toType(mainType, subType, &tmp))
-        d_ptr->setup(mainType, subType, tmp, size);
+        d_ptr->setup(tmp, size);
 }
 
 /*!
@@ -752,7 +744,7 @@ int QKnxDatapointType::size() const
 */
 int QKnxDatapointType::subType() const
 {
-    return d_ptr->m_subType;
+    return int(d_ptr->m_type % 100000);
 }
 
 /*!
@@ -760,7 +752,7 @@ int QKnxDatapointType::subType() const
 */
 int QKnxDatapointType::mainType() const
 {
-    return d_ptr->m_mainType;
+    return int(d_ptr->m_type / 100000);
 }
 
 /*!
@@ -768,7 +760,7 @@ int QKnxDatapointType::mainType() const
 */
 QVariant QKnxDatapointType::minimum() const
 {
-    return d_ptr->m_minimum;
+    return d_ptr->m_metaData->m_minimum;
 }
 
 /*!
@@ -776,7 +768,7 @@ QVariant QKnxDatapointType::minimum() const
 */
 void QKnxDatapointType::setMinimum(const QVariant &minimum)
 {
-    d_ptr->m_minimum = minimum;
+    d_ptr->m_metaData->m_minimum = minimum;
 }
 
 /*!
@@ -784,7 +776,7 @@ void QKnxDatapointType::setMinimum(const QVariant &minimum)
 */
 QVariant QKnxDatapointType::maximum() const
 {
-    return d_ptr->m_maximum;
+    return d_ptr->m_metaData->m_maximum;
 }
 
 /*!
@@ -792,7 +784,7 @@ QVariant QKnxDatapointType::maximum() const
 */
 void QKnxDatapointType::setMaximum(const QVariant &maximum)
 {
-    d_ptr->m_maximum = maximum;
+    d_ptr->m_metaData->m_maximum = maximum;
 }
 
 /*!
@@ -800,7 +792,7 @@ void QKnxDatapointType::setMaximum(const QVariant &maximum)
 */
 double QKnxDatapointType::coefficient() const
 {
-    return d_ptr->m_coefficient;
+    return d_ptr->m_metaData->m_coefficient;
 }
 
 /*!
@@ -808,7 +800,7 @@ double QKnxDatapointType::coefficient() const
 */
 void QKnxDatapointType::setCoefficient(double coef)
 {
-    d_ptr->m_coefficient = coef;
+    d_ptr->m_metaData->m_coefficient = coef;
 }
 
 /*!
@@ -816,7 +808,7 @@ void QKnxDatapointType::setCoefficient(double coef)
 */
 QString QKnxDatapointType::minimumText() const
 {
-    return d_ptr->m_minimumText;
+    return d_ptr->m_metaData->m_minimumText;
 }
 
 /*!
@@ -825,7 +817,7 @@ QString QKnxDatapointType::minimumText() const
 */
 void QKnxDatapointType::setMinimumText(const QString &minimumText)
 {
-    d_ptr->m_minimumText = minimumText;
+    d_ptr->m_metaData->m_minimumText = minimumText;
 }
 
 /*!
@@ -833,7 +825,7 @@ void QKnxDatapointType::setMinimumText(const QString &minimumText)
 */
 QString QKnxDatapointType::maximumText() const
 {
-    return d_ptr->m_maximumText;
+    return d_ptr->m_metaData->m_maximumText;
 }
 
 /*!
@@ -842,7 +834,7 @@ QString QKnxDatapointType::maximumText() const
 */
 void QKnxDatapointType::setMaximumText(const QString &maximumText)
 {
-    d_ptr->m_maximumText = maximumText;
+    d_ptr->m_metaData->m_maximumText = maximumText;
 }
 
 /*!
@@ -851,8 +843,9 @@ void QKnxDatapointType::setMaximumText(const QString &maximumText)
 */
 void QKnxDatapointType::setRange(const QVariant &minimum, const QVariant &maximum)
 {
-    d_ptr->m_minimum = minimum;
-    d_ptr->m_maximum = maximum;
+    auto metaData = d_ptr->m_metaData.data();
+    metaData->m_minimum = minimum;
+    metaData->m_maximum = maximum;
 }
 
 /*!
@@ -861,8 +854,9 @@ void QKnxDatapointType::setRange(const QVariant &minimum, const QVariant &maximu
 */
 void QKnxDatapointType::setRangeText(const QString &minimumText, const QString &maximumText)
 {
-    d_ptr->m_minimumText = minimumText;
-    d_ptr->m_maximumText = maximumText;
+    auto metaData = d_ptr->m_metaData.data();
+    metaData->m_minimumText = minimumText;
+    metaData->m_maximumText = maximumText;
 }
 
 /*!
@@ -870,7 +864,7 @@ void QKnxDatapointType::setRangeText(const QString &minimumText, const QString &
 */
 QString QKnxDatapointType::unit() const
 {
-    return d_ptr->m_unit;
+    return d_ptr->m_metaData->m_unit;
 }
 
 /*!
@@ -878,7 +872,7 @@ QString QKnxDatapointType::unit() const
 */
 void QKnxDatapointType::setUnit(const QString &unit)
 {
-    d_ptr->m_unit = unit;
+    d_ptr->m_metaData->m_unit = unit;
 }
 
 /*!
@@ -886,7 +880,7 @@ void QKnxDatapointType::setUnit(const QString &unit)
 */
 QString QKnxDatapointType::description() const
 {
-    return d_ptr->m_descrition;
+    return d_ptr->m_metaData->m_description;
 }
 
 /*!
@@ -894,7 +888,7 @@ QString QKnxDatapointType::description() const
 */
 void QKnxDatapointType::setDescription(const QString &description)
 {
-    d_ptr->m_descrition = description;
+    d_ptr->m_metaData->m_description = description;
 }
 
 /*!
@@ -1010,17 +1004,21 @@ void QKnxDatapointType::swap(QKnxDatapointType &other) Q_DECL_NOTHROW
 */
 bool QKnxDatapointType::operator==(const QKnxDatapointType &other) const
 {
-    return d_ptr == other.d_ptr
-        || (d_ptr->m_subType == other.d_ptr->m_subType
-            && d_ptr->m_mainType == other.d_ptr->m_mainType
-            && d_ptr->m_bytes == other.d_ptr->m_bytes
-            && d_ptr->m_unit == other.d_ptr->m_unit
-            && d_ptr->m_descrition == other.d_ptr->m_descrition
-            && d_ptr->m_minimum == other.d_ptr->m_minimum
-            && d_ptr->m_maximum == other.d_ptr->m_maximum
-            && d_ptr->m_coefficient == other.d_ptr->m_coefficient
-            && d_ptr->m_minimumText == other.d_ptr->m_minimumText
-            && d_ptr->m_maximumText == other.d_ptr->m_maximumText);
+    if (d_ptr == other.d_ptr)
+        return true;
+    if (d_ptr->m_type != other.d_ptr->m_type || d_ptr->m_bytes != other.d_ptr->m_bytes)
+        return false;
+
+    const auto lhs = d_ptr->m_metaData.constData();
+    const auto rhs = other.d_ptr->m_metaData.constData();
+    return lhs == rhs
+        || (lhs->m_unit == rhs->m_unit
+            && lhs->m_description == rhs->m_description
+            && lhs->m_minimum == rhs->m_minimum
+            && lhs->m_maximum == rhs->m_maximum
+            && lhs->m_coefficient == rhs->m_coefficient
+            && lhs->m_minimumText == rhs->m_minimumText
+            && lhs->m_maximumText == rhs->m_maximumText);
 }
 
 /*!
@@ -1039,20 +1037,8 @@ bool QKnxDatapointType::operator!=(const QKnxDatapointType &other) const
 */
 QKnxDatapointType::Type QKnxDatapointType::toType(const QString &dpt)
 {
-    QKnxDatapointTypePrivate dtp;
-    auto match = dtp.m_dpt.match(dpt);
-    if (!match.hasMatch())
-        return QKnxDatapointType::Type::Unknown;
-
-    QString subType = QStringLiteral("0");
-    auto mainType = match.captured(QStringLiteral("MainOnly"));
-    if (mainType.isEmpty()) {
-        subType = match.captured(QStringLiteral("SubType"));
-        mainType = match.captured(QStringLiteral("MainType"));
-    }
-
     quint32 type;
-    if (QKnxDatapointTypePrivate::toType(mainType, subType, &type))
+    if (QKnxDatapointTypePrivate::toType(dpt, &type))
         return static_cast<Type> (type);
     return QKnxDatapointType::Type::Unknown;
 }
@@ -1068,6 +1054,18 @@ void QKnxDatapointType::resize(int newSize)
     d_ptr->m_bytes.resize(newSize);
 }
 
+/*!
+    \internal
+    \since 5.15
+
+    Returns a pointer to the bytes stored in the datapoint type, so that
+    subclasses can encode their value in place.
+*/
+quint8 *QKnxDatapointType::data()
+{
+    return d_ptr->m_bytes.data();
+}
+
 /*!
     \internal
 */
@@ -1075,6 +1073,99 @@ QKnxDatapointType::QKnxDatapointType(QKnxDatapointTypePrivate &dd)
     : d_ptr(new QKnxDatapointTypePrivate(dd))
 {}
 
+Q_GLOBAL_STATIC_WITH_ARGS(QSharedDataPointer<QKnxDatapointTypeMetaData>, qt_knxEmptyMetaData,
+    (new QKnxDatapointTypeMetaData))
+
+/*!
+    \internal
+    \class QKnxDatapointTypePrivate
+
+    Holds the per-object state of a datapoint type: the type identifier and
+    the value bytes. Units, descriptions, and ranges live in a
+    QKnxDatapointTypeMetaData block that is shared implicitly. The
+    constructors of the datapoint type classes fill the block once and share
+    it among all objects of the same class, see metaData(). Calling one of the
+    setters of QKnxDatapointType detaches the object from the shared block.
+*/
+QKnxDatapointTypePrivate::QKnxDatapointTypePrivate()
+{
+    if (auto metaData = qt_knxEmptyMetaData())
+        m_metaData = *metaData;
+    else
+        m_metaData = new QKnxDatapointTypeMetaData;
+}
+
+namespace QKnxPrivate
+{
+    // Consumes the case insensitive ASCII prefix, given in lower case.
+    static bool skipPrefix(const QChar *&it, const QChar *end, const char *prefix)
+    {
+        const QChar *p = it;
+        for (; *prefix; ++prefix, ++p) {
+            if (p == end)
+                return false;
+            const ushort c = p->unicode();
+            const ushort expected = ushort(*prefix);
+            if (c != expected && !(expected >= 'a' && expected <= 'z' && c == expected - 0x20))
+                return false;
+        }
+        it = p;
+        return true;
+    }
+
+    // Consumes one to five ASCII digits, like the \d{1,5} of the former pattern.
+    static bool readNumber(const QChar *&it, const QChar *end, quint32 *number)
+    {
+        quint32 value = 0;
+        int digits = 0;
+        for (; it != end && it->unicode() >= '0' && it->unicode() <= '9'; ++it) {
+            if (++digits > 5)
+                return false;
+            value = value * 10 + (it->unicode() - '0');
+        }
+        *number = value;
+        return digits > 0;
+    }
+}
+
+/*!
+    \internal
+
+    Parses the datapoint type identifier \a dptId, which is either
+    \c DPT-main, or main and sub number separated by a dot or a dash with an
+    optional \c DPST- prefix. The comparison of the prefixes is case
+    insensitive and both numbers have at most five digits. On success, stores
+    the main number times 100000 plus the sub number in \a type and returns
+    \c true.
+
+    The identifier is parsed in place without allocating memory.
+*/
+bool QKnxDatapointTypePrivate::toType(const QString &dptId, quint32 *type)
+{
+    const QChar *it = dptId.constData();
+    const QChar *const end = it + dptId.size();
+
+    quint32 main = 0, sub = 0;
+    if (QKnxPrivate::skipPrefix(it, end, "dpt-")) {
+        if (!QKnxPrivate::readNumber(it, end, &main))
+            return false;
+    } else {
+        QKnxPrivate::skipPrefix(it, end, "dpst-");
+        if (!QKnxPrivate::readNumber(it, end, &main) || it == end)
+            return false;
+        if (*it != QLatin1Char('.') && *it != QLatin1Char('-'))
+            return false;
+        if (!QKnxPrivate::readNumber(++it, end, &sub))
+            return false;
+    }
+
+    const quint64 tmp = quint64(main) * 100000 + sub;
+    if (it != end || tmp > quint64(0xffffffff))
+        return false;
+    *type = quint32(tmp);
+    return true;
+}
+
 
 // -- QKnxVariableSizeDatapointType
 
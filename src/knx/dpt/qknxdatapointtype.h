@@ -156,8 +156,11 @@ public:
         Dpt221 = 22100000,
             DptSerialNumber = 22100001,
         Dpt225_ScalingSpeed = 22500000,
+            DptScalingSpeed = 22500001, DptScalingStepTime = 22500002,
         Dpt232_3ByteColourRGB = 23200000,
-            DptColourRGB = 23200600
+            DptColourRGB = 23200600,
+        Dpt251_6ByteColourRGBW = 25100000,
+            DptColourRGBW = 25100600
     };
     Q_ENUM(Type)
     Type type() const;
@@ -232,10 +235,12 @@ public:
 
 protected:
     void resize(int newSize);
+    quint8 *data();
 
 private:
     QKnxDatapointType() = delete;
     explicit QKnxDatapointType(QKnxDatapointTypePrivate &dd);
+    friend struct QKnxDatapointTypePrivate;
 
 private:
     QSharedDataPointer<QKnxDatapointTypePrivate> d_ptr;
@@ -41,52 +41,61 @@
 // We mean it.
 //
 
-#include <QtCore/qregularexpression.h>
 #include <QtCore/qshareddata.h>
 #include <QtCore/qvariant.h>
 #include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qknxdatapointtype.h>
 #include <QtKnx/qtknxglobal.h>
 
 QT_BEGIN_NAMESPACE
 
+struct QKnxDatapointTypeMetaData : public QSharedData
+{
+    QString m_unit, m_description;
+    QVariant m_minimum, m_maximum;
+    double m_coefficient { 1 };
+    QString m_minimumText, m_maximumText;
+};
+
 struct Q_KNX_EXPORT QKnxDatapointTypePrivate : public QSharedData
 {
-    QKnxDatapointTypePrivate() = default;
+    QKnxDatapointTypePrivate();
     ~QKnxDatapointTypePrivate() = default;
 
-    int m_subType { 0 };
-    int m_mainType { 0 };
     quint32 m_type { 0 };
     QKnxByteArray m_bytes;
-    QString m_unit, m_descrition;
-    QVariant m_minimum, m_maximum;
-    double m_coefficient { 1 };
-    QString m_minimumText, m_maximumText;
-    const QRegularExpression m_dpt { QStringLiteral("^DPT-(?<MainOnly>\\d{1,5})$"
-        "|^(DPST-)?(?<MainType>\\d{1,5})(\\.|-)(?<SubType>\\d{1,5})$"),
-            QRegularExpression::CaseInsensitiveOption };
+    QSharedDataPointer<QKnxDatapointTypeMetaData> m_metaData;
 
-    static bool toType(quint16 main, quint16 sub, quint32 *type) {
-        return toType(QString::number(main), QString::number(sub), type);
-    }
-    static bool toType(const QString &main, const QString &sub, quint32 *type)
+    static bool toType(quint16 main, quint16 sub, quint32 *type)
     {
-        if (main.isEmpty() || sub.isEmpty())
+        const quint64 tmp = quint64(main) * 100000 + sub;
+        if (tmp > quint64(0xffffffff))
             return false;
-
-        bool ok = true;
-        *type = QString(main.rightJustified(5, QLatin1Char('0')) + sub
-            .rightJustified(5, QLatin1Char('0'))).toUInt(&ok);
-        return ok;
+        *type = quint32(tmp);
+        return true;
     }
-    void setup(quint16 mainType, quint16 subType, quint32 type, int size)
+    static bool toType(const QString &dptId, quint32 *type);
+    void setup(quint32 type, int size)
     {
-        m_subType = subType;
-        m_mainType = mainType;
-
         m_type = type;
         m_bytes.fill(0x00, size);
     }
+
+    // Runs the setters in init() once on the object under construction and
+    // returns the resulting metadata, which is then shared by all objects of
+    // the same class. Meant to initialize a function-local static.
+    template <typename Init>
+    static QSharedDataPointer<QKnxDatapointTypeMetaData> metaData(QKnxDatapointType *dpt,
+        Init init)
+    {
+        init();
+        return dpt->d_ptr->m_metaData;
+    }
+    static void setMetaData(QKnxDatapointType *dpt,
+        const QSharedDataPointer<QKnxDatapointTypeMetaData> &metaData)
+    {
+        dpt->d_ptr->m_metaData = metaData;
+    }
 };
 
 QT_END_NAMESPACE
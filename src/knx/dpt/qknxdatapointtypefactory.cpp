@@ -29,6 +29,7 @@
 
 #include "qknxdatapointtype_p.h"
 #include "qknxdatapointtypefactory.h"
+#include "qknxdptcodec.h"
 
 #include "qknx1bit.h"
 #include "qknx1bitcontrolled.h"
@@ -47,16 +48,518 @@
 #include "qknx8bitunsignedvalue.h"
 #include "qknxchar.h"
 #include "qknxcharstring.h"
+#include "qknxcolour.h"
 #include "qknxdatetime.h"
 #include "qknxelectricalenergy.h"
 #include "qknxentranceaccess.h"
+#include "qknxscalingspeed.h"
 #include "qknxscene.h"
 #include "qknxstatusmode3.h"
 #include "qknxutf8string.h"
 #include "qknxvarstring.h"
 
+#include <QtCore/qnumeric.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
+namespace QKnxPrivate
+{
+    /*
+        Maps between the value of a main type codec and QVariant. Composite
+        main types are exposed as their single encoded byte, main types 5, 7
+        and 8 apply the coefficient of the sub type like the matching class.
+    */
+    template <int MainType> struct QKnxDptVariant
+    {
+        using Codec = QKnxDptMainTypeCodec<MainType>;
+
+        static QVariant decode(const quint8 *data, int size, double)
+        {
+            return QVariant::fromValue(Codec::decode(data, size));
+        }
+
+        static bool encode(const QVariant &value, double, quint8 *data)
+        {
+            return Codec::encode(value.value<typename Codec::ValueType>(), data);
+        }
+    };
+
+    template <int MainType> struct QKnxDptCompositeVariant
+    {
+        using Codec = QKnxDptMainTypeCodec<MainType>;
+
+        static QVariant decode(const quint8 *data, int size, double)
+        {
+            quint8 byte = 0;
+            Codec::encode(Codec::decode(data, size), &byte);
+            return QVariant::fromValue(byte);
+        }
+
+        static bool encode(const QVariant &value, double, quint8 *data)
+        {
+            const quint8 byte = value.value<quint8>();
+            return Codec::encode(Codec::decode(&byte, Codec::TypeSize), data);
+        }
+    };
+
+    template <int MainType, typename Result> struct QKnxDptScaledVariant
+    {
+        using Codec = QKnxDptMainTypeCodec<MainType>;
+
+        static QVariant decode(const quint8 *data, int size, double coefficient)
+        {
+            return QVariant::fromValue(Result(Codec::decode(data, size) * coefficient));
+        }
+
+        static bool encode(const QVariant &value, double coefficient, quint8 *data)
+        {
+            const qint64 raw = qRound64(value.toDouble() / coefficient);
+            if (raw < std::numeric_limits<typename Codec::ValueType>::min()
+                || raw > std::numeric_limits<typename Codec::ValueType>::max()) {
+                return false;
+            }
+            return Codec::encode(typename Codec::ValueType(raw), data);
+        }
+    };
+
+    template <> struct QKnxDptVariant<2> : QKnxDptCompositeVariant<2> {};
+    template <> struct QKnxDptVariant<3> : QKnxDptCompositeVariant<3> {};
+    template <> struct QKnxDptVariant<5> : QKnxDptScaledVariant<5, double> {};
+    template <> struct QKnxDptVariant<7> : QKnxDptScaledVariant<7, quint32> {};
+    template <> struct QKnxDptVariant<8> : QKnxDptScaledVariant<8, double> {};
+    template <> struct QKnxDptVariant<18> : QKnxDptCompositeVariant<18> {};
+    template <> struct QKnxDptVariant<26> : QKnxDptCompositeVariant<26> {};
+
+    // The unscaled value of a numeric main type, used for deadband comparison.
+    template <int MainType> static double dptNumber(const quint8 *data, int size)
+    {
+        return double(QKnxDptMainTypeCodec<MainType>::decode(data, size));
+    }
+
+    struct QKnxDptDispatchEntry
+    {
+        int typeSize;
+        QVariant (*decode)(const quint8 *data, int size, double coefficient);
+        bool (*encode)(const QVariant &value, double coefficient, quint8 *data);
+        double (*number)(const quint8 *data, int size);
+    };
+
+    template <int MainType> constexpr QKnxDptDispatchEntry codecEntry()
+    {
+        return { QKnxDptMainTypeCodec<MainType>::TypeSize, &QKnxDptVariant<MainType>::decode,
+            &QKnxDptVariant<MainType>::encode, nullptr };
+    }
+
+    template <int MainType> constexpr QKnxDptDispatchEntry numericEntry()
+    {
+        return { QKnxDptMainTypeCodec<MainType>::TypeSize, &QKnxDptVariant<MainType>::decode,
+            &QKnxDptVariant<MainType>::encode, &dptNumber<MainType> };
+    }
+
+    static constexpr QKnxDptDispatchEntry NoCodec { 0, nullptr, nullptr, nullptr };
+
+    // Indexed by main type, main types without a fixed size codec have no entry.
+    static constexpr QKnxDptDispatchEntry DispatchTable[] = {
+        NoCodec,            codecEntry<1>(),    codecEntry<2>(),    codecEntry<3>(),
+        codecEntry<4>(),    numericEntry<5>(),  numericEntry<6>(),  numericEntry<7>(),
+        numericEntry<8>(),  numericEntry<9>(),  codecEntry<10>(),   codecEntry<11>(),
+        numericEntry<12>(), numericEntry<13>(), numericEntry<14>(), NoCodec,
+        NoCodec,            codecEntry<17>(),   codecEntry<18>(),   NoCodec,
+        codecEntry<20>(),   codecEntry<21>(),   NoCodec,            codecEntry<23>(),
+        NoCodec,            NoCodec,            codecEntry<26>(),   codecEntry<27>(),
+        NoCodec,            numericEntry<29>()
+    };
+
+    // Sub types whose value is scaled, must match the coefficients set by the classes.
+    static constexpr double dispatchCoefficient(int mainType, int subType)
+    {
+        return (mainType == 5 && subType == 1) ? 100 / 255.
+            : (mainType == 5 && subType == 3) ? 360 / 255.
+            : ((mainType == 7 || mainType == 8) && subType == 3) ? 10.
+            : ((mainType == 7 || mainType == 8) && subType == 4) ? 100.
+            : (mainType == 8 && subType == 10) ? 327.67 / 32767
+            : 1.;
+    }
+
+    static const QKnxDptDispatchEntry *dispatchEntry(int mainType)
+    {
+        if (mainType <= 0 || mainType >= int(sizeof(DispatchTable) / sizeof(DispatchTable[0])))
+            return nullptr;
+        const auto entry = &DispatchTable[mainType];
+        return entry->decode ? entry : nullptr;
+    }
+
+    struct QKnxDatapointTypeRegistryEntry
+    {
+        quint32 type;
+        int size;
+        QKnxDatapointTypeFactory::FactoryFunction create;
+    };
+
+    template <typename Class> QKnxDatapointType *createDatapointType()
+    {
+        return new Class();
+    }
+
+    template <typename Class> constexpr QKnxDatapointTypeRegistryEntry registryEntry()
+    {
+        return { quint32(Class::MainType) * 100000 + quint32(Class::SubType), Class::TypeSize,
+            &createDatapointType<Class> };
+    }
+
+    // The built-in datapoint types, sorted by main and sub type. Being a constant
+    // expression, the table needs no dynamic initialization.
+    static constexpr QKnxDatapointTypeRegistryEntry Registry[] = {
+        // DPT-1
+        registryEntry<QKnx1Bit>(),
+        registryEntry<QKnxSwitch>(),
+        registryEntry<QKnxBool>(),
+        registryEntry<QKnxEnable>(),
+        registryEntry<QKnxRamp>(),
+        registryEntry<QKnxAlarm>(),
+        registryEntry<QKnxBinaryValue>(),
+        registryEntry<QKnxStep>(),
+        registryEntry<QKnxUpDown>(),
+        registryEntry<QKnxOpenClose>(),
+        registryEntry<QKnxStart>(),
+        registryEntry<QKnxState>(),
+        registryEntry<QKnxInvert>(),
+        registryEntry<QKnxDimSendStyle>(),
+        registryEntry<QKnxInputSource>(),
+        registryEntry<QKnxReset>(),
+        registryEntry<QKnxAck>(),
+        registryEntry<QKnxTrigger>(),
+        registryEntry<QKnxOccupancy>(),
+        registryEntry<QKnxWindowDoor>(),
+        registryEntry<QKnxLogicalFunction>(),
+        registryEntry<QKnxSceneAB>(),
+        registryEntry<QKnxShutterBlindsMode>(),
+        registryEntry<QKnxHeatCool>(),
+
+        // DPT-2
+        registryEntry<QKnx1BitControlled>(),
+        registryEntry<QKnxSwitchControl>(),
+        registryEntry<QKnxBoolControl>(),
+        registryEntry<QKnxEnableControl>(),
+        registryEntry<QKnxRampControl>(),
+        registryEntry<QKnxAlarmControl>(),
+        registryEntry<QKnxBinaryValueControl>(),
+        registryEntry<QKnxStepControl>(),
+        registryEntry<QKnxDirection1Control>(),
+        registryEntry<QKnxDirection2Control>(),
+        registryEntry<QKnxStartControl>(),
+        registryEntry<QKnxStateControl>(),
+        registryEntry<QKnxInvertControl>(),
+
+        // DPT-3
+        registryEntry<QKnx3BitControlled>(),
+        registryEntry<QKnxControlDimming>(),
+        registryEntry<QKnxControlBlinds>(),
+
+        // DPT-4
+        registryEntry<QKnxChar>(),
+        registryEntry<QKnxCharASCII>(),
+        registryEntry<QKnxChar88591>(),
+
+        // DPT-5
+        registryEntry<QKnx8BitUnsignedValue>(),
+        registryEntry<QKnxScaling>(),
+        registryEntry<QKnxAngle>(),
+        registryEntry<QKnxPercentU8>(),
+        registryEntry<QKnxDecimalFactor>(),
+        registryEntry<QKnxTariff>(),
+        registryEntry<QKnxValue1Ucount>(),
+
+        // DPT-6
+        registryEntry<QKnx8BitSignedValue>(),
+        registryEntry<QKnxPercentV8>(),
+        registryEntry<QKnxValue1Count>(),
+        registryEntry<QKnxStatusMode3>(),
+
+        // DPT-7
+        registryEntry<QKnx2ByteUnsignedValue>(),
+        registryEntry<QKnxValue2Ucount>(),
+        registryEntry<QKnxTimePeriodMsec>(),
+        registryEntry<QKnxTimePeriod10Msec>(),
+        registryEntry<QKnxTimePeriod100Msec>(),
+        registryEntry<QKnxTimePeriodSec>(),
+        registryEntry<QKnxTimePeriodMin>(),
+        registryEntry<QKnxTimePeriodHrs>(),
+        registryEntry<QKnxPropDataType>(),
+        registryEntry<QKnxLengthMilliMeter>(),
+        registryEntry<QKnxUEICurrentMilliA>(),
+        registryEntry<QKnxBrightness>(),
+
+        // DPT-8
+        registryEntry<QKnx2ByteSignedValue>(),
+        registryEntry<QKnxValue2Count>(),
+        registryEntry<QKnxDeltaTimeMsec>(),
+        registryEntry<QKnxDeltaTime10Msec>(),
+        registryEntry<QKnxDeltaTime100Msec>(),
+        registryEntry<QKnxDeltaTimeSec>(),
+        registryEntry<QKnxDeltaTimeMin>(),
+        registryEntry<QKnxDeltaTimeHrs>(),
+        registryEntry<QKnxPercentV16>(),
+        registryEntry<QKnxRotationAngle>(),
+
+        // DPT-9
+        registryEntry<QKnx2ByteFloat>(),
+        registryEntry<QKnxTemperatureCelsius>(),
+        registryEntry<QKnxTemperatureKelvin>(),
+        registryEntry<QKnxTemperatureChange>(),
+        registryEntry<QKnxValueLux>(),
+        registryEntry<QKnxWindSpeed>(),
+        registryEntry<QKnxPressure>(),
+        registryEntry<QKnxHumidity>(),
+        registryEntry<QKnxAirQuality>(),
+        registryEntry<QKnxAirFlow>(),
+        registryEntry<QKnxTimeSecond>(),
+        registryEntry<QKnxTimeMilliSecond>(),
+        registryEntry<QKnxVoltage>(),
+        registryEntry<QKnxCurrent>(),
+        registryEntry<QKnxPowerDensity>(),
+        registryEntry<QKnxKelvinPerPercent>(),
+        registryEntry<QKnxPower>(),
+        registryEntry<QKnxVolumeFlow>(),
+        registryEntry<QKnxAmountRain>(),
+        registryEntry<QKnxTemperatureFahrenheit>(),
+        registryEntry<QKnxWindSpeedKmPerHour>(),
+        registryEntry<QKnxValueAbsoluteHumidity>(),
+        registryEntry<QKnxConcentration>(),
+
+        // DPT-10
+        registryEntry<QKnxTimeOfDay>(),
+
+        // DPT-11
+        registryEntry<QKnxDate>(),
+
+        // DPT-12
+        registryEntry<QKnx4ByteUnsignedValue>(),
+        registryEntry<QKnxValue4UCount>(),
+
+        // DPT-13
+        registryEntry<QKnx4ByteSignedValue>(),
+        registryEntry<QKnxValue4Count>(),
+        registryEntry<QKnxFlowRateCubicMeterPerHour>(),
+        registryEntry<QKnxActiveEnergy>(),
+        registryEntry<QKnxApparentEnergy>(),
+        registryEntry<QKnxReactiveEnergy>(),
+        registryEntry<QKnxActiveEnergykWh>(),
+        registryEntry<QKnxApparentEnergykVAh>(),
+        registryEntry<QKnxReactiveEnergykVARh>(),
+        registryEntry<QKnxLongDeltaTimeSec>(),
+
+        // DPT-14
+        registryEntry<QKnxValueAcceleration>(),
+        registryEntry<QKnxValueAccelerationAngular>(),
+        registryEntry<QKnxValueActivationEnergy>(),
+        registryEntry<QKnxValueActivity>(),
+        registryEntry<QKnxValueMol>(),
+        registryEntry<QKnxValueAmplitude>(),
+        registryEntry<QKnxValueAngleRad>(),
+        registryEntry<QKnxValueAngleDeg>(),
+        registryEntry<QKnxValueAngularMomentum>(),
+        registryEntry<QKnxValueAngularVelocity>(),
+        registryEntry<QKnxValueArea>(),
+        registryEntry<QKnxValueCapacitance>(),
+        registryEntry<QKnxValueChargeDensitySurface>(),
+        registryEntry<QKnxValueChargeDensityVolume>(),
+        registryEntry<QKnxValueCompressibility>(),
+        registryEntry<QKnxValueConductance>(),
+        registryEntry<QKnxValueElectricalConductivity>(),
+        registryEntry<QKnxValueDensity>(),
+        registryEntry<QKnxValueElectricCharge>(),
+        registryEntry<QKnxValueElectricCurrent>(),
+        registryEntry<QKnxValueElectricCurrentDensity>(),
+        registryEntry<QKnxValueElectricDipoleMoment>(),
+        registryEntry<QKnxValueElectricDisplacement>(),
+        registryEntry<QKnxValueElectricFieldStrength>(),
+        registryEntry<QKnxValueElectricFlux>(),
+        registryEntry<QKnxValueElectricFluxDensity>(),
+        registryEntry<QKnxValueElectricPolarization>(),
+        registryEntry<QKnxValueElectricPotential>(),
+        registryEntry<QKnxValueElectricPotentialDifference>(),
+        registryEntry<QKnxValueElectromagneticMoment>(),
+        registryEntry<QKnxValueElectromotiveForce>(),
+        registryEntry<QKnxValueEnergy>(),
+        registryEntry<QKnxValueForce>(),
+        registryEntry<QKnxValueFrequency>(),
+        registryEntry<QKnxValueAngularFrequency>(),
+        registryEntry<QKnxValueHeatCapacity>(),
+        registryEntry<QKnxValueHeatFlowRate>(),
+        registryEntry<QKnxValueHeatQuantity>(),
+        registryEntry<QKnxValueImpedance>(),
+        registryEntry<QKnxValueLength>(),
+        registryEntry<QKnxValueLightQuantity>(),
+        registryEntry<QKnxValueLuminance>(),
+        registryEntry<QKnxValueLuminousFlux>(),
+        registryEntry<QKnxValueLuminousIntensity>(),
+        registryEntry<QKnxValueMagneticFieldStrength>(),
+        registryEntry<QKnxValueMagneticFlux>(),
+        registryEntry<QKnxValueMagneticFluxDensity>(),
+        registryEntry<QKnxValueMagneticMoment>(),
+        registryEntry<QKnxValueMagneticPolarization>(),
+        registryEntry<QKnxValueMagnetization>(),
+        registryEntry<QKnxValueMagnetomotiveForce>(),
+        registryEntry<QKnxValueMass>(),
+        registryEntry<QKnxValueMassFlux>(),
+        registryEntry<QKnxValueMomentum>(),
+        registryEntry<QKnxValuePhaseAngleRad>(),
+        registryEntry<QKnxValuePhaseAngleDeg>(),
+        registryEntry<QKnxValuePower>(),
+        registryEntry<QKnxValuePowerFactor>(),
+        registryEntry<QKnxValuePressure>(),
+        registryEntry<QKnxValueReactance>(),
+        registryEntry<QKnxValueResistance>(),
+        registryEntry<QKnxValueResistivity>(),
+        registryEntry<QKnxValueSelfInductance>(),
+        registryEntry<QKnxValueSolidAngle>(),
+        registryEntry<QKnxValueSoundIntensity>(),
+        registryEntry<QKnxValueSpeed>(),
+        registryEntry<QKnxValueStress>(),
+        registryEntry<QKnxValueSurfaceTension>(),
+        registryEntry<QKnxValueCommonTemperature>(),
+        registryEntry<QKnxValueAbsoluteTemperature>(),
+        registryEntry<QKnxValueTemperatureDifference>(),
+        registryEntry<QKnxValueThermalCapacity>(),
+        registryEntry<QKnxValueThermalConductivity>(),
+        registryEntry<QKnxValueThermoelectricPower>(),
+        registryEntry<QKnxValueTime>(),
+        registryEntry<QKnxValueTorque>(),
+        registryEntry<QKnxValueVolume>(),
+        registryEntry<QKnxValueVolumeFlux>(),
+        registryEntry<QKnxValueWeight>(),
+        registryEntry<QKnxValueWork>(),
+
+        // DPT-15
+        registryEntry<QKnxEntranceAccess>(),
+
+        // DPT-16
+        registryEntry<QKnxCharStringASCII>(),
+        registryEntry<QKnxCharString88591>(),
+
+        // DPT-17
+        registryEntry<QKnxSceneNumber>(),
+
+        // DPT-18
+        registryEntry<QKnxSceneControl>(),
+
+        // DPT-19
+        registryEntry<QKnxDateTime>(),
+
+        // DPT-20
+        registryEntry<QKnx1Byte>(),
+        registryEntry<QKnxScloMode>(),
+        registryEntry<QKnxBuildingMode>(),
+        registryEntry<QKnxOccupyMode>(),
+        registryEntry<QKnxPriority>(),
+        registryEntry<QKnxLightApplicationMode>(),
+        registryEntry<QKnxApplicationArea>(),
+        registryEntry<QKnxAlarmClassType>(),
+        registryEntry<QKnxPsuMode>(),
+        registryEntry<QKnxErrorClassSystem>(),
+        registryEntry<QKnxErrorClassHvac>(),
+        registryEntry<QKnxTimeDelay>(),
+        registryEntry<QKnxBeaufortWindForceScale>(),
+        registryEntry<QKnxSensorSelect>(),
+        registryEntry<QKnxActuatorConnectType>(),
+        registryEntry<QKnxCloudCover>(),
+
+        // DPT-21
+        registryEntry<QKnx8BitSet>(),
+        registryEntry<QKnxGeneralStatus>(),
+        registryEntry<QKnxDeviceControl>(),
+
+        // DPT-23
+        registryEntry<QKnx2BitSet>(),
+        registryEntry<QKnxOnOffAction>(),
+        registryEntry<QKnxAlarmReaction>(),
+        registryEntry<QKnxUpDownAction>(),
+
+        // DPT-24
+        registryEntry<QKnxVarString>(),
+        registryEntry<QKnxVarString88591>(),
+
+        // DPT-26
+        registryEntry<QKnxSceneInfo>(),
+
+        // DPT-27
+        registryEntry<QKnx32BitSet>(),
+        registryEntry<QKnxCombinedInfoOnOff>(),
+
+        // DPT-28
+        registryEntry<QKnxUtf8String>(),
+        registryEntry<QKnxUtf8>(),
+
+        // DPT-29
+        registryEntry<QKnxElectricalEnergy>(),
+        registryEntry<QKnxActiveEnergyV64>(),
+        registryEntry<QKnxApparentEnergyV64>(),
+        registryEntry<QKnxReactiveEnergyV64>(),
+
+        // DPT-225
+        registryEntry<QKnxScalingSpeed>(),
+        registryEntry<QKnxScalingStepTime>(),
+
+        // DPT-232
+        registryEntry<QKnxColourRGB>(),
+
+        // DPT-251
+        registryEntry<QKnxColourRGBW>()
+    };
+
+    static constexpr int RegistrySize = int(sizeof(Registry) / sizeof(Registry[0]));
+
+    static constexpr bool isSorted(const QKnxDatapointTypeRegistryEntry *entries, int count)
+    {
+        return count < 2 || (isSorted(entries, count / 2)
+            && entries[count / 2 - 1].type < entries[count / 2].type
+            && isSorted(entries + count / 2, count - count / 2));
+    }
+    static_assert(isSorted(Registry, RegistrySize), "The datapoint type registry must be sorted "
+        "by main and sub type, without duplicates.");
+
+    // Returns the first entry not less than main type and sub type.
+    static const QKnxDatapointTypeRegistryEntry *registryLowerBound(int mainType, int subType)
+    {
+        const quint32 type = quint32(mainType) * 100000 + quint32(subType);
+        return std::lower_bound(Registry, Registry + RegistrySize, type,
+            [](const QKnxDatapointTypeRegistryEntry &entry, quint32 type) {
+                return entry.type < type;
+        });
+    }
+
+    static const QKnxDatapointTypeRegistryEntry *findRegistryEntry(int mainType, int subType)
+    {
+        if (mainType < 0 || mainType > 0xffff || subType < 0 || subType > 0xffff)
+            return nullptr;
+        const auto entry = registryLowerBound(mainType, subType);
+        if (entry == Registry + RegistrySize)
+            return nullptr;
+        return entry->type == quint32(mainType) * 100000 + quint32(subType) ? entry : nullptr;
+    }
+
+    static bool registryContainsMainType(int mainType)
+    {
+        if (mainType < 0 || mainType > 0xffff)
+            return false;
+        const auto entry = registryLowerBound(mainType, 0);
+        return entry != Registry + RegistrySize && int(entry->type / 100000) == mainType;
+    }
+
+    static bool splitType(QKnxDatapointType::Type type, int *mainType, int *subType)
+    {
+        const auto number = quint32(type);
+        *mainType = int(number / 100000);
+        *subType = int(number % 100000);
+        return type != QKnxDatapointType::Type::Unknown;
+    }
+}
+
 /*!
     \class QKnxDatapointTypeFactory
 
@@ -95,6 +598,10 @@ QT_BEGIN_NAMESPACE
 
     Registers a datapoint type with the main type \a mainType, sub type
     \a subType, and size \a size.
+
+    The datapoint types provided by Qt KNX are built into the factory and do
+    not need to be registered. A registered type takes precedence over a
+    built-in type with the same main type and sub type.
 */
 
 /*!
@@ -106,18 +613,11 @@ QT_BEGIN_NAMESPACE
 */
 QKnxDatapointType *QKnxDatapointTypeFactory::createType(int mainType, int subType) const
 {
-    const auto main = factoryTable().constFind(mainType);
-    if (main == factoryTable().constEnd())
-        return nullptr;
-
-    auto sub = (*main).constFind(subType);
-    if (sub == (*main).constEnd())
-        sub = (*main).constFind(0); // try base, e.g. 1.00[0]
-
-    if (sub == (*main).constEnd())
-        return nullptr;
-
-    return (*sub)();
+    if (auto create = factoryFunction(mainType, subType))
+        return create();
+    if (auto create = factoryFunction(mainType, 0)) // try base, e.g. 1.00[0]
+        return create();
+    return nullptr;
 }
 
 /*!
@@ -151,7 +651,163 @@ QKnxDatapointType *QKnxDatapointTypeFactory::createType(QKnxDatapointType::Type
 */
 int QKnxDatapointTypeFactory::typeSize(int mainType)
 {
-    return sizeTable().value(mainType);
+    const auto size = sizeTable().constFind(mainType);
+    if (size != sizeTable().constEnd())
+        return *size;
+
+    if (!QKnxPrivate::registryContainsMainType(mainType))
+        return 0;
+    return QKnxPrivate::registryLowerBound(mainType, 0)->size;
+}
+
+/*!
+    \since 5.15
+
+    Decodes the value of the datapoint type with the main type \a mainType
+    and sub type \a subType from the first \a size bytes of \a data, without
+    creating a datapoint type object.
+
+    The value has the type returned by the \c value() function of the
+    matching datapoint type class, and the coefficient of the sub type is
+    applied. Composite main types, such as 2, 3, 18, and 26, return their
+    encoded byte as \c quint8.
+
+    Returns an invalid QVariant if the main type has no fixed size codec or
+    \a size is too small.
+
+    \sa QKnxDptCodec
+*/
+QVariant QKnxDatapointTypeFactory::decode(int mainType, int subType, const quint8 *data,
+    int size)
+{
+    const auto entry = QKnxPrivate::dispatchEntry(mainType);
+    if (!entry || !data || size < entry->typeSize)
+        return {};
+    return entry->decode(data, size, QKnxPrivate::dispatchCoefficient(mainType, subType));
+}
+
+/*!
+    \since 5.15
+    \overload
+
+    Decodes the value of the datapoint type \a type from the first \a size
+    bytes of \a data.
+*/
+QVariant QKnxDatapointTypeFactory::decode(QKnxDatapointType::Type type, const quint8 *data,
+    int size)
+{
+    int mainType = 0, subType = 0;
+    if (QKnxPrivate::splitType(type, &mainType, &subType))
+        return decode(mainType, subType, data, size);
+    return {};
+}
+
+/*!
+    \since 5.15
+
+    Encodes \a value as the datapoint type with the main type \a mainType and
+    sub type \a subType into \a data, which must hold at least
+    \l typeSize() bytes.
+
+    Returns \c false and does not write to \a data if the main type has no
+    fixed size codec or the value cannot be represented. The range defined by
+    the datapoint type's minimum and maximum is not checked.
+*/
+bool QKnxDatapointTypeFactory::encode(int mainType, int subType, const QVariant &value,
+    quint8 *data)
+{
+    const auto entry = QKnxPrivate::dispatchEntry(mainType);
+    if (!entry || !data || !value.isValid())
+        return false;
+    return entry->encode(value, QKnxPrivate::dispatchCoefficient(mainType, subType), data);
+}
+
+/*!
+    \since 5.15
+    \overload
+
+    Encodes \a value as the datapoint type \a type into \a data.
+*/
+bool QKnxDatapointTypeFactory::encode(QKnxDatapointType::Type type, const QVariant &value,
+    quint8 *data)
+{
+    int mainType = 0, subType = 0;
+    if (QKnxPrivate::splitType(type, &mainType, &subType))
+        return encode(mainType, subType, value, data);
+    return false;
+}
+
+/*!
+    \since 5.15
+
+    Returns \c true if the value of the datapoint type with the main type
+    \a mainType and sub type \a subType changed significantly from the first
+    \a size bytes of \a previous to the first \a size bytes of \a current;
+    otherwise returns \c false. No datapoint type object is created.
+
+    For the numeric main types 5, 6, 7, 8, 9, 12, 13, 14, and 29, the values
+    are decoded and the coefficient of the sub type is applied. A change is
+    significant if the difference exceeds both \a absoluteDeadband, given in
+    the unit of the sub type, and \a relativeDeadband, given as a fraction of
+    the absolute previous value. With both deadbands set to \c 0, any change
+    is significant. Two NaN values of the main types 9 and 14 are considered
+    equal.
+
+    All other main types, such as bitsets, enumerations, and strings, are
+    compared byte by byte, as are payloads that are shorter than
+    \l typeSize().
+
+    Passing the last published value as \a previous, rather than the last
+    received one, gives hysteresis: a slowly drifting value is reported once
+    it has left the band around the published value.
+
+    \code
+        if (QKnxDatapointTypeFactory::isSignificantChange(9, 1, published, received, 2, 0.5)) {
+            publish(received);
+            std::copy(received, received + 2, published);
+        }
+    \endcode
+*/
+bool QKnxDatapointTypeFactory::isSignificantChange(int mainType, int subType,
+    const quint8 *previous, const quint8 *current, int size, double absoluteDeadband,
+    double relativeDeadband)
+{
+    if (!previous || !current || size <= 0)
+        return previous != current && size > 0;
+
+    const auto entry = QKnxPrivate::dispatchEntry(mainType);
+    if (!entry || !entry->number || size < entry->typeSize)
+        return std::memcmp(previous, current, size_t(size)) != 0;
+
+    const double coefficient = QKnxPrivate::dispatchCoefficient(mainType, subType);
+    const double last = entry->number(previous, size) * coefficient;
+    const double next = entry->number(current, size) * coefficient;
+    if (last == next)
+        return false;
+    if (qIsNaN(last) || qIsNaN(next))
+        return !(qIsNaN(last) && qIsNaN(next));
+    if (qIsInf(last) || qIsInf(next))
+        return true;
+
+    return qAbs(next - last) > qMax(absoluteDeadband, relativeDeadband * qAbs(last));
+}
+
+/*!
+    \since 5.15
+    \overload
+
+    Returns \c true if the value of the datapoint type \a type changed
+    significantly from \a previous to \a current.
+*/
+bool QKnxDatapointTypeFactory::isSignificantChange(QKnxDatapointType::Type type,
+    const quint8 *previous, const quint8 *current, int size, double absoluteDeadband,
+    double relativeDeadband)
+{
+    int mainType = 0, subType = 0;
+    if (!QKnxPrivate::splitType(type, &mainType, &subType))
+        mainType = subType = 0;
+    return isSignificantChange(mainType, subType, previous, current, size, absoluteDeadband,
+        relativeDeadband);
 }
 
 /*!
@@ -159,7 +815,19 @@ int QKnxDatapointTypeFactory::typeSize(int mainType)
 */
 QList<int> QKnxDatapointTypeFactory::mainTypes() const
 {
-    return factoryTable().keys();
+    QList<int> mainTypes;
+    for (const auto &entry : QKnxPrivate::Registry) {
+        const int mainType = int(entry.type / 100000);
+        if (mainTypes.isEmpty() || mainTypes.last() != mainType)
+            mainTypes.append(mainType);
+    }
+
+    const auto &table = factoryTable();
+    for (auto it = table.constBegin(); it != table.constEnd(); ++it) {
+        if (!QKnxPrivate::registryContainsMainType(it.key()))
+            mainTypes.append(it.key());
+    }
+    return mainTypes;
 }
 
 /*!
@@ -168,7 +836,7 @@ QList<int> QKnxDatapointTypeFactory::mainTypes() const
 */
 bool QKnxDatapointTypeFactory::containsMainType(int mainType) const
 {
-    return factoryTable().contains(mainType);
+    return QKnxPrivate::registryContainsMainType(mainType) || factoryTable().contains(mainType);
 }
 
 /*!
@@ -176,10 +844,23 @@ bool QKnxDatapointTypeFactory::containsMainType(int mainType) const
 */
 QList<int> QKnxDatapointTypeFactory::subTypes(int mainType) const
 {
+    QList<int> subTypes;
+    if (QKnxPrivate::registryContainsMainType(mainType)) {
+        const auto end = QKnxPrivate::Registry + QKnxPrivate::RegistrySize;
+        for (auto it = QKnxPrivate::registryLowerBound(mainType, 0);
+            it != end && int(it->type / 100000) == mainType; ++it) {
+            subTypes.append(int(it->type % 100000));
+        }
+    }
+
     const auto main = factoryTable().constFind(mainType);
-    if (main != factoryTable().constEnd())
-        return (*main).keys();
-    return {};
+    if (main != factoryTable().constEnd()) {
+        for (auto it = (*main).constBegin(); it != (*main).constEnd(); ++it) {
+            if (!QKnxPrivate::findRegistryEntry(mainType, it.key()))
+                subTypes.append(it.key());
+        }
+    }
+    return subTypes;
 }
 
 /*!
@@ -188,303 +869,30 @@ QList<int> QKnxDatapointTypeFactory::subTypes(int mainType) const
 */
 bool QKnxDatapointTypeFactory::containsSubType(int mainType, int subType) const
 {
-    const auto main = factoryTable().constFind(mainType);
-    if (main != factoryTable().constEnd())
-        return (*main).constFind(subType) != (*main).constEnd();
-    return false;
+    return factoryFunction(mainType, subType) != nullptr;
 }
 
 /*!
     \internal
+
+    Returns the factory function for the exact \a mainType and \a subType.
+    Types registered through registerType() take precedence over the
+    built-in ones.
 */
-QKnxDatapointTypeFactory::QKnxDatapointTypeFactory()
+QKnxDatapointTypeFactory::FactoryFunction QKnxDatapointTypeFactory::factoryFunction(int mainType,
+    int subType)
 {
-    // DPT-1
-    registerType<QKnx1Bit>();
-    registerType<QKnxSwitch>();
-    registerType<QKnxBool>();
-    registerType<QKnxEnable>();
-    registerType<QKnxRamp>();
-    registerType<QKnxAlarm>();
-    registerType<QKnxBinaryValue>();
-    registerType<QKnxStep>();
-    registerType<QKnxUpDown>();
-    registerType<QKnxOpenClose>();
-    registerType<QKnxStart>();
-    registerType<QKnxState>();
-    registerType<QKnxInvert>();
-    registerType<QKnxDimSendStyle>();
-    registerType<QKnxInputSource>();
-    registerType<QKnxReset>();
-    registerType<QKnxAck>();
-    registerType<QKnxTrigger>();
-    registerType<QKnxOccupancy>();
-    registerType<QKnxWindowDoor>();
-    registerType<QKnxLogicalFunction>();
-    registerType<QKnxSceneAB>();
-    registerType<QKnxShutterBlindsMode>();
-    registerType<QKnxHeatCool>();
-
-    // DPT-2
-    registerType<QKnx1BitControlled>();
-    registerType<QKnxSwitchControl>();
-    registerType<QKnxBoolControl>();
-    registerType<QKnxEnableControl>();
-    registerType<QKnxRampControl>();
-    registerType<QKnxAlarmControl>();
-    registerType<QKnxBinaryValueControl>();
-    registerType<QKnxStepControl>();
-    registerType<QKnxDirection1Control>();
-    registerType<QKnxDirection2Control>();
-    registerType<QKnxStartControl>();
-    registerType<QKnxStateControl>();
-    registerType<QKnxInvertControl>();
-
-    // DPT-3
-    registerType<QKnx3BitControlled>();
-    registerType<QKnxControlDimming>();
-    registerType<QKnxControlBlinds>();
-
-    // DPT-4
-    registerType<QKnxChar>();
-    registerType<QKnxCharASCII>();
-    registerType<QKnxChar88591>();
-
-    // DPT-5
-    registerType<QKnx8BitUnsignedValue>();
-    registerType<QKnxScaling>();
-    registerType<QKnxAngle>();
-    registerType<QKnxPercentU8>();
-    registerType<QKnxDecimalFactor>();
-    registerType<QKnxValue1Ucount>();
-    registerType<QKnxTariff>();
-
-    // DPT-6
-    registerType<QKnx8BitSignedValue>();
-    registerType<QKnxPercentV8>();
-    registerType<QKnxValue1Count>();
-    registerType<QKnxStatusMode3>();
-
-    // DPT-7
-    registerType<QKnx2ByteUnsignedValue>();
-    registerType<QKnxValue2Ucount>();
-    registerType<QKnxPropDataType>();
-    registerType<QKnxTimePeriodMsec>();
-    registerType<QKnxTimePeriod10Msec>();
-    registerType<QKnxTimePeriod100Msec>();
-    registerType<QKnxTimePeriodSec>();
-    registerType<QKnxTimePeriodMin>();
-    registerType<QKnxTimePeriodHrs>();
-    registerType<QKnxLengthMilliMeter>();
-    registerType<QKnxUEICurrentMilliA>();
-    registerType<QKnxBrightness>();
-
-    // DPT-8
-    registerType<QKnx2ByteSignedValue>();
-    registerType<QKnxValue2Count>();
-    registerType<QKnxPercentV16>();
-    registerType<QKnxDeltaTimeMsec>();
-    registerType<QKnxDeltaTime10Msec>();
-    registerType<QKnxDeltaTime100Msec>();
-    registerType<QKnxDeltaTimeSec>();
-    registerType<QKnxDeltaTimeMin>();
-    registerType<QKnxDeltaTimeHrs>();
-    registerType<QKnxRotationAngle>();
-
-    // DPT-9
-    registerType<QKnx2ByteFloat>();
-    registerType<QKnxTemperatureCelsius>();
-    registerType<QKnxTemperatureKelvin>();
-    registerType<QKnxTemperatureChange>();
-    registerType<QKnxValueLux>();
-    registerType<QKnxWindSpeed>();
-    registerType<QKnxPressure>();
-    registerType<QKnxHumidity>();
-    registerType<QKnxAirQuality>();
-    registerType<QKnxAirFlow>();
-    registerType<QKnxTimeSecond>();
-    registerType<QKnxTimeMilliSecond>();
-    registerType<QKnxVoltage>();
-    registerType<QKnxCurrent>();
-    registerType<QKnxPowerDensity>();
-    registerType<QKnxKelvinPerPercent>();
-    registerType<QKnxPower>();
-    registerType<QKnxVolumeFlow>();
-    registerType<QKnxAmountRain>();
-    registerType<QKnxTemperatureFahrenheit>();
-    registerType<QKnxWindSpeedKmPerHour>();
-    registerType<QKnxValueAbsoluteHumidity>();
-    registerType<QKnxConcentration>();
-
-    // DPT-10
-    registerType<QKnxTimeOfDay>();
-    registerType<QKnxDate>();
-
-    // DPT-12
-    registerType<QKnx4ByteUnsignedValue>();
-    registerType<QKnxValue4UCount>();
-
-    // DPT-13
-    registerType<QKnx4ByteSignedValue>();
-    registerType<QKnxValue4Count>();
-    registerType<QKnxFlowRateCubicMeterPerHour>();
-    registerType<QKnxActiveEnergy>();
-    registerType<QKnxApparentEnergy>();
-    registerType<QKnxReactiveEnergy>();
-    registerType<QKnxActiveEnergykWh>();
-    registerType<QKnxApparentEnergykVAh>();
-    registerType<QKnxReactiveEnergykVARh>();
-    registerType<QKnxLongDeltaTimeSec>();
-
-    // DPT-14
-    registerType<QKnx4ByteFloat>();
-    registerType<QKnxValueAcceleration>(); // TODO: this replaces the QKnx4ByteFloat (subtype == 0)
-    registerType<QKnxValueAccelerationAngular>();
-    registerType<QKnxValueActivationEnergy>();
-    registerType<QKnxValueActivity>();
-    registerType<QKnxValueMol>();
-    registerType<QKnxValueAmplitude>();
-    registerType<QKnxValueAngleRad>();
-    registerType<QKnxValueAngleDeg>();
-    registerType<QKnxValueAngularMomentum>();
-    registerType<QKnxValueAngularVelocity>();
-    registerType<QKnxValueArea>();
-    registerType<QKnxValueCapacitance>();
-    registerType<QKnxValueChargeDensitySurface>();
-    registerType<QKnxValueChargeDensityVolume>();
-    registerType<QKnxValueCompressibility>();
-    registerType<QKnxValueConductance>();
-    registerType<QKnxValueElectricalConductivity>();
-    registerType<QKnxValueDensity>();
-    registerType<QKnxValueElectricCharge>();
-    registerType<QKnxValueElectricCurrent>();
-    registerType<QKnxValueElectricCurrentDensity>();
-    registerType<QKnxValueElectricDipoleMoment>();
-    registerType<QKnxValueElectricDisplacement>();
-    registerType<QKnxValueElectricFieldStrength>();
-    registerType<QKnxValueElectricFlux>();
-    registerType<QKnxValueElectricFluxDensity>();
-    registerType<QKnxValueElectricPolarization>();
-    registerType<QKnxValueElectricPotential>();
-    registerType<QKnxValueElectricPotentialDifference>();
-    registerType<QKnxValueElectromagneticMoment>();
-    registerType<QKnxValueElectromotiveForce>();
-    registerType<QKnxValueEnergy>();
-    registerType<QKnxValueForce>();
-    registerType<QKnxValueFrequency>();
-    registerType<QKnxValueAngularFrequency>();
-    registerType<QKnxValueHeatCapacity>();
-    registerType<QKnxValueHeatFlowRate>();
-    registerType<QKnxValueHeatQuantity>();
-    registerType<QKnxValueImpedance>();
-    registerType<QKnxValueLength>();
-    registerType<QKnxValueLightQuantity>();
-    registerType<QKnxValueLuminance>();
-    registerType<QKnxValueLuminousFlux>();
-    registerType<QKnxValueLuminousIntensity>();
-    registerType<QKnxValueMagneticFieldStrength>();
-    registerType<QKnxValueMagneticFlux>();
-    registerType<QKnxValueMagneticFluxDensity>();
-    registerType<QKnxValueMagneticMoment>();
-    registerType<QKnxValueMagneticPolarization>();
-    registerType<QKnxValueMagnetization>();
-    registerType<QKnxValueMagnetomotiveForce>();
-    registerType<QKnxValueMass>();
-    registerType<QKnxValueMassFlux>();
-    registerType<QKnxValueMomentum>();
-    registerType<QKnxValuePhaseAngleRad>();
-    registerType<QKnxValuePhaseAngleDeg>();
-    registerType<QKnxValuePower>();
-    registerType<QKnxValuePowerFactor>();
-    registerType<QKnxValuePressure>();
-    registerType<QKnxValueReactance>();
-    registerType<QKnxValueResistance>();
-    registerType<QKnxValueResistivity>();
-    registerType<QKnxValueSelfInductance>();
-    registerType<QKnxValueSolidAngle>();
-    registerType<QKnxValueSoundIntensity>();
-    registerType<QKnxValueSpeed>();
-    registerType<QKnxValueStress>();
-    registerType<QKnxValueSurfaceTension>();
-    registerType<QKnxValueCommonTemperature>();
-    registerType<QKnxValueAbsoluteTemperature>();
-    registerType<QKnxValueTemperatureDifference>();
-    registerType<QKnxValueThermalCapacity>();
-    registerType<QKnxValueThermalConductivity>();
-    registerType<QKnxValueThermoelectricPower>();
-    registerType<QKnxValueTime>();
-    registerType<QKnxValueTorque>();
-    registerType<QKnxValueVolume>();
-    registerType<QKnxValueVolumeFlux>();
-    registerType<QKnxValueWeight>();
-    registerType<QKnxValueWork>();
-
-    // DPT-15
-    registerType<QKnxEntranceAccess>();
-
-    // DPT-16
-    registerType<QKnxCharString>();
-    registerType<QKnxCharStringASCII>(); // TODO: this replaces the QKnxCharString (subtype == 0)
-    registerType<QKnxCharString88591>();
-
-    // DPT-17
-    registerType<QKnxSceneNumber>();
-
-    // DPT-18
-    registerType<QKnxSceneControl>();
-
-    // DPT-19
-    registerType<QKnxDateTime>();
-
-    // DPT-20
-    registerType<QKnx1Byte>();
-    registerType<QKnxScloMode>();
-    registerType<QKnxBuildingMode>();
-    registerType<QKnxOccupyMode>();
-    registerType<QKnxPriority>();
-    registerType<QKnxLightApplicationMode>();
-    registerType<QKnxApplicationArea>();
-    registerType<QKnxAlarmClassType>();
-    registerType<QKnxPsuMode>();
-    registerType<QKnxErrorClassSystem>();
-    registerType<QKnxErrorClassHvac>();
-    registerType<QKnxTimeDelay>();
-    registerType<QKnxBeaufortWindForceScale>();
-    registerType<QKnxSensorSelect>();
-    registerType<QKnxActuatorConnectType>();
-    registerType<QKnxCloudCover>();
-
-    // DPT-21
-    registerType<QKnx8BitSet>();
-    registerType<QKnxGeneralStatus>();
-    registerType<QKnxDeviceControl>();
-
-    // DPT-23
-    registerType<QKnx2BitSet>();
-    registerType<QKnxOnOffAction>();
-    registerType<QKnxAlarmReaction>();
-    registerType<QKnxUpDownAction>();
-
-    // DPT-24
-    registerType<QKnxVarString>();
-    registerType<QKnxVarString88591>();
-
-    // DPT-26
-    registerType<QKnxSceneInfo>();
-
-    // DPT-27
-    registerType<QKnx32BitSet>();
-    registerType<QKnxCombinedInfoOnOff>();
-
-    // DPT-29
-    registerType<QKnxElectricalEnergy>();
-    registerType<QKnxActiveEnergyV64>();
-    registerType<QKnxApparentEnergyV64>();
-    registerType<QKnxReactiveEnergyV64>();
-
-    // DPT-28
-    registerType<QKnxUtf8String>();
-    registerType<QKnxUtf8>();
+    const auto &table = factoryTable();
+    const auto main = table.constFind(mainType);
+    if (main != table.constEnd()) {
+        const auto sub = (*main).constFind(subType);
+        if (sub != (*main).constEnd())
+            return *sub;
+    }
+
+    if (auto entry = QKnxPrivate::findRegistryEntry(mainType, subType))
+        return entry->create;
+    return nullptr;
 }
 
 /*!
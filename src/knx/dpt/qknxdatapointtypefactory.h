@@ -61,6 +61,19 @@ public:
 
     static int typeSize(int mainType);
 
+    static QVariant decode(int mainType, int subType, const quint8 *data, int size);
+    static QVariant decode(QKnxDatapointType::Type type, const quint8 *data, int size);
+
+    static bool encode(int mainType, int subType, const QVariant &value, quint8 *data);
+    static bool encode(QKnxDatapointType::Type type, const QVariant &value, quint8 *data);
+
+    static bool isSignificantChange(int mainType, int subType, const quint8 *previous,
+        const quint8 *current, int size, double absoluteDeadband = 0.,
+        double relativeDeadband = 0.);
+    static bool isSignificantChange(QKnxDatapointType::Type type, const quint8 *previous,
+        const quint8 *current, int size, double absoluteDeadband = 0.,
+        double relativeDeadband = 0.);
+
     QList<int> mainTypes() const;
     bool containsMainType(int mainType) const;
 
@@ -68,7 +81,7 @@ public:
     bool containsSubType(int mainType, int subType) const;
 
 private:
-    QKnxDatapointTypeFactory();
+    QKnxDatapointTypeFactory() = default;
 
     template <typename Class> static QKnxDatapointType *create()
     {
@@ -81,10 +94,7 @@ private:
         return _instance;
     }
 
-    template <typename Class> void registerType()
-    {
-        registerType<Class>(Class::MainType, Class::SubType, Class::TypeSize);
-    }
+    static FactoryFunction factoryFunction(int mainType, int subType);
 
     static QHash<int, int> &sizeTable();
     static void setTypeSize(int mainType, int size);
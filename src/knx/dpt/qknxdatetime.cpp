@@ -29,6 +29,7 @@
 
 #include "qknxdatetime.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -66,9 +67,13 @@ QKnxTimeOfDay::QKnxTimeOfDay()
 QKnxTimeOfDay::QKnxTimeOfDay(const QKnxTime &time)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Time of day"));
-    setRangeText(tr("No day, 00:00:00"), tr("Sunday, 23:59:59"));
-    setRange(QVariant::fromValue(QKnxTime(00, 00, 00)), QVariant::fromValue(QKnxTime(23, 59, 59)));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Time of day"));
+        setRangeText(tr("No day, 00:00:00"), tr("Sunday, 23:59:59"));
+        setRange(QVariant::fromValue(QKnxTime(00, 00, 00)),
+            QVariant::fromValue(QKnxTime(23, 59, 59)));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setValue(time);
 }
 
@@ -87,8 +92,7 @@ QKnxTimeOfDay::QKnxTimeOfDay(quint8 h, quint8 m, quint8 s, QKnxTime::DayOfWeek d
 */
 QKnxTime QKnxTimeOfDay::value() const
 {
-    return { quint8(byte(0) & 0x1f), byte(1), byte(2),
-        static_cast<QKnxTime::DayOfWeek> ((byte(0) & 0xe0) >> 5u) };
+    return QKnxDptCodec<QKnxTimeOfDay>::decode(constData(), size());
 }
 
 /*!
@@ -99,12 +103,10 @@ QKnxTime QKnxTimeOfDay::value() const
 */
 bool QKnxTimeOfDay::setValue(const QKnxTime &time)
 {
-    if (!time.isValid())
+    quint8 data[TypeSize];
+    if (!QKnxDptCodec<QKnxTimeOfDay>::encode(time, data))
         return false;
-
-    return setByte(2, quint8(time.second()))
-        && setByte(1, quint8(time.minute()))
-        && setByte(0, quint8(time.hour()) | quint8(time.dayOfWeek()) << 5u);
+    return setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 /*!
@@ -225,9 +227,12 @@ bool QKnxTimeOfDay::isValid() const
 QKnxDate::QKnxDate()
     : QKnxDate(QDate(2000, 0, 0))
 {
-    setDescription(tr("Date"));
-    setRange(QDate(1990, 1, 1), QDate(2089, 12, 31));
-    setRangeText(tr("Monday, 1990-01-01"), tr("Saturday, 2089-12-31"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Date"));
+        setRange(QDate(1990, 1, 1), QDate(2089, 12, 31));
+        setRangeText(tr("Monday, 1990-01-01"), tr("Saturday, 2089-12-31"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 }
 
 /*!
@@ -254,7 +259,7 @@ QKnxDate::QKnxDate(quint16 year, quint8 month, quint8 day)
 */
 QDate QKnxDate::value() const
 {
-    return { year(), month(), day() };
+    return QKnxDptCodec<QKnxDate>::decode(constData(), size());
 }
 
 /*!
@@ -265,12 +270,13 @@ QDate QKnxDate::value() const
 */
 bool QKnxDate::setValue(const QDate &date)
 {
-    if (date.isValid() && (date >= minimum().toDate()) && (date <= maximum().toDate())) {
-        return setByte(0, date.day())
-            && setByte(1, date.month())
-            && setByte(2, quint8(date.year() % 100));
-    }
-    return false;
+    if (!date.isValid() || (date < minimum().toDate()) || (date > maximum().toDate()))
+        return false;
+
+    quint8 data[TypeSize];
+    if (!QKnxDptCodec<QKnxDate>::encode(date, data))
+        return false;
+    return setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 /*!
@@ -420,11 +426,14 @@ QKnxDateTime::QKnxDateTime(const QDate &date, const QKnxTime24 &time, Attributes
         ClockQuality quality)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Date Time"));
-    setMinimumText(tr("Monday, 1900-01-01; Any day, 00:00:00"));
-    setMaximumText(tr("Wednesday, 2155-12-31; Sunday, 24:00:00"));
-    setMinimum(QVariant({ QDate(1900, 01, 01), QVariant::fromValue(QKnxTime24(00, 00, 00)) }));
-    setMaximum(QVariant({ QDate(2155, 12, 31), QVariant::fromValue(QKnxTime24(24, 00, 00)) }));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Date Time"));
+        setMinimumText(tr("Monday, 1900-01-01; Any day, 00:00:00"));
+        setMaximumText(tr("Wednesday, 2155-12-31; Sunday, 24:00:00"));
+        setMinimum(QVariant({ QDate(1900, 01, 01), QVariant::fromValue(QKnxTime24(00, 00, 00)) }));
+        setMaximum(QVariant({ QDate(2155, 12, 31), QVariant::fromValue(QKnxTime24(24, 00, 00)) }));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(date, time, attributes, quality);
 }
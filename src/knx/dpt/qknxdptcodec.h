@@ -0,0 +1,768 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXDPTCODEC_H
+#define QKNXDPTCODEC_H
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qnumeric.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+
+#include <QtKnx/qknxtime.h>
+#include <QtKnx/qtknxglobal.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+template <int MainType> struct QKnxDptMainTypeCodec;
+
+namespace QKnxPrivate
+{
+    // Prefer a codec's own bulk decode of back to back values, fall back to one by one.
+    template <typename Codec>
+    auto decodeRun(const quint8 *data, int count, typename Codec::ValueType *values, int)
+        -> decltype(Codec::decode(data, count, values), void())
+    {
+        Codec::decode(data, count, values);
+    }
+
+    template <typename Codec>
+    void decodeRun(const quint8 *data, int count, typename Codec::ValueType *values, long)
+    {
+        for (int i = 0; i < count; ++i)
+            values[i] = Codec::decode(data + i * Codec::TypeSize, Codec::TypeSize);
+    }
+    // Codecs of variable length main types report the encoded size of each value.
+    template <typename Codec>
+    constexpr auto isFixedSize(int) -> decltype(&Codec::encodedSize, bool())
+    {
+        return false;
+    }
+
+    template <typename Codec>
+    constexpr bool isFixedSize(long)
+    {
+        return true;
+    }
+
+    template <typename T, int Size> struct QKnxDptIntegerCodec
+    {
+        using ValueType = T;
+        static const constexpr int TypeSize = Size;
+
+        static ValueType decode(const quint8 *data, int size)
+        {
+            if (!data || size < TypeSize)
+                return ValueType();
+            return ValueType(qFromBigEndian<typename QIntegerForSize<Size>::Unsigned>(data));
+        }
+
+        static bool encode(ValueType value, quint8 *data)
+        {
+            qToBigEndian(typename QIntegerForSize<Size>::Unsigned(value), data);
+            return true;
+        }
+
+        static void decode(const quint8 *data, int count, ValueType *values)
+        {
+            using Unsigned = typename QIntegerForSize<Size>::Unsigned;
+            for (int i = 0; i < count; ++i, data += TypeSize)
+                values[i] = ValueType(qFromBigEndian<Unsigned>(data));
+        }
+    };
+
+    // Reads one strictly encoded UTF-8 sequence, rejecting overlong forms, surrogates and
+    // code points beyond U+10FFFF.
+    inline bool readUtf8(const char *&it, const char *end, uint *ucs4)
+    {
+        const uchar lead = uchar(*it);
+        const int length = (lead < 0x80) ? 1 : (lead < 0xc2) ? 0 : (lead < 0xe0) ? 2
+            : (lead < 0xf0) ? 3 : (lead < 0xf5) ? 4 : 0;
+        if (length == 0 || end - it < length)
+            return false;
+
+        uint value = (length == 1) ? lead : (lead & (0x7f >> length));
+        for (int i = 1; i < length; ++i) {
+            const uchar next = uchar(it[i]);
+            if ((next & 0xc0) != 0x80)
+                return false;
+            value = (value << 6) | (next & 0x3f);
+        }
+
+        if ((length == 3 && (value < 0x800 || (value >= 0xd800 && value <= 0xdfff)))
+            || (length == 4 && (value < 0x10000 || value > 0x10ffff))) {
+            return false;
+        }
+        it += length;
+        *ucs4 = value;
+        return true;
+    }
+
+    inline bool isValidUtf8(const char *string, int size)
+    {
+        uint ucs4 = 0;
+        for (const char *it = string, *end = string + size; it != end;) {
+            if (!readUtf8(it, end, &ucs4))
+                return false;
+        }
+        return true;
+    }
+
+    template <quint8 Mask> struct QKnxDptMaskedByteCodec
+    {
+        using ValueType = quint8;
+        static const constexpr int TypeSize = 1;
+
+        static ValueType decode(const quint8 *data, int size)
+        {
+            if (!data || size < TypeSize)
+                return 0;
+            return data[0] & Mask;
+        }
+
+        static bool encode(ValueType value, quint8 *data)
+        {
+            if (value & ~Mask)
+                return false;
+            data[0] = value;
+            return true;
+        }
+    };
+}
+
+template <typename T> struct QKnxDptCodec : public QKnxDptMainTypeCodec<T::MainType>
+{
+    using Codec = QKnxDptMainTypeCodec<T::MainType>;
+    static const constexpr bool IsFixedSize = QKnxPrivate::isFixedSize<Codec>(0);
+
+    static int decodeColumn(const quint8 *data, const int *offsets, int count,
+        typename Codec::ValueType *values)
+    {
+        if (!data || !values || count <= 0)
+            return 0;
+
+        if (!offsets) {
+            QKnxPrivate::decodeRun<Codec>(data, count, values, 0);
+            return count;
+        }
+
+        int decoded = 0;
+        for (int i = 0; i < count;) {
+            // payloads of exactly TypeSize bytes stored back to back form a run
+            int end = i;
+            while (end < count && offsets[end + 1] - offsets[end] == Codec::TypeSize)
+                ++end;
+            if (end > i) {
+                QKnxPrivate::decodeRun<Codec>(data + offsets[i], end - i, values + i, 0);
+                decoded += end - i;
+                i = end;
+                continue;
+            }
+
+            const int size = offsets[i + 1] - offsets[i];
+            values[i] = Codec::decode(data + offsets[i], size);
+            decoded += (size >= Codec::TypeSize);
+            ++i;
+        }
+        return decoded;
+    }
+
+    static int encodeColumn(const typename Codec::ValueType *values, int count, quint8 *data)
+    {
+        static_assert(IsFixedSize, "QKnxDptCodec::encodeColumn supports only fixed size "
+            "datapoint types.");
+        if (!values || !data || count <= 0)
+            return 0;
+
+        for (int i = 0; i < count; ++i, data += Codec::TypeSize) {
+            if (!Codec::encode(values[i], data))
+                return i;
+        }
+        return count;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<1>
+{
+    using ValueType = bool;
+    static const constexpr int TypeSize = 1;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        return data && size >= TypeSize && (data[0] & 0x01);
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        data[0] = (value ? 0x01 : 0x00);
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<2>
+{
+    struct ValueType
+    {
+        bool value;
+        bool control;
+    };
+    static const constexpr int TypeSize = 1;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return { false, false };
+        return { (data[0] & 0x01) != 0, (data[0] & 0x02) != 0 };
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        data[0] = (value.value ? 0x01 : 0x00) | (value.control ? 0x02 : 0x00);
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<3>
+{
+    struct ValueType
+    {
+        bool control;
+        quint8 numberOfIntervals;
+    };
+    static const constexpr int TypeSize = 1;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return { false, 0 };
+        const quint8 stepCode = data[0] & 0x07;
+        return { (data[0] & 0x08) != 0, quint8(stepCode ? 1u << (stepCode - 1) : 0u) };
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        const quint8 n = value.numberOfIntervals;
+        if (n > 32 || (n & (n - 1)) != 0)
+            return false; // break or a power of two up to 32
+
+        quint8 stepCode = 0;
+        for (quint8 i = n; i != 0; i >>= 1)
+            ++stepCode;
+        data[0] = (value.control ? 0x08 : 0x00) | stepCode;
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<4> : QKnxPrivate::QKnxDptIntegerCodec<unsigned char, 1>
+{};
+
+template <> struct QKnxDptMainTypeCodec<5> : QKnxPrivate::QKnxDptIntegerCodec<quint8, 1>
+{};
+
+template <> struct QKnxDptMainTypeCodec<6> : QKnxPrivate::QKnxDptIntegerCodec<qint8, 1>
+{};
+
+template <> struct QKnxDptMainTypeCodec<7> : QKnxPrivate::QKnxDptIntegerCodec<quint16, 2>
+{};
+
+template <> struct QKnxDptMainTypeCodec<8> : QKnxPrivate::QKnxDptIntegerCodec<qint16, 2>
+{};
+
+template <> struct QKnxDptMainTypeCodec<9>
+{
+    using ValueType = float;
+    static const constexpr int TypeSize = 2;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return 0.f;
+        return decode(qFromBigEndian<quint16>(data));
+    }
+
+    static void decode(const quint8 *data, int count, ValueType *values)
+    {
+        for (int i = 0; i < count; ++i)
+            values[i] = decode(quint16(data[2 * i] << 8 | data[2 * i + 1]));
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        if (qIsNaN(value))
+            return false;
+
+        // Smallest exponent that brings the mantissa into 11 bits, read from
+        // the binary exponent of |value| * 100 / 2048. Computed in double, the
+        // bit layout below is IEEE 754 binary64 whatever qreal is.
+        quint32 E = 0;
+        if (qAbs(double(value)) > 20.48) {
+            const double scaled = qAbs(double(value)) * 100 / 2048.;
+            static_assert(sizeof(double) == sizeof(quint64), "double must be 64 bits");
+            quint64 bits = 0;
+            memcpy(&bits, &scaled, sizeof(bits));
+            const int exponent = int((bits >> 52) & 0x7ff) - 1023;
+            if (exponent > 14)
+                return false;
+            E = quint32(exponent + 1);
+        }
+
+        qint32 M = qRound(value * scale(E) * 100);
+        if (M > 2047) { // rounded up to the next power of two
+            if (++E > 15)
+                return false;
+            M = qRound(value * scale(E) * 100);
+        }
+        if (M > 2047 || M < -2048)
+            return false;
+
+        qToBigEndian(quint16((quint32(M) & 0x87ff) | (E << 11)), data);
+        return true;
+    }
+
+private:
+    static ValueType decode(quint16 raw)
+    {
+        const qint32 M = qint32(raw & 0x07ff) - qint32(raw & 0x8000 ? 0x0800 : 0);
+        return float(0.01 * qreal(M * (1 << ((raw >> 11) & 0x0f))));
+    }
+
+    static float scale(quint32 E)
+    {
+        static const float scales[16] = { 1.f, 1.f / (1 << 1), 1.f / (1 << 2), 1.f / (1 << 3),
+            1.f / (1 << 4), 1.f / (1 << 5), 1.f / (1 << 6), 1.f / (1 << 7), 1.f / (1 << 8),
+            1.f / (1 << 9), 1.f / (1 << 10), 1.f / (1 << 11), 1.f / (1 << 12), 1.f / (1 << 13),
+            1.f / (1 << 14), 1.f / (1 << 15) };
+        return scales[E];
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<10>
+{
+    using ValueType = QKnxTime;
+    static const constexpr int TypeSize = 3;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return {};
+        return { quint8(data[0] & 0x1f), data[1], data[2],
+            static_cast<QKnxTime::DayOfWeek>((data[0] & 0xe0) >> 5u) };
+    }
+
+    static bool encode(const ValueType &value, quint8 *data)
+    {
+        if (!value.isValid())
+            return false;
+        data[0] = quint8(value.hour()) | quint8(quint8(value.dayOfWeek()) << 5u);
+        data[1] = quint8(value.minute());
+        data[2] = quint8(value.second());
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<11>
+{
+    using ValueType = QDate;
+    static const constexpr int TypeSize = 3;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return {};
+        return { data[2] + (data[2] < 90 ? 2000 : 1900), data[1], data[0] };
+    }
+
+    static bool encode(const ValueType &value, quint8 *data)
+    {
+        if (!value.isValid() || value.year() < 1990 || value.year() > 2089)
+            return false;
+        data[0] = quint8(value.day());
+        data[1] = quint8(value.month());
+        data[2] = quint8(value.year() % 100);
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<12> : QKnxPrivate::QKnxDptIntegerCodec<quint32, 4>
+{};
+
+template <> struct QKnxDptMainTypeCodec<13> : QKnxPrivate::QKnxDptIntegerCodec<qint32, 4>
+{};
+
+template <> struct QKnxDptMainTypeCodec<14>
+{
+    using ValueType = float;
+    static const constexpr int TypeSize = 4;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return 0.f;
+        return decode(qFromBigEndian<quint32>(data));
+    }
+
+    static void decode(const quint8 *data, int count, ValueType *values)
+    {
+        for (int i = 0; i < count; ++i, data += TypeSize)
+            values[i] = decode(quint32(data[0]) << 24 | quint32(data[1]) << 16
+                | quint32(data[2]) << 8 | data[3]);
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        quint32 temp = 0;
+        memcpy(&temp, &value, sizeof(value));
+        qToBigEndian(temp, data);
+        return true;
+    }
+
+private:
+    static ValueType decode(quint32 raw)
+    {
+        float value = 0;
+        memcpy(&value, &raw, sizeof(value));
+        return value;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<16>
+{
+    using ValueType = QLatin1String;
+    static const constexpr int TypeSize = 14;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return {};
+        int length = 0;
+        while (length < TypeSize && data[length] != 0)
+            ++length;
+        return ValueType(reinterpret_cast<const char *>(data), length);
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        if (value.size() > TypeSize)
+            return false;
+        if (value.size() > 0)
+            memmove(data, value.data(), size_t(value.size()));
+        memset(data + value.size(), 0, size_t(TypeSize - value.size()));
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<17> : QKnxPrivate::QKnxDptMaskedByteCodec<0x3f>
+{};
+
+template <> struct QKnxDptMainTypeCodec<18>
+{
+    struct ValueType
+    {
+        quint8 sceneNumber;
+        bool learn;
+    };
+    static const constexpr int TypeSize = 1;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return { 0, false };
+        return { quint8(data[0] & 0x3f), (data[0] & 0x80) != 0 };
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        if (value.sceneNumber > 0x3f)
+            return false;
+        data[0] = value.sceneNumber | (value.learn ? 0x80 : 0x00);
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<20> : QKnxPrivate::QKnxDptIntegerCodec<quint8, 1>
+{};
+
+template <> struct QKnxDptMainTypeCodec<21> : QKnxPrivate::QKnxDptIntegerCodec<quint8, 1>
+{};
+
+template <> struct QKnxDptMainTypeCodec<23> : QKnxPrivate::QKnxDptMaskedByteCodec<0x03>
+{};
+
+template <> struct QKnxDptMainTypeCodec<24>
+{
+    using ValueType = QLatin1String;
+    static const constexpr int TypeSize = 1;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return {};
+        const auto end = static_cast<const quint8 *>(memchr(data, 0, size_t(size)));
+        return ValueType(reinterpret_cast<const char *>(data), end ? int(end - data) : size);
+    }
+
+    static int encodedSize(ValueType value)
+    {
+        return value.size() + 1;
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        if (value.size() >= 0xffff)
+            return false;
+        if (value.size() > 0)
+            memmove(data, value.data(), size_t(value.size()));
+        data[value.size()] = 0;
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<26>
+{
+    struct ValueType
+    {
+        quint8 sceneNumber;
+        bool inactive;
+    };
+    static const constexpr int TypeSize = 1;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return { 0, false };
+        return { quint8(data[0] & 0x3f), (data[0] & 0x40) != 0 };
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        if (value.sceneNumber > 0x3f)
+            return false;
+        data[0] = value.sceneNumber | (value.inactive ? 0x40 : 0x00);
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<27> : QKnxPrivate::QKnxDptIntegerCodec<quint32, 4>
+{};
+
+template <> struct QKnxDptMainTypeCodec<29> : QKnxPrivate::QKnxDptIntegerCodec<qint64, 8>
+{};
+
+template <> struct QKnxDptMainTypeCodec<225>
+{
+    struct ValueType
+    {
+        quint16 timePeriod;
+        quint8 scaling;
+    };
+    static const constexpr int TypeSize = 3;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return { 0, 0 };
+        return { qFromBigEndian<quint16>(data), data[2] };
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        qToBigEndian(value.timePeriod, data);
+        data[2] = value.scaling;
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<232>
+{
+    struct ValueType
+    {
+        quint8 red;
+        quint8 green;
+        quint8 blue;
+    };
+    static const constexpr int TypeSize = 3;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return { 0, 0, 0 };
+        return { data[0], data[1], data[2] };
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        data[0] = value.red;
+        data[1] = value.green;
+        data[2] = value.blue;
+        return true;
+    }
+};
+
+template <> struct QKnxDptMainTypeCodec<251>
+{
+    struct ValueType
+    {
+        quint8 red;
+        quint8 green;
+        quint8 blue;
+        quint8 white;
+        quint8 validChannels; // bit 3 red, bit 2 green, bit 1 blue, bit 0 white
+    };
+    static const constexpr int TypeSize = 6;
+
+    static ValueType decode(const quint8 *data, int size)
+    {
+        if (!data || size < TypeSize)
+            return { 0, 0, 0, 0, 0 };
+        return { data[0], data[1], data[2], data[3], quint8(data[5] & 0x0f) };
+    }
+
+    static bool encode(ValueType value, quint8 *data)
+    {
+        if (value.validChannels & 0xf0)
+            return false;
+        data[0] = value.red;
+        data[1] = value.green;
+        data[2] = value.blue;
+        data[3] = value.white;
+        data[4] = 0; // reserved
+        data[5] = value.validChannels;
+        return true;
+    }
+};
+
+template <typename T> class QKnxDptStringBuilder
+{
+    static_assert(T::MainType == 24 || T::MainType == 28, "QKnxDptStringBuilder supports only "
+        "the variable length string main types 24 and 28.");
+
+public:
+    QKnxDptStringBuilder(quint8 *data, int capacity)
+        : m_data(data)
+        , m_capacity(capacity)
+        , m_valid(data && capacity > 0)
+    {
+        if (m_valid)
+            m_data[0] = 0;
+    }
+
+    QKnxDptStringBuilder &append(QLatin1String string)
+    {
+        const int start = m_size;
+        for (int i = 0; m_valid && i < string.size(); ++i)
+            appendUcs4(uchar(string.data()[i]));
+        return finishAppend(start);
+    }
+
+    QKnxDptStringBuilder &append(QStringView string)
+    {
+        const int start = m_size;
+        for (auto it = string.cbegin(), end = string.cend(); m_valid && it != end; ++it) {
+            if (!it->isSurrogate()) {
+                appendUcs4(it->unicode());
+            } else if (it->isHighSurrogate() && it + 1 != end && (it + 1)->isLowSurrogate()) {
+                appendUcs4(QChar::surrogateToUcs4(*it, *(it + 1)));
+                ++it;
+            } else {
+                m_valid = false;
+            }
+        }
+        return finishAppend(start);
+    }
+
+    QKnxDptStringBuilder &appendUtf8(const char *string, int size = -1)
+    {
+        const int start = m_size;
+        if (string) {
+            uint ucs4 = 0;
+            const char *end = string + (size < 0 ? int(strlen(string)) : size);
+            for (const char *it = string; m_valid && it != end;) {
+                if (QKnxPrivate::readUtf8(it, end, &ucs4))
+                    appendUcs4(ucs4);
+                else
+                    m_valid = false;
+            }
+        }
+        return finishAppend(start);
+    }
+
+    void clear()
+    {
+        m_size = 0;
+        m_valid = m_data && m_capacity > 0;
+        if (m_valid)
+            m_data[0] = 0;
+    }
+
+    bool isValid() const { return m_valid; }
+    int size() const { return m_valid ? m_size + 1 : 0; }
+    const quint8 *constData() const { return m_data; }
+
+private:
+    void appendUcs4(uint ucs4)
+    {
+        const int length = (T::MainType == 24) ? (ucs4 > 0xff ? 0 : 1)
+            : (ucs4 < 0x80) ? 1 : (ucs4 < 0x800) ? 2 : (ucs4 < 0x10000) ? 3 : 4;
+        if (length == 0 || m_capacity - m_size - 1 < length || m_size + length >= 0xffff) {
+            m_valid = false;
+            return;
+        }
+
+        quint8 *out = m_data + m_size;
+        if (length == 1) {
+            out[0] = quint8(ucs4);
+        } else {
+            for (int i = length - 1; i > 0; --i, ucs4 >>= 6)
+                out[i] = quint8(0x80 | (ucs4 & 0x3f));
+            out[0] = quint8((0xf00 >> length) | ucs4);
+        }
+        m_size += length;
+    }
+
+    QKnxDptStringBuilder &finishAppend(int start)
+    {
+        if (!m_valid)
+            m_size = start; // never leave a partially appended string behind
+        if (m_data && m_capacity > 0)
+            m_data[m_size] = 0;
+        return *this;
+    }
+
+    quint8 *m_data = nullptr;
+    int m_capacity = 0;
+    int m_size = 0;
+    bool m_valid = false;
+};
+
+QT_END_NAMESPACE
+
+#endif
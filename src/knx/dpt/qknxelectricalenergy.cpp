@@ -29,8 +29,7 @@
 
 #include "qknxelectricalenergy.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -81,10 +80,13 @@ QKnxElectricalEnergy::QKnxElectricalEnergy(qint64 value)
 QKnxElectricalEnergy::QKnxElectricalEnergy(int subType, qint64 value)
     : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("8-byte signed value"));
-    setRange(QVariant::fromValue(LONG_MIN), QVariant::fromValue(LONG_MAX));
-    setRangeText(tr("Minimum Value, -9 223 372 036 854 775 808"),
-        tr("Maximum Value, 9 223 372 036 854 775 807"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("8-byte signed value"));
+        setRange(QVariant::fromValue(LONG_MIN), QVariant::fromValue(LONG_MAX));
+        setRangeText(tr("Minimum Value, -9 223 372 036 854 775 808"),
+            tr("Maximum Value, 9 223 372 036 854 775 807"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setValue(value);
 }
@@ -94,7 +96,7 @@ QKnxElectricalEnergy::QKnxElectricalEnergy(int subType, qint64 value)
 */
 qint64 QKnxElectricalEnergy::value() const
 {
-    return qint64(QKnxUtils::QUint64::fromBytes(bytes()));
+    return QKnxDptCodec<QKnxElectricalEnergy>::decode(constData(), size());
 }
 
 /*!
@@ -105,9 +107,12 @@ qint64 QKnxElectricalEnergy::value() const
 */
 bool QKnxElectricalEnergy::setValue(qint64 value)
 {
-    if (value <= maximum().toLongLong() && value >= minimum().toLongLong())
-        return setBytes(QKnxUtils::QUint64::bytes(quint64(value)), 0, 8);
-    return false;
+    if (value > maximum().toLongLong() || value < minimum().toLongLong())
+        return false;
+
+    quint8 data[TypeSize];
+    QKnxDptCodec<QKnxElectricalEnergy>::encode(value, data);
+    return setBytes(QKnxByteArray(data, TypeSize), 0, TypeSize);
 }
 
 /*!
@@ -123,8 +128,11 @@ bool QKnxElectricalEnergy::isValid() const
 CLASS::CLASS() \
     : QKnxElectricalEnergy(SubType, 0) \
 { \
-    setUnit(tr(UNIT)); \
-    setDescription(tr(DESCRIPTION)); \
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() { \
+        setUnit(tr(UNIT)); \
+        setDescription(tr(DESCRIPTION)); \
+    }); \
+    QKnxDatapointTypePrivate::setMetaData(this, metaData); \
 } \
 CLASS::CLASS(qint64 value) \
     : CLASS() \
@@ -0,0 +1,192 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxscalingspeed.h"
+#include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxScalingSpeed
+    \inherits QKnxFixedSizeDatapointType
+    \inmodule QtKnx
+    \ingroup qtknx-datapoint-types
+    \since 5.15
+
+    \brief The QKnxScalingSpeed class is a datapoint type for the time it
+    takes to fade to a brightness value.
+
+    This datapoint type stores a time period in milliseconds and a scaling
+    value as percentage from \c 0 to \c 100. The percentage is encoded with a
+    resolution of 100/255 like \l QKnxScaling. Used in the lighting application
+    area, only.
+
+    This is a fixed size datapoint type with the length of 3 bytes.
+
+    \sa QKnxScalingStepTime, QKnxDatapointType, {Qt KNX Datapoint Type Classes}
+*/
+
+// -- QKnxScalingSpeed
+
+/*!
+    Creates a fixed size datapoint type with the time period and scaling value
+    set to \c 0.
+*/
+QKnxScalingSpeed::QKnxScalingSpeed()
+    : QKnxScalingSpeed(0, 0.)
+{}
+
+/*!
+    Creates a fixed size datapoint type with the time period set to
+    \a timePeriod milliseconds and the scaling value set to \a scaling
+    percent.
+*/
+QKnxScalingSpeed::QKnxScalingSpeed(quint16 timePeriod, double scaling)
+    : QKnxScalingSpeed(SubType, timePeriod, scaling)
+{}
+
+/*!
+    Creates a fixed size datapoint type with the sub type \a subType, the time
+    period set to \a timePeriod milliseconds, and the scaling value set to
+    \a scaling percent.
+*/
+QKnxScalingSpeed::QKnxScalingSpeed(int subType, quint16 timePeriod, double scaling)
+    : QKnxFixedSizeDatapointType(MainType, subType, TypeSize)
+{
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setUnit(tr("percent"));
+        setCoefficient(100 / 255.);
+        setDescription(tr("Scaling speed"));
+        setRange(QVariant::fromValue(0.), QVariant::fromValue(100.));
+        setRangeText(tr("Minimum Value, 0"), tr("Maximum Value, 100"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
+
+    setValue(timePeriod, scaling);
+}
+
+/*!
+    Returns the time period in milliseconds stored in the datapoint type.
+*/
+quint16 QKnxScalingSpeed::timePeriod() const
+{
+    return QKnxDptCodec<QKnxScalingSpeed>::decode(constData(), size()).timePeriod;
+}
+
+/*!
+    Sets the time period stored in the datapoint type to \a timePeriod
+    milliseconds.
+
+    Returns \c true if the value was set; otherwise returns \c false.
+*/
+bool QKnxScalingSpeed::setTimePeriod(quint16 timePeriod)
+{
+    return setValue(timePeriod, scaling());
+}
+
+/*!
+    Returns the scaling value in percent stored in the datapoint type.
+*/
+double QKnxScalingSpeed::scaling() const
+{
+    return QKnxDptCodec<QKnxScalingSpeed>::decode(constData(), size()).scaling * coefficient();
+}
+
+/*!
+    Sets the scaling value stored in the datapoint type to \a scaling percent.
+
+    If the value is outside the allowed range, returns \c false and does not set
+    the value.
+*/
+bool QKnxScalingSpeed::setScaling(double scaling)
+{
+    if (scaling <= maximum().toDouble() && scaling >= minimum().toDouble())
+        return setByte(2, quint8(qRound(scaling / coefficient())));
+    return false;
+}
+
+/*!
+    Sets the time period stored in the datapoint type to \a timePeriod
+    milliseconds and the scaling value to \a scaling percent.
+
+    If the scaling value is outside the allowed range, returns \c false and
+    does not set the value.
+*/
+bool QKnxScalingSpeed::setValue(quint16 timePeriod, double scaling)
+{
+    if (scaling > maximum().toDouble() || scaling < minimum().toDouble())
+        return false;
+    return QKnxDptCodec<QKnxScalingSpeed>::encode({ timePeriod,
+        quint8(qRound(scaling / coefficient())) }, data());
+}
+
+
+// -- QKnxScalingStepTime
+
+/*!
+    \class QKnxScalingStepTime
+    \inherits QKnxScalingSpeed
+    \inmodule QtKnx
+    \ingroup qtknx-datapoint-types
+    \since 5.15
+
+    \brief The QKnxScalingStepTime class is a datapoint type for the time
+    between two steps of a brightness fade.
+
+    This datapoint type stores a time period in milliseconds and the size of
+    each step as percentage from \c 0 to \c 100.
+
+    This is a fixed size datapoint type with the length of 3 bytes.
+
+    \sa QKnxScalingSpeed, QKnxDatapointType, {Qt KNX Datapoint Type Classes}
+*/
+
+/*!
+    Creates a fixed size datapoint type with the time period and step size set
+    to \c 0.
+*/
+QKnxScalingStepTime::QKnxScalingStepTime()
+    : QKnxScalingStepTime(0, 0.)
+{}
+
+/*!
+    Creates a fixed size datapoint type with the time period set to
+    \a timePeriod milliseconds and the step size set to \a scaling percent.
+*/
+QKnxScalingStepTime::QKnxScalingStepTime(quint16 timePeriod, double scaling)
+    : QKnxScalingSpeed(SubType, timePeriod, scaling)
+{
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Scaling step time"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,71 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXSCALINGSPEED_H
+#define QKNXSCALINGSPEED_H
+
+#include <QtKnx/qknxdatapointtype.h>
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxScalingSpeed : public QKnxFixedSizeDatapointType
+{
+public:
+    QKnxScalingSpeed();
+    QKnxScalingSpeed(quint16 timePeriod, double scaling);
+
+    static const constexpr int TypeSize = 0x03;
+    static const constexpr int MainType = 0xe1;
+    static const constexpr int SubType = 0x01;
+
+    quint16 timePeriod() const;
+    bool setTimePeriod(quint16 timePeriod);
+
+    double scaling() const;
+    bool setScaling(double scaling);
+
+    bool setValue(quint16 timePeriod, double scaling);
+
+protected:
+    QKnxScalingSpeed(int subType, quint16 timePeriod, double scaling);
+};
+
+class Q_KNX_EXPORT QKnxScalingStepTime : public QKnxScalingSpeed
+{
+public:
+    QKnxScalingStepTime();
+    QKnxScalingStepTime(quint16 timePeriod, double scaling);
+
+    static const constexpr int SubType = 0x02;
+};
+
+QT_END_NAMESPACE
+
+#endif
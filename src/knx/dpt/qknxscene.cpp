@@ -29,6 +29,7 @@
 
 #include "qknxscene.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -118,9 +119,12 @@ QKnxSceneNumber::QKnxSceneNumber()
 QKnxSceneNumber::QKnxSceneNumber(quint8 number)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Scene Number"));
-    setRange(QVariant(0x00), QVariant(0x3f));
-    setRangeText(tr("Minimum, 0"), tr("Maximum, 63"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Scene Number"));
+        setRange(QVariant(0x00), QVariant(0x3f));
+        setRangeText(tr("Minimum, 0"), tr("Maximum, 63"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setSceneNumber(number);
 }
@@ -130,7 +134,7 @@ QKnxSceneNumber::QKnxSceneNumber(quint8 number)
 */
 quint8 QKnxSceneNumber::sceneNumber() const
 {
-    return byte(0) & 0x3f;
+    return QKnxDptCodec<QKnxSceneNumber>::decode(constData(), size());
 }
 
 /*!
@@ -176,9 +180,12 @@ QKnxSceneControl::QKnxSceneControl()
 QKnxSceneControl::QKnxSceneControl(quint8 sceneNumber, QKnxSceneControl::Control control)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Scene Control"));
-    setRange(QVariant(0x00), QVariant(0xbf));
-    setRangeText(tr("Minimum scene number, 0"), tr("Maximum scene number, 63"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Scene Control"));
+        setRange(QVariant(0x00), QVariant(0xbf));
+        setRangeText(tr("Minimum scene number, 0"), tr("Maximum scene number, 63"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setSceneNumber(sceneNumber);
     setControl(control);
@@ -189,7 +196,7 @@ QKnxSceneControl::QKnxSceneControl(quint8 sceneNumber, QKnxSceneControl::Control
 */
 quint8 QKnxSceneControl::sceneNumber() const
 {
-    return qint8(byte(0) & 0x3f);
+    return QKnxDptCodec<QKnxSceneControl>::decode(constData(), size()).sceneNumber;
 }
 
 /*!
@@ -210,7 +217,7 @@ bool QKnxSceneControl::setSceneNumber(quint8 number)
 */
 QKnxSceneControl::Control QKnxSceneControl::control() const
 {
-    return Control(QKnxDatapointType::testBit(byte(0), 7));
+    return Control(QKnxDptCodec<QKnxSceneControl>::decode(constData(), size()).learn);
 }
 
 /*!
@@ -268,9 +275,12 @@ QKnxSceneInfo::QKnxSceneInfo()
 QKnxSceneInfo::QKnxSceneInfo(quint8 sceneNumber, QKnxSceneInfo::Info info)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Scene Information"));
-    setRange(QVariant(0x00), QVariant(0x7f));
-    setRangeText(tr("Minimum scene number, 0"), tr("Maximum scene number, 63"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Scene Information"));
+        setRange(QVariant(0x00), QVariant(0x7f));
+        setRangeText(tr("Minimum scene number, 0"), tr("Maximum scene number, 63"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setSceneNumber(sceneNumber);
     setInfo(info);
@@ -281,7 +291,7 @@ QKnxSceneInfo::QKnxSceneInfo(quint8 sceneNumber, QKnxSceneInfo::Info info)
 */
 quint8 QKnxSceneInfo::sceneNumber() const
 {
-    return qint8(byte(0) & 0x3f);
+    return QKnxDptCodec<QKnxSceneInfo>::decode(constData(), size()).sceneNumber;
 }
 
 /*!
@@ -302,7 +312,7 @@ bool QKnxSceneInfo::setSceneNumber(quint8 number)
 */
 QKnxSceneInfo::Info QKnxSceneInfo::info() const
 {
-    return Info(QKnxDatapointType::testBit(byte(0), 6));
+    return Info(QKnxDptCodec<QKnxSceneInfo>::decode(constData(), size()).inactive);
 }
 
 /*!
@@ -99,9 +99,12 @@ QKnxStatusMode3::QKnxStatusMode3()
 QKnxStatusMode3::QKnxStatusMode3(Mode mode, StatusFlags statusFlags)
     : QKnxFixedSizeDatapointType(MainType, SubType, TypeSize)
 {
-    setDescription(tr("Status with Mode"));
-    setRange(QVariant(0x01), QVariant(0xfc));
-    setRangeText(tr("All set and Mode 0"), tr("All cleared and Mode 2"));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Status with Mode"));
+        setRange(QVariant(0x01), QVariant(0xfc));
+        setRangeText(tr("All set and Mode 0"), tr("All cleared and Mode 2"));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
 
     setMode(mode);
     setStatusFlags(statusFlags);
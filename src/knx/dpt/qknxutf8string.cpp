@@ -29,7 +29,7 @@
 
 #include "qknxutf8string.h"
 #include "qknxdatapointtype_p.h"
-#include "qtextcodec.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -53,6 +53,25 @@ QT_BEGIN_NAMESPACE
 
 // -- QKnxUtf8String
 
+// Returns the number of bytes needed to encode the string as UTF-8, or -1 if the string contains
+// an unpaired surrogate.
+static int encodedUtf8Size(const QString &string)
+{
+    int size = 0;
+    for (auto it = string.cbegin(), end = string.cend(); it != end; ++it) {
+        const ushort unicode = it->unicode();
+        if (!it->isSurrogate()) {
+            size += (unicode < 0x80) ? 1 : (unicode < 0x800) ? 2 : 3;
+        } else if (it->isHighSurrogate() && it + 1 != end && (it + 1)->isLowSurrogate()) {
+            size += 4;
+            ++it;
+        } else {
+            return -1;
+        }
+    }
+    return size;
+}
+
 /*!
     Creates a variable sized datapoint type.
 */
@@ -82,8 +101,11 @@ QKnxUtf8String::QKnxUtf8String(const char *string, int size)
 QKnxUtf8String::QKnxUtf8String(int subType, const char *string, int size)
     : QKnxVariableSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("Variable length character string (UTF-8)"));
-    setRange(QVariant(0x00), QVariant(0xff));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Variable length character string (UTF-8)"));
+        setRange(QVariant(0x00), QVariant(0xff));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setString(string, size);
 }
 
@@ -92,24 +114,23 @@ QKnxUtf8String::QKnxUtf8String(int subType, const char *string, int size)
 */
 QString QKnxUtf8String::string() const
 {
-    auto data = bytes(); // TODO: fix this
-    return QString::fromUtf8((const char*) data.constData(), data.size() - 1);
+    return QString::fromUtf8(reinterpret_cast<const char *>(constData()), size() - 1);
 }
 
 /*!
     Sets the string stored in the datapoint type to \a string.
 
-    If the value is outside the allowed range, returns \c false and does not set
-    the string.
+    If the value is outside the allowed range or contains an unpaired surrogate,
+    returns \c false and does not set the string.
 */
 bool QKnxUtf8String::setString(const QString &string)
 {
-    if (string.size() >= USHRT_MAX)
+    const int utf8Size = encodedUtf8Size(string);
+    if (utf8Size < 0 || utf8Size >= USHRT_MAX)
         return false;
 
-    auto utf8 = string.toUtf8();
-    return setBytes(QKnxByteArray(utf8.constData(), utf8.size()) + QKnxByteArray::fromHex("00"), 0,
-        utf8.size() + 1);
+    resize(utf8Size + 1);
+    return QKnxDptStringBuilder<QKnxUtf8String>(data(), utf8Size + 1).append(string).isValid();
 }
 
 /*!
@@ -123,26 +144,16 @@ bool QKnxUtf8String::setString(const QString &string)
 */
 bool QKnxUtf8String::setString(const char *string, int size)
 {
-    auto null = QKnxByteArray::fromHex("00");
-    if (!string)
-        return setBytes(null, 0, 1);
-
-    size = (size < 0 ? int(strlen(string)) : size);
-    if (size == 0)
-        return setBytes(null, 0, 1);
-
-    if (size >= USHRT_MAX)
-        return false;
-
-    QTextCodec *codec = QTextCodec::codecForName("UTF-8");
-    if (!codec)
+    size = (!string ? 0 : (size < 0 ? int(strlen(string)) : size));
+    if (size >= USHRT_MAX || !QKnxPrivate::isValidUtf8(string, size))
         return false;
 
-    QTextCodec::ConverterState state;
-    auto text = codec->toUnicode(string, size, &state);
-    if (state.invalidChars > 0)
-        return false;
-    return setString(text);
+    resize(size + 1);
+    auto bytes = data();
+    if (size > 0)
+        memmove(bytes, string, size_t(size));
+    bytes[size] = 0;
+    return true;
 }
 
 /*!
@@ -29,6 +29,7 @@
 
 #include "qknxvarstring.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdptcodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -83,17 +84,23 @@ QKnxVarString::QKnxVarString(const char *string, int size)
 QKnxVarString::QKnxVarString(int subType, const char *string, int size)
     : QKnxVariableSizeDatapointType(MainType, subType, TypeSize)
 {
-    setDescription(tr("Variable length character string (ISO 8859-1)"));
-    setRange(QVariant(0x00), QVariant(0xff));
+    static const auto metaData = QKnxDatapointTypePrivate::metaData(this, [this]() {
+        setDescription(tr("Variable length character string (ISO 8859-1)"));
+        setRange(QVariant(0x00), QVariant(0xff));
+    });
+    QKnxDatapointTypePrivate::setMetaData(this, metaData);
     setString(string, size);
 }
 
 /*!
     Returns the string stored in the datapoint type.
+
+    The returned string refers to the bytes of the datapoint type and stays
+    valid until the datapoint type is modified or destroyed.
 */
 QLatin1String QKnxVarString::string() const
 {
-    return QLatin1String((const char*) constData());
+    return QKnxDptCodec<QKnxVarString>::decode(constData(), size());
 }
 
 /*!
@@ -116,17 +123,13 @@ bool QKnxVarString::setString(QLatin1String string)
 */
 bool QKnxVarString::setString(const char *string, int size)
 {
-    auto null = QKnxByteArray::fromHex("00");
-    if (!string)
-        return setBytes(null, 0, 1);
-
-    size = (size < 0 ? int(strlen(string)) : size);
-    if (size == 0)
-        return setBytes(null, 0, 1);
-
+    size = (!string ? 0 : (size < 0 ? int(strlen(string)) : size));
     if (size >= USHRT_MAX)
         return false;
-    return setBytes(QKnxByteArray(string, size) + null, 0, size + 1);
+
+    // resizing keeps the capacity, so setting strings of similar length does not allocate
+    resize(size + 1);
+    return QKnxDptCodec<QKnxVarString>::encode(QLatin1String(string, size), data());
 }
 
 /*!
@@ -54,7 +54,9 @@ PUBLIC_HEADERS += $$PWD/qknxnetip.h \
     $$PWD/qknxnetiptimernotify.h \
     $$PWD/qknxnetipsecurewrapper.h \
     $$PWD/qknxnetiprouter.h \
-    $$PWD/qknxnetipsecureconfiguration.h
+    $$PWD/qknxnetiprouterstatistics.h \
+    $$PWD/qknxnetipsecureconfiguration.h \
+    $$PWD/qknxnetipsecuretransport.h
 
 PRIVATE_HEADERS += \
     $$PWD/qknxbuilderdata_p.h \
@@ -62,8 +64,14 @@ PRIVATE_HEADERS += \
     $$PWD/qknxnetipserverdescriptionagent_p.h \
     $$PWD/qknxnetipserverdiscoveryagent_p.h \
     $$PWD/qknxnetipserverinfo_p.h \
+    $$PWD/qknxnetiprouterstatistics_p.h \
+    $$PWD/qknxnetipsendqueue_p.h \
+    $$PWD/qknxnetipdatagramsocket_p.h \
+    $$PWD/qknxnetipsimulatednetwork_p.h \
     $$PWD/qknxnetiptestrouter_p.h \
-    $$PWD/qknxnetipsecureconfiguration_p.h
+    $$PWD/qknxnetipsecureconfiguration_p.h \
+    $$PWD/qknxnetipsecuretransport_p.h \
+    $$PWD/qknxnetipsecurehandshake_p.h
 
 SOURCES += $$PWD/qknxnetip.cpp \
     $$PWD/qknxnetipconfigdib.cpp \
@@ -121,4 +129,9 @@ SOURCES += $$PWD/qknxnetip.cpp \
     $$PWD/qknxnetipsecurewrapper.cpp \
     $$PWD/qknxnetiprouter.cpp \
     $$PWD/qknxnetiprouter_p.cpp \
-    $$PWD/qknxnetipsecureconfiguration.cpp
+    $$PWD/qknxnetiprouterstatistics.cpp \
+    $$PWD/qknxnetipdatagramsocket.cpp \
+    $$PWD/qknxnetipsimulatednetwork.cpp \
+    $$PWD/qknxnetipsecureconfiguration.cpp \
+    $$PWD/qknxnetipsecuretransport.cpp \
+    $$PWD/qknxnetipsecurehandshake.cpp
@@ -0,0 +1,120 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include "qknxnetipdatagramsocket_p.h"
+
+#include <QtNetwork/qudpsocket.h>
+
+QT_BEGIN_NAMESPACE
+
+QKnxNetIpUdpSocket::QKnxNetIpUdpSocket(QObject *parent)
+    : QKnxNetIpDatagramSocket(parent)
+    , m_socket(new QUdpSocket(this))
+{
+    connect(m_socket, &QUdpSocket::readyRead, this, &QKnxNetIpDatagramSocket::readyRead);
+    connect(m_socket, &QUdpSocket::stateChanged, this, &QKnxNetIpDatagramSocket::stateChanged);
+    connect(m_socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error),
+        this, &QKnxNetIpDatagramSocket::errorOccurred);
+}
+
+bool QKnxNetIpUdpSocket::bind(const QHostAddress &address, quint16 port,
+    QAbstractSocket::BindMode mode)
+{
+    return m_socket->bind(address, port, mode);
+}
+
+void QKnxNetIpUdpSocket::close()
+{
+    m_socket->close();
+}
+
+QAbstractSocket::SocketState QKnxNetIpUdpSocket::state() const
+{
+    return m_socket->state();
+}
+
+QHostAddress QKnxNetIpUdpSocket::localAddress() const
+{
+    return m_socket->localAddress();
+}
+
+quint16 QKnxNetIpUdpSocket::localPort() const
+{
+    return m_socket->localPort();
+}
+
+QString QKnxNetIpUdpSocket::errorString() const
+{
+    return m_socket->errorString();
+}
+
+void QKnxNetIpUdpSocket::setSocketOption(QAbstractSocket::SocketOption option,
+    const QVariant &value)
+{
+    m_socket->setSocketOption(option, value);
+}
+
+bool QKnxNetIpUdpSocket::joinMulticastGroup(const QHostAddress &group,
+    const QNetworkInterface &iface)
+{
+    return m_socket->joinMulticastGroup(group, iface);
+}
+
+bool QKnxNetIpUdpSocket::leaveMulticastGroup(const QHostAddress &group,
+    const QNetworkInterface &iface)
+{
+    return m_socket->leaveMulticastGroup(group, iface);
+}
+
+void QKnxNetIpUdpSocket::setMulticastInterface(const QNetworkInterface &iface)
+{
+    m_socket->setMulticastInterface(iface);
+}
+
+bool QKnxNetIpUdpSocket::hasPendingDatagrams() const
+{
+    return m_socket->hasPendingDatagrams();
+}
+
+QNetworkDatagram QKnxNetIpUdpSocket::receiveDatagram()
+{
+    return m_socket->receiveDatagram();
+}
+
+qint64 QKnxNetIpUdpSocket::writeDatagram(const QByteArray &datagram, const QHostAddress &host,
+    quint16 port)
+{
+    return m_socket->writeDatagram(datagram, host, port);
+}
+
+bool QKnxNetIpUdpSocket::waitForReadyRead(int msecs)
+{
+    return m_socket->waitForReadyRead(msecs);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,134 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#ifndef QKNXNETIPDATAGRAMSOCKET_P_H
+#define QKNXNETIPDATAGRAMSOCKET_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qobject.h>
+#include <QtCore/qvariant.h>
+
+#include <QtKnx/qtknxglobal.h>
+
+#include <QtNetwork/qabstractsocket.h>
+#include <QtNetwork/qhostaddress.h>
+#include <QtNetwork/qnetworkdatagram.h>
+#include <QtNetwork/qnetworkinterface.h>
+
+QT_BEGIN_NAMESPACE
+
+class QUdpSocket;
+
+// The subset of QUdpSocket used by the KNXnet/IP router and endpoint
+// connections. It lets them run on a real network or on an in-process
+// simulated one, see QKnxNetIpSimulatedNetwork.
+class Q_KNX_EXPORT QKnxNetIpDatagramSocket : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QKnxNetIpDatagramSocket(QObject *parent = nullptr)
+        : QObject(parent)
+    {}
+    ~QKnxNetIpDatagramSocket() override = default;
+
+    virtual bool bind(const QHostAddress &address, quint16 port,
+        QAbstractSocket::BindMode mode = QAbstractSocket::DefaultForPlatform) = 0;
+    virtual void close() = 0;
+
+    virtual QAbstractSocket::SocketState state() const = 0;
+    virtual QHostAddress localAddress() const = 0;
+    virtual quint16 localPort() const = 0;
+    virtual QString errorString() const = 0;
+
+    virtual void setSocketOption(QAbstractSocket::SocketOption option, const QVariant &value) = 0;
+
+    virtual bool joinMulticastGroup(const QHostAddress &group, const QNetworkInterface &iface) = 0;
+    virtual bool leaveMulticastGroup(const QHostAddress &group, const QNetworkInterface &iface) = 0;
+    virtual void setMulticastInterface(const QNetworkInterface &iface) = 0;
+
+    virtual bool hasPendingDatagrams() const = 0;
+    virtual QNetworkDatagram receiveDatagram() = 0;
+    virtual qint64 writeDatagram(const QByteArray &datagram, const QHostAddress &host,
+        quint16 port) = 0;
+
+    virtual bool waitForReadyRead(int msecs) = 0;
+
+Q_SIGNALS:
+    void readyRead();
+    void stateChanged(QAbstractSocket::SocketState state);
+    void errorOccurred(QAbstractSocket::SocketError error);
+};
+
+class Q_KNX_EXPORT QKnxNetIpUdpSocket final : public QKnxNetIpDatagramSocket
+{
+    Q_OBJECT
+
+public:
+    explicit QKnxNetIpUdpSocket(QObject *parent = nullptr);
+    ~QKnxNetIpUdpSocket() override = default;
+
+    bool bind(const QHostAddress &address, quint16 port,
+        QAbstractSocket::BindMode mode = QAbstractSocket::DefaultForPlatform) override;
+    void close() override;
+
+    QAbstractSocket::SocketState state() const override;
+    QHostAddress localAddress() const override;
+    quint16 localPort() const override;
+    QString errorString() const override;
+
+    void setSocketOption(QAbstractSocket::SocketOption option, const QVariant &value) override;
+
+    bool joinMulticastGroup(const QHostAddress &group, const QNetworkInterface &iface) override;
+    bool leaveMulticastGroup(const QHostAddress &group, const QNetworkInterface &iface) override;
+    void setMulticastInterface(const QNetworkInterface &iface) override;
+
+    bool hasPendingDatagrams() const override;
+    QNetworkDatagram receiveDatagram() override;
+    qint64 writeDatagram(const QByteArray &datagram, const QHostAddress &host,
+        quint16 port) override;
+
+    bool waitForReadyRead(int msecs) override;
+
+private:
+    QUdpSocket *m_socket { nullptr };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -27,7 +27,6 @@
 **
 ******************************************************************************/
 
-#include "qknxcryptographicengine.h"
 #include "qknxnetipconnectrequest.h"
 #include "qknxnetipconnectresponse.h"
 #include "qknxnetipconnectionstaterequest.h"
@@ -38,10 +37,10 @@
 #include "qknxnetipdisconnectresponse.h"
 #include "qknxnetipendpointconnection.h"
 #include "qknxnetipendpointconnection_p.h"
-#include "qknxnetipsessionauthenticate.h"
+#include "qknxnetipsimulatednetwork_p.h"
+#include "qknxnetipsecuretransport_p.h"
 #include "qknxnetipsecurewrapper.h"
 #include "qknxnetipsessionrequest.h"
-#include "qknxnetipsessionresponse.h"
 #include "qknxnetipsessionstatus.h"
 #include "qknxnetiptunnelingacknowledge.h"
 #include "qknxnetiptunnelingfeatureget.h"
@@ -309,26 +308,17 @@ QKnxNetIp::ServiceType
     case QKnxNetIp::ServiceType::SecureWrapper: {
         qDebug() << "Received secure wrapper frame:" << frame;
 
-        const QKnxNetIpSecureWrapperProxy proxy(frame);
-        if (!proxy.isValid())
-            break;
-
-        const auto seqNumber = proxy.sequenceNumber();
-        const auto serialNumber = proxy.serialNumber();
-        const auto messageTag = proxy.messageTag();
-
-        const auto decData = QKnxCryptographicEngine::decryptSecureWrapperPayload(m_sessionKey,
-            proxy.encapsulatedFrame(), seqNumber, serialNumber, messageTag);
-
-        const auto mac = QKnxCryptographicEngine::computeMessageAuthenticationCode(m_sessionKey,
-            frame.header(), proxy.secureSessionId(), decData, seqNumber, serialNumber, messageTag);
-        const auto decMac = QKnxCryptographicEngine::decryptMessageAuthenticationCode(m_sessionKey,
-            proxy.messageAuthenticationCode(), seqNumber, serialNumber, messageTag);
+        const auto decFrame = m_session.unwrap(frame);
+        if (!decFrame.isValid())
+            break; // invalid frame or MAC could not be verified, bail out
 
-        if (decMac != mac)
-            break; // MAC could not be verified, bail out
+        // only after a successful authentication the sequence number can be trusted
+        if (!m_replayWindow.accept(QKnxNetIpSecureWrapperProxy(frame).sequenceNumber())) {
+            qDebug() << "Discarded replayed secure wrapper frame.";
+            break;
+        }
 
-        return processReceivedFrame(QKnxNetIpFrame::fromBytes(decData));
+        return processReceivedFrame(decFrame);
     }   break;
 
     case QKnxNetIp::ServiceType::SessionRequest:
@@ -338,67 +328,9 @@ QKnxNetIp::ServiceType
     case QKnxNetIp::ServiceType::SessionResponse: {
         qDebug() << "Received session response frame:" << frame;
 
-        QKnxNetIpSessionResponseProxy proxy(frame);
-        if (!proxy.isValid())
-            break;
-
-        const auto authHash = QKnxCryptographicEngine::deviceAuthenticationCodeHash(m_secureConfig.
-            d->deviceAuthenticationCode);
-        const auto xorX_Y = QKnxCryptographicEngine::XOR(m_secureConfig.d->publicKey.bytes(), proxy
-            .publicKey());
-
-        auto mac = QKnxCryptographicEngine::computeMessageAuthenticationCode(authHash,
-            frame.header(), proxy.secureSessionId(), xorX_Y);
-        auto decMac = QKnxCryptographicEngine::decryptMessageAuthenticationCode(authHash,
-            proxy.messageAuthenticationCode());
-
-        if (decMac != mac)
-            break; // MAC could not be verified, bail out
-
-        m_secureTimer->stop();
-        m_secureTimer->disconnect();
-        m_sessionId = proxy.secureSessionId();
-        m_sessionKey = QKnxCryptographicEngine::sessionKey(m_secureConfig.d->privateKey,
-            QKnxSecureKey::fromBytes(QKnxSecureKey::Type::Public, proxy.publicKey()));
-
-        auto secureWrapper = QKnxNetIpSecureWrapperProxy::secureBuilder()
-            .setSecureSessionId(m_sessionId)
-            .setSequenceNumber(m_sequenceNumber)
-            .setSerialNumber(m_serialNumber)
-            // .setMessageTag(0x0000) TODO: Do we need an API for this?
-            .setEncapsulatedFrame(QKnxNetIpSessionAuthenticateProxy::secureBuilder()
-                .setUserId(m_secureConfig.d->userId)
-                .create(m_secureConfig.d->userPassword, m_secureConfig.d->publicKey.bytes(), proxy
-                    .publicKey()))
-            .create(m_sessionKey);
-
-        ++m_sequenceNumber;
-        m_waitForAuthentication = true;
-        if (m_tcpSocket)
-            m_tcpSocket->write(secureWrapper.bytes().toByteArray());
-
-        Q_Q(QKnxNetIpEndpointConnection);
-        QObject::connect(m_secureTimer, &QTimer::timeout, q, [&]() {
-            m_secureTimer->stop();
-            setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::AuthFailed,
-                QKnxNetIpEndpointConnection::tr("Did not receive session status frame."));
-
-            auto secureStatusWrapper = QKnxNetIpSecureWrapperProxy::secureBuilder()
-                .setSecureSessionId(m_sessionId)
-                .setSequenceNumber(m_sequenceNumber)
-                .setSerialNumber(m_serialNumber)
-                // .setMessageTag(0x0000) TODO: Do we need an API for this?
-                .setEncapsulatedFrame(QKnxNetIpSessionStatusProxy::builder()
-                    .setStatus(QKnxNetIp::SecureSessionStatus::Close)
-                    .create())
-                .create(m_sessionKey);
-            if (m_tcpSocket)
-                m_tcpSocket->write(secureStatusWrapper.bytes().toByteArray());
-
-            Q_Q(QKnxNetIpEndpointConnection);
-            q->disconnectFromHost();
-        });
-        m_secureTimer->start(QKnxNetIp::SecureSessionAuthenticateTimeout);
+        // verification and key agreement run in the background, see processSessionResult()
+        if (!m_handshake->isRunning())
+            m_handshake->start(m_secureConfig, frame);
     }   break;
 
     case QKnxNetIp::ServiceType::SessionAuthenticate:
@@ -420,19 +352,12 @@ QKnxNetIp::ServiceType
                 m_secureTimer->disconnect();
                 m_waitForAuthentication = false;
                 auto ep = (m_tcpSocket ? m_routeBack : (m_nat ? m_routeBack : m_localEndpoint));
-                auto secureWrapper = QKnxNetIpSecureWrapperProxy::secureBuilder()
-                    .setSecureSessionId(m_sessionId)
-                    .setSequenceNumber(m_sequenceNumber)
-                    .setSerialNumber(m_serialNumber)
-                    // .setMessageTag(0x0000) TODO: Do we need an API for this?
-                    .setEncapsulatedFrame(QKnxNetIpConnectRequestProxy::builder()
-                        .setControlEndpoint(ep)
-                        .setDataEndpoint(ep)
-                        .setRequestInformation(m_cri)
-                        .create())
-                    .create(m_sessionKey);
-
-                ++m_sequenceNumber;
+                auto secureWrapper = wrapSecure(QKnxNetIpConnectRequestProxy::builder()
+                    .setControlEndpoint(ep)
+                    .setDataEndpoint(ep)
+                    .setRequestInformation(m_cri)
+                    .create());
+
                 if (m_tcpSocket)
                     m_tcpSocket->write(secureWrapper.bytes().toByteArray());
 
@@ -441,18 +366,11 @@ QKnxNetIp::ServiceType
 
                 Q_Q(QKnxNetIpEndpointConnection);
                 QObject::connect(m_secureTimer, &QTimer::timeout, q, [&]() {
-                    auto secureStatusWrapper = QKnxNetIpSecureWrapperProxy::secureBuilder()
-                        .setSecureSessionId(m_sessionId)
-                        .setSequenceNumber(m_sequenceNumber)
-                        .setSerialNumber(m_serialNumber)
-                        // .setMessageTag(0x0000) TODO: Do we need an API for this?
-                        .setEncapsulatedFrame(QKnxNetIpSessionStatusProxy::builder()
-                            .setStatus(QKnxNetIp::SecureSessionStatus::KeepAlive)
-                            .create())
-                        .create(m_sessionKey);
+                    auto secureStatusWrapper = wrapSecure(QKnxNetIpSessionStatusProxy::builder()
+                        .setStatus(QKnxNetIp::SecureSessionStatus::KeepAlive)
+                        .create());
                     qDebug() << "Sending keep alive status frame:" << secureStatusWrapper;
 
-                    ++m_sequenceNumber;
                     if (m_tcpSocket)
                         m_tcpSocket->write(secureStatusWrapper.bytes().toByteArray());
                 });
@@ -511,6 +429,42 @@ QKnxNetIp::ServiceType
     return serviceType;
 }
 
+void QKnxNetIpEndpointConnectionPrivate::processSessionResult(
+    const QKnxNetIpSecureHandshake::Result &result)
+{
+    if (!result.isValid())
+        return; // MAC could not be verified, bail out
+
+    m_secureTimer->stop();
+    m_secureTimer->disconnect();
+    m_sessionId = result.sessionId;
+    m_session = QKnxCcmContext(result.sessionKey);
+    m_replayWindow.clear();
+
+    auto secureWrapper = wrapSecure(result.sessionAuthenticate);
+
+    m_waitForAuthentication = true;
+    if (m_tcpSocket)
+        m_tcpSocket->write(secureWrapper.bytes().toByteArray());
+
+    Q_Q(QKnxNetIpEndpointConnection);
+    QObject::connect(m_secureTimer, &QTimer::timeout, q, [&]() {
+        m_secureTimer->stop();
+        setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::AuthFailed,
+            QKnxNetIpEndpointConnection::tr("Did not receive session status frame."));
+
+        auto secureStatusWrapper = wrapSecure(QKnxNetIpSessionStatusProxy::builder()
+            .setStatus(QKnxNetIp::SecureSessionStatus::Close)
+            .create());
+        if (m_tcpSocket)
+            m_tcpSocket->write(secureStatusWrapper.bytes().toByteArray());
+
+        Q_Q(QKnxNetIpEndpointConnection);
+        q->disconnectFromHost();
+    });
+    m_secureTimer->start(QKnxNetIp::SecureSessionAuthenticateTimeout);
+}
+
 bool QKnxNetIpEndpointConnectionPrivate::initConnection(const QHostAddress &a, quint16 p,
     QKnxNetIp::HostProtocol hp)
 {
@@ -561,17 +515,39 @@ bool QKnxNetIpEndpointConnectionPrivate::initConnection(const QHostAddress &a, q
 
     m_sessionId = 0;
     m_sequenceNumber = 0;
+    m_session = {};
+    m_replayWindow.clear();
     m_waitForAuthentication = false;
 
+    Q_Q(QKnxNetIpEndpointConnection);
+    if (!m_handshake) {
+        m_handshake = new QKnxNetIpSecureHandshake(q);
+        QObject::connect(m_handshake, &QKnxNetIpSecureHandshake::finished, q,
+            [&](const QKnxNetIpSecureHandshake::Result &result) {
+                processSessionResult(result);
+        });
+    }
+    m_handshake->cancel();
+
     setupTimer();
 
     QKnxPrivate::clearSocket(&m_tcpSocket);
     QKnxPrivate::clearSocket(&m_udpSocket);
 
-    Q_Q(QKnxNetIpEndpointConnection);
-    QAbstractSocket *socket = nullptr;
     if (hp == QKnxNetIp::HostProtocol::TCP_IPv4) {
-        socket = m_tcpSocket = new QTcpSocket(q_func());
+        if (m_network) {
+            setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
+                QKnxNetIpEndpointConnection::tr("A simulated network supports UDP connections "
+                    "only."));
+            return false;
+        }
+
+        if (m_transport) {
+            setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Connecting);
+            return true; // the secure transport owns the TCP connection
+        }
+
+        m_tcpSocket = new QTcpSocket(q_func());
         QObject::connect(m_tcpSocket, &QTcpSocket::readyRead, q, [&]() {
             if (m_tcpSocket->bytesAvailable() < QKnxNetIpFrameHeader::HeaderSize10)
                 return;
@@ -586,10 +562,21 @@ bool QKnxNetIpEndpointConnectionPrivate::initConnection(const QHostAddress &a, q
             m_rxBuffer.remove(0, header.totalSize());
             processReceivedFrame(frame);
         });
+        QObject::connect(m_tcpSocket,
+            QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), q,
+            [this](QAbstractSocket::SocketError) {
+                setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
+                    m_tcpSocket->errorString());
+                Q_Q(QKnxNetIpEndpointConnection);
+                q->disconnectFromHost();
+        });
     } else if (hp == QKnxNetIp::HostProtocol::UDP_IPv4) {
-        socket = m_udpSocket = new QUdpSocket(q_func());
-        QObject::connect(m_udpSocket, &QUdpSocket::readyRead, q, [&]() {
-            while (m_udpSocket && m_udpSocket->state() == QUdpSocket::BoundState
+        if (m_network)
+            m_udpSocket = m_network->createSocket(m_networkAddress, q_func());
+        else
+            m_udpSocket = new QKnxNetIpUdpSocket(q_func());
+        QObject::connect(m_udpSocket, &QKnxNetIpDatagramSocket::readyRead, q, [&]() {
+            while (m_udpSocket && m_udpSocket->state() == QAbstractSocket::BoundState
                 && m_udpSocket->hasPendingDatagrams()) {
                     auto tmp = m_udpSocket->receiveDatagram();
                     auto frame = QKnxNetIpFrame::fromBytes(QKnxByteArray::fromByteArray(tmp.data()));
@@ -600,15 +587,10 @@ bool QKnxNetIpEndpointConnectionPrivate::initConnection(const QHostAddress &a, q
                         m_remoteDataEndpoint = { tmp.senderAddress(), quint16(tmp.senderPort())};
             }
         });
-    } else {
-        return false;
-    }
-
-    if (socket) {
-        QObject::connect(socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error),
-            q, [socket, this](QAbstractSocket::SocketError) {
+        QObject::connect(m_udpSocket, &QKnxNetIpDatagramSocket::errorOccurred, q,
+            [this](QAbstractSocket::SocketError) {
                 setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
-                    socket->errorString());
+                    m_udpSocket->errorString());
                 Q_Q(QKnxNetIpEndpointConnection);
                 q->disconnectFromHost();
         });
@@ -629,26 +611,24 @@ void QKnxNetIpEndpointConnectionPrivate::cleanup()
     QKnxPrivate::clearTimer(&m_acknowledgeTimer);
     QKnxPrivate::clearTimer(&m_secureTimer);
 
+    if (m_handshake)
+        m_handshake->cancel();
+
     if (m_udpSocket) {
         m_udpSocket->close();
         QKnxPrivate::clearSocket(&m_udpSocket);
     } else if (m_tcpSocket) {
         if (m_secureConfig.isValid()) {
-            auto secureStatusWrapper = QKnxNetIpSecureWrapperProxy::secureBuilder()
-                .setSecureSessionId(m_sessionId)
-                .setSequenceNumber(m_sequenceNumber)
-                .setSerialNumber(m_serialNumber)
-                // .setMessageTag(0x0000) TODO: Do we need an API for this?
-                .setEncapsulatedFrame(QKnxNetIpSessionStatusProxy::builder()
-                    .setStatus(QKnxNetIp::SecureSessionStatus::Close)
-                    .create())
-                .create(m_sessionKey);
-            ++m_sequenceNumber;
+            auto secureStatusWrapper = wrapSecure(QKnxNetIpSessionStatusProxy::builder()
+                .setStatus(QKnxNetIp::SecureSessionStatus::Close)
+                .create());
             m_tcpSocket->write(secureStatusWrapper.bytes().toByteArray());
             m_tcpSocket->waitForBytesWritten();
         }
         m_tcpSocket->close();
         QKnxPrivate::clearSocket(&m_tcpSocket);
+    } else if (m_transport) {
+        QKnxNetIpSecureTransportPrivate::get(m_transport)->detach(this);
     }
 
     setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnected);
@@ -670,20 +650,8 @@ bool QKnxNetIpEndpointConnectionPrivate::sendCemiRequest()
         return true;
     }
 
-    if (m_tcpSocket) {
-        if (m_secureConfig.isValid()) {
-            auto secureFrame = QKnxNetIpSecureWrapperProxy::secureBuilder()
-                .setSecureSessionId(m_sessionId)
-                .setSequenceNumber(m_sequenceNumber)
-                .setSerialNumber(m_serialNumber)
-                // .setMessageTag(0x0000) TODO: Do we need an API for this?
-                .setEncapsulatedFrame(m_lastSendCemiRequest)
-                .create(m_sessionKey);
-            ++m_sequenceNumber;
-            m_tcpSocket->write(secureFrame.bytes().toByteArray());
-        } else {
-            m_tcpSocket->write(m_lastSendCemiRequest.bytes().toByteArray());
-        }
+    if (isTcpConnection()) {
+        sendTcpFrame(m_lastSendCemiRequest);
         return true; // TCP connections do not send an ACK
     }
     return false;
@@ -694,20 +662,8 @@ void QKnxNetIpEndpointConnectionPrivate::sendStateRequest()
     qDebug().noquote().nospace() << "Sending connection state request: 0x" << m_lastStateRequest
         .bytes().toHex();
 
-    if (m_tcpSocket) {
-        if (m_secureConfig.isValid()) {
-            auto secureFrame = QKnxNetIpSecureWrapperProxy::secureBuilder()
-                .setSecureSessionId(m_sessionId)
-                .setSequenceNumber(m_sequenceNumber)
-                .setSerialNumber(m_serialNumber)
-                // .setMessageTag(0x0000) TODO: Do we need an API for this?
-                .setEncapsulatedFrame(m_lastStateRequest)
-                .create(m_sessionKey);
-            ++m_sequenceNumber;
-            m_tcpSocket->write(secureFrame.bytes().toByteArray());
-        } else {
-            m_tcpSocket->write(m_lastStateRequest.bytes().toByteArray());
-        }
+    if (isTcpConnection()) {
+        sendTcpFrame(m_lastStateRequest);
     } else {
         m_udpSocket->writeDatagram(m_lastStateRequest.bytes().toByteArray(),
             m_remoteControlEndpoint.address, m_remoteControlEndpoint.port);
@@ -717,6 +673,20 @@ void QKnxNetIpEndpointConnectionPrivate::sendStateRequest()
     m_connectionStateTimer->start(QKnxNetIp::ConnectionStateRequestTimeout);
 }
 
+void QKnxNetIpEndpointConnectionPrivate::sendConnectRequest()
+{
+    auto request = QKnxNetIpConnectRequestProxy::builder()
+        .setControlEndpoint(m_routeBack)
+        .setDataEndpoint(m_routeBack)
+        .setRequestInformation(m_cri)
+        .create();
+    m_controlEndpointVersion = request.header().protocolVersion();
+
+    qDebug() << "Sending connect request:" << request;
+    sendTcpFrame(request);
+    m_connectRequestTimer->start(QKnxNetIp::ConnectRequestTimeout);
+}
+
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxLinkLayerFrame &)
 {}
 
@@ -728,7 +698,7 @@ void QKnxNetIpEndpointConnectionPrivate::processTunnelingRequest(const QKnxNetIp
     qDebug() << "Received tunneling request:" << frame;
 
     QKnxNetIpTunnelingRequestProxy request(frame);
-    if (m_tcpSocket) {
+    if (isTcpConnection()) {
         process(request.cemi());
         return; // no need to send ACK in TCP connection
     }
@@ -798,7 +768,7 @@ void QKnxNetIpEndpointConnectionPrivate::processDeviceConfigurationRequest(const
     qDebug() << "Received device configuration request:" << frame;
 
     QKnxNetIpDeviceConfigurationRequestProxy request(frame);
-    if (m_tcpSocket && request.isValid()) {
+    if (isTcpConnection() && request.isValid()) {
         process(request.cemi());
         return; // no need to send ACK in TCP connection
     }
@@ -899,7 +869,7 @@ void QKnxNetIpEndpointConnectionPrivate::processFeatureFrame(const QKnxNetIpFram
     qDebug() << "Received tunneling feature frame:" << frame;
 
     QKnxNetIpTunnelingFeatureInfoProxy proxy(frame);
-    if (m_tcpSocket || proxy.isValid()) {
+    if (isTcpConnection() || proxy.isValid()) {
         processTunnelingFeatureFrame(frame);
         return; // no need to send ACK in TCP connection
     }
@@ -947,7 +917,7 @@ void QKnxNetIpEndpointConnectionPrivate::processConnectResponse(const QKnxNetIpF
             m_lastStateRequest = QKnxNetIpConnectionStateRequestProxy::builder()
                 .setChannelId(m_channelId)
                 .setControlEndpoint(
-                        m_tcpSocket ? m_routeBack : (m_nat ? m_routeBack : m_localEndpoint)
+                        isTcpConnection() ? m_routeBack : (m_nat ? m_routeBack : m_localEndpoint)
                     )
                 .create();
 
@@ -1000,18 +970,8 @@ void QKnxNetIpEndpointConnectionPrivate::processDisconnectRequest(const QKnxNetI
             .setStatus(QKnxNetIp::Error::None)
             .create();
         qDebug() << "Sending disconnect response:" << responseFrame;
-        if (m_tcpSocket) {
-            if (m_secureConfig.isValid()) {
-                responseFrame = QKnxNetIpSecureWrapperProxy::secureBuilder()
-                    .setSecureSessionId(m_sessionId)
-                    .setSequenceNumber(m_sequenceNumber)
-                    .setSerialNumber(m_serialNumber)
-                    // .setMessageTag(0x0000) TODO: Do we need an API for this?
-                    .setEncapsulatedFrame(responseFrame)
-                    .create(m_sessionKey);
-                ++m_sequenceNumber;
-            }
-            m_tcpSocket->write(responseFrame.bytes().toByteArray());
+        if (isTcpConnection()) {
+            sendTcpFrame(responseFrame);
         } else {
             m_udpSocket->writeDatagram(responseFrame.bytes().toByteArray(),
                 m_remoteControlEndpoint.address, m_remoteControlEndpoint.port);
@@ -1062,6 +1022,22 @@ void QKnxNetIpEndpointConnectionPrivate::setAndEmitErrorOccurred(
     emit q->errorOccurred(m_error, m_errorString);
 }
 
+QKnxNetIpFrame QKnxNetIpEndpointConnectionPrivate::wrapSecure(const QKnxNetIpFrame &frame)
+{
+    // TODO: Do we need an API for the message tag?
+    return m_session.wrap(frame, m_sessionId, m_sequenceNumber++, m_serialNumber, 0x0000);
+}
+
+void QKnxNetIpEndpointConnectionPrivate::sendTcpFrame(const QKnxNetIpFrame &frame)
+{
+    if (m_tcpSocket) {
+        m_tcpSocket->write((m_secureConfig.isValid() ? wrapSecure(frame) : frame).bytes()
+            .toByteArray());
+    } else if (m_transport) {
+        QKnxNetIpSecureTransportPrivate::get(m_transport)->send(this, frame);
+    }
+}
+
 
 // -- QKnxNetIpEndpointConnection
 
@@ -1071,6 +1047,10 @@ void QKnxNetIpEndpointConnectionPrivate::setAndEmitErrorOccurred(
 QKnxNetIpEndpointConnection::~QKnxNetIpEndpointConnection()
 {
     disconnectFromHost();
+
+    Q_D(QKnxNetIpEndpointConnection);
+    if (d->m_transport)
+        QKnxNetIpSecureTransportPrivate::get(d->m_transport)->detach(d);
 }
 
 /*!
@@ -1274,6 +1254,11 @@ void QKnxNetIpEndpointConnection::connectToHost(const QHostAddress &address, qui
         return connectToHost(address, port);
 
     Q_D(QKnxNetIpEndpointConnection);
+    if (d->m_transport) {
+        return d->setAndEmitErrorOccurred(Error::Network, tr("A secure transport can only be "
+            "used by secure connections."));
+    }
+
     if (!d->initConnection(address, port, protocol))
         return;
 
@@ -1351,18 +1336,53 @@ void QKnxNetIpEndpointConnection::setSecureConfiguration(const QKnxNetIpSecureCo
     }
 }
 
+/*!
+    \since 5.15
+
+    Returns the secure transport used by the connection, or \c nullptr if the
+    connection uses a TCP connection of its own.
+
+    \sa setSecureTransport()
+*/
+QKnxNetIpSecureTransport *QKnxNetIpEndpointConnection::secureTransport() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_transport;
+}
+
+/*!
+    \since 5.15
+
+    Sets the secure transport used by connectToHostEncrypted() to
+    \a transport. Connections sharing a transport share its TCP connection,
+    and connections with the same credentials also share one secure session.
+    Passing \c nullptr makes the connection use a TCP connection of its own.
+    The transport cannot be changed while the connection is established.
+
+    \note A connection with a secure transport set can only be established
+    using connectToHostEncrypted().
+
+    \sa QKnxNetIpSecureTransport
+*/
+void QKnxNetIpEndpointConnection::setSecureTransport(QKnxNetIpSecureTransport *transport)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    if (d->m_state == QKnxNetIpEndpointConnection::State::Disconnected)
+        d->m_transport = transport;
+}
+
 /*!
     \since 5.13
 
     Establishes a connection to the KNXnet/IP control endpoint \a controlEndpoint.
 
-    \sa setSerialNumber(), setSecureConfiguration()
+    \sa setSerialNumber(), setSecureConfiguration(), setSecureTransport()
 */
 void QKnxNetIpEndpointConnection::connectToHostEncrypted(const QKnxNetIpHpai &controlEndpoint)
 {
     const QKnxNetIpHpaiProxy proxy(controlEndpoint);
     if (proxy.isValid() && proxy.hostProtocol() == QKnxNetIp::HostProtocol::TCP_IPv4)
-        connectToHost(proxy.hostAddress(), proxy.port());
+        connectToHostEncrypted(proxy.hostAddress(), proxy.port());
 }
 
 /*!
@@ -1370,7 +1390,7 @@ void QKnxNetIpEndpointConnection::connectToHostEncrypted(const QKnxNetIpHpai &co
 
     Establishes a secure session to the host with \a address and \a port.
 
-    \sa setSerialNumber(), setSecureConfiguration()
+    \sa setSerialNumber(), setSecureConfiguration(), setSecureTransport()
 */
 void QKnxNetIpEndpointConnection::connectToHostEncrypted(const QHostAddress &address, quint16 port)
 {
@@ -1384,6 +1404,17 @@ void QKnxNetIpEndpointConnection::connectToHostEncrypted(const QHostAddress &add
     if (d->m_serialNumber.size() != 6)
         return d->setAndEmitErrorOccurred(Error::SerialNumber, tr("Invalid device serial number."));
 
+    // derive the password hashes while the connection and session request are on their way
+    d->m_secureConfig.precomputePasswordHashes();
+
+    if (d->m_transport) {
+        if (QKnxNetIpSecureTransportPrivate::get(d->m_transport)->attach(d, address, port))
+            return;
+        d->setAndEmitErrorOccurred(Error::Network, tr("The secure transport is connected to "
+            "a different host."));
+        return d->cleanup();
+    }
+
     connect(d->m_tcpSocket, &QTcpSocket::connected, this, [&]() {
         Q_D(QKnxNetIpEndpointConnection);
         d->m_localEndpoint = Endpoint(d->m_tcpSocket->localAddress(),
@@ -1432,20 +1463,8 @@ void QKnxNetIpEndpointConnection::disconnectFromHost()
             .create();
 
         qDebug() << "Sending disconnect request:" << frame;
-        if (d->m_tcpSocket) {
-            if (d->m_secureConfig.isValid()) {
-                auto secureFrame = QKnxNetIpSecureWrapperProxy::secureBuilder()
-                    .setSecureSessionId(d->m_sessionId)
-                    .setSequenceNumber(d->m_sequenceNumber)
-                    .setSerialNumber(d->m_serialNumber)
-                    // .setMessageTag(0x0000) TODO: Do we need an API for this?
-                    .setEncapsulatedFrame(frame)
-                    .create(d->m_sessionKey);
-                ++(d->m_sequenceNumber);
-                d->m_tcpSocket->write(secureFrame.bytes().toByteArray());
-            } else {
-                d->m_tcpSocket->write(frame.bytes().toByteArray());
-            }
+        if (d->isTcpConnection()) {
+            d->sendTcpFrame(frame);
         } else {
             d->m_udpSocket->writeDatagram(frame.bytes().toByteArray(),
                 d->m_remoteControlEndpoint.address, d->m_remoteControlEndpoint.port);
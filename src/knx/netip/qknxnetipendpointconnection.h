@@ -41,6 +41,7 @@
 QT_BEGIN_NAMESPACE
 
 class QKnxNetIpEndpointConnectionPrivate;
+class QKnxNetIpSecureTransport;
 class Q_KNX_EXPORT QKnxNetIpEndpointConnection : public QObject
 {
     Q_OBJECT
@@ -124,6 +125,9 @@ public:
     QKnxNetIpSecureConfiguration secureConfiguration() const;
     void setSecureConfiguration(const QKnxNetIpSecureConfiguration &config);
 
+    QKnxNetIpSecureTransport *secureTransport() const;
+    void setSecureTransport(QKnxNetIpSecureTransport *transport);
+
     void connectToHostEncrypted(const QKnxNetIpHpai &controlEndpoint);
     void connectToHostEncrypted(const QHostAddress &address, quint16 port);
 
@@ -41,6 +41,7 @@
 // We mean it.
 //
 
+#include <QtCore/qpointer.h>
 #include <QtCore/qtimer.h>
 
 #include <QtKnx/qtknxglobal.h>
@@ -49,6 +50,11 @@
 #include <QtKnx/qknxlinklayerframe.h>
 #include <QtKnx/qknxnetipendpointconnection.h>
 #include <QtKnx/qknxnetipsecureconfiguration.h>
+#include <QtKnx/qknxnetipsecuretransport.h>
+#include <QtKnx/private/qknxccmcontext_p.h>
+#include <QtKnx/private/qknxnetipdatagramsocket_p.h>
+#include <QtKnx/private/qknxnetipsecurehandshake_p.h>
+#include <QtKnx/private/qknxreplaywindow_p.h>
 
 #include <QtNetwork/qhostaddress.h>
 
@@ -64,7 +70,7 @@ class QKnxNetIpDisconnectRequestProxy;
 class QKnxNetIpDisconnectResponseProxy;
 class QKnxNetIpTunnelingAcknowledgeProxy;
 class QKnxNetIpTunnelingRequestProxy;
-class QUdpSocket;
+class QKnxNetIpSimulatedNetwork;
 class QTcpSocket;
 
 struct UserProperties
@@ -122,6 +128,7 @@ struct Endpoint final
 class Q_KNX_EXPORT QKnxNetIpEndpointConnectionPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QKnxNetIpEndpointConnection)
+    friend class QKnxNetIpSecureTransportPrivate;
 
 public:
     QKnxNetIpEndpointConnectionPrivate(const QHostAddress &address, quint16 port,
@@ -139,6 +146,7 @@ public:
 
     bool sendCemiRequest();
     void sendStateRequest();
+    void sendConnectRequest();
 
     QKnxNetIp::ServiceType processReceivedFrame(const QKnxNetIpFrame &frame);
     virtual void process(const QKnxLinkLayerFrame &frame);
@@ -164,9 +172,18 @@ public:
     virtual void processDisconnectRequest(const QKnxNetIpFrame &frame);
     virtual void processDisconnectResponse(const QKnxNetIpFrame &frame);
 
+    void processSessionResult(const QKnxNetIpSecureHandshake::Result &result);
+
     void setAndEmitStateChanged(QKnxNetIpEndpointConnection::State newState);
     void setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error newError, const QString &message);
 
+    QKnxNetIpFrame wrapSecure(const QKnxNetIpFrame &frame);
+    void sendTcpFrame(const QKnxNetIpFrame &frame);
+    bool isTcpConnection() const
+    {
+        return m_remoteControlEndpoint.hostProtocol == QKnxNetIp::HostProtocol::TCP_IPv4;
+    }
+
     QKnxNetIpCri cri() const { return m_cri; }
     void updateCri(QKnxNetIp::TunnelLayer layer)
     {
@@ -236,19 +253,25 @@ private:
     QTimer *m_acknowledgeTimer { nullptr };
     bool m_waitForAcknowledgement { false };
 
-    QUdpSocket *m_udpSocket { nullptr };
+    QKnxNetIpDatagramSocket *m_udpSocket { nullptr };
     QTcpSocket *m_tcpSocket { nullptr };
     QKnxByteArray m_rxBuffer;
 
+    QPointer<QKnxNetIpSimulatedNetwork> m_network;
+    QHostAddress m_networkAddress;
+
     UserProperties m_user;
 
     quint16 m_sessionId { 0 };
     quint48 m_sequenceNumber { 0 };
     bool m_waitForAuthentication { false };
 
-    QKnxByteArray m_sessionKey;
+    QKnxCcmContext m_session;
+    QKnxReplayWindow m_replayWindow;
     QTimer *m_secureTimer { nullptr };
+    QKnxNetIpSecureHandshake *m_handshake { nullptr };
     QKnxNetIpSecureConfiguration m_secureConfig;
+    QPointer<QKnxNetIpSecureTransport> m_transport;
 
     // TODO: We need some kind of device configuration class as well.
     QKnxByteArray m_serialNumber { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
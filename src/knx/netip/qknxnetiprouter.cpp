@@ -27,6 +27,7 @@
 **
 ******************************************************************************/
 
+#include "qknxcryptographicengine.h"
 #include "qknxnetiprouter.h"
 #include "qknxnetiprouter_p.h"
 #include "qknxnetip.h"
@@ -40,6 +41,10 @@
 #include <QtCore/qtimer.h>
 #include <QtNetwork/qnetworkdatagram.h>
 
+#include "private/qknxkeyring_p.h"
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -112,6 +117,49 @@ QT_BEGIN_NAMESPACE
 
     \endcode
 
+    A single QKnxNetIpRouter instance can also serve several network interfaces
+    and multicast groups at once, for example to bridge a building network and
+    a management network. The router joins every configured multicast group on
+    every configured interface using one UDP socket. Each received routing
+    indication is tagged with the interface it arrived on, and outgoing routing
+    indications can be restricted to a single interface:
+
+    \code
+        QKnxNetIpRouter router;
+        router.setInterfaceAffinities({ QNetworkInterface::interfaceFromName("eth0"),
+            QNetworkInterface::interfaceFromName("eth1") });
+        router.start();
+
+        QObject::connect(&router, &QKnxNetIpRouter::routingIndicationReceivedOnInterface,
+            [&](QKnxNetIpFrame frame, QKnxNetIpRouter::FilterAction action,
+                QNetworkInterface ingress) {
+                // forward the frame on every interface but the one it arrived on
+                for (const auto &iface : router.interfaceAffinities()) {
+                    if (iface.index() != ingress.index())
+                        router.sendRoutingIndicationOnInterface(frame, iface);
+                }
+        });
+    \endcode
+
+    \section2 Secure Routing
+
+    If a backbone key is set, the router takes part in a KNX IP Secure backbone.
+    Every routing frame is then sent encapsulated in an authenticated and
+    encrypted secure wrapper frame, and only secure wrapper and timer notify
+    frames are accepted from the network. The sequence information of those
+    frames is a shared multicast timer that all devices on the backbone keep
+    synchronized through timer notify frames. Frames with a timer value older
+    than the configured latency tolerance are discarded to prevent replay
+    attacks. The backbone configuration can be read from an ETS exported
+    keyring file:
+
+    \code
+        QKnxNetIpRouter router;
+        router.setSerialNumber(QKnxByteArray::fromHex("00fa12345678"));
+        if (router.setBackboneFromKeyring("project.knxkeys", "secret", true))
+            router.start();
+    \endcode
+
     \sa QKnxLinkLayerFrame, Routing
 */
 
@@ -211,6 +259,21 @@ QT_BEGIN_NAMESPACE
     \a frame and specifies the action \a routingAction to be applied by the router.
 */
 
+/*!
+    \fn void QKnxNetIpRouter::routingIndicationReceivedOnInterface(QKnxNetIpFrame frame, QKnxNetIpRouter::FilterAction action, QNetworkInterface iface)
+    \since 5.15
+
+    This signal is emitted when the KNXnet/IP router receives a routing
+    indication \a frame and specifies the action \a action to be applied by
+    the router. The network interface \a iface is the interface the frame was
+    received on; it is invalid if the ingress interface could not be
+    determined.
+
+    The signal is emitted right after \l routingIndicationReceived().
+
+    \sa interfaceAffinities()
+*/
+
 /*!
     \fn void QKnxNetIpRouter::routingBusyReceived(QKnxNetIpFrame frame)
 
@@ -348,11 +411,14 @@ QKnxNetIpRouter::QKnxNetIpRouter(QObject *parent)
 
 /*!
     Returns the current network interface used by this KNX routing instance.
+    If the router is bound to several interfaces, the first one is returned.
+
+    \sa interfaceAffinities()
  */
 QNetworkInterface QKnxNetIpRouter::interfaceAffinity() const
 {
     Q_D(const QKnxNetIpRouter);
-    return d->m_iface;
+    return d->m_ifaces.value(0);
 }
 
 /*!
@@ -377,7 +443,7 @@ void QKnxNetIpRouter::setInterfaceAffinity(const QHostAddress &address)
             break;
         }
 
-        d->m_iface = iface;
+        d->m_ifaces = { iface };
         return;
     }
 
@@ -391,19 +457,89 @@ void QKnxNetIpRouter::setInterfaceAffinity(const QHostAddress &address)
 void QKnxNetIpRouter::setInterfaceAffinity(const QNetworkInterface &iface)
 {
     Q_D(QKnxNetIpRouter);
-    if (iface.flags().testFlag(QNetworkInterface::IsRunning))
-        d->m_iface = iface;
+    if (d->isValidInterface(iface))
+        d->m_ifaces = { iface };
     else
         d->errorOccurred(Error::Network, tr("Could not set an affinity to any interface"));
 }
 
 /*!
-    Returns the multicast address used by the QKnxNetIpRouter.
+    \since 5.15
+
+    Returns all network interfaces used by this KNX routing instance.
+
+    \sa setInterfaceAffinities()
+*/
+QList<QNetworkInterface> QKnxNetIpRouter::interfaceAffinities() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_ifaces;
+}
+
+/*!
+    \since 5.15
+
+    Sets the network interfaces \a ifaces that the QKnxNetIpRouter instance
+    shall use. The router joins all its multicast groups on each interface and
+    by default sends routing frames on each interface.
+
+    If one of the interfaces is not running, the list is not changed and an
+    error is emitted.
+
+    \note The new interfaces are used the next time the router is started.
+
+    \sa addInterfaceAffinity(), sendRoutingIndicationOnInterface()
+*/
+void QKnxNetIpRouter::setInterfaceAffinities(const QList<QNetworkInterface> &ifaces)
+{
+    Q_D(QKnxNetIpRouter);
+
+    QList<QNetworkInterface> list;
+    for (const auto &iface : ifaces) {
+        if (!d->isValidInterface(iface)) {
+            d->errorOccurred(Error::Network, tr("Could not set an affinity to any interface"));
+            return;
+        }
+
+        auto it = std::find_if(list.cbegin(), list.cend(), [&iface](const QNetworkInterface &i) {
+            return i.index() == iface.index();
+        });
+        if (it == list.cend())
+            list.append(iface);
+    }
+    d->m_ifaces = list;
+}
+
+/*!
+    \since 5.15
+
+    Adds the network interface \a iface to the interfaces that the
+    QKnxNetIpRouter instance shall use.
+
+    \sa setInterfaceAffinities()
+*/
+void QKnxNetIpRouter::addInterfaceAffinity(const QNetworkInterface &iface)
+{
+    Q_D(QKnxNetIpRouter);
+    if (!d->isValidInterface(iface)) {
+        d->errorOccurred(Error::Network, tr("Could not set an affinity to any interface"));
+        return;
+    }
+
+    if (d->indexOfInterface(iface.index()) < 0)
+        d->m_ifaces.append(iface);
+}
+
+/*!
+    Returns the multicast address used by the QKnxNetIpRouter. If the router
+    uses several multicast addresses, the first one is returned.
+
+    \sa multicastAddresses()
  */
 QHostAddress QKnxNetIpRouter::multicastAddress() const
 {
     Q_D(const QKnxNetIpRouter);
-    return d->m_multicastAddress;
+    return d->m_multicastAddresses.value(0);
 }
 
 /*!
@@ -418,7 +554,73 @@ void QKnxNetIpRouter::setMulticastAddress(const QHostAddress &address)
     if (!isIPv4 || !address.isMulticast())
         return;
 
-    d->m_multicastAddress = address;
+    d->m_multicastAddresses = { address };
+}
+
+/*!
+    \since 5.15
+
+    Returns all multicast addresses used by the QKnxNetIpRouter.
+
+    \sa setMulticastAddresses()
+*/
+QList<QHostAddress> QKnxNetIpRouter::multicastAddresses() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_multicastAddresses;
+}
+
+/*!
+    \since 5.15
+
+    Sets the multicast addresses to \a addresses. This allows a single router
+    instance to serve several backbone segments that use separate multicast
+    groups. Routing frames are sent to every group.
+
+    If one of the addresses is not an IPv4 multicast address, or the list is
+    empty, the addresses are not changed.
+
+    \note The new addresses are used the next time the router is started.
+
+    \sa addMulticastAddress()
+*/
+void QKnxNetIpRouter::setMulticastAddresses(const QList<QHostAddress> &addresses)
+{
+    Q_D(QKnxNetIpRouter);
+
+    QList<QHostAddress> list;
+    for (const auto &address : addresses) {
+        auto isIPv4 = false;
+        address.toIPv4Address(&isIPv4);
+        if (!isIPv4 || !address.isMulticast())
+            return;
+        if (!list.contains(address))
+            list.append(address);
+    }
+
+    if (!list.isEmpty())
+        d->m_multicastAddresses = list;
+}
+
+/*!
+    \since 5.15
+
+    Adds the multicast address \a address to the addresses used by the
+    QKnxNetIpRouter.
+
+    \sa setMulticastAddresses()
+*/
+void QKnxNetIpRouter::addMulticastAddress(const QHostAddress &address)
+{
+    Q_D(QKnxNetIpRouter);
+
+    auto isIPv4 = false;
+    address.toIPv4Address(&isIPv4);
+    if (!isIPv4 || !address.isMulticast())
+        return;
+
+    if (!d->m_multicastAddresses.contains(address))
+        d->m_multicastAddresses.append(address);
 }
 
 /*!
@@ -444,21 +646,282 @@ void QKnxNetIpRouter::setIndividualAddress(const QKnxAddress &address)
     }
 }
 
+/*!
+    \since 5.15
+
+    Returns the backbone key used to secure routing frames, or an empty byte
+    array if the router does not use KNX IP Secure routing.
+
+    \sa setBackboneKey()
+*/
+QKnxByteArray QKnxNetIpRouter::backboneKey() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_backbone.key();
+}
+
+/*!
+    \since 5.15
+
+    Sets the 16 byte backbone \a key used to secure routing frames. The key
+    schedule is prepared once and reused for every frame sent or received.
+    Setting an empty key disables KNX IP Secure routing.
+
+    \sa setBackboneFromKeyring()
+*/
+void QKnxNetIpRouter::setBackboneKey(const QKnxByteArray &key)
+{
+    Q_D(QKnxNetIpRouter);
+    if (key.isEmpty()) {
+        d->m_backbone = {};
+        return;
+    }
+
+    QKnxCcmContext context(key);
+    if (!context.isValid()) {
+        d->errorOccurred(QKnxNetIpRouter::Error::KnxRouting, tr("Could not set backbone "
+            "key."));
+        return;
+    }
+    d->m_backbone = context;
+}
+
+/*!
+    \since 5.15
+
+    Reads the backbone key, multicast address, and latency tolerance from an
+    ETS exported \a keyring (*.knxkeys) file that was encrypted with the given
+    password \a password. Set the \a validate argument to \c true to verify
+    that all data in the keyring file is trustworthy, \c false to omit the
+    check.
+
+    Returns \c true on success; otherwise returns \c false and leaves the
+    router configuration unchanged.
+*/
+bool QKnxNetIpRouter::setBackboneFromKeyring(const QString &keyring, const QByteArray &password,
+    bool validate)
+{
+    QKnx::Ets::Keyring::QKnxKeyring ring;
+    const auto pwHash = QKnxCryptographicEngine::keyringPasswordHash(password);
+    if (!ring.load(keyring, pwHash, validate) || ring.Backbone.isEmpty())
+        return false;
+
+    const auto backbone = ring.Backbone.value(0);
+    const QHostAddress address(backbone.MulticastAddress);
+    const QKnxCcmContext context(QKnxCryptographicEngine::decodeAndDecryptToolKey(pwHash,
+        QKnxCryptographicEngine::hashSha256(ring.Created.toUtf8()), backbone.Key));
+    if (!address.isMulticast() || !context.isValid())
+        return false;
+
+    Q_D(QKnxNetIpRouter);
+    d->m_backbone = context;
+    d->m_multicastAddresses = { address };
+    d->m_latencyTolerance = backbone.Latency;
+    return true;
+}
+
+/*!
+    \since 5.15
+
+    Returns the time in milliseconds a secure routing frame may be delayed on
+    the backbone before it is discarded. The default value is \c 2000.
+*/
+quint16 QKnxNetIpRouter::latencyTolerance() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_latencyTolerance;
+}
+
+/*!
+    \since 5.15
+
+    Sets the latency tolerance to \a milliseconds. Valid values are in the
+    range of \c 0 to \c 8000 milliseconds, other values are ignored.
+*/
+void QKnxNetIpRouter::setLatencyTolerance(quint16 milliseconds)
+{
+    Q_D(QKnxNetIpRouter);
+    if (milliseconds <= 8000)
+        d->m_latencyTolerance = milliseconds;
+}
+
+/*!
+    \since 5.15
+
+    Returns the KNX serial number the router uses in secure routing frames.
+    The default value is six zero bytes.
+*/
+QKnxByteArray QKnxNetIpRouter::serialNumber() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_serialNumber;
+}
+
+/*!
+    \since 5.15
+
+    Sets the KNX serial number to \a serialNumber. The serial number must be
+    six bytes long, otherwise it is ignored.
+*/
+void QKnxNetIpRouter::setSerialNumber(const QKnxByteArray &serialNumber)
+{
+    Q_D(QKnxNetIpRouter);
+    if (serialNumber.size() == 6)
+        d->m_serialNumber = serialNumber;
+}
+
+/*!
+    \since 5.15
+
+    Returns the current value of the 48 bit multicast timer in milliseconds.
+    The timer is synchronized with the other devices of a secured backbone.
+*/
+quint48 QKnxNetIpRouter::timerValue() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->timerValue();
+}
+
+/*!
+    \since 5.15
+
+    Returns the path of the file the multicast timer value is persisted in,
+    or an empty string if the value is not persisted.
+
+    \sa setTimerStateFile()
+*/
+QString QKnxNetIpRouter::timerStateFile() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return (d->m_timerStore ? d->m_timerStore->filePath() : QString());
+}
+
+/*!
+    \since 5.15
+
+    Sets the file the multicast timer value of a secured backbone is persisted
+    in to \a filePath. An empty path disables persistence.
+
+    While routing, the router writes its timer value together with the current
+    time to the file along with the periodic timer notification and when it
+    stops. On the next start, the timer resumes from the stored value plus the
+    time that passed in between, so the router rejoins the backbone close to
+    the shared timer value instead of starting from zero and forcing the other
+    devices to resynchronize it.
+
+    \sa timerValue()
+*/
+void QKnxNetIpRouter::setTimerStateFile(const QString &filePath)
+{
+    Q_D(QKnxNetIpRouter);
+    if (filePath.isEmpty())
+        d->m_timerStore.reset();
+    else
+        d->m_timerStore.reset(new QKnxSequenceNumberStore(filePath));
+}
+
+/*!
+    \since 5.15
+
+    Returns a snapshot of the router's traffic counters.
+
+    \note This function is thread-safe. It does not lock and can be polled
+    from a monitoring thread while the router is processing frames.
+
+    \sa resetStatistics()
+*/
+QKnxNetIpRouterStatistics QKnxNetIpRouter::statistics() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_counters.snapshot();
+}
+
+/*!
+    \since 5.15
+
+    Sets all traffic counters of the router to \c 0.
+
+    \sa statistics()
+*/
+void QKnxNetIpRouter::resetStatistics()
+{
+    Q_D(QKnxNetIpRouter);
+    d->m_counters.reset();
+}
+
+/*!
+    \since 5.15
+
+    Returns the maximum number of routing indications the router queues for
+    sending. The default value is \c 0, which disables the queue.
+
+    \sa setSendQueueCapacity()
+*/
+int QKnxNetIpRouter::sendQueueCapacity() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->m_sendQueue.capacity();
+}
+
+/*!
+    \since 5.15
+
+    Sets the maximum number of queued routing indications to \a capacity.
+
+    Without a queue, routing indications are sent in call order and dropped
+    while a neighbor is busy. With a queue, they are kept while a neighbor is
+    busy and released by the flow control pacer in the order of the priority
+    of their cEMI control field: \c System and \c Urgent frames go first,
+    \c Normal and \c Low frames share the remaining bandwidth at a 3:1
+    ratio. A frame class is never passed over more than 16 times in a row. If
+    the queue is full, the newest frame of the lowest queued priority is
+    dropped to make room for a frame of higher priority, so an alarm does not
+    wait behind a bulk dimming ramp.
+
+    Frames dropped that way, frames rejected because the queue holds only
+    frames of the same or a higher priority, and frames dropped because
+    \a capacity is smaller than the number of queued frames are reported with
+    the errorOccurred() signal and the error \c KnxRouting. The router stays
+    in its current state.
+
+    \sa QKnxControlField::Priority
+*/
+void QKnxNetIpRouter::setSendQueueCapacity(int capacity)
+{
+    Q_D(QKnxNetIpRouter);
+    const auto dropped = d->m_sendQueue.dropped();
+    d->m_sendQueue.setCapacity(capacity);
+    if (d->m_sendQueue.dropped() != dropped) {
+        emit errorOccurred(QKnxNetIpRouter::Error::KnxRouting, tr("Dropped %1 queued routing "
+            "indications, the send queue capacity was reduced.")
+            .arg(d->m_sendQueue.dropped() - dropped));
+    }
+}
+
 /*!
     Multicasts the routing indication \a frame through the network interface
     associated with the QKnxNetIpRouter.
+
+    \sa setSendQueueCapacity()
  */
 void QKnxNetIpRouter::sendRoutingIndication(const QKnxNetIpFrame &frame)
 {
     Q_D(QKnxNetIpRouter);
 
-    if (d->m_state != QKnxNetIpRouter::State::Routing)
+    if (d->m_state != QKnxNetIpRouter::State::Routing
+        && !(d->m_state == QKnxNetIpRouter::State::NeighborBusy && d->m_sendQueue.capacity() > 0)) {
         return;
+    }
 
     QKnxNetIpRoutingIndicationProxy indication(frame);
     if (!indication.isValid())
         return;
 
+    if (d->m_sendQueue.capacity() > 0) {
+        d->queueRoutingIndication(frame, indication.cemi().controlField().priority(), {});
+        return;
+    }
+
     if (!d->sendFrame(frame)) {
         d->errorOccurred(QKnxNetIpRouter::Error::KnxRouting, tr("Could not send routing "
             "indication."));
@@ -467,6 +930,42 @@ void QKnxNetIpRouter::sendRoutingIndication(const QKnxNetIpFrame &frame)
     }
 }
 
+/*!
+    \since 5.15
+
+    Multicasts the routing indication \a frame through the network interface
+    \a iface only. The interface must be one of the interfaces associated with
+    the QKnxNetIpRouter.
+
+    \sa interfaceAffinities(), routingIndicationReceivedOnInterface()
+ */
+void QKnxNetIpRouter::sendRoutingIndicationOnInterface(const QKnxNetIpFrame &frame,
+                                                       const QNetworkInterface &iface)
+{
+    Q_D(QKnxNetIpRouter);
+
+    if (d->m_state != QKnxNetIpRouter::State::Routing
+        && !(d->m_state == QKnxNetIpRouter::State::NeighborBusy && d->m_sendQueue.capacity() > 0)) {
+        return;
+    }
+
+    QKnxNetIpRoutingIndicationProxy indication(frame);
+    if (!indication.isValid() || !iface.isValid())
+        return;
+
+    if (d->m_sendQueue.capacity() > 0) {
+        d->queueRoutingIndication(frame, indication.cemi().controlField().priority(), iface);
+        return;
+    }
+
+    if (!d->sendFrame(frame, iface)) {
+        d->errorOccurred(QKnxNetIpRouter::Error::KnxRouting, tr("Could not send routing "
+            "indication."));
+    } else {
+        emit routingIndicationSent(frame);
+    }
+}
+
 /*!
     Multicasts the routing busy message containing \a frame through the
     network interface associated with the QKnxNetIpRouter.
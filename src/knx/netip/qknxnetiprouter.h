@@ -31,8 +31,10 @@
 #define QKNXNETIPROUTER_H
 
 #include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxbytearray.h>
 #include <QtKnx/qknxnetipframe.h>
 #include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetiprouterstatistics.h>
 #include <QtKnx/qtknxglobal.h>
 
 #include <QtNetwork/qhostaddress.h>
@@ -103,14 +105,45 @@ public:
     void setInterfaceAffinity(const QHostAddress &address);
     void setInterfaceAffinity(const QNetworkInterface &iface);
 
+    QList<QNetworkInterface> interfaceAffinities() const;
+    void setInterfaceAffinities(const QList<QNetworkInterface> &ifaces);
+    void addInterfaceAffinity(const QNetworkInterface &iface);
+
     QHostAddress multicastAddress() const;
     void setMulticastAddress(const QHostAddress &address);
 
+    QList<QHostAddress> multicastAddresses() const;
+    void setMulticastAddresses(const QList<QHostAddress> &addresses);
+    void addMulticastAddress(const QHostAddress &address);
+
     QKnxAddress individualAddress() const;
     void setIndividualAddress(const QKnxAddress &address);
 
+    QKnxByteArray backboneKey() const;
+    void setBackboneKey(const QKnxByteArray &key);
+    bool setBackboneFromKeyring(const QString &keyring, const QByteArray &password, bool validate);
+
+    quint16 latencyTolerance() const;
+    void setLatencyTolerance(quint16 milliseconds);
+
+    QKnxByteArray serialNumber() const;
+    void setSerialNumber(const QKnxByteArray &serialNumber);
+
+    quint48 timerValue() const;
+
+    QString timerStateFile() const;
+    void setTimerStateFile(const QString &filePath);
+
+    QKnxNetIpRouterStatistics statistics() const;
+    void resetStatistics();
+
+    int sendQueueCapacity() const;
+    void setSendQueueCapacity(int capacity);
+
 public Q_SLOTS:
     void sendRoutingIndication(const QKnxNetIpFrame &frame);
+    void sendRoutingIndicationOnInterface(const QKnxNetIpFrame &frame,
+                                          const QNetworkInterface &iface);
     void sendRoutingBusy(const QKnxNetIpFrame &frame);
     void sendRoutingLostMessage(const QKnxNetIpFrame &frame);
     void sendRoutingSystemBroadcast(const QKnxNetIpFrame &frame);
@@ -125,6 +158,9 @@ Q_SIGNALS:
     void routingSystemBroadcastSent(QKnxNetIpFrame frame);
 
     void routingIndicationReceived(QKnxNetIpFrame frame, QKnxNetIpRouter::FilterAction action);
+    void routingIndicationReceivedOnInterface(QKnxNetIpFrame frame,
+                                              QKnxNetIpRouter::FilterAction action,
+                                              QNetworkInterface iface);
     void routingBusyReceived(QKnxNetIpFrame frame);
     void routingLostCountReceived(QKnxNetIpFrame frame);
     void routingSystemBroadcastReceived(QKnxNetIpFrame frame);
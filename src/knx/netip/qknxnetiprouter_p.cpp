@@ -33,11 +33,15 @@
 #include "qknxnetiprouter.h"
 #include "qknxnetiproutinglostmessage.h"
 #include "qknxnetiproutingsystembroadcast.h"
+#include "qknxnetipsecurewrapper.h"
+#include "qknxnetipsimulatednetwork_p.h"
+#include "qknxnetiptimernotify.h"
 
 #ifdef QT_BUILD_INTERNAL
 #include "qknxnetiptestrouter_p.h"
 #endif
 
+#include <QtCore/qdatetime.h>
 #include <QtCore/qrandom.h>
 
 QT_BEGIN_NAMESPACE
@@ -73,7 +77,7 @@ void QKnxNetIpRouterPrivate::start()
     QKnxNetIpTestRouter::instance()->setRouterInstance(this);
 #endif
 
-    if (!m_iface.isValid()) {
+    if (m_ifaces.isEmpty() && !m_network) {
         // Choose first interface available and capable of multicasting
         const auto interfaces = QNetworkInterface::allInterfaces();
         for (const auto &iface : interfaces) {
@@ -81,23 +85,54 @@ void QKnxNetIpRouterPrivate::start()
             if (flags.testFlag(QNetworkInterface::IsRunning)
                 && flags.testFlag(QNetworkInterface::CanMulticast)
                 && !flags.testFlag(QNetworkInterface::IsLoopBack)) {
-                m_iface = iface;
+                m_ifaces.append(iface);
                 break;
             }
         }
         // still no interface valid found
-        if (!m_iface.isValid()) {
+        if (m_ifaces.isEmpty()) {
             errorOccurred(QKnxNetIpRouter::Error::Network,
                 QKnxNetIpRouter::tr("Could not start routing because there isn't a "
                     "valid interface."));
             return;
         }
     }
-    m_ownAddress = m_iface.addressEntries().first().ip();
+
+    // datagrams sent from any of the interfaces we are bound to loop back to us
+    m_ownAddresses.clear();
+    for (const auto &iface : qAsConst(m_ifaces)) {
+        const auto entries = iface.addressEntries();
+        for (const auto &entry : entries)
+            m_ownAddresses.insert(entry.ip());
+    }
+    if (m_network)
+        m_ownAddresses.insert(m_networkAddress);
 
     m_busyTimer = new QTimer;
     m_busyTimer->setSingleShot(true);
 
+    // the multicast timer keeps running across restarts of the router
+    if (!m_timerClock.isValid())
+        m_timerClock.start();
+    restoreTimerValue();
+
+    // periodic timer notification while the router is part of a secured backbone
+    m_timerNotifyTimer = new QTimer;
+    m_timerNotifyTimer->setSingleShot(true);
+    QObject::connect(m_timerNotifyTimer, &QTimer::timeout, [&]() {
+        sendTimerNotify(m_serialNumber, 0x0000);
+        scheduleTimerNotify();
+        persistTimerValue();
+    });
+
+    // delayed answer to a device whose timer value is out of sync
+    m_timerUpdateTimer = new QTimer;
+    m_timerUpdateTimer->setSingleShot(true);
+    QObject::connect(m_timerUpdateTimer, &QTimer::timeout, [&]() {
+        sendTimerNotify(m_updateSerialNumber, m_updateMessageTag);
+        scheduleTimerNotify();
+    });
+
     // while neighbor router busy don't overflow him with messages, timeout until some msec
     QObject::connect(m_busyTimer, &QTimer::timeout, [&]() {
         switch (m_busyStage) {
@@ -128,79 +163,131 @@ void QKnxNetIpRouterPrivate::start()
             }
             break;
         }
+        // every tick of the pacer releases queued frames
+        processSendQueue();
     });
 
-    m_socket = new QUdpSocket;
-    m_socket->setSocketOption(QUdpSocket::SocketOption::MulticastTtlOption, 60);
+    if (m_network)
+        m_socket = m_network->createSocket(m_networkAddress);
+    else
+        m_socket = new QKnxNetIpUdpSocket;
+    m_socket->setSocketOption(QAbstractSocket::SocketOption::MulticastTtlOption, 60);
 
-    // handle QUdpSocket state changes here
-    QObject::connect(m_socket, &QUdpSocket::stateChanged, [&](QUdpSocket::SocketState s) {
+    // handle socket state changes here
+    QObject::connect(m_socket, &QKnxNetIpDatagramSocket::stateChanged,
+        [&](QAbstractSocket::SocketState s) {
+        const auto ifaces = interfaces();
         switch (s) {
-        case QUdpSocket::BoundState:
-            m_socket->setMulticastInterface(m_iface);
-            if (m_socket->joinMulticastGroup(m_multicastAddress, m_iface)) {
+        case QAbstractSocket::BoundState: {
+            // one socket serves every interface, join each group on each of them
+            bool joined = true;
+            for (const auto &iface : ifaces) {
+                for (const auto &group : qAsConst(m_multicastAddresses))
+                    joined = m_socket->joinMulticastGroup(group, iface) && joined;
+            }
+            m_socket->setMulticastInterface(ifaces.first());
+
+            if (joined) {
                 changeState(QKnxNetIpRouter::State::Routing);
+                if (isSecure())
+                    startTimerSynchronization();
             } else {
                 errorOccurred(QKnxNetIpRouter::Error::Network,
                     QKnxNetIpRouter::tr("Could not join multicast group."));
             }
-            break;
-        case QUdpSocket::ClosingState:
-            if (!m_socket->leaveMulticastGroup(m_multicastAddress, m_iface)) {
+        }   break;
+        case QAbstractSocket::ClosingState: {
+            bool left = true;
+            for (const auto &iface : ifaces) {
+                for (const auto &group : qAsConst(m_multicastAddresses))
+                    left = m_socket->leaveMulticastGroup(group, iface) && left;
+            }
+
+            if (left) {
                 changeState(QKnxNetIpRouter::State::NotInit);
             } else {
                 errorOccurred(QKnxNetIpRouter::Error::Network,
                     QKnxNetIpRouter::tr("Could not leave multicast group."));
             }
-            break;
+        }   break;
         default:
             break;
         }
     });
 
-    // handle frames received by the UDP socket
-    QObject::connect(m_socket, &QUdpSocket::readyRead, [&]() {
+    // handle frames received by the socket
+    QObject::connect(m_socket, &QKnxNetIpDatagramSocket::readyRead, [&]() {
         // TODO: Review this part, the following members might get cleared unexpectedly
         // when messages come in one after the other and are not contained all in a single
         // datagram.
         m_framesReadCount = 0;
         m_sameKnxDstAddressIndicationCount = 0;
         m_lastIndicationAddress = QKnxAddress();
-        while (m_socket && m_socket->state() == QUdpSocket::BoundState
+
+        // secure wrappers are authenticated in batches, see processSecureWrappers()
+        QVector<QKnxNetIpFrame> secureWrappers;
+        QVector<QNetworkInterface> secureIngresses;
+
+        while (m_socket && m_socket->state() == QAbstractSocket::BoundState
             && m_socket->hasPendingDatagrams()) {
 
             QNetworkDatagram datagram = m_socket->receiveDatagram();
-            if (datagram.senderAddress() == m_ownAddress
-                || m_framesReadCount == 10 // incoming queue too big, signal busy
-                || m_sameKnxDstAddressIndicationCount == 5) {
+            if (m_ownAddresses.contains(datagram.senderAddress())) {
+                m_counters.add(Counter::DiscardedOwn);
+                continue; // discard packet
+            }
+
+            // pending secure wrappers are only counted once authenticated, each may add at
+            // most one indication for the same destination address; flush the batch before
+            // it could cross the limit so the check below stays exact
+            if (!secureWrappers.isEmpty()
+                && m_sameKnxDstAddressIndicationCount + secureWrappers.size() >= 5) {
+                processSecureWrappers(secureWrappers, secureIngresses);
+                secureWrappers.clear();
+                secureIngresses.clear();
+            }
+
+            if (m_framesReadCount >= 10 // incoming queue too big, signal busy
+                || m_sameKnxDstAddressIndicationCount >= 5) {
+                    m_counters.add(Counter::DiscardedQueueFull);
                     continue; // discard packet
             }
 
             auto data = QKnxByteArray::fromByteArray(datagram.data());
             const auto header = QKnxNetIpFrameHeader::fromBytes(data, 0);
-            if (!header.isValid() || header.totalSize() != data.size())
+            if (!header.isValid() || header.totalSize() != data.size()) {
+                m_counters.add(Counter::DiscardedMalformed);
                 continue; // discard packet
+            }
 
             m_framesReadCount++;
-            switch (header.serviceType()) {
-            case QKnxNetIp::ServiceType::RoutingIndication:
-                processRoutingIndication(QKnxNetIpFrame::fromBytes(data, 0));
-                break;
-            case QKnxNetIp::ServiceType::RoutingBusy:
-                processRoutingBusy(QKnxNetIpFrame::fromBytes(data, 0));
-                break;
-            case QKnxNetIp::ServiceType::RoutingLostMessage:
-                processRoutingLostMessage(QKnxNetIpFrame::fromBytes(data, 0));
-                break;
-            case QKnxNetIp::ServiceType::RoutingSystemBroadcast:
-                processRoutingSystemBroadcast(QKnxNetIpFrame::fromBytes(data, 0));
-                break;
-            default:
-                break;
+            m_counters.add(Counter::Received);
+            m_counters.frameArrived(datagram.senderAddress());
+
+            const int index = indexOfInterface(datagram.interfaceIndex());
+            const auto ingress = (index >= 0 ? m_ifaces.at(index) : QNetworkInterface());
+
+            if (isSecure()) {
+                // plain routing frames are not accepted on a secured backbone
+                if (header.serviceType() == QKnxNetIp::ServiceType::SecureWrapper) {
+                    secureWrappers.append(QKnxNetIpFrame::fromBytes(data, 0));
+                    secureIngresses.append(ingress);
+                } else if (header.serviceType() == QKnxNetIp::ServiceType::TimerNotify) {
+                    // the timer value must be checked in the order the frames arrived
+                    processSecureWrappers(secureWrappers, secureIngresses);
+                    secureWrappers.clear();
+                    secureIngresses.clear();
+                    processTimerNotify(QKnxNetIpFrame::fromBytes(data, 0));
+                } else {
+                    m_counters.add(Counter::DiscardedSecurity);
+                }
+            } else {
+                processFrame(QKnxNetIpFrame::fromBytes(data, 0), ingress);
             }
         }
+        processSecureWrappers(secureWrappers, secureIngresses);
 
-        if (m_framesReadCount == 10 || m_sameKnxDstAddressIndicationCount == 5) {
+        if (m_framesReadCount >= 10 || m_sameKnxDstAddressIndicationCount >= 5) {
             // incoming queue over 10 packets or over 5 packets with
             // individual address destination.
             auto routingBusyNetIpFrame = QKnxNetIpRoutingBusyProxy::builder()
@@ -213,18 +300,17 @@ void QKnxNetIpRouterPrivate::start()
         }
     });
 
-    // handle UDP socket errors
-    using overload = void (QUdpSocket::*)(QUdpSocket::SocketError);
-    QObject::connect(m_socket,
-        static_cast<overload>(&QUdpSocket::error), [&](QUdpSocket::SocketError) {
+    // handle socket errors
+    QObject::connect(m_socket, &QKnxNetIpDatagramSocket::errorOccurred,
+        [&](QAbstractSocket::SocketError) {
         errorOccurred(QKnxNetIpRouter::Error::Network,
             m_socket->errorString());
     });
 
 
-    // initialize UDP socket and bind
+    // initialize socket and bind
     if (!m_socket->bind(QHostAddress(QHostAddress::AnyIPv4), m_multicastPort,
-        (QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint))) {
+        (QAbstractSocket::ShareAddress | QAbstractSocket::ReuseAddressHint))) {
             errorOccurred(QKnxNetIpRouter::Error::Network,
                 QKnxNetIpRouter::tr("Could not bind endpoint: %1")
                 .arg(m_socket->errorString()));
@@ -260,15 +346,33 @@ void QKnxNetIpRouterPrivate::cleanup()
     }
     m_busyCounter = 0;
     m_busyStage = BusyTimerStage::NotInit;
+    m_sendQueue.clear();
+
+    persistTimerValue();
+    if (m_timerNotifyTimer) {
+        m_timerNotifyTimer->stop();
+        m_timerNotifyTimer->disconnect();
+        m_timerNotifyTimer->deleteLater();
+        m_timerNotifyTimer = nullptr;
+    }
+
+    if (m_timerUpdateTimer) {
+        m_timerUpdateTimer->stop();
+        m_timerUpdateTimer->disconnect();
+        m_timerUpdateTimer->deleteLater();
+        m_timerUpdateTimer = nullptr;
+    }
 
     m_errorMessage = QString();
     m_error = QKnxNetIpRouter::Error::None;
 }
 
-void QKnxNetIpRouterPrivate::processRoutingIndication(const QKnxNetIpFrame &frame)
+void QKnxNetIpRouterPrivate::processRoutingIndication(const QKnxNetIpFrame &frame,
+    const QNetworkInterface &ingress)
 {
     QKnxNetIpRoutingIndicationProxy indication(frame);
     if (!indication.isValid()) {
+        m_counters.add(Counter::DiscardedMalformed);
         errorOccurred(QKnxNetIpRouter::Error::KnxRouting,
             QKnxNetIpRouter::tr("QKnxNetIp Routing Indication Message is not "
                 "correctly formed."));
@@ -285,15 +389,25 @@ void QKnxNetIpRouterPrivate::processRoutingIndication(const QKnxNetIpFrame &fram
         m_sameKnxDstAddressIndicationCount = 0;
     }
 
+    const auto action = filterAction(cemi);
+    if (action == QKnxNetIpRouter::FilterAction::IgnoreTotally
+        || action == QKnxNetIpRouter::FilterAction::IgnoreAcked) {
+        m_counters.add(Counter::Filtered);
+    }
+
     Q_Q(QKnxNetIpRouter);
-    emit q->routingIndicationReceived(frame, filterAction(cemi));
+    emit q->routingIndicationReceived(frame, action);
+    emit q->routingIndicationReceivedOnInterface(frame, action, ingress);
 }
 
 void QKnxNetIpRouterPrivate::processRoutingBusy(const QKnxNetIpFrame &frame)
 {
     QKnxNetIpRoutingBusyProxy busyMessage(frame);
-    if (!busyMessage.isValid())
+    if (!busyMessage.isValid()) {
+        m_counters.add(Counter::DiscardedMalformed);
         return;
+    }
+    m_counters.add(Counter::BusyReceived);
 
     flowControlHandling(busyMessage.routingBusyWaitTime());
 
@@ -305,11 +419,13 @@ void QKnxNetIpRouterPrivate::processRoutingLostMessage(const QKnxNetIpFrame &fra
 {
     QKnxNetIpRoutingLostMessageProxy lostMessage(frame);
     if (!lostMessage.isValid()) {
+        m_counters.add(Counter::DiscardedMalformed);
         errorOccurred(QKnxNetIpRouter::Error::KnxRouting,
             QKnxNetIpRouter::tr("QKnxNetIp Routing Lost Message is not "
                 "correctly formed."));
         return;
     }
+    m_counters.add(Counter::LostMessages, lostMessage.lostMessageCount());
 
     Q_Q(QKnxNetIpRouter);
     emit q->routingLostCountReceived(frame);
@@ -322,20 +438,267 @@ void QKnxNetIpRouterPrivate::processRoutingSystemBroadcast(const QKnxNetIpFrame
         Q_Q(QKnxNetIpRouter);
         emit q->routingSystemBroadcastReceived(frame);
     } else {
+        m_counters.add(Counter::DiscardedMalformed);
         errorOccurred(QKnxNetIpRouter::Error::KnxRouting,
             QKnxNetIpRouter::tr("QKnxNetIp Routing System Broadcast is not correctly "
                 "formed."));
     }
 }
 
-bool QKnxNetIpRouterPrivate::sendFrame(const QKnxNetIpFrame &frame)
+void QKnxNetIpRouterPrivate::processFrame(const QKnxNetIpFrame &frame,
+    const QNetworkInterface &ingress)
+{
+    switch (frame.serviceType()) {
+    case QKnxNetIp::ServiceType::RoutingIndication:
+        processRoutingIndication(frame, ingress);
+        break;
+    case QKnxNetIp::ServiceType::RoutingBusy:
+        processRoutingBusy(frame);
+        break;
+    case QKnxNetIp::ServiceType::RoutingLostMessage:
+        processRoutingLostMessage(frame);
+        break;
+    case QKnxNetIp::ServiceType::RoutingSystemBroadcast:
+        processRoutingSystemBroadcast(frame);
+        break;
+    default:
+        break;
+    }
+}
+
+void QKnxNetIpRouterPrivate::processSecureWrappers(const QVector<QKnxNetIpFrame> &frames,
+    const QVector<QNetworkInterface> &ingresses)
+{
+    if (frames.isEmpty())
+        return;
+
+    // all frames on the backbone share one key, authenticate them at once
+    const auto encapsulated = m_backbone.unwrap(frames);
+    for (int i = 0; i < frames.size(); ++i) {
+        // multicast secure wrappers always use the session identifier zero
+        const QKnxNetIpSecureWrapperProxy proxy(frames.at(i));
+        if (!proxy.isValid() || proxy.secureSessionId() != 0x0000) {
+            m_counters.add(Counter::DiscardedMalformed);
+            continue;
+        }
+
+        if (!encapsulated.at(i).isValid()) {
+            m_counters.add(Counter::DiscardedSecurity);
+            continue; // authentication failed, silently discard
+        }
+
+        if (!checkTimerValue(proxy.sequenceNumber(), proxy.serialNumber(), proxy.messageTag())) {
+            m_counters.add(Counter::DiscardedSecurity);
+            continue; // outdated frame, possibly a replay
+        }
+
+        processFrame(encapsulated.at(i), ingresses.at(i));
+    }
+}
+
+void QKnxNetIpRouterPrivate::processTimerNotify(const QKnxNetIpFrame &frame)
+{
+    if (!m_backbone.verifyTimerNotify(frame)) {
+        m_counters.add(Counter::DiscardedSecurity);
+        return;
+    }
+
+    const QKnxNetIpTimerNotifyProxy proxy(frame);
+    const auto timer = proxy.timerValue();
+    const auto serialNumber = proxy.serialNumber();
+    const auto messageTag = proxy.messageTag();
+
+    // another device already answered the out of sync device we wanted to update
+    if (m_timerUpdateTimer && m_timerUpdateTimer->isActive()
+        && serialNumber == m_updateSerialNumber && messageTag == m_updateMessageTag
+        && timer + syncLatencyTolerance() >= timerValue()) {
+        m_timerUpdateTimer->stop();
+    }
+
+    checkTimerValue(timer, serialNumber, messageTag);
+}
+
+quint48 QKnxNetIpRouterPrivate::timerValue() const
+{
+    const auto elapsed = (m_timerClock.isValid() ? m_timerClock.elapsed() : 0);
+    return quint48(m_timerOffset + elapsed) & Q_UINT48_MAX;
+}
+
+void QKnxNetIpRouterPrivate::setTimerValue(quint48 value)
+{
+    const auto elapsed = (m_timerClock.isValid() ? m_timerClock.elapsed() : 0);
+    m_timerOffset = qint64(value & Q_UINT48_MAX) - elapsed;
+}
+
+bool QKnxNetIpRouterPrivate::checkTimerValue(quint48 received, const QKnxByteArray &serialNumber,
+    quint16 messageTag)
+{
+    const auto local = timerValue();
+    if (received > local) {
+        // the sender is ahead, everyone synchronizes to the highest timer value
+        setTimerValue(received);
+        scheduleTimerNotify();
+        return true;
+    }
+
+    if (received + m_latencyTolerance >= local) {
+        // the sender is in sync, it takes over the periodic notification for now
+        if (local - received <= syncLatencyTolerance())
+            scheduleTimerNotify();
+        return true;
+    }
+
+    scheduleTimerUpdate(serialNumber, messageTag);
+    return false;
+}
+
+void QKnxNetIpRouterPrivate::startTimerSynchronization()
+{
+    // ask for the current timer value, answers echo our serial number and tag
+    sendTimerNotify(m_serialNumber, quint16(QRandomGenerator::global()->bounded(1, 0x10000)));
+    scheduleTimerNotify();
+}
+
+void QKnxNetIpRouterPrivate::scheduleTimerNotify()
+{
+    if (!m_timerNotifyTimer)
+        return;
+    m_timerNotifyTimer->start(10000
+        + int(QRandomGenerator::global()->bounded(3 * syncLatencyTolerance() + 1)));
+}
+
+void QKnxNetIpRouterPrivate::scheduleTimerUpdate(const QKnxByteArray &serialNumber,
+    quint16 messageTag)
+{
+    if (!m_timerUpdateTimer || m_timerUpdateTimer->isActive())
+        return;
+
+    // a random delay gives other devices the chance to answer first
+    m_updateSerialNumber = serialNumber;
+    m_updateMessageTag = messageTag;
+    m_timerUpdateTimer->start(int(QRandomGenerator::global()->bounded(syncLatencyTolerance() + 1)));
+}
+
+void QKnxNetIpRouterPrivate::sendTimerNotify(const QKnxByteArray &serialNumber,
+    quint16 messageTag)
+{
+    if (!isSecure())
+        return;
+
+    const auto frame = m_backbone.createTimerNotify(timerValue(), serialNumber, messageTag);
+    if (frame.isValid())
+        writeDatagram(frame.bytes().toByteArray());
+}
+
+void QKnxNetIpRouterPrivate::restoreTimerValue()
+{
+    if (!m_timerStore || !m_timerStore->load())
+        return;
+
+    // the backbone timer kept running while we were down, account for that
+    qint64 timestamp = 0;
+    const auto value = m_timerStore->highWaterMark(QByteArrayLiteral("routing/timer"), &timestamp);
+    if (timestamp == 0)
+        return;
+    const auto downtime = qMax<qint64>(0, QDateTime::currentMSecsSinceEpoch() - timestamp);
+    if (value + quint48(downtime) > timerValue())
+        setTimerValue(value + quint48(downtime));
+}
+
+void QKnxNetIpRouterPrivate::persistTimerValue()
+{
+    // called with the periodic timer notification, i.e. at most every ten seconds
+    if (!m_timerStore || !isSecure())
+        return;
+    m_timerStore->setHighWaterMark(QByteArrayLiteral("routing/timer"), timerValue());
+    m_timerStore->sync();
+}
+
+bool QKnxNetIpRouterPrivate::sendFrame(const QKnxNetIpFrame &frame,
+    const QNetworkInterface &egress)
 {
     if (m_state != QKnxNetIpRouter::State::Routing)
         return true; // no errors, only ignore the frame
 
-    return m_socket->writeDatagram(frame.bytes().toByteArray(),
-        m_multicastAddress,
-        m_multicastPort) != -1;
+    if (egress.isValid() && indexOfInterface(egress.index()) < 0)
+        return false;
+
+    bool result = false;
+    if (isSecure()) {
+        // multicast frames use session zero and the current timer value as sequence
+        const auto secureFrame = m_backbone.wrap(frame, 0x0000, timerValue(), m_serialNumber,
+            0x0000);
+        if (!secureFrame.isValid())
+            return false;
+
+        // every secure frame sent notifies the others about our timer value
+        scheduleTimerNotify();
+        result = writeDatagram(secureFrame.bytes().toByteArray(), egress);
+    } else {
+        result = writeDatagram(frame.bytes().toByteArray(), egress);
+    }
+
+    if (result) {
+        m_counters.add(Counter::Sent);
+        if (frame.serviceType() == QKnxNetIp::ServiceType::RoutingBusy)
+            m_counters.add(Counter::BusySent);
+    }
+    return result;
+}
+
+bool QKnxNetIpRouterPrivate::writeDatagram(const QByteArray &datagram,
+    const QNetworkInterface &egress)
+{
+    if (!m_socket || m_socket->state() != QAbstractSocket::BoundState)
+        return false;
+
+    const auto ifaces = egress.isValid() ? QList<QNetworkInterface> { egress } : interfaces();
+
+    // the socket's outgoing multicast interface only has to be switched if
+    // there is more than one interface to choose from
+    const bool switchInterface = m_ifaces.size() > 1;
+
+    bool result = true;
+    for (const auto &iface : ifaces) {
+        if (switchInterface)
+            m_socket->setMulticastInterface(iface);
+        for (const auto &group : qAsConst(m_multicastAddresses))
+            result = (m_socket->writeDatagram(datagram, group, m_multicastPort) != -1) && result;
+    }
+    return result;
+}
+
+void QKnxNetIpRouterPrivate::processSendQueue()
+{
+    // while slowing down after a busy neighbor, the pacer releases one frame per tick
+    int budget = (m_busyStage == BusyTimerStage::NotInit ? m_sendQueue.size() : 1);
+
+    Q_Q(QKnxNetIpRouter);
+    while (budget-- > 0 && m_state == QKnxNetIpRouter::State::Routing && !m_sendQueue.isEmpty()) {
+        const auto queued = m_sendQueue.dequeue();
+        if (!sendFrame(queued.frame, queued.egress)) {
+            errorOccurred(QKnxNetIpRouter::Error::KnxRouting, QKnxNetIpRouter::tr("Could not "
+                "send routing indication."));
+            return;
+        }
+        emit q->routingIndicationSent(queued.frame);
+    }
+}
+
+void QKnxNetIpRouterPrivate::queueRoutingIndication(const QKnxNetIpFrame &frame,
+    QKnxControlField::Priority priority, const QNetworkInterface &egress)
+{
+    // a full queue is expected while a neighbor is busy, report the drop but keep routing
+    Q_Q(QKnxNetIpRouter);
+    const auto dropped = m_sendQueue.dropped();
+    if (!m_sendQueue.enqueue(priority, { frame, egress })) {
+        emit q->errorOccurred(QKnxNetIpRouter::Error::KnxRouting, QKnxNetIpRouter::tr("Could "
+            "not queue routing indication, the send queue is full."));
+    } else if (m_sendQueue.dropped() != dropped) {
+        emit q->errorOccurred(QKnxNetIpRouter::Error::KnxRouting, QKnxNetIpRouter::tr("Dropped "
+            "a queued routing indication of lower priority, the send queue is full."));
+    }
+    processSendQueue();
 }
 
 void QKnxNetIpRouterPrivate::flowControlHandling(quint16 newBusyWaitTime)
@@ -359,6 +722,31 @@ void QKnxNetIpRouterPrivate::flowControlHandling(quint16 newBusyWaitTime)
     changeState(QKnxNetIpRouter::State::NeighborBusy);
 }
 
+int QKnxNetIpRouterPrivate::indexOfInterface(int interfaceIndex) const
+{
+    if (interfaceIndex <= 0)
+        return -1;
+
+    for (int i = 0; i < m_ifaces.size(); ++i) {
+        if (m_ifaces.at(i).index() == interfaceIndex)
+            return i;
+    }
+    return -1;
+}
+
+QList<QNetworkInterface> QKnxNetIpRouterPrivate::interfaces() const
+{
+    // a router on a simulated network is not bound to any network interface
+    if (m_ifaces.isEmpty())
+        return { QNetworkInterface() };
+    return m_ifaces;
+}
+
+bool QKnxNetIpRouterPrivate::isValidInterface(const QNetworkInterface &iface) const
+{
+    return iface.isValid() && iface.flags().testFlag(QNetworkInterface::IsRunning);
+}
+
 QKnxNetIpRouter::FilterAction
     QKnxNetIpRouterPrivate::filterAction(const QKnxLinkLayerFrame &frame)
 {
@@ -41,12 +41,21 @@
 // We mean it.
 //
 
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qset.h>
 #include <QtCore/qtimer.h>
 #include <QtCore/private/qobject_p.h>
 
 #include <QtKnx/qknxnetip.h>
 #include <QtKnx/qknxnetipframe.h>
 #include <QtKnx/qknxnetiprouter.h>
+#include <QtKnx/private/qknxccmcontext_p.h>
+#include <QtKnx/private/qknxnetipdatagramsocket_p.h>
+#include <QtKnx/private/qknxnetiprouterstatistics_p.h>
+#include <QtKnx/private/qknxnetipsendqueue_p.h>
+#include <QtKnx/private/qknxsequencenumberstore_p.h>
 
 #include <QtNetwork/qnetworkdatagram.h>
 #include <QtNetwork/qnetworkinterface.h>
@@ -54,6 +63,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QKnxNetIpSimulatedNetwork;
+
 class QKnxNetIpRouterPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QKnxNetIpRouter)
@@ -67,12 +78,39 @@ public:
 
     void cleanup();
 
-    void processRoutingIndication(const QKnxNetIpFrame &frame);
+    void processRoutingIndication(const QKnxNetIpFrame &frame,
+                                  const QNetworkInterface &ingress = {});
     void processRoutingBusy(const QKnxNetIpFrame &frame);
     void processRoutingLostMessage(const QKnxNetIpFrame &frame);
     void processRoutingSystemBroadcast(const QKnxNetIpFrame &frame);
 
-    bool sendFrame(const QKnxNetIpFrame &frame);
+    void processFrame(const QKnxNetIpFrame &frame, const QNetworkInterface &ingress);
+    void processSecureWrappers(const QVector<QKnxNetIpFrame> &frames,
+        const QVector<QNetworkInterface> &ingresses);
+    void processTimerNotify(const QKnxNetIpFrame &frame);
+
+    bool sendFrame(const QKnxNetIpFrame &frame, const QNetworkInterface &egress = {});
+    bool writeDatagram(const QByteArray &datagram, const QNetworkInterface &egress = {});
+    void processSendQueue();
+    void queueRoutingIndication(const QKnxNetIpFrame &frame, QKnxControlField::Priority priority,
+        const QNetworkInterface &egress);
+
+    bool isSecure() const { return m_backbone.isValid(); }
+    quint48 timerValue() const;
+    void setTimerValue(quint48 value);
+    bool checkTimerValue(quint48 received, const QKnxByteArray &serialNumber, quint16 messageTag);
+    quint16 syncLatencyTolerance() const { return qMax<quint16>(m_latencyTolerance / 10, 1); }
+
+    void startTimerSynchronization();
+    void scheduleTimerNotify();
+    void scheduleTimerUpdate(const QKnxByteArray &serialNumber, quint16 messageTag);
+    void sendTimerNotify(const QKnxByteArray &serialNumber, quint16 messageTag);
+    void restoreTimerValue();
+    void persistTimerValue();
+
+    int indexOfInterface(int interfaceIndex) const;
+    QList<QNetworkInterface> interfaces() const;
+    bool isValidInterface(const QNetworkInterface &iface) const;
 
     void flowControlHandling(quint16 newBusyWaitTime);
 
@@ -81,7 +119,9 @@ public:
 
     QKnxNetIpRouter::FilterAction filterAction(const QKnxLinkLayerFrame &frame);
 
-    QUdpSocket *m_socket { nullptr };
+    QKnxNetIpDatagramSocket *m_socket { nullptr };
+    QPointer<QKnxNetIpSimulatedNetwork> m_network;
+    QHostAddress m_networkAddress;
 
     QKnxAddress m_individualAddress;
 
@@ -89,10 +129,12 @@ public:
     QKnxAddress m_lastIndicationAddress;
     quint16 m_sameKnxDstAddressIndicationCount;
 
-    QNetworkInterface m_iface;
-    QHostAddress m_multicastAddress { QLatin1String(QKnxNetIp::Constants::MulticastAddress) };
+    QList<QNetworkInterface> m_ifaces;
+    QList<QHostAddress> m_multicastAddresses {
+        QHostAddress(QLatin1String(QKnxNetIp::Constants::MulticastAddress))
+    };
     quint16 m_multicastPort { QKnxNetIp::Constants::DefaultPort };
-    QHostAddress m_ownAddress;
+    QSet<QHostAddress> m_ownAddresses;
 
     QKnxNetIpRouter::State m_state { QKnxNetIpRouter::State::NotInit };
 
@@ -110,11 +152,35 @@ public:
     BusyTimerStage m_busyStage { BusyTimerStage::NotInit };
     quint32 m_busyCounter { 0 };
 
+    struct QueuedFrame
+    {
+        QKnxNetIpFrame frame;
+        QNetworkInterface egress;
+    };
+    QKnxNetIpSendQueue<QueuedFrame> m_sendQueue;
+
     QKnxNetIpRouter::Error m_error { QKnxNetIpRouter::Error::None };
     QString m_errorMessage;
 
+    using Counter = QKnxNetIpRouterCounters::Counter;
+    QKnxNetIpRouterCounters m_counters;
+
     QKnxNetIpRouter::KnxAddressWhitelist m_filterTable;
     QKnxNetIpRouter::RoutingMode m_routingMode { QKnxNetIpRouter::RoutingMode::Block };
+
+    QKnxCcmContext m_backbone;
+    QKnxByteArray m_serialNumber { 6, 0x00 };
+    quint16 m_latencyTolerance { 2000 };
+
+    // multicast timer, the current value is m_timerOffset + m_timerClock.elapsed()
+    QElapsedTimer m_timerClock;
+    qint64 m_timerOffset { 0 };
+
+    QTimer *m_timerNotifyTimer { nullptr };
+    QTimer *m_timerUpdateTimer { nullptr };
+    QScopedPointer<QKnxSequenceNumberStore> m_timerStore;
+    QKnxByteArray m_updateSerialNumber;
+    quint16 m_updateMessageTag { 0 };
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,396 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetiprouterstatistics.h"
+#include "qknxnetiprouterstatistics_p.h"
+
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+namespace QKnxPrivate
+{
+    static const int BucketBounds[QKnxNetIpRouterStatisticsPrivate::BucketCount - 1] {
+        1, 2, 5, 10, 20, 50, 100, 200, 500, 1000
+    };
+
+    static int bucketOf(qint64 interArrival)
+    {
+        for (int i = 0; i < QKnxNetIpRouterStatisticsPrivate::BucketCount - 1; ++i) {
+            if (interArrival < BucketBounds[i])
+                return i;
+        }
+        return QKnxNetIpRouterStatisticsPrivate::BucketCount - 1;
+    }
+}
+
+/*!
+    \class QKnxNetIpRouterStatistics
+
+    \inmodule QtKnx
+    \ingroup qtknx-routing
+    \ingroup qtknx-netip
+    \since 5.15
+
+    \brief The QKnxNetIpRouterStatistics class holds a snapshot of the traffic
+    counters of a QKnxNetIpRouter.
+
+    The counters tell where routing frames are lost: on the network, in the
+    routing filter, in the flow control, or in the application. A snapshot is
+    taken with QKnxNetIpRouter::statistics(), which may be called from any
+    thread without blocking the router.
+
+    In addition to the global counters, the snapshot contains the number of
+    frames, the average frame rate, and a histogram of inter-arrival times for
+    each source IP address the router received frames from. Up to 64 source
+    addresses are tracked.
+
+    \code
+        QKnxNetIpRouter router;
+        router.start();
+        ...
+        const auto statistics = router.statistics();
+        qInfo() << "Received:" << statistics.framesReceived()
+                << "filtered:" << statistics.framesFiltered()
+                << "malformed:" << statistics.framesDiscardedMalformed();
+
+        const auto bounds = QKnxNetIpRouterStatistics::interArrivalBucketBounds();
+        for (const auto &peer : statistics.peers()) {
+            qInfo() << peer << statistics.framesPerSecond(peer) << "frames/s";
+            const auto histogram = statistics.interArrivalHistogram(peer);
+            for (int i = 0; i < histogram.size(); ++i)
+                qInfo() << "  <" << bounds.value(i, -1) << "ms:" << histogram.at(i);
+        }
+    \endcode
+*/
+
+/*!
+    Constructs an empty statistics object with all counters set to \c 0.
+*/
+QKnxNetIpRouterStatistics::QKnxNetIpRouterStatistics()
+    : d_ptr(new QKnxNetIpRouterStatisticsPrivate)
+{}
+
+/*!
+    Destroys the statistics object.
+*/
+QKnxNetIpRouterStatistics::~QKnxNetIpRouterStatistics() = default;
+
+/*!
+    Returns the number of datagrams with a valid KNXnet/IP header received from
+    other devices, including frames that were filtered or discarded afterwards.
+*/
+quint64 QKnxNetIpRouterStatistics::framesReceived() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::Received];
+}
+
+/*!
+    Returns the number of frames successfully sent to the network.
+*/
+quint64 QKnxNetIpRouterStatistics::framesSent() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::Sent];
+}
+
+/*!
+    Returns the number of routing indications the routing filter decided to
+    ignore.
+
+    \sa QKnxNetIpRouter::FilterAction
+*/
+quint64 QKnxNetIpRouterStatistics::framesFiltered() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::Filtered];
+}
+
+/*!
+    Returns the number of datagrams discarded because they did not contain a
+    well-formed KNXnet/IP routing frame.
+*/
+quint64 QKnxNetIpRouterStatistics::framesDiscardedMalformed() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::DiscardedMalformed];
+}
+
+/*!
+    Returns the number of datagrams discarded because they were sent by the
+    router itself and looped back by the network.
+*/
+quint64 QKnxNetIpRouterStatistics::framesDiscardedOwn() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::DiscardedOwn];
+}
+
+/*!
+    Returns the number of datagrams discarded because the incoming queue was
+    full and the router signaled busy.
+*/
+quint64 QKnxNetIpRouterStatistics::framesDiscardedQueueFull() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::DiscardedQueueFull];
+}
+
+/*!
+    Returns the number of frames discarded on a secured backbone, either
+    because they were not authenticated or because their timer value was
+    outdated.
+*/
+quint64 QKnxNetIpRouterStatistics::framesDiscardedSecurity() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::DiscardedSecurity];
+}
+
+/*!
+    Returns the number of routing busy frames received.
+*/
+quint64 QKnxNetIpRouterStatistics::routingBusyReceived() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::BusyReceived];
+}
+
+/*!
+    Returns the number of routing busy frames sent.
+*/
+quint64 QKnxNetIpRouterStatistics::routingBusySent() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::BusySent];
+}
+
+/*!
+    Returns the sum of the lost message counts reported by other devices
+    through routing lost message frames.
+*/
+quint64 QKnxNetIpRouterStatistics::lostMessages() const
+{
+    return d_ptr->counters[QKnxNetIpRouterStatisticsPrivate::LostMessages];
+}
+
+/*!
+    Returns the source IP addresses the router received frames from.
+*/
+QList<QHostAddress> QKnxNetIpRouterStatistics::peers() const
+{
+    QList<QHostAddress> peers;
+    for (auto it = d_ptr->peers.constBegin(); it != d_ptr->peers.constEnd(); ++it)
+        peers.append(QHostAddress(it.key()));
+    return peers;
+}
+
+/*!
+    Returns the number of frames received from the source address \a peer.
+*/
+quint64 QKnxNetIpRouterStatistics::framesReceived(const QHostAddress &peer) const
+{
+    return d_ptr->peers.value(peer.toIPv4Address()).frames;
+}
+
+/*!
+    Returns the average number of frames per second received from the source
+    address \a peer between its first and its last frame.
+*/
+qreal QKnxNetIpRouterStatistics::framesPerSecond(const QHostAddress &peer) const
+{
+    const auto it = d_ptr->peers.constFind(peer.toIPv4Address());
+    if (it == d_ptr->peers.constEnd() || it->frames < 2)
+        return 0.;
+
+    const auto duration = qMax<qint64>(it->lastArrival - it->firstArrival, 1);
+    return qreal(it->frames - 1) * 1000. / qreal(duration);
+}
+
+/*!
+    Returns the histogram of the times between two consecutive frames received
+    from the source address \a peer. The bucket boundaries are returned by
+    interArrivalBucketBounds().
+*/
+QVector<quint64> QKnxNetIpRouterStatistics::interArrivalHistogram(const QHostAddress &peer) const
+{
+    const auto it = d_ptr->peers.constFind(peer.toIPv4Address());
+    if (it == d_ptr->peers.constEnd())
+        return QVector<quint64>(QKnxNetIpRouterStatisticsPrivate::BucketCount, 0);
+    return it->histogram;
+}
+
+/*!
+    Returns the exclusive upper bounds in milliseconds of the inter-arrival
+    histogram buckets. The histogram has one more bucket than bounds, the last
+    bucket counts all times of at least the last bound.
+*/
+QVector<int> QKnxNetIpRouterStatistics::interArrivalBucketBounds()
+{
+    return QVector<int>(std::begin(QKnxPrivate::BucketBounds),
+        std::end(QKnxPrivate::BucketBounds));
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QKnxNetIpRouterStatistics::QKnxNetIpRouterStatistics(const QKnxNetIpRouterStatistics &other)
+    : d_ptr(other.d_ptr)
+{}
+
+/*!
+    Assigns \a other to this object.
+*/
+QKnxNetIpRouterStatistics &
+    QKnxNetIpRouterStatistics::operator=(const QKnxNetIpRouterStatistics &other)
+{
+    d_ptr = other.d_ptr;
+    return *this;
+}
+
+/*!
+    Move-constructs an object instance, making it point to the same object that
+    \a other was pointing to.
+*/
+QKnxNetIpRouterStatistics::QKnxNetIpRouterStatistics(QKnxNetIpRouterStatistics &&other)
+    Q_DECL_NOTHROW
+    : d_ptr(other.d_ptr)
+{
+    other.d_ptr = nullptr;
+}
+
+/*!
+    Move-assigns \a other to this object instance.
+*/
+QKnxNetIpRouterStatistics &
+    QKnxNetIpRouterStatistics::operator=(QKnxNetIpRouterStatistics &&other) Q_DECL_NOTHROW
+{
+    swap(other);
+    return *this;
+}
+
+/*!
+    Swaps \a other with this object. This operation is very fast and never
+    fails.
+*/
+void QKnxNetIpRouterStatistics::swap(QKnxNetIpRouterStatistics &other) Q_DECL_NOTHROW
+{
+    d_ptr.swap(other.d_ptr);
+}
+
+/*!
+    \internal
+    \class QKnxNetIpRouterCounters
+
+    Holds the live counters of a router. Only the router thread writes to the
+    counters, but every field is atomic so that snapshot() can be called from
+    any thread without a lock.
+*/
+QKnxNetIpRouterCounters::QKnxNetIpRouterCounters()
+{
+    m_clock.start();
+}
+
+/*!
+    \internal
+
+    Records the arrival of a frame from \a sender in the per peer counters.
+*/
+void QKnxNetIpRouterCounters::frameArrived(const QHostAddress &sender)
+{
+    const quint32 address = sender.toIPv4Address();
+    if (address == 0)
+        return;
+
+    // open addressing with linear probing, slots are claimed and never released
+    Peer *peer = nullptr;
+    const int start = int(qHash(address) % MaxPeers);
+    for (int i = 0; i < MaxPeers && !peer; ++i) {
+        auto &slot = m_peers[(start + i) % MaxPeers];
+        const auto current = slot.address.loadAcquire();
+        if (current == address || (current == 0
+            && (slot.address.testAndSetOrdered(0, address) || slot.address.loadAcquire() == address))) {
+            peer = &slot;
+        }
+    }
+    if (!peer)
+        return; // table full, only the global counters are updated
+
+    const qint64 now = m_clock.elapsed();
+    const auto last = peer->lastArrival.fetchAndStoreRelaxed(now);
+    if (peer->frames.fetchAndAddRelaxed(1) == 0)
+        peer->firstArrival.storeRelease(now);
+    else
+        peer->histogram[QKnxPrivate::bucketOf(now - last)].fetchAndAddRelaxed(1);
+}
+
+/*!
+    \internal
+
+    Returns a snapshot of the current counter values. Counters are read one by
+    one, so the snapshot might be off by the frames processed while it is taken.
+*/
+QKnxNetIpRouterStatistics QKnxNetIpRouterCounters::snapshot() const
+{
+    QKnxNetIpRouterStatistics statistics;
+    auto d = statistics.d_ptr.data();
+    for (int i = 0; i < QKnxNetIpRouterStatisticsPrivate::CounterCount; ++i)
+        d->counters[i] = m_counters[i].loadAcquire();
+
+    for (const auto &slot : m_peers) {
+        const auto address = slot.address.loadAcquire();
+        const auto frames = slot.frames.loadAcquire();
+        if (address == 0 || frames == 0)
+            continue;
+
+        QKnxNetIpRouterStatisticsPrivate::Peer peer;
+        peer.frames = frames;
+        peer.firstArrival = slot.firstArrival.loadAcquire();
+        peer.lastArrival = slot.lastArrival.loadAcquire();
+        peer.histogram.reserve(QKnxNetIpRouterStatisticsPrivate::BucketCount);
+        for (const auto &bucket : slot.histogram)
+            peer.histogram.append(bucket.loadAcquire());
+        d->peers.insert(address, peer);
+    }
+    return statistics;
+}
+
+/*!
+    \internal
+
+    Sets all counters to \c 0 and forgets about all peers.
+*/
+void QKnxNetIpRouterCounters::reset()
+{
+    for (auto &counter : m_counters)
+        counter.storeRelease(0);
+
+    for (auto &slot : m_peers) {
+        slot.frames.storeRelease(0);
+        slot.firstArrival.storeRelease(0);
+        slot.lastArrival.storeRelease(0);
+        for (auto &bucket : slot.histogram)
+            bucket.storeRelease(0);
+        slot.address.storeRelease(0);
+    }
+}
+
+QT_END_NAMESPACE
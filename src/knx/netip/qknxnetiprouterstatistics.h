@@ -0,0 +1,85 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPROUTERSTATISTICS_H
+#define QKNXNETIPROUTERSTATISTICS_H
+
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
+
+#include <QtKnx/qtknxglobal.h>
+
+#include <QtNetwork/qhostaddress.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpRouterStatisticsPrivate;
+class Q_KNX_EXPORT QKnxNetIpRouterStatistics final
+{
+    friend class QKnxNetIpRouterCounters;
+
+public:
+    QKnxNetIpRouterStatistics();
+    ~QKnxNetIpRouterStatistics();
+
+    quint64 framesReceived() const;
+    quint64 framesSent() const;
+    quint64 framesFiltered() const;
+
+    quint64 framesDiscardedMalformed() const;
+    quint64 framesDiscardedOwn() const;
+    quint64 framesDiscardedQueueFull() const;
+    quint64 framesDiscardedSecurity() const;
+
+    quint64 routingBusyReceived() const;
+    quint64 routingBusySent() const;
+    quint64 lostMessages() const;
+
+    QList<QHostAddress> peers() const;
+    quint64 framesReceived(const QHostAddress &peer) const;
+    qreal framesPerSecond(const QHostAddress &peer) const;
+    QVector<quint64> interArrivalHistogram(const QHostAddress &peer) const;
+
+    static QVector<int> interArrivalBucketBounds();
+
+    QKnxNetIpRouterStatistics(const QKnxNetIpRouterStatistics &other);
+    QKnxNetIpRouterStatistics &operator=(const QKnxNetIpRouterStatistics &other);
+
+    QKnxNetIpRouterStatistics(QKnxNetIpRouterStatistics &&other) Q_DECL_NOTHROW;
+    QKnxNetIpRouterStatistics &operator=(QKnxNetIpRouterStatistics &&other) Q_DECL_NOTHROW;
+
+    void swap(QKnxNetIpRouterStatistics &other) Q_DECL_NOTHROW;
+
+private:
+    QSharedDataPointer<QKnxNetIpRouterStatisticsPrivate> d_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,125 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPROUTERSTATISTICS_P_H
+#define QKNXNETIPROUTERSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qshareddata.h>
+
+#include <QtKnx/qknxnetiprouterstatistics.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpRouterStatisticsPrivate final : public QSharedData
+{
+public:
+    QKnxNetIpRouterStatisticsPrivate() = default;
+    ~QKnxNetIpRouterStatisticsPrivate() = default;
+
+    enum Counter
+    {
+        Received,
+        Sent,
+        Filtered,
+        DiscardedMalformed,
+        DiscardedOwn,
+        DiscardedQueueFull,
+        DiscardedSecurity,
+        BusyReceived,
+        BusySent,
+        LostMessages,
+        CounterCount
+    };
+
+    // see QKnxNetIpRouterStatistics::interArrivalBucketBounds()
+    enum { BucketCount = 11 };
+
+    struct Peer
+    {
+        quint64 frames { 0 };
+        qint64 firstArrival { 0 };
+        qint64 lastArrival { 0 };
+        QVector<quint64> histogram;
+    };
+
+    quint64 counters[CounterCount] { 0 };
+    QHash<quint32, Peer> peers;
+};
+
+// Live counters updated by the router on its own thread. Every field is an
+// atomic, so a snapshot can be taken from any thread without a lock.
+class Q_KNX_EXPORT QKnxNetIpRouterCounters final
+{
+public:
+    using Counter = QKnxNetIpRouterStatisticsPrivate::Counter;
+    enum { MaxPeers = 64 };
+
+    QKnxNetIpRouterCounters();
+
+    void add(Counter counter, quint64 value = 1)
+    {
+        m_counters[counter].fetchAndAddRelaxed(value);
+    }
+    void frameArrived(const QHostAddress &sender);
+
+    QKnxNetIpRouterStatistics snapshot() const;
+    void reset();
+
+private:
+    struct Peer
+    {
+        QAtomicInteger<quint32> address; // IPv4 address, 0 marks an unused slot
+        QAtomicInteger<quint64> frames;
+        QAtomicInteger<qint64> firstArrival;
+        QAtomicInteger<qint64> lastArrival;
+        QAtomicInteger<quint64> histogram[QKnxNetIpRouterStatisticsPrivate::BucketCount];
+    };
+
+    QElapsedTimer m_clock;
+    QAtomicInteger<quint64> m_counters[QKnxNetIpRouterStatisticsPrivate::CounterCount];
+    Peer m_peers[MaxPeers];
+};
+
+QT_END_NAMESPACE
+
+#endif
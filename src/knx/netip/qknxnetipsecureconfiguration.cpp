@@ -29,12 +29,14 @@
 
 #include "qknxcryptographicengine.h"
 #include "qknxnetipsecureconfiguration.h"
-
-#include <QtCore/qfile.h>
+#include "qknxutils.h"
 
 #include "private/qknxkeyring_p.h"
+#include "private/qknxkeyringstore_p.h"
 #include "private/qknxnetipsecureconfiguration_p.h"
 
+#include <QtCore/qthreadpool.h>
+
 QT_BEGIN_NAMESPACE
 
 namespace QKnxPrivate
@@ -70,64 +72,53 @@ namespace QKnxPrivate
     }
 
     static QVector<QKnxNetIpSecureConfiguration> fromKeyring(QKnxNetIpSecureConfiguration::Type type,
-        const QKnxAddress &ia, const QString &filePath, const QByteArray &password, bool validate)
+        const QVector<QKnxAddress> &ias, const QString &filePath, const QByteArray &password,
+        bool validate)
     {
-        QFile file;
-        file.setFileName(filePath);
-        if (!file.open(QIODevice::ReadOnly))
-            return {};
-
-        QXmlStreamReader reader(&file);
         QKnx::Ets::Keyring::QKnxKeyring keyring;
-
         const auto pwHash = QKnxCryptographicEngine::keyringPasswordHash(password);
-        if (validate) {
-            if (!keyring.validate(&reader, pwHash))
-                return {};
-            file.seek(0);
-            reader.setDevice(&file);
-        }
-
-        if (!keyring.parseElement(&reader, true))
+        if (!keyring.load(filePath, pwHash, validate))
             return {};
         const auto createdHash = QKnxCryptographicEngine::hashSha256(keyring.Created.toUtf8());
 
-        auto iaString = ia.toString();
-        QVector<QKnxNetIpSecureConfiguration> results;
+        if (type == QKnxNetIpSecureConfiguration::Type::Tunneling && keyring.Interface.isEmpty())
+            return {};
+        if (type == QKnxNetIpSecureConfiguration::Type::DeviceManagement && keyring.Devices.isEmpty())
+            return {};
 
-        if (type == QKnxNetIpSecureConfiguration::Type::Tunneling) {
-            if (keyring.Interface.isEmpty())
-                return {};
-
-            if (!iaString.isEmpty()) { // only a single interface is requested
-                for (const auto iface : qAsConst(keyring.Interface)) {
-                    if (iaString != iface.IndividualAddress)
-                        continue;
-                    return { QKnxPrivate::fromInterface(iface, pwHash, createdHash) };
-                }
-            } else {
-                for (const auto iface : qAsConst(keyring.Interface))
+        // an empty list requests all entries, otherwise the result matches the request order
+        QVector<QKnxNetIpSecureConfiguration> results;
+        if (ias.isEmpty()) {
+            if (type == QKnxNetIpSecureConfiguration::Type::Tunneling) {
+                for (const auto &iface : qAsConst(keyring.Interface))
                     results.append(QKnxPrivate::fromInterface(iface, pwHash, createdHash));
+            } else if (type == QKnxNetIpSecureConfiguration::Type::DeviceManagement) {
+                const auto devices = keyring.Devices.value(0).Device;
+                for (const auto &device : devices)
+                    results.append(QKnxPrivate::fromDevice(device, pwHash, createdHash));
             }
+            return results;
         }
 
-        if (type == QKnxNetIpSecureConfiguration::Type::DeviceManagement) {
-            if (keyring.Devices.isEmpty())
-                return {};
-
-            const auto devices = keyring.Devices.value(0).Device;
-            if (!iaString.isEmpty()) { // only a single device is requested
-                for (const auto device : devices) {
-                    if (iaString != device.IndividualAddress)
-                        continue;
-                    return { QKnxPrivate::fromDevice(device, pwHash, createdHash) };
-                }
-            } else {
-                for (const auto device : devices)
-                    results.append(QKnxPrivate::fromDevice(device, pwHash, createdHash));
+        QKnxKeyringStore store;
+        if (!store.load(keyring, pwHash))
+            return {};
+
+        results.resize(ias.size());
+        for (int i = 0; i < ias.size(); ++i) {
+            const auto &ia = ias.at(i);
+            if (ia.type() != QKnxAddress::Type::Individual || !ia.isValid())
+                continue;
+            const auto address = QKnxUtils::QUint16::fromBytes(ia.bytes());
+
+            if (type == QKnxNetIpSecureConfiguration::Type::Tunneling) {
+                if (const auto iface = store.findInterface(address))
+                    results[i] = QKnxPrivate::fromInterface(*iface, pwHash, createdHash);
+            } else if (type == QKnxNetIpSecureConfiguration::Type::DeviceManagement) {
+                if (const auto device = store.findDevice(address))
+                    results[i] = QKnxPrivate::fromDevice(*device, pwHash, createdHash);
             }
         }
-
         return results;
     }
 }
@@ -192,6 +183,34 @@ QVector<QKnxNetIpSecureConfiguration> QKnxNetIpSecureConfiguration::fromKeyring(
     return QKnxPrivate::fromKeyring(type, {}, keyring, password, validate);
 }
 
+/*!
+    \since 5.15
+
+    Constructs a vector of secure configurations for the given type \a type
+    and each of the individual addresses \a ias from an ETS exported
+    \a keyring (*.knxkeys) file that was encrypted with the given password
+    \a password. Set the \a validate argument to \c true to verify that all
+    data in the keyring file is trustworthy, \c false to omit the check.
+
+    The keyring file is read, validated and decrypted only once for all
+    requested addresses, which makes this function the preferred way to set
+    up several secure connections at once. The returned vector has the same
+    size and order as \a ias, with an invalid configuration at the position
+    of each address that was not found.
+
+    \note If an error occurred, the returned vector is empty.
+
+    \sa precomputePasswordHashes()
+*/
+QVector<QKnxNetIpSecureConfiguration> QKnxNetIpSecureConfiguration::fromKeyring(Type type,
+    const QVector<QKnxAddress> &ias, const QString &keyring, const QByteArray &password,
+    bool validate)
+{
+    if (ias.isEmpty())
+        return {};
+    return QKnxPrivate::fromKeyring(type, ias, keyring, password, validate);
+}
+
 /*!
     Constructs a secure configurations for the given type \a type and the
     given individual address \a ia from an ETS exported \a keyring (*.knxkeys)
@@ -206,7 +225,9 @@ QVector<QKnxNetIpSecureConfiguration> QKnxNetIpSecureConfiguration::fromKeyring(
 QKnxNetIpSecureConfiguration QKnxNetIpSecureConfiguration::fromKeyring(QKnxNetIpSecureConfiguration::Type type,
     const QKnxAddress &ia, const QString &keyring, const QByteArray &password, bool validate)
 {
-    return QKnxPrivate::fromKeyring(type, ia, keyring, password, validate).value(0, {});
+    if (!ia.isValid())
+        return QKnxPrivate::fromKeyring(type, {}, keyring, password, validate).value(0, {});
+    return QKnxPrivate::fromKeyring(type, { ia }, keyring, password, validate).value(0, {});
 }
 
 /*!
@@ -380,6 +401,36 @@ bool QKnxNetIpSecureConfiguration::setDeviceAuthenticationCode(const QByteArray
     return valid;
 }
 
+/*!
+    \since 5.15
+
+    Starts deriving the user password hash and the device authentication code
+    hash of this configuration on the global thread pool and returns
+    immediately.
+
+    Both hashes are needed to establish a secure session and are expensive to
+    compute. Once derived, they are taken from the password hash cache of
+    QKnxCryptographicEngine, so calling this function early, for example for
+    all configurations returned by fromKeyring(), shortens the connection
+    setup considerably.
+
+    \sa QKnxCryptographicEngine::setPasswordHashCacheCapacity()
+*/
+void QKnxNetIpSecureConfiguration::precomputePasswordHashes() const
+{
+    const auto userPassword = d->userPassword;
+    const auto authenticationCode = d->deviceAuthenticationCode;
+    if (userPassword.isEmpty() && authenticationCode.isEmpty())
+        return;
+
+    QThreadPool::globalInstance()->start([userPassword, authenticationCode]() {
+        if (!userPassword.isEmpty())
+            QKnxCryptographicEngine::userPasswordHash(userPassword);
+        if (!authenticationCode.isEmpty())
+            QKnxCryptographicEngine::deviceAuthenticationCodeHash(authenticationCode);
+    });
+}
+
 /*!
     Returns \c true if the keep alive flag is set; \c false otherwise. By
     default this is set to \c false.
@@ -57,6 +57,10 @@ public:
     static QKnxNetIpSecureConfiguration fromKeyring(QKnxNetIpSecureConfiguration::Type type,
         const QKnxAddress &ia, const QString &keyring, const QByteArray &password, bool validate);
 
+    static QVector<QKnxNetIpSecureConfiguration> fromKeyring(QKnxNetIpSecureConfiguration::Type type,
+        const QVector<QKnxAddress> &ias, const QString &keyring, const QByteArray &password,
+        bool validate);
+
     bool isNull() const;
     bool isValid() const;
 
@@ -83,6 +87,8 @@ public:
     bool isSecureSessionKeepAliveSet() const;
     void setKeepSecureSessionAlive(bool keepAlive);
 
+    void precomputePasswordHashes() const;
+
     QKnxNetIpSecureConfiguration(const QKnxNetIpSecureConfiguration &other);
     QKnxNetIpSecureConfiguration &operator=(const QKnxNetIpSecureConfiguration &other);
 
@@ -0,0 +1,156 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxcryptographicengine.h"
+#include "qknxnetipsecurehandshake_p.h"
+#include "qknxnetipsessionauthenticate.h"
+#include "qknxnetipsessionresponse.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QKnxNetIpSecureHandshake
+
+    Runs the expensive part of a secure session handshake on the global thread
+    pool: the verification of the session response, the X25519 key agreement,
+    and the creation of the session authenticate frame, which needs the user
+    password hash. The result is delivered through finished() on the thread
+    the object lives in, so the protocol thread only waits for the network.
+*/
+
+struct QKnxNetIpSecureHandshake::Shared
+{
+    QMutex mutex;
+    QKnxNetIpSecureHandshake *receiver { nullptr };
+};
+
+QKnxNetIpSecureHandshake::QKnxNetIpSecureHandshake(QObject *parent)
+    : QObject(parent)
+    , m_shared(new Shared)
+{
+    m_shared->receiver = this;
+}
+
+QKnxNetIpSecureHandshake::~QKnxNetIpSecureHandshake()
+{
+    // a running job must not post its result to a destroyed object
+    const QMutexLocker locker(&m_shared->mutex);
+    m_shared->receiver = nullptr;
+}
+
+/*!
+    Verifies the message authentication code of \a sessionResponse with the
+    device authentication code of \a config and derives the session key. On
+    success, the returned result also contains the not yet wrapped session
+    authenticate frame; otherwise an invalid result is returned.
+
+    This function is thread-safe.
+*/
+QKnxNetIpSecureHandshake::Result QKnxNetIpSecureHandshake::process(
+    const QKnxNetIpSecureConfiguration &config, const QKnxNetIpFrame &sessionResponse)
+{
+    const QKnxNetIpSessionResponseProxy proxy(sessionResponse);
+    if (!proxy.isValid())
+        return {};
+
+    const auto publicKey = config.publicKey().bytes();
+    const auto authHash = QKnxCryptographicEngine::deviceAuthenticationCodeHash(config
+        .deviceAuthenticationCode());
+    const auto xorX_Y = QKnxCryptographicEngine::XOR(publicKey, proxy.publicKey());
+
+    const auto mac = QKnxCryptographicEngine::computeMessageAuthenticationCode(authHash,
+        sessionResponse.header(), proxy.secureSessionId(), xorX_Y);
+    const auto decMac = QKnxCryptographicEngine::decryptMessageAuthenticationCode(authHash,
+        proxy.messageAuthenticationCode());
+    if (mac.isEmpty() || decMac != mac)
+        return {}; // MAC could not be verified, bail out
+
+    Result result;
+    result.sessionId = proxy.secureSessionId();
+    result.sessionKey = QKnxCryptographicEngine::sessionKey(config.privateKey(),
+        QKnxSecureKey::fromBytes(QKnxSecureKey::Type::Public, proxy.publicKey()));
+    result.sessionAuthenticate = QKnxNetIpSessionAuthenticateProxy::secureBuilder()
+        .setUserId(config.userId())
+        .create(config.userPassword(), publicKey, proxy.publicKey());
+    return result;
+}
+
+/*!
+    Returns \c true if a handshake step is computed in the background;
+    otherwise returns \c false.
+*/
+bool QKnxNetIpSecureHandshake::isRunning() const
+{
+    return m_running;
+}
+
+/*!
+    Starts processing \a sessionResponse with \a config on the global thread
+    pool and returns immediately. A result of a previously started step is
+    discarded.
+*/
+void QKnxNetIpSecureHandshake::start(const QKnxNetIpSecureConfiguration &config,
+    const QKnxNetIpFrame &sessionResponse)
+{
+    m_running = true;
+    const auto generation = ++m_generation;
+
+    const auto shared = m_shared;
+    QThreadPool::globalInstance()->start([shared, generation, config, sessionResponse]() {
+        const auto result = QKnxNetIpSecureHandshake::process(config, sessionResponse);
+
+        const QMutexLocker locker(&shared->mutex);
+        if (!shared->receiver)
+            return;
+
+        // the call is dropped together with its posted event if the receiver gets destroyed
+        const auto receiver = shared->receiver;
+        QMetaObject::invokeMethod(receiver, [receiver, generation, result]() {
+            if (receiver->m_generation != generation)
+                return; // canceled or restarted in the meantime
+            receiver->m_running = false;
+            emit receiver->finished(result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/*!
+    Discards the result of a running handshake step.
+*/
+void QKnxNetIpSecureHandshake::cancel()
+{
+    ++m_generation;
+    m_running = false;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,89 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPSECUREHANDSHAKE_P_H
+#define QKNXNETIPSECUREHANDSHAKE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qobject.h>
+#include <QtCore/qsharedpointer.h>
+
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qknxnetipsecureconfiguration.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxNetIpSecureHandshake final : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Result final
+    {
+        bool isValid() const { return !sessionKey.isEmpty() && sessionAuthenticate.isValid(); }
+
+        quint16 sessionId { 0 };
+        QKnxByteArray sessionKey;
+        QKnxNetIpFrame sessionAuthenticate;
+    };
+
+    explicit QKnxNetIpSecureHandshake(QObject *parent = nullptr);
+    ~QKnxNetIpSecureHandshake() override;
+
+    static Result process(const QKnxNetIpSecureConfiguration &config,
+        const QKnxNetIpFrame &sessionResponse);
+
+    bool isRunning() const;
+    void start(const QKnxNetIpSecureConfiguration &config, const QKnxNetIpFrame &sessionResponse);
+    void cancel();
+
+Q_SIGNALS:
+    void finished(const QKnxNetIpSecureHandshake::Result &result);
+
+private:
+    struct Shared;
+    QSharedPointer<Shared> m_shared;
+    quint32 m_generation { 0 };
+    bool m_running { false };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,635 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetipconnectionstateresponse.h"
+#include "qknxnetipdisconnectrequest.h"
+#include "qknxnetipdisconnectresponse.h"
+#include "qknxnetipendpointconnection_p.h"
+#include "qknxnetipsecuretransport.h"
+#include "qknxnetipsecuretransport_p.h"
+#include "qknxnetipsecurewrapper.h"
+#include "qknxnetipsessionrequest.h"
+#include "qknxnetipsessionstatus.h"
+#include "qtcpsocket.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \since 5.15
+    \inmodule QtKnx
+
+    \class QKnxNetIpSecureTransport
+    \ingroup qtknx-netip
+
+    \brief The QKnxNetIpSecureTransport class shares one TCP connection and
+    its secure sessions between several KNXnet/IP secure tunneling and device
+    management connections.
+
+    KNXnet/IP secure servers support several secure sessions on one TCP
+    connection, and several tunneling connections inside one secure session.
+    Each QKnxNetIpTunnel or QKnxNetIpDeviceManagement object that is set up
+    with the same transport using
+    QKnxNetIpEndpointConnection::setSecureTransport() uses the transport's
+    TCP connection instead of opening its own.
+
+    Connections whose secure configurations contain the same user ID, user
+    password, and device authentication code share one secure session. The
+    session is established only once, so the Diffie-Hellman key exchange and
+    the password hashing are done once for all of them. Received frames are
+    passed to the right connection by their secure session ID and
+    communication channel ID.
+
+    The TCP connection is opened when the first connection calls
+    QKnxNetIpEndpointConnection::connectToHostEncrypted(). A secure session is
+    closed after its last connection is disconnected, and the TCP connection
+    is closed after the last session is closed.
+
+    \code
+        QKnxNetIpSecureTransport transport;
+
+        QKnxNetIpTunnel first;
+        first.setSecureTransport(&transport);
+        first.setSecureConfiguration(firstConfig);
+        first.connectToHostEncrypted(address, port);
+
+        QKnxNetIpTunnel second;
+        second.setSecureTransport(&transport);
+        second.setSecureConfiguration(secondConfig);
+        second.connectToHostEncrypted(address, port);
+    \endcode
+
+    This class is part of the Qt KNX module and currently available as a
+    Technology Preview, and therefore the API and functionality provided
+    by the class may be subject to change at any time without prior notice.
+
+    \sa QKnxNetIpSecureConfiguration
+*/
+
+namespace QKnxPrivate
+{
+    static int channelId(const QKnxNetIpFrame &frame)
+    {
+        switch (frame.serviceType()) {
+        case QKnxNetIp::ServiceType::TunnelingRequest:
+        case QKnxNetIp::ServiceType::TunnelingAcknowledge:
+        case QKnxNetIp::ServiceType::TunnelingFeatureGet:
+        case QKnxNetIp::ServiceType::TunnelingFeatureSet:
+        case QKnxNetIp::ServiceType::TunnelingFeatureInfo:
+        case QKnxNetIp::ServiceType::TunnelingFeatureResponse:
+        case QKnxNetIp::ServiceType::DeviceConfigurationRequest:
+        case QKnxNetIp::ServiceType::DeviceConfigurationAcknowledge:
+            return frame.channelId();
+        case QKnxNetIp::ServiceType::ConnectionStateResponse:
+            return QKnxNetIpConnectionStateResponseProxy(frame).channelId();
+        case QKnxNetIp::ServiceType::DisconnectRequest:
+            return QKnxNetIpDisconnectRequestProxy(frame).channelId();
+        case QKnxNetIp::ServiceType::DisconnectResponse:
+            return QKnxNetIpDisconnectResponseProxy(frame).channelId();
+        default:
+            break;
+        }
+        return -1;
+    }
+
+    static bool sameCredentials(const QKnxNetIpSecureConfiguration &lhs,
+        const QKnxNetIpSecureConfiguration &rhs)
+    {
+        return lhs.userId() == rhs.userId()
+            && lhs.userPassword() == rhs.userPassword()
+            && lhs.deviceAuthenticationCode() == rhs.deviceAuthenticationCode();
+    }
+}
+
+/*!
+    \internal
+
+    Attaches \a connection to the transport and connects the transport to the
+    host with \a address and \a port if it is not connected yet. Returns
+    \c false if the transport is connected to a different host.
+*/
+bool QKnxNetIpSecureTransportPrivate::attach(QKnxNetIpEndpointConnectionPrivate *connection,
+    const QHostAddress &address, quint16 port)
+{
+    if (m_socket && (m_address != address || m_port != port))
+        return false;
+
+    Q_Q(QKnxNetIpSecureTransport);
+    if (!m_socket) {
+        m_address = address;
+        m_port = port;
+        m_rxBuffer = {};
+
+        m_socket = new QTcpSocket(q);
+        QObject::connect(m_socket, &QTcpSocket::connected, q, [&]() {
+            const Endpoint local(m_socket->localAddress(), m_socket->localPort(),
+                QKnxNetIp::HostProtocol::TCP_IPv4);
+            for (auto session : qAsConst(m_sessions)) {
+                for (auto attached : qAsConst(session->connections))
+                    attached->m_localEndpoint = local;
+            }
+            requestNextSession();
+        });
+        QObject::connect(m_socket, &QTcpSocket::readyRead, q, [&]() {
+            m_rxBuffer += QKnxByteArray::fromByteArray(m_socket->readAll());
+            while (m_socket && m_rxBuffer.size() >= QKnxNetIpFrameHeader::HeaderSize10) {
+                const auto header = QKnxNetIpFrameHeader::fromBytes(m_rxBuffer);
+                if (!header.isValid()) {
+                    m_rxBuffer = {};
+                    break; // the stream can not be resynchronized, drop what we have
+                }
+                if (m_rxBuffer.size() < header.totalSize())
+                    break;
+
+                const auto frame = QKnxNetIpFrame::fromBytes(m_rxBuffer);
+                m_rxBuffer.remove(0, header.totalSize());
+                processReceivedFrame(frame);
+            }
+        });
+        QObject::connect(m_socket,
+            QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error), q,
+            [this](QAbstractSocket::SocketError) {
+                abort(QKnxNetIpEndpointConnection::Error::Network, m_socket->errorString());
+        });
+        m_socket->connectToHost(address, port);
+    }
+
+    auto session = findSession(connection->m_secureConfig);
+    if (!session) {
+        connection->m_secureConfig.precomputePasswordHashes();
+
+        session = new Session;
+        session->config = connection->m_secureConfig;
+        session->serialNumber = connection->m_serialNumber;
+        session->timer = new QTimer(q);
+        session->timer->setSingleShot(true);
+        m_sessions.append(session);
+    }
+    session->connections.append(connection);
+
+    if (m_socket->state() == QAbstractSocket::ConnectedState) {
+        connection->m_localEndpoint = { m_socket->localAddress(), m_socket->localPort(),
+            QKnxNetIp::HostProtocol::TCP_IPv4 };
+        if (session->state == Session::State::Authenticated)
+            connection->sendConnectRequest();
+        else
+            requestNextSession();
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Detaches \a connection from the transport. The secure session is closed
+    once no connection uses it anymore, the TCP connection once no session is
+    left.
+*/
+void QKnxNetIpSecureTransportPrivate::detach(QKnxNetIpEndpointConnectionPrivate *connection)
+{
+    auto session = findSession(connection);
+    if (!session)
+        return;
+
+    session->connections.removeAll(connection);
+    session->pendingConnects.removeAll(connection);
+    if (session->connections.isEmpty())
+        closeSession(session, true);
+}
+
+/*!
+    \internal
+
+    Wraps \a frame into a secure wrapper frame of the session used by
+    \a connection and writes it to the TCP connection. Returns \c true on
+    success; otherwise returns \c false.
+*/
+bool QKnxNetIpSecureTransportPrivate::send(QKnxNetIpEndpointConnectionPrivate *connection,
+    const QKnxNetIpFrame &frame)
+{
+    auto session = findSession(connection);
+    if (!session || session->state != Session::State::Authenticated)
+        return false;
+
+    // the connect response carries no reference to its request, it has to be matched by order
+    if (frame.serviceType() == QKnxNetIp::ServiceType::ConnectRequest)
+        session->pendingConnects.append(connection);
+
+    write(wrap(session, frame, connection->m_serialNumber));
+    return true;
+}
+
+/*!
+    \internal
+
+    Closes all sessions and the TCP connection. The connections attached to
+    the transport report \a error and \a message and are disconnected.
+*/
+void QKnxNetIpSecureTransportPrivate::abort(QKnxNetIpEndpointConnection::Error error,
+    const QString &message)
+{
+    while (!m_sessions.isEmpty())
+        failSession(m_sessions.last(), error, message);
+}
+
+QKnxNetIpSecureTransportPrivate::Session *QKnxNetIpSecureTransportPrivate::findSession(
+    quint16 id) const
+{
+    for (auto session : m_sessions) {
+        if (session->state != Session::State::Requested && session->id == id)
+            return session;
+    }
+    return nullptr;
+}
+
+QKnxNetIpSecureTransportPrivate::Session *QKnxNetIpSecureTransportPrivate::findSession(
+    const QKnxNetIpEndpointConnectionPrivate *connection) const
+{
+    for (auto session : m_sessions) {
+        for (auto attached : qAsConst(session->connections)) {
+            if (attached == connection)
+                return session;
+        }
+    }
+    return nullptr;
+}
+
+QKnxNetIpSecureTransportPrivate::Session *QKnxNetIpSecureTransportPrivate::findSession(
+    const QKnxNetIpSecureConfiguration &config) const
+{
+    for (auto session : m_sessions) {
+        if (QKnxPrivate::sameCredentials(session->config, config))
+            return session;
+    }
+    return nullptr;
+}
+
+void QKnxNetIpSecureTransportPrivate::requestNextSession()
+{
+    // the session response does not reference the request, so only one can be outstanding
+    if (m_handshake || !m_socket || m_socket->state() != QAbstractSocket::ConnectedState)
+        return;
+
+    for (auto session : qAsConst(m_sessions)) {
+        if (session->state != Session::State::Requested)
+            continue;
+
+        auto request = QKnxNetIpSessionRequestProxy::builder()
+            .setControlEndpoint(Endpoint(QHostAddress::AnyIPv4, 0,
+                QKnxNetIp::HostProtocol::TCP_IPv4))
+            .setPublicKey(session->config.publicKey().bytes())
+            .create();
+        for (auto attached : qAsConst(session->connections))
+            attached->m_controlEndpointVersion = request.header().protocolVersion();
+
+        qDebug() << "Sending secure session request:" << request;
+        m_handshake = session;
+        write(request);
+
+        Q_Q(QKnxNetIpSecureTransport);
+        session->timer->disconnect();
+        QObject::connect(session->timer, &QTimer::timeout, q, [this, session]() {
+            failSession(session, QKnxNetIpEndpointConnection::Error::AuthFailed,
+                QKnxNetIpEndpointConnection::tr("Could not establish secure session."));
+        });
+        session->timer->start(QKnxNetIp::SecureSessionRequestTimeout);
+        return;
+    }
+}
+
+void QKnxNetIpSecureTransportPrivate::closeSession(Session *session, bool notifyServer)
+{
+    if (!m_sessions.removeOne(session))
+        return;
+
+    if (m_handshake == session) {
+        m_handshake = nullptr;
+        m_handshakeTask->cancel();
+    }
+
+    if (notifyServer && session->context.isValid() && m_socket
+        && m_socket->state() == QAbstractSocket::ConnectedState) {
+        write(wrap(session, QKnxNetIpSessionStatusProxy::builder()
+            .setStatus(QKnxNetIp::SecureSessionStatus::Close)
+            .create(), session->serialNumber));
+    }
+
+    session->timer->stop();
+    session->timer->disconnect();
+    session->timer->deleteLater();
+    delete session;
+
+    if (m_sessions.isEmpty() && m_socket) {
+        m_socket->disconnect();
+        m_socket->disconnectFromHost();
+        m_socket->deleteLater();
+        m_socket = nullptr;
+        m_rxBuffer = {};
+    } else {
+        requestNextSession();
+    }
+}
+
+void QKnxNetIpSecureTransportPrivate::failSession(Session *session,
+    QKnxNetIpEndpointConnection::Error error, const QString &message)
+{
+    const auto connections = session->connections;
+    closeSession(session, error != QKnxNetIpEndpointConnection::Error::Network);
+
+    for (auto connection : connections) {
+        connection->setAndEmitErrorOccurred(error, message);
+        connection->cleanup();
+    }
+}
+
+void QKnxNetIpSecureTransportPrivate::processReceivedFrame(const QKnxNetIpFrame &frame)
+{
+    switch (frame.serviceType()) {
+    case QKnxNetIp::ServiceType::SessionResponse:
+        processSessionResponse(frame);
+        break;
+
+    case QKnxNetIp::ServiceType::SessionStatus:
+        // an unsecured status can only refer to the pending session request
+        if (m_handshake)
+            processSessionStatus(m_handshake, frame);
+        break;
+
+    case QKnxNetIp::ServiceType::SecureWrapper: {
+        const QKnxNetIpSecureWrapperProxy proxy(frame);
+        if (!proxy.isValid())
+            break;
+
+        auto session = findSession(proxy.secureSessionId());
+        if (!session) {
+            qDebug() << "Discarded secure wrapper frame for unknown session:"
+                << proxy.secureSessionId();
+            break;
+        }
+
+        const auto decFrame = session->context.unwrap(frame);
+        if (!decFrame.isValid())
+            break; // invalid frame or MAC could not be verified, bail out
+
+        if (!session->replayWindow.accept(proxy.sequenceNumber())) {
+            qDebug() << "Discarded replayed secure wrapper frame.";
+            break;
+        }
+        dispatch(session, decFrame);
+    }   break;
+
+    default:
+        qDebug() << "Discarded unsecured frame:" << frame;
+        break;
+    }
+}
+
+void QKnxNetIpSecureTransportPrivate::processSessionResponse(const QKnxNetIpFrame &frame)
+{
+    qDebug() << "Received session response frame:" << frame;
+
+    // verification and key agreement run in the background, see processSessionResult()
+    if (m_handshake && !m_handshakeTask->isRunning())
+        m_handshakeTask->start(m_handshake->config, frame);
+}
+
+void QKnxNetIpSecureTransportPrivate::processSessionResult(
+    const QKnxNetIpSecureHandshake::Result &result)
+{
+    auto session = m_handshake;
+    if (!session || !result.isValid())
+        return; // MAC could not be verified, bail out
+
+    m_handshake = nullptr;
+    session->id = result.sessionId;
+    session->context = QKnxCcmContext(result.sessionKey);
+    session->replayWindow.clear();
+    session->state = Session::State::Authenticating;
+    write(wrap(session, result.sessionAuthenticate, session->serialNumber));
+
+    Q_Q(QKnxNetIpSecureTransport);
+    session->timer->stop();
+    session->timer->disconnect();
+    QObject::connect(session->timer, &QTimer::timeout, q, [this, session]() {
+        failSession(session, QKnxNetIpEndpointConnection::Error::AuthFailed,
+            QKnxNetIpEndpointConnection::tr("Did not receive session status frame."));
+    });
+    session->timer->start(QKnxNetIp::SecureSessionAuthenticateTimeout);
+
+    // the session is identified by its ID from now on, the next one can be requested
+    requestNextSession();
+}
+
+void QKnxNetIpSecureTransportPrivate::processSessionStatus(Session *session,
+    const QKnxNetIpFrame &frame)
+{
+    qDebug() << "Received session status frame:" << frame;
+
+    const QKnxNetIpSessionStatusProxy proxy(frame);
+    if (!proxy.isValid())
+        return;
+
+    switch (proxy.status()) {
+    case QKnxNetIp::SecureSessionStatus::AuthenticationSuccess: {
+        if (session->state != Session::State::Authenticating)
+            break;
+
+        session->state = Session::State::Authenticated;
+        session->timer->stop();
+        session->timer->disconnect();
+
+        const auto connections = session->connections;
+        for (auto connection : connections)
+            connection->sendConnectRequest();
+
+        if (!session->config.isSecureSessionKeepAliveSet())
+            break;
+
+        Q_Q(QKnxNetIpSecureTransport);
+        QObject::connect(session->timer, &QTimer::timeout, q, [this, session]() {
+            write(wrap(session, QKnxNetIpSessionStatusProxy::builder()
+                .setStatus(QKnxNetIp::SecureSessionStatus::KeepAlive)
+                .create(), session->serialNumber));
+        });
+        session->timer->setSingleShot(false);
+        session->timer->start(QKnxNetIp::Timeout::SecureSessionTimeout - 5000);
+    }   break;
+
+    case QKnxNetIp::SecureSessionStatus::AuthenticationFailed:
+        failSession(session, QKnxNetIpEndpointConnection::Error::AuthFailed,
+            QKnxNetIpEndpointConnection::tr("Secure session authentication failed."));
+        break;
+
+    case QKnxNetIp::SecureSessionStatus::Unauthenticated:
+        failSession(session, QKnxNetIpEndpointConnection::Error::AuthFailed,
+            QKnxNetIpEndpointConnection::tr("Secure session not authenticated."));
+        break;
+
+    case QKnxNetIp::SecureSessionStatus::Timeout:
+        failSession(session, QKnxNetIpEndpointConnection::Error::Timeout,
+            QKnxNetIpEndpointConnection::tr("A timeout occurred during secure session handshake."));
+        break;
+
+    case QKnxNetIp::SecureSessionStatus::Close:
+        failSession(session, QKnxNetIpEndpointConnection::Error::Timeout,
+            QKnxNetIpEndpointConnection::tr("The server requested to close the secure session."));
+        break;
+
+    default:
+        qDebug() << "Received unexpected status frame:" << frame;
+        break;
+    }
+}
+
+void QKnxNetIpSecureTransportPrivate::dispatch(Session *session, const QKnxNetIpFrame &frame)
+{
+    if (frame.serviceType() == QKnxNetIp::ServiceType::SessionStatus)
+        return processSessionStatus(session, frame);
+
+    if (session->state != Session::State::Authenticated) {
+        qDebug() << "Discarded frame received on unauthenticated session:" << frame;
+        return;
+    }
+
+    QKnxNetIpEndpointConnectionPrivate *connection = nullptr;
+    if (frame.serviceType() == QKnxNetIp::ServiceType::ConnectResponse) {
+        if (!session->pendingConnects.isEmpty())
+            connection = session->pendingConnects.takeFirst();
+    } else {
+        const auto channelId = QKnxPrivate::channelId(frame);
+        for (auto attached : qAsConst(session->connections)) {
+            if (channelId >= 0 && attached->m_channelId == channelId) {
+                connection = attached;
+                break;
+            }
+        }
+    }
+
+    if (connection)
+        connection->processReceivedFrame(frame);
+    else
+        qDebug() << "Discarded frame for unknown communication channel:" << frame;
+}
+
+QKnxNetIpFrame QKnxNetIpSecureTransportPrivate::wrap(Session *session,
+    const QKnxNetIpFrame &frame, const QKnxByteArray &serialNumber)
+{
+    // all connections of the session share its sequence counter
+    return session->context.wrap(frame, session->id, session->sequenceNumber++, serialNumber,
+        0x0000);
+}
+
+void QKnxNetIpSecureTransportPrivate::write(const QKnxNetIpFrame &frame)
+{
+    if (m_socket)
+        m_socket->write(frame.bytes().toByteArray());
+}
+
+
+// -- QKnxNetIpSecureTransport
+
+/*!
+    Creates a secure transport with the parent \a parent.
+*/
+QKnxNetIpSecureTransport::QKnxNetIpSecureTransport(QObject *parent)
+    : QObject(*new QKnxNetIpSecureTransportPrivate, parent)
+{
+    Q_D(QKnxNetIpSecureTransport);
+    d->m_handshakeTask = new QKnxNetIpSecureHandshake(this);
+    connect(d->m_handshakeTask, &QKnxNetIpSecureHandshake::finished, this,
+        [this](const QKnxNetIpSecureHandshake::Result &result) {
+            Q_D(QKnxNetIpSecureTransport);
+            d->processSessionResult(result);
+    });
+}
+
+/*!
+    Destroys the secure transport. All connections still using it are
+    disconnected.
+*/
+QKnxNetIpSecureTransport::~QKnxNetIpSecureTransport()
+{
+    Q_D(QKnxNetIpSecureTransport);
+    d->abort(QKnxNetIpEndpointConnection::Error::Close,
+        QKnxNetIpEndpointConnection::tr("The secure transport was destroyed."));
+}
+
+/*!
+    Returns \c true if the TCP connection to the KNXnet/IP server is
+    established; otherwise returns \c false.
+*/
+bool QKnxNetIpSecureTransport::isConnected() const
+{
+    Q_D(const QKnxNetIpSecureTransport);
+    return d->m_socket && d->m_socket->state() == QAbstractSocket::ConnectedState;
+}
+
+/*!
+    Returns the address of the KNXnet/IP server the transport is connected or
+    connecting to. If the transport is not in use, a null address is returned.
+*/
+QHostAddress QKnxNetIpSecureTransport::remoteAddress() const
+{
+    Q_D(const QKnxNetIpSecureTransport);
+    return d->m_socket ? d->m_address : QHostAddress();
+}
+
+/*!
+    Returns the port of the KNXnet/IP server the transport is connected or
+    connecting to. If the transport is not in use, \c 0 is returned.
+*/
+quint16 QKnxNetIpSecureTransport::remotePort() const
+{
+    Q_D(const QKnxNetIpSecureTransport);
+    return d->m_socket ? d->m_port : 0;
+}
+
+/*!
+    Returns the number of secure sessions that are requested or established
+    on the TCP connection.
+*/
+int QKnxNetIpSecureTransport::sessionCount() const
+{
+    Q_D(const QKnxNetIpSecureTransport);
+    return d->m_sessions.size();
+}
+
+/*!
+    Returns the number of tunneling and device management connections using
+    the transport.
+*/
+int QKnxNetIpSecureTransport::connectionCount() const
+{
+    Q_D(const QKnxNetIpSecureTransport);
+    int count = 0;
+    for (auto session : d->m_sessions)
+        count += session->connections.size();
+    return count;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,62 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPSECURETRANSPORT_H
+#define QKNXNETIPSECURETRANSPORT_H
+
+#include <QtCore/qobject.h>
+
+#include <QtKnx/qtknxglobal.h>
+
+#include <QtNetwork/qhostaddress.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpSecureTransportPrivate;
+class Q_KNX_EXPORT QKnxNetIpSecureTransport final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(QKnxNetIpSecureTransport)
+    Q_DECLARE_PRIVATE(QKnxNetIpSecureTransport)
+
+public:
+    explicit QKnxNetIpSecureTransport(QObject *parent = nullptr);
+    ~QKnxNetIpSecureTransport() override;
+
+    bool isConnected() const;
+    QHostAddress remoteAddress() const;
+    quint16 remotePort() const;
+
+    int sessionCount() const;
+    int connectionCount() const;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,138 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPSECURETRANSPORT_P_H
+#define QKNXNETIPSECURETRANSPORT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qtimer.h>
+#include <QtCore/qvector.h>
+#include <QtCore/private/qobject_p.h>
+
+#include <QtKnx/qknxnetipendpointconnection.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qknxnetipsecureconfiguration.h>
+#include <QtKnx/qknxnetipsecuretransport.h>
+#include <QtKnx/private/qknxccmcontext_p.h>
+#include <QtKnx/private/qknxnetipsecurehandshake_p.h>
+#include <QtKnx/private/qknxreplaywindow_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpEndpointConnectionPrivate;
+class QTcpSocket;
+
+class Q_KNX_EXPORT QKnxNetIpSecureTransportPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QKnxNetIpSecureTransport)
+
+public:
+    QKnxNetIpSecureTransportPrivate() = default;
+    ~QKnxNetIpSecureTransportPrivate() override = default;
+
+    static QKnxNetIpSecureTransportPrivate *get(QKnxNetIpSecureTransport *transport)
+    {
+        return transport->d_func();
+    }
+
+    struct Session final
+    {
+        enum class State : quint8
+        {
+            Requested,
+            Authenticating,
+            Authenticated
+        };
+
+        State state { State::Requested };
+        quint16 id { 0 };
+        quint48 sequenceNumber { 0 };
+        QKnxCcmContext context;
+        QKnxReplayWindow replayWindow;
+        QKnxNetIpSecureConfiguration config;
+        QKnxByteArray serialNumber;
+        QTimer *timer { nullptr };
+
+        // connections sharing the session, and the ones waiting for a connect response in the
+        // order their connect requests were sent
+        QVector<QKnxNetIpEndpointConnectionPrivate *> connections;
+        QVector<QKnxNetIpEndpointConnectionPrivate *> pendingConnects;
+    };
+
+    bool attach(QKnxNetIpEndpointConnectionPrivate *connection, const QHostAddress &address,
+        quint16 port);
+    void detach(QKnxNetIpEndpointConnectionPrivate *connection);
+    bool send(QKnxNetIpEndpointConnectionPrivate *connection, const QKnxNetIpFrame &frame);
+
+    void abort(QKnxNetIpEndpointConnection::Error error, const QString &message);
+
+private:
+    Session *findSession(quint16 id) const;
+    Session *findSession(const QKnxNetIpEndpointConnectionPrivate *connection) const;
+    Session *findSession(const QKnxNetIpSecureConfiguration &config) const;
+
+    void requestNextSession();
+    void closeSession(Session *session, bool notifyServer);
+    void failSession(Session *session, QKnxNetIpEndpointConnection::Error error,
+        const QString &message);
+
+    void processReceivedFrame(const QKnxNetIpFrame &frame);
+    void processSessionResponse(const QKnxNetIpFrame &frame);
+    void processSessionResult(const QKnxNetIpSecureHandshake::Result &result);
+    void processSessionStatus(Session *session, const QKnxNetIpFrame &frame);
+    void dispatch(Session *session, const QKnxNetIpFrame &frame);
+
+    QKnxNetIpFrame wrap(Session *session, const QKnxNetIpFrame &frame,
+        const QKnxByteArray &serialNumber);
+    void write(const QKnxNetIpFrame &frame);
+
+private:
+    QHostAddress m_address;
+    quint16 m_port { 0 };
+    QTcpSocket *m_socket { nullptr };
+    QKnxByteArray m_rxBuffer;
+
+    Session *m_handshake { nullptr };
+    QKnxNetIpSecureHandshake *m_handshakeTask { nullptr };
+    QVector<Session *> m_sessions;
+};
+
+QT_END_NAMESPACE
+
+#endif
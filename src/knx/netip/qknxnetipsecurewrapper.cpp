@@ -31,6 +31,8 @@
 #include "qknxnetipsecurewrapper.h"
 #include "qknxutils.h"
 
+#include "private/qknxccmcontext_p.h"
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -380,8 +382,6 @@ QKnxNetIpSecureWrapperProxy::Builder &
     take away the burden to do the encryption of the encapsulated frame and
     the calculation the message authentication code (MAC).
 
-    \note To use this class OpenSSL must be supported on your target system.
-
     This frame will be sent during secure KNXnet/IP communication and includes
     a fully encrypted KNXnet/IP frame as well as information needed to decrypt
     the encapsulated frame and for ensuring data integrity and freshness.
@@ -508,38 +508,13 @@ QKnxNetIpSecureWrapperProxy::SecureBuilder &
 QKnxNetIpFrame
     QKnxNetIpSecureWrapperProxy::SecureBuilder::create(const QKnxByteArray &sessionKey) const
 {
-#if QT_CONFIG(opensslv11)
     if (sessionKey.isEmpty() || d_ptr->m_seqNumber > Q_UINT48_MAX || d_ptr->m_serial.size() != 6
         || !d_ptr->m_unencryptedFrame.isValid()) {
             return { QKnxNetIp::ServiceType::SecureWrapper };
     }
 
-    auto encryptedFrame = QKnxCryptographicEngine::encryptSecureWrapperPayload(sessionKey,
-        d_ptr->m_unencryptedFrame, d_ptr->m_seqNumber, d_ptr->m_serial, d_ptr->m_tag);
-    if (encryptedFrame.isEmpty())
-        return {};
-
-    auto builder = QKnxNetIpSecureWrapperProxy::builder();
-    auto frame = builder
-        .setSecureSessionId(d_ptr->m_sessionId)
-        .setSequenceNumber(d_ptr->m_seqNumber)
-        .setSerialNumber(d_ptr->m_serial)
-        .setMessageTag(d_ptr->m_tag)
-        .setEncapsulatedFrame(encryptedFrame)
-        .setMessageAuthenticationCode(QKnxByteArray(16, 0x00)) // dummy MAC to get a proper header
-        .create();
-
-    auto mac = QKnxCryptographicEngine::computeMessageAuthenticationCode(sessionKey,
-        frame.header(), d_ptr->m_sessionId, d_ptr->m_unencryptedFrame.bytes(), d_ptr->m_seqNumber,
-        d_ptr->m_serial, d_ptr->m_tag);
-    mac = QKnxCryptographicEngine::encryptMessageAuthenticationCode(sessionKey, mac,
-            d_ptr->m_seqNumber, d_ptr->m_serial, d_ptr->m_tag);
-
-    return builder.setMessageAuthenticationCode(mac).create();
-#else
-    Q_UNUSED(sessionKey)
-    return { QKnxNetIp::ServiceType::SecureWrapper };
-#endif
+    return QKnxCcmContext(sessionKey).wrap(d_ptr->m_unencryptedFrame, d_ptr->m_sessionId,
+        d_ptr->m_seqNumber, d_ptr->m_serial, d_ptr->m_tag);
 }
 
 /*!
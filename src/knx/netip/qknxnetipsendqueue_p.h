@@ -0,0 +1,211 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPSENDQUEUE_P_H
+#define QKNXNETIPSENDQUEUE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qqueue.h>
+
+#include <QtKnx/qknxcontrolfield.h>
+
+QT_BEGIN_NAMESPACE
+
+// Bounded outbound queue ordered by cEMI frame priority. System and urgent
+// frames are served strictly before normal and low priority frames, which
+// share the remaining bandwidth with a 3:1 weight. A class that had to step
+// aside StarvationLimit times in a row is served next regardless, so a steady
+// stream of high priority frames cannot block the others forever.
+template <typename T>
+class QKnxNetIpSendQueue final
+{
+public:
+    enum { NormalWeight = 3, StarvationLimit = 16 };
+
+    explicit QKnxNetIpSendQueue(int capacity = 0)
+        : m_capacity(qMax(0, capacity))
+    {}
+
+    int capacity() const { return m_capacity; }
+    void setCapacity(int capacity)
+    {
+        m_capacity = qMax(0, capacity);
+        while (size() > m_capacity)
+            evictLowest();
+    }
+
+    int size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    // Number of frames rejected or evicted because the queue was full.
+    quint64 dropped() const { return m_dropped; }
+
+    void clear()
+    {
+        for (auto &queue : m_queues)
+            queue.clear();
+        for (auto &skipped : m_skipped)
+            skipped = 0;
+        m_size = 0;
+        m_normalCredit = NormalWeight;
+    }
+
+    // If the queue is full, the newest frame of a lower priority class is
+    // dropped to make room. Returns false if the frame could not be queued.
+    bool enqueue(QKnxControlField::Priority priority, const T &item)
+    {
+        if (m_capacity <= 0)
+            return false;
+
+        const int rank = rankOf(priority);
+        if (m_size >= m_capacity) {
+            const int lowest = lowestNonEmptyRank();
+            if (lowest <= rank) {
+                ++m_dropped;
+                return false;
+            }
+            evictLowest();
+        }
+
+        m_queues[rank].enqueue(item);
+        ++m_size;
+        return true;
+    }
+
+    // The frame dequeue() returns next. The queue must not be empty.
+    const T &head() const
+    {
+        Q_ASSERT(m_size > 0);
+        return m_queues[nextRank()].head();
+    }
+
+    T dequeue()
+    {
+        const int rank = nextRank();
+        if (rank < 0)
+            return T();
+
+        for (int i = 0; i < RankCount; ++i) {
+            if (i != rank && !m_queues[i].isEmpty())
+                ++m_skipped[i];
+        }
+        m_skipped[rank] = 0;
+
+        if (rank == NormalRank)
+            --m_normalCredit;
+        else if (rank == LowRank)
+            m_normalCredit = NormalWeight;
+
+        --m_size;
+        return m_queues[rank].dequeue();
+    }
+
+private:
+    enum Rank { SystemRank, UrgentRank, NormalRank, LowRank, RankCount };
+
+    static int rankOf(QKnxControlField::Priority priority)
+    {
+        switch (priority) {
+        case QKnxControlField::Priority::System:
+            return SystemRank;
+        case QKnxControlField::Priority::Urgent:
+            return UrgentRank;
+        case QKnxControlField::Priority::Normal:
+            return NormalRank;
+        case QKnxControlField::Priority::Low:
+            break;
+        }
+        return LowRank;
+    }
+
+    int nextRank() const
+    {
+        if (m_size == 0)
+            return -1;
+
+        for (int i = 0; i < RankCount; ++i) {
+            if (m_skipped[i] >= StarvationLimit && !m_queues[i].isEmpty())
+                return i;
+        }
+
+        if (!m_queues[SystemRank].isEmpty())
+            return SystemRank;
+        if (!m_queues[UrgentRank].isEmpty())
+            return UrgentRank;
+
+        // weighted round robin between normal and low priority
+        if (m_queues[LowRank].isEmpty())
+            return NormalRank;
+        if (m_queues[NormalRank].isEmpty() || m_normalCredit <= 0)
+            return LowRank;
+        return NormalRank;
+    }
+
+    int lowestNonEmptyRank() const
+    {
+        for (int i = RankCount - 1; i >= 0; --i) {
+            if (!m_queues[i].isEmpty())
+                return i;
+        }
+        return -1;
+    }
+
+    void evictLowest()
+    {
+        const int rank = lowestNonEmptyRank();
+        if (rank < 0)
+            return;
+        m_queues[rank].removeLast();
+        if (m_queues[rank].isEmpty())
+            m_skipped[rank] = 0;
+        --m_size;
+        ++m_dropped;
+    }
+
+    QQueue<T> m_queues[RankCount];
+    int m_skipped[RankCount] { 0, 0, 0, 0 };
+    int m_size { 0 };
+    int m_capacity { 0 };
+    int m_normalCredit { NormalWeight };
+    quint64 m_dropped { 0 };
+};
+
+QT_END_NAMESPACE
+
+#endif
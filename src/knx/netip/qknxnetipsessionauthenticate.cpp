@@ -266,8 +266,6 @@ QKnxNetIpSessionAuthenticateProxy::Builder &
     Technology Preview, and therefore the API and functionality provided
     by the class may be subject to change at any time without prior notice.
 
-    \note To use this class OpenSSL must be supported on your target system.
-
     This frame will be sent by the KNXnet/IP secure client to the control
     endpoint of the KNXnet/IP secure server after the Diffie-Hellman handshake
     to authenticate the user against the server device.
@@ -330,7 +328,6 @@ QKnxNetIpFrame QKnxNetIpSessionAuthenticateProxy::SecureBuilder::create(
                                                         const QKnxByteArray &clientPublicKey,
                                                         const QKnxByteArray &serverPublicKey) const
 {
-#if QT_CONFIG(opensslv11)
     if (!QKnxNetIp::isSecureUserId(d_ptr->m_id))
         return { QKnxNetIp::ServiceType::SessionAuthenticate };
 
@@ -346,12 +343,6 @@ QKnxNetIpFrame QKnxNetIpSessionAuthenticateProxy::SecureBuilder::create(
     mac = QKnxCryptographicEngine::encryptMessageAuthenticationCode(userPasswordHash, mac);
 
     return builder.setMessageAuthenticationCode(mac).create();
-#else
-    Q_UNUSED(sessionPassword)
-    Q_UNUSED(clientPublicKey)
-    Q_UNUSED(serverPublicKey)
-    return { QKnxNetIp::ServiceType::SessionAuthenticate };
-#endif
 }
 
 /*!
@@ -281,8 +281,6 @@ QKnxNetIpSessionResponseProxy::Builder &
     Technology Preview, and therefore the API and functionality provided
     by the class may be subject to change at any time without prior notice.
 
-    \note To use this class OpenSSL must be supported on your target system.
-
     This frame will be sent by the KNXnet/IP secure server to the KNXnet/IP
     secure client control endpoint in response to a received secure session
     request frame.
@@ -353,7 +351,6 @@ QKnxNetIpSessionResponseProxy::SecureBuilder &
 QKnxNetIpFrame QKnxNetIpSessionResponseProxy::SecureBuilder::create(const QByteArray &devicePassword,
     const QKnxByteArray &clientPublicKey) const
 {
-#if QT_CONFIG(opensslv11)
     if (d_ptr->m_id < 0 || clientPublicKey.size() != 32 || d_ptr->m_serverPublicKey.size() != 32)
         return { QKnxNetIp::ServiceType::SessionResponse };
 
@@ -373,11 +370,6 @@ QKnxNetIpFrame QKnxNetIpSessionResponseProxy::SecureBuilder::create(const QByteA
     mac = QKnxCryptographicEngine::encryptMessageAuthenticationCode(deviceAuthenticationCode, mac);
 
     return builder.setMessageAuthenticationCode(mac).create();
-#else
-    Q_UNUSED(devicePassword)
-    Q_UNUSED(clientPublicKey)
-    return { QKnxNetIp::ServiceType::SessionResponse };
-#endif
 }
 
 /*!
@@ -0,0 +1,832 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include "qknxnetipconnectionstaterequest.h"
+#include "qknxnetipconnectionstateresponse.h"
+#include "qknxnetipconnectrequest.h"
+#include "qknxnetipconnectresponse.h"
+#include "qknxnetipcrd.h"
+#include "qknxnetipcri.h"
+#include "qknxnetipdisconnectrequest.h"
+#include "qknxnetipdisconnectresponse.h"
+#include "qknxnetipendpointconnection_p.h"
+#include "qknxnetiphpai.h"
+#include "qknxnetiprouter_p.h"
+#include "qknxnetiproutingbusy.h"
+#include "qknxnetiproutingindication.h"
+#include "qknxnetipsimulatednetwork_p.h"
+#include "qknxnetiptunnelingacknowledge.h"
+#include "qknxnetiptunnelingrequest.h"
+
+#include <QtKnx/private/qknxtpdufactory_p.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpSimulatedSocket final : public QKnxNetIpDatagramSocket
+{
+public:
+    QKnxNetIpSimulatedSocket(QKnxNetIpSimulatedNetwork *network, const QHostAddress &host,
+            QObject *parent)
+        : QKnxNetIpDatagramSocket(parent)
+        , m_network(network)
+        , m_host(host)
+    {
+        m_network->m_sockets.append(this);
+    }
+
+    ~QKnxNetIpSimulatedSocket() override
+    {
+        if (m_network)
+            m_network->m_sockets.removeAll(this);
+    }
+
+    bool bind(const QHostAddress &address, quint16 port, QAbstractSocket::BindMode mode) override
+    {
+        if (!m_network || m_state != QAbstractSocket::UnconnectedState)
+            return setError(QAbstractSocket::UnsupportedSocketOperationError,
+                QStringLiteral("Socket is not attached to a network or already bound."));
+
+        // wildcard and loopback addresses bind to the simulated host
+        if (!address.isNull() && address != QHostAddress::Any && address != QHostAddress::AnyIPv4
+            && !address.isLoopback() && address != m_host) {
+            return setError(QAbstractSocket::SocketAddressNotAvailableError,
+                QStringLiteral("The address is not available on the simulated host."));
+        }
+
+        if (port == 0)
+            port = m_network->allocatePort();
+
+        for (const auto *socket : qAsConst(m_network->m_sockets)) {
+            if (socket != this && socket->m_state == QAbstractSocket::BoundState
+                && socket->m_host == m_host && socket->m_port == port
+                && !mode.testFlag(QAbstractSocket::ShareAddress)) {
+                return setError(QAbstractSocket::AddressInUseError,
+                    QStringLiteral("The address is already in use."));
+            }
+        }
+
+        m_port = port;
+        m_state = QAbstractSocket::BoundState;
+        emit stateChanged(m_state);
+        return true;
+    }
+
+    void close() override
+    {
+        if (m_state == QAbstractSocket::UnconnectedState)
+            return;
+        emit stateChanged(QAbstractSocket::ClosingState);
+        m_groups.clear();
+        m_pending.clear();
+        m_port = 0;
+        m_state = QAbstractSocket::UnconnectedState;
+        emit stateChanged(m_state);
+    }
+
+    QAbstractSocket::SocketState state() const override { return m_state; }
+    QHostAddress localAddress() const override
+    {
+        return m_state == QAbstractSocket::BoundState ? m_host : QHostAddress();
+    }
+    quint16 localPort() const override { return m_port; }
+    QString errorString() const override { return m_errorString; }
+
+    void setSocketOption(QAbstractSocket::SocketOption, const QVariant &) override {}
+
+    bool joinMulticastGroup(const QHostAddress &group, const QNetworkInterface &) override
+    {
+        if (m_state != QAbstractSocket::BoundState || !group.isMulticast())
+            return false;
+        m_groups.insert(group);
+        return true;
+    }
+
+    bool leaveMulticastGroup(const QHostAddress &group, const QNetworkInterface &) override
+    {
+        return m_groups.remove(group);
+    }
+
+    void setMulticastInterface(const QNetworkInterface &) override {}
+
+    bool hasPendingDatagrams() const override { return !m_pending.isEmpty(); }
+    QNetworkDatagram receiveDatagram() override
+    {
+        return m_pending.isEmpty() ? QNetworkDatagram() : m_pending.dequeue();
+    }
+
+    qint64 writeDatagram(const QByteArray &data, const QHostAddress &host, quint16 port) override
+    {
+        if (!m_network || m_state != QAbstractSocket::BoundState)
+            return -1;
+
+        QNetworkDatagram datagram(data, host, port);
+        datagram.setSender(m_host, m_port);
+        return m_network->send(datagram);
+    }
+
+    bool waitForReadyRead(int) override
+    {
+        const auto received = m_received;
+        if (m_network)
+            m_network->flush();
+        return received != m_received;
+    }
+
+    bool accepts(const QHostAddress &address, quint16 port) const
+    {
+        if (m_state != QAbstractSocket::BoundState || m_port != port)
+            return false;
+        return address.isMulticast() ? m_groups.contains(address) : address == m_host;
+    }
+
+    void deliver(const QNetworkDatagram &datagram)
+    {
+        m_pending.enqueue(datagram);
+        ++m_received;
+    }
+
+    QHostAddress host() const { return m_host; }
+
+private:
+    bool setError(QAbstractSocket::SocketError error, const QString &errorString)
+    {
+        m_errorString = errorString;
+        emit errorOccurred(error);
+        return false;
+    }
+
+    QPointer<QKnxNetIpSimulatedNetwork> m_network;
+    QHostAddress m_host;
+    quint16 m_port { 0 };
+    QAbstractSocket::SocketState m_state { QAbstractSocket::UnconnectedState };
+    QSet<QHostAddress> m_groups;
+    QQueue<QNetworkDatagram> m_pending;
+    quint64 m_received { 0 };
+    QString m_errorString;
+};
+
+
+// -- QKnxNetIpSimulatedNetwork
+
+QKnxNetIpSimulatedNetwork::QKnxNetIpSimulatedNetwork(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+    m_deliveryTimer.setSingleShot(true);
+    connect(&m_deliveryTimer, &QTimer::timeout, this, [this]() { deliverDue(); });
+}
+
+QKnxNetIpSimulatedNetwork::~QKnxNetIpSimulatedNetwork()
+{
+    m_inFlight.clear();
+}
+
+void QKnxNetIpSimulatedNetwork::setSeed(quint32 seed)
+{
+    m_seed = seed;
+    m_random.seed(seed);
+}
+
+void QKnxNetIpSimulatedNetwork::setLatency(int minimum, int maximum)
+{
+    m_minimumLatency = qMax(0, minimum);
+    m_maximumLatency = qMax(m_minimumLatency, maximum);
+}
+
+void QKnxNetIpSimulatedNetwork::setLossRate(double rate)
+{
+    m_lossRate = qBound(0., rate, 1.);
+}
+
+void QKnxNetIpSimulatedNetwork::setReorderRate(double rate)
+{
+    m_reorderRate = qBound(0., rate, 1.);
+}
+
+// The router creates its socket from the network on the next call to start().
+void QKnxNetIpSimulatedNetwork::attach(QKnxNetIpRouter *router, const QHostAddress &address)
+{
+    if (!router)
+        return;
+    auto d = static_cast<QKnxNetIpRouterPrivate *>(QObjectPrivate::get(router));
+    d->m_network = this;
+    d->m_networkAddress = address;
+}
+
+// The connection creates its socket from the network on the next call to
+// connectToHost(). Only UDP connections are supported.
+void QKnxNetIpSimulatedNetwork::attach(QKnxNetIpEndpointConnection *connection,
+    const QHostAddress &address)
+{
+    if (!connection)
+        return;
+    auto d = static_cast<QKnxNetIpEndpointConnectionPrivate *>(QObjectPrivate::get(connection));
+    d->m_network = this;
+    d->m_networkAddress = address;
+}
+
+QKnxNetIpDatagramSocket *QKnxNetIpSimulatedNetwork::createSocket(const QHostAddress &address,
+    QObject *parent)
+{
+    return new QKnxNetIpSimulatedSocket(this, address, parent);
+}
+
+qint64 QKnxNetIpSimulatedNetwork::inject(const QByteArray &datagram, const QHostAddress &sender,
+    quint16 senderPort, const QHostAddress &destination, quint16 port)
+{
+    QNetworkDatagram networkDatagram(datagram, destination, port);
+    networkDatagram.setSender(sender, senderPort);
+    return send(networkDatagram);
+}
+
+void QKnxNetIpSimulatedNetwork::flush()
+{
+    deliverDue(true);
+}
+
+quint16 QKnxNetIpSimulatedNetwork::allocatePort()
+{
+    const auto port = m_nextPort;
+    m_nextPort = (m_nextPort == 65535 ? 49152 : m_nextPort + 1);
+    return port;
+}
+
+qint64 QKnxNetIpSimulatedNetwork::send(const QNetworkDatagram &datagram)
+{
+    const qint64 size = datagram.data().size();
+    if (size > 65507)
+        return -1;
+
+    ++m_sent;
+    emit datagramSent(datagram);
+
+    if (m_lossRate > 0. && m_random.generateDouble() < m_lossRate) {
+        ++m_lost;
+        return size; // the sender cannot tell
+    }
+
+    qint64 delay = m_minimumLatency;
+    if (m_maximumLatency > m_minimumLatency)
+        delay += m_random.bounded(m_maximumLatency - m_minimumLatency + 1);
+
+    // held back long enough to be overtaken by the next datagram
+    if (m_reorderRate > 0. && m_random.generateDouble() < m_reorderRate)
+        delay += m_maximumLatency + 1;
+
+    m_inFlight.insert(qMakePair(m_clock.elapsed() + delay, m_sequence++), datagram);
+    scheduleDelivery();
+    return size;
+}
+
+void QKnxNetIpSimulatedNetwork::deliverDue(bool all)
+{
+    const auto now = m_clock.elapsed();
+    const auto sequence = m_sequence; // datagrams sent while delivering wait for the next round
+
+    QList<QPointer<QKnxNetIpSimulatedSocket>> receivers;
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end();) {
+        if (!all && it.key().first > now)
+            break;
+        if (it.key().second >= sequence) {
+            ++it;
+            continue;
+        }
+
+        const auto datagram = it.value();
+        it = m_inFlight.erase(it);
+
+        const auto destination = datagram.destinationAddress();
+        const auto port = quint16(datagram.destinationPort());
+        for (auto *socket : qAsConst(m_sockets)) {
+            if (!socket->accepts(destination, port))
+                continue;
+
+            socket->deliver(datagram);
+            ++m_delivered;
+            if (!receivers.contains(socket))
+                receivers.append(socket);
+
+            if (!destination.isMulticast())
+                break;
+        }
+    }
+
+    // like a real socket, each receiver is notified once for a burst of datagrams
+    for (const auto &socket : qAsConst(receivers)) {
+        if (socket && socket->hasPendingDatagrams())
+            emit socket->readyRead();
+    }
+    scheduleDelivery();
+}
+
+void QKnxNetIpSimulatedNetwork::scheduleDelivery()
+{
+    if (m_inFlight.isEmpty()) {
+        m_deliveryTimer.stop();
+        return;
+    }
+    m_deliveryTimer.start(int(qMax<qint64>(0, m_inFlight.firstKey().first - m_clock.elapsed())));
+}
+
+
+// -- QKnxNetIpSimulatedLine
+
+QKnxNetIpSimulatedLine::QKnxNetIpSimulatedLine(QObject *parent)
+    : QObject(parent)
+{}
+
+void QKnxNetIpSimulatedLine::transmit(const QKnxLinkLayerFrame &frame, QObject *source)
+{
+    ++m_transmitted;
+    QTimer::singleShot(0, this, [this, frame, source]() {
+        emit frameTransmitted(frame, source);
+    });
+}
+
+
+// -- QKnxNetIpSimulatedDevice
+
+QKnxNetIpSimulatedDevice::QKnxNetIpSimulatedDevice(const QKnxAddress &individualAddress,
+        QKnxNetIpSimulatedLine *line, QObject *parent)
+    : QObject(parent)
+    , m_individualAddress(individualAddress)
+    , m_line(line)
+{
+    if (m_line)
+        connect(m_line, &QKnxNetIpSimulatedLine::frameTransmitted, this,
+            &QKnxNetIpSimulatedDevice::process);
+}
+
+void QKnxNetIpSimulatedDevice::setGroupValue(const QKnxAddress &group, const QKnxByteArray &value)
+{
+    if (group.type() == QKnxAddress::Type::Group)
+        m_values.insert(group, value);
+}
+
+void QKnxNetIpSimulatedDevice::writeGroupValue(const QKnxAddress &group,
+    const QKnxByteArray &value)
+{
+    setGroupValue(group, value);
+    transmit(group, QKnxTpduFactory::Multicast::createGroupValueWriteTpdu(value));
+}
+
+void QKnxNetIpSimulatedDevice::readGroupValue(const QKnxAddress &group)
+{
+    transmit(group, QKnxTpduFactory::Multicast::createGroupValueReadTpdu());
+}
+
+void QKnxNetIpSimulatedDevice::process(const QKnxLinkLayerFrame &frame, QObject *source)
+{
+    if (source == this)
+        return;
+    ++m_received;
+
+    const auto group = frame.destinationAddress();
+    if (group.type() != QKnxAddress::Type::Group || !m_values.contains(group))
+        return;
+
+    const auto tpdu = frame.tpdu();
+    switch (tpdu.applicationControlField()) {
+    case QKnxTpdu::ApplicationControlField::GroupValueRead:
+        transmit(group, QKnxTpduFactory::Multicast::createGroupValueResponseTpdu(m_values
+            .value(group)));
+        break;
+    case QKnxTpdu::ApplicationControlField::GroupValueResponse:
+    case QKnxTpdu::ApplicationControlField::GroupValueWrite: {
+        const auto value = tpdu.data();
+        if (m_values.value(group) != value) {
+            m_values.insert(group, value);
+            emit groupValueChanged(group, value);
+        }
+    }   break;
+    default:
+        break;
+    }
+}
+
+void QKnxNetIpSimulatedDevice::transmit(const QKnxAddress &group, const QKnxTpdu &tpdu)
+{
+    if (!m_line)
+        return;
+
+    m_line->transmit(QKnxLinkLayerFrame::builder()
+        .setMessageCode(QKnxLinkLayerFrame::MessageCode::DataIndication)
+        .setSourceAddress(m_individualAddress)
+        .setDestinationAddress(group)
+        .setTpdu(tpdu)
+        .createFrame(), this);
+}
+
+
+// -- QKnxNetIpSimulatedRouter
+
+QKnxNetIpSimulatedRouter::QKnxNetIpSimulatedRouter(const QHostAddress &address,
+        QKnxNetIpSimulatedNetwork *network, QKnxNetIpSimulatedLine *line, QObject *parent)
+    : QObject(parent)
+    , m_router(new QKnxNetIpRouter(this))
+    , m_line(line)
+{
+    m_router->setRoutingMode(QKnxNetIpRouter::RoutingMode::RouteAll);
+    if (network)
+        network->attach(m_router, address);
+
+    connect(m_router, &QKnxNetIpRouter::routingIndicationReceived, this,
+        [this](QKnxNetIpFrame frame, QKnxNetIpRouter::FilterAction action) {
+        if (m_busy) {
+            m_router->sendRoutingBusy(QKnxNetIpRoutingBusyProxy::builder()
+                .setDeviceState(QKnxNetIp::DeviceState::KnxFault)
+                .setRoutingBusyWaitTime(m_busyWaitTime)
+                .setRoutingBusyControl(0)
+                .create());
+            return;
+        }
+
+        if (!m_line || (action != QKnxNetIpRouter::FilterAction::RouteDecremented
+            && action != QKnxNetIpRouter::FilterAction::RouteLast
+            && action != QKnxNetIpRouter::FilterAction::ForwardLocally)) {
+            return;
+        }
+
+        auto cemi = QKnxNetIpRoutingIndicationProxy(frame).cemi();
+        cemi.setMessageCode(QKnxLinkLayerFrame::MessageCode::DataIndication);
+        if (action == QKnxNetIpRouter::FilterAction::RouteDecremented) {
+            // bounds the life time of a frame circling between two coupled lines
+            auto extCtrl = cemi.extendedControlField();
+            extCtrl.setHopCount(extCtrl.hopCount() - 1);
+            cemi.setExtendedControlField(extCtrl);
+        }
+        m_line->transmit(cemi, this);
+    });
+
+    if (m_line) {
+        connect(m_line, &QKnxNetIpSimulatedLine::frameTransmitted, this,
+            [this](const QKnxLinkLayerFrame &frame, QObject *source) {
+            if (source == this)
+                return;
+            m_router->sendRoutingIndication(QKnxNetIpRoutingIndicationProxy::builder()
+                .setCemi(frame)
+                .create());
+        });
+    }
+}
+
+QKnxNetIpSimulatedRouter::~QKnxNetIpSimulatedRouter()
+{
+    m_router->stop();
+}
+
+void QKnxNetIpSimulatedRouter::setBusy(bool busy, quint16 waitTime)
+{
+    m_busy = busy;
+    m_busyWaitTime = qBound<quint16>(20, waitTime, 100);
+}
+
+void QKnxNetIpSimulatedRouter::start()
+{
+    m_router->start();
+}
+
+void QKnxNetIpSimulatedRouter::stop()
+{
+    m_router->stop();
+}
+
+
+// -- QKnxNetIpSimulatedTunnelingServer
+
+namespace QKnxPrivate
+{
+    static void endpointOf(const QKnxNetIpHpai &hpai, const QNetworkDatagram &datagram,
+        QHostAddress *address, quint16 *port)
+    {
+        const QKnxNetIpHpaiProxy proxy(hpai);
+        *address = proxy.hostAddress();
+        *port = proxy.port();
+
+        // route back endpoint, answer to the sender of the datagram
+        if (address->isNull() || *address == QHostAddress::AnyIPv4 || *port == 0) {
+            *address = datagram.senderAddress();
+            *port = quint16(datagram.senderPort());
+        }
+    }
+}
+
+QKnxNetIpSimulatedTunnelingServer::QKnxNetIpSimulatedTunnelingServer(const QHostAddress &address,
+        quint16 port, QKnxNetIpSimulatedNetwork *network, QKnxNetIpSimulatedLine *line,
+        QObject *parent)
+    : QObject(parent)
+    , m_line(line)
+{
+    for (int i = 250; i < 255; ++i)
+        m_tunnelAddresses.append(QKnxAddress::createIndividual(1, 1, i));
+
+    if (network) {
+        m_socket = network->createSocket(address, this);
+        connect(m_socket, &QKnxNetIpDatagramSocket::readyRead, this,
+            &QKnxNetIpSimulatedTunnelingServer::readyRead);
+        m_socket->bind(address, port);
+    }
+
+    if (m_line) {
+        connect(m_line, &QKnxNetIpSimulatedLine::frameTransmitted, this,
+            &QKnxNetIpSimulatedTunnelingServer::processLineFrame);
+    }
+}
+
+void QKnxNetIpSimulatedTunnelingServer::setTunnelAddresses(const QVector<QKnxAddress> &addresses)
+{
+    m_tunnelAddresses = addresses;
+}
+
+void QKnxNetIpSimulatedTunnelingServer::readyRead()
+{
+    while (m_socket && m_socket->hasPendingDatagrams()) {
+        const auto datagram = m_socket->receiveDatagram();
+        const auto frame = QKnxNetIpFrame::fromBytes(QKnxByteArray::fromByteArray(datagram.data()));
+        if (!frame.isValid())
+            continue;
+
+        switch (frame.serviceType()) {
+        case QKnxNetIp::ServiceType::ConnectRequest:
+            processConnectRequest(frame, datagram);
+            break;
+        case QKnxNetIp::ServiceType::ConnectionStateRequest:
+            processConnectionStateRequest(frame, datagram);
+            break;
+        case QKnxNetIp::ServiceType::DisconnectRequest:
+            processDisconnectRequest(frame, datagram);
+            break;
+        case QKnxNetIp::ServiceType::TunnelingRequest:
+            processTunnelingRequest(frame);
+            break;
+        case QKnxNetIp::ServiceType::TunnelingAcknowledge:
+            processTunnelingAcknowledge(frame);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void QKnxNetIpSimulatedTunnelingServer::processConnectRequest(const QKnxNetIpFrame &frame,
+    const QNetworkDatagram &datagram)
+{
+    const QKnxNetIpConnectRequestProxy request(frame);
+    if (!request.isValid())
+        return;
+
+    Connection connection;
+    QKnxPrivate::endpointOf(request.controlEndpoint(), datagram, &connection.controlAddress,
+        &connection.controlPort);
+    QKnxPrivate::endpointOf(request.dataEndpoint(), datagram, &connection.dataAddress,
+        &connection.dataPort);
+
+    auto status = QKnxNetIp::Error::None;
+    const auto requestInformation = request.requestInformation();
+    const QKnxNetIpCriProxy cri(requestInformation);
+    if (cri.connectionType() != QKnxNetIp::ConnectionType::Tunnel) {
+        status = QKnxNetIp::Error::ConnectionType;
+    } else if (cri.tunnelLayer() != QKnxNetIp::TunnelLayer::Link) {
+        status = QKnxNetIp::Error::TunnelingLayer;
+    } else {
+        for (const auto &address : qAsConst(m_tunnelAddresses)) {
+            auto it = std::find_if(m_connections.cbegin(), m_connections.cend(),
+                [&address](const Connection &c) { return c.individualAddress == address; });
+            if (it == m_connections.cend()) {
+                connection.individualAddress = address;
+                break;
+            }
+        }
+        if (!connection.individualAddress.isValid() || m_connections.size() >= 255)
+            status = QKnxNetIp::Error::NoMoreConnections;
+    }
+
+    if (status != QKnxNetIp::Error::None) {
+        reply(QKnxNetIpConnectResponseProxy::builder()
+            .setStatus(status)
+            .create(), connection.controlAddress, connection.controlPort);
+        return;
+    }
+
+    while (m_nextChannelId == 0 || m_connections.contains(m_nextChannelId))
+        ++m_nextChannelId;
+    const quint8 channelId = m_nextChannelId++;
+
+    connection.acknowledgeTimer = new QTimer(this);
+    connection.acknowledgeTimer->setSingleShot(true);
+    connect(connection.acknowledgeTimer, &QTimer::timeout, this, [this, channelId]() {
+        auto it = m_connections.find(channelId);
+        if (it == m_connections.end())
+            return;
+
+        if (!it->repeated) {
+            it->repeated = true;
+            reply(it->lastRequest, it->dataAddress, it->dataPort);
+            it->acknowledgeTimer->start(QKnxNetIp::TunnelingRequestTimeout);
+        } else {
+            // give up on the frame, the sequence counter stays where the client expects it
+            it->waitForAcknowledgement = false;
+            sendNextRequest(channelId);
+        }
+    });
+    m_connections.insert(channelId, connection);
+
+    reply(QKnxNetIpConnectResponseProxy::builder()
+        .setChannelId(channelId)
+        .setStatus(QKnxNetIp::Error::None)
+        .setDataEndpoint(QKnxNetIpHpaiProxy::builder()
+            .setHostAddress(m_socket->localAddress())
+            .setPort(m_socket->localPort())
+            .create())
+        .setResponseData(QKnxNetIpCrdProxy::builder()
+            .setConnectionType(QKnxNetIp::ConnectionType::Tunnel)
+            .setIndividualAddress(connection.individualAddress)
+            .create())
+        .create(), connection.controlAddress, connection.controlPort);
+}
+
+void QKnxNetIpSimulatedTunnelingServer::processConnectionStateRequest(const QKnxNetIpFrame &frame,
+    const QNetworkDatagram &datagram)
+{
+    const QKnxNetIpConnectionStateRequestProxy request(frame);
+    if (!request.isValid())
+        return;
+
+    QHostAddress address;
+    quint16 port = 0;
+    QKnxPrivate::endpointOf(request.controlEndpoint(), datagram, &address, &port);
+
+    reply(QKnxNetIpConnectionStateResponseProxy::builder()
+        .setChannelId(request.channelId())
+        .setStatus(m_connections.contains(request.channelId()) ? QKnxNetIp::Error::None
+            : QKnxNetIp::Error::ConnectionId)
+        .create(), address, port);
+}
+
+void QKnxNetIpSimulatedTunnelingServer::processDisconnectRequest(const QKnxNetIpFrame &frame,
+    const QNetworkDatagram &datagram)
+{
+    const QKnxNetIpDisconnectRequestProxy request(frame);
+    if (!request.isValid())
+        return;
+
+    QHostAddress address;
+    quint16 port = 0;
+    QKnxPrivate::endpointOf(request.controlEndpoint(), datagram, &address, &port);
+
+    const auto it = m_connections.find(request.channelId());
+    const bool known = (it != m_connections.end());
+    if (known) {
+        it->acknowledgeTimer->deleteLater();
+        m_connections.erase(it);
+    }
+
+    reply(QKnxNetIpDisconnectResponseProxy::builder()
+        .setChannelId(request.channelId())
+        .setStatus(known ? QKnxNetIp::Error::None : QKnxNetIp::Error::ConnectionId)
+        .create(), address, port);
+}
+
+void QKnxNetIpSimulatedTunnelingServer::processTunnelingRequest(const QKnxNetIpFrame &frame)
+{
+    const QKnxNetIpTunnelingRequestProxy request(frame);
+    if (!request.isValid())
+        return;
+
+    const quint8 channelId = request.channelId();
+    auto it = m_connections.find(channelId);
+    if (it == m_connections.end())
+        return;
+
+    const quint8 sequenceNumber = request.sequenceNumber();
+    const bool expected = (sequenceNumber == it->receiveCount);
+    if (!expected && quint8(sequenceNumber + 1) != it->receiveCount)
+        return; // out of sequence, the client will repeat
+
+    reply(QKnxNetIpTunnelingAcknowledgeProxy::builder()
+        .setChannelId(channelId)
+        .setSequenceNumber(sequenceNumber)
+        .setStatus(QKnxNetIp::Error::None)
+        .create(), it->dataAddress, it->dataPort);
+
+    if (!expected)
+        return; // repeated request, acknowledged again but not processed twice
+    ++it->receiveCount;
+
+    auto cemi = request.cemi();
+    if (cemi.messageCode() != QKnxLinkLayerFrame::MessageCode::DataRequest)
+        return;
+    if (cemi.sourceAddress().isUnregistered())
+        cemi.setSourceAddress(it->individualAddress);
+
+    auto confirmation = cemi;
+    confirmation.setMessageCode(QKnxLinkLayerFrame::MessageCode::DataConfirmation);
+    sendTunnelingRequest(channelId, confirmation);
+
+    cemi.setMessageCode(QKnxLinkLayerFrame::MessageCode::DataIndication);
+    if (m_line)
+        m_line->transmit(cemi, this);
+
+    // the other clients of the server see the frame like any frame on the line
+    const auto channels = m_connections.keys();
+    for (const auto other : channels) {
+        if (other != channelId)
+            sendTunnelingRequest(other, cemi);
+    }
+}
+
+void QKnxNetIpSimulatedTunnelingServer::processTunnelingAcknowledge(const QKnxNetIpFrame &frame)
+{
+    const QKnxNetIpTunnelingAcknowledgeProxy acknowledge(frame);
+    if (!acknowledge.isValid())
+        return;
+
+    const quint8 channelId = acknowledge.channelId();
+    auto it = m_connections.find(channelId);
+    if (it == m_connections.end() || !it->waitForAcknowledgement)
+        return;
+
+    if (acknowledge.status() != QKnxNetIp::Error::None
+        || acknowledge.sequenceNumber() != it->sendCount) {
+        return; // the acknowledge timer repeats the request
+    }
+
+    it->acknowledgeTimer->stop();
+    it->waitForAcknowledgement = false;
+    ++it->sendCount;
+    sendNextRequest(channelId);
+}
+
+void QKnxNetIpSimulatedTunnelingServer::processLineFrame(const QKnxLinkLayerFrame &frame,
+    QObject *source)
+{
+    if (source == this)
+        return;
+
+    const auto channels = m_connections.keys();
+    for (const auto channelId : channels)
+        sendTunnelingRequest(channelId, frame);
+}
+
+void QKnxNetIpSimulatedTunnelingServer::sendTunnelingRequest(quint8 channelId,
+    const QKnxLinkLayerFrame &frame)
+{
+    auto it = m_connections.find(channelId);
+    if (it == m_connections.end())
+        return;
+    it->pending.enqueue(frame);
+    sendNextRequest(channelId);
+}
+
+void QKnxNetIpSimulatedTunnelingServer::sendNextRequest(quint8 channelId)
+{
+    auto it = m_connections.find(channelId);
+    if (it == m_connections.end() || it->waitForAcknowledgement || it->pending.isEmpty())
+        return;
+
+    it->lastRequest = QKnxNetIpTunnelingRequestProxy::builder()
+        .setChannelId(channelId)
+        .setSequenceNumber(it->sendCount)
+        .setCemi(it->pending.dequeue())
+        .create();
+    it->repeated = false;
+    it->waitForAcknowledgement = true;
+    it->acknowledgeTimer->start(QKnxNetIp::TunnelingRequestTimeout);
+    reply(it->lastRequest, it->dataAddress, it->dataPort);
+}
+
+void QKnxNetIpSimulatedTunnelingServer::reply(const QKnxNetIpFrame &frame,
+    const QHostAddress &address, quint16 port)
+{
+    if (m_socket)
+        m_socket->writeDatagram(frame.bytes().toByteArray(), address, port);
+}
+
+QT_END_NAMESPACE
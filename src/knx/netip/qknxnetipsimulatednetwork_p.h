@@ -0,0 +1,278 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#ifndef QKNXNETIPSIMULATEDNETWORK_P_H
+#define QKNXNETIPSIMULATEDNETWORK_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qrandom.h>
+#include <QtCore/qset.h>
+#include <QtCore/qtimer.h>
+
+#include <QtKnx/qtknxglobal.h>
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/private/qknxnetipdatagramsocket_p.h>
+
+#include <QtNetwork/qhostaddress.h>
+#include <QtNetwork/qnetworkdatagram.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpEndpointConnection;
+class QKnxNetIpRouter;
+class QKnxNetIpSimulatedSocket;
+
+// In-process KNXnet/IP network. Datagrams written to sockets created by the
+// network are delivered to the other sockets of the network after a random
+// latency, and may be lost or reordered. All randomness is drawn from a
+// seeded generator, so a test run can be repeated exactly.
+class Q_KNX_EXPORT QKnxNetIpSimulatedNetwork : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QKnxNetIpSimulatedNetwork(QObject *parent = nullptr);
+    ~QKnxNetIpSimulatedNetwork() override;
+
+    quint32 seed() const { return m_seed; }
+    void setSeed(quint32 seed);
+
+    int minimumLatency() const { return m_minimumLatency; }
+    int maximumLatency() const { return m_maximumLatency; }
+    void setLatency(int minimum, int maximum = -1);
+
+    double lossRate() const { return m_lossRate; }
+    void setLossRate(double rate);
+
+    double reorderRate() const { return m_reorderRate; }
+    void setReorderRate(double rate);
+
+    void attach(QKnxNetIpRouter *router, const QHostAddress &address);
+    void attach(QKnxNetIpEndpointConnection *connection, const QHostAddress &address);
+
+    QKnxNetIpDatagramSocket *createSocket(const QHostAddress &address, QObject *parent = nullptr);
+
+    qint64 inject(const QByteArray &datagram, const QHostAddress &sender, quint16 senderPort,
+        const QHostAddress &destination, quint16 port);
+
+    int pendingDatagrams() const { return m_inFlight.size(); }
+    void flush();
+
+    quint64 datagramsSent() const { return m_sent; }
+    quint64 datagramsDelivered() const { return m_delivered; }
+    quint64 datagramsLost() const { return m_lost; }
+
+Q_SIGNALS:
+    void datagramSent(const QNetworkDatagram &datagram);
+
+private:
+    friend class QKnxNetIpSimulatedSocket;
+
+    quint16 allocatePort();
+    qint64 send(const QNetworkDatagram &datagram);
+    void deliverDue(bool all = false);
+    void scheduleDelivery();
+
+    quint32 m_seed { 0 };
+    QRandomGenerator m_random { 0u };
+    int m_minimumLatency { 0 };
+    int m_maximumLatency { 0 };
+    double m_lossRate { 0. };
+    double m_reorderRate { 0. };
+
+    QList<QKnxNetIpSimulatedSocket *> m_sockets;
+    quint16 m_nextPort { 49152 };
+
+    // datagrams on the wire, ordered by due time and then by send order
+    QMap<QPair<qint64, quint64>, QNetworkDatagram> m_inFlight;
+    quint64 m_sequence { 0 };
+    QElapsedTimer m_clock;
+    QTimer m_deliveryTimer;
+
+    quint64 m_sent { 0 };
+    quint64 m_delivered { 0 };
+    quint64 m_lost { 0 };
+};
+
+// A KNX twisted pair line. Frames transmitted on the line are indicated to
+// every other participant one event loop iteration later.
+class Q_KNX_EXPORT QKnxNetIpSimulatedLine : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QKnxNetIpSimulatedLine(QObject *parent = nullptr);
+    ~QKnxNetIpSimulatedLine() override = default;
+
+    void transmit(const QKnxLinkLayerFrame &frame, QObject *source = nullptr);
+    quint64 framesTransmitted() const { return m_transmitted; }
+
+Q_SIGNALS:
+    void frameTransmitted(const QKnxLinkLayerFrame &frame, QObject *source);
+
+private:
+    quint64 m_transmitted { 0 };
+};
+
+// A twisted pair device holding one value per group address. It answers
+// group value reads and takes over group value writes seen on its line.
+class Q_KNX_EXPORT QKnxNetIpSimulatedDevice : public QObject
+{
+    Q_OBJECT
+
+public:
+    QKnxNetIpSimulatedDevice(const QKnxAddress &individualAddress, QKnxNetIpSimulatedLine *line,
+        QObject *parent = nullptr);
+    ~QKnxNetIpSimulatedDevice() override = default;
+
+    QKnxAddress individualAddress() const { return m_individualAddress; }
+
+    bool hasGroupObject(const QKnxAddress &group) const { return m_values.contains(group); }
+    QKnxByteArray groupValue(const QKnxAddress &group) const { return m_values.value(group); }
+    void setGroupValue(const QKnxAddress &group, const QKnxByteArray &value);
+
+    void writeGroupValue(const QKnxAddress &group, const QKnxByteArray &value);
+    void readGroupValue(const QKnxAddress &group);
+
+    quint64 framesReceived() const { return m_received; }
+
+Q_SIGNALS:
+    void groupValueChanged(const QKnxAddress &group, const QKnxByteArray &value);
+
+private:
+    void process(const QKnxLinkLayerFrame &frame, QObject *source);
+    void transmit(const QKnxAddress &group, const QKnxTpdu &tpdu);
+
+    QKnxAddress m_individualAddress;
+    QPointer<QKnxNetIpSimulatedLine> m_line;
+    QHash<QKnxAddress, QKnxByteArray> m_values;
+    quint64 m_received { 0 };
+};
+
+// A KNX IP router coupling a line to the multicast group of the network. It
+// uses QKnxNetIpRouter for the IP side and can be made to answer every
+// routing indication with a routing busy frame.
+class Q_KNX_EXPORT QKnxNetIpSimulatedRouter : public QObject
+{
+    Q_OBJECT
+
+public:
+    QKnxNetIpSimulatedRouter(const QHostAddress &address, QKnxNetIpSimulatedNetwork *network,
+        QKnxNetIpSimulatedLine *line, QObject *parent = nullptr);
+    ~QKnxNetIpSimulatedRouter() override;
+
+    QKnxNetIpRouter *router() const { return m_router; }
+
+    bool isBusy() const { return m_busy; }
+    void setBusy(bool busy, quint16 waitTime = 100);
+
+    void start();
+    void stop();
+
+private:
+    QKnxNetIpRouter *m_router { nullptr };
+    QPointer<QKnxNetIpSimulatedLine> m_line;
+    bool m_busy { false };
+    quint16 m_busyWaitTime { 100 };
+};
+
+// A KNXnet/IP tunneling server coupling UDP tunneling connections to a line.
+// Each connection gets one of the configured tunnel addresses.
+class Q_KNX_EXPORT QKnxNetIpSimulatedTunnelingServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    QKnxNetIpSimulatedTunnelingServer(const QHostAddress &address, quint16 port,
+        QKnxNetIpSimulatedNetwork *network, QKnxNetIpSimulatedLine *line,
+        QObject *parent = nullptr);
+    ~QKnxNetIpSimulatedTunnelingServer() override = default;
+
+    QVector<QKnxAddress> tunnelAddresses() const { return m_tunnelAddresses; }
+    void setTunnelAddresses(const QVector<QKnxAddress> &addresses);
+
+    int connectionCount() const { return m_connections.size(); }
+
+private:
+    struct Connection
+    {
+        QHostAddress controlAddress;
+        quint16 controlPort { 0 };
+        QHostAddress dataAddress;
+        quint16 dataPort { 0 };
+        QKnxAddress individualAddress;
+        quint8 sendCount { 0 };
+        quint8 receiveCount { 0 };
+        QQueue<QKnxLinkLayerFrame> pending;
+        QKnxNetIpFrame lastRequest;
+        bool waitForAcknowledgement { false };
+        bool repeated { false };
+        QTimer *acknowledgeTimer { nullptr };
+    };
+
+    void readyRead();
+    void processConnectRequest(const QKnxNetIpFrame &frame, const QNetworkDatagram &datagram);
+    void processConnectionStateRequest(const QKnxNetIpFrame &frame,
+        const QNetworkDatagram &datagram);
+    void processDisconnectRequest(const QKnxNetIpFrame &frame, const QNetworkDatagram &datagram);
+    void processTunnelingRequest(const QKnxNetIpFrame &frame);
+    void processTunnelingAcknowledge(const QKnxNetIpFrame &frame);
+    void processLineFrame(const QKnxLinkLayerFrame &frame, QObject *source);
+
+    void sendTunnelingRequest(quint8 channelId, const QKnxLinkLayerFrame &frame);
+    void sendNextRequest(quint8 channelId);
+    void reply(const QKnxNetIpFrame &frame, const QHostAddress &address, quint16 port);
+
+    QKnxNetIpDatagramSocket *m_socket { nullptr };
+    QPointer<QKnxNetIpSimulatedLine> m_line;
+    QVector<QKnxAddress> m_tunnelAddresses;
+    QMap<quint8, Connection> m_connections;
+    quint8 m_nextChannelId { 1 };
+};
+
+QT_END_NAMESPACE
+
+#endif
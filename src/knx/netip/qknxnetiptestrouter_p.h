@@ -70,7 +70,7 @@ public:
         // address is assigned to trick the router into not discarding packets that
         // have the same address as the interface used by the QKnxNetIpRouter
         if (readAllPackets)
-            m_router->m_ownAddress = QHostAddress(16843010); //  setting ip 1.1.1.2
+            m_router->m_ownAddresses = { QHostAddress(16843010) }; //  setting ip 1.1.1.2
         socket->waitForReadyRead(1);
     }
 
@@ -308,8 +308,6 @@ QKnxNetIpTimerNotifyProxy::Builder &
     Technology Preview, and therefore the API and functionality provided
     by the class may be subject to change at any time without prior notice.
 
-    \note To use this class OpenSSL must be supported on your target system.
-
     This frame will be sent during secure KNXnet/IP multicast group
     communication to keep the multicast group member's timer values
     synchronized. The frame is therefore sent to the KNXnet/IP routing
@@ -401,7 +399,6 @@ QKnxNetIpTimerNotifyProxy::SecureBuilder &
 QKnxNetIpFrame
     QKnxNetIpTimerNotifyProxy::SecureBuilder::create(const QKnxByteArray &backboneKey, quint16 ssid) const
 {
-#if QT_CONFIG(opensslv11)
     if (d_ptr->m_timer > Q_UINT48_MAX || d_ptr->m_serial.size() != 6 || d_ptr->m_tag < 0)
         return { QKnxNetIp::ServiceType::TimerNotify };
 
@@ -420,11 +417,6 @@ QKnxNetIpFrame
         d_ptr->m_timer, d_ptr->m_serial, d_ptr->m_tag);
 
     return builder.setMessageAuthenticationCode(mac).create();
-#else
-    Q_UNUSED(backboneKey)
-    Q_UNUSED(ssid)
-    return { QKnxNetIp::ServiceType::TimerNotify };
-#endif
 }
 
 /*!
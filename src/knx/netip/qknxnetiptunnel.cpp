@@ -29,6 +29,7 @@
 
 #include "qknxnetipconnectresponse.h"
 #include "qknxnetipendpointconnection_p.h"
+#include "qknxnetipsendqueue_p.h"
 #include "qknxnetiptunnel.h"
 #include "qknxnetiptunnelingfeatureinfo.h"
 #include "qknxnetiptunnelingrequest.h"
@@ -113,11 +114,17 @@ public:
 
     void process(const QKnxLinkLayerFrame &frame) override;
     void processConnectResponse(const QKnxNetIpFrame &frame) override;
+    void processTunnelingAcknowledge(const QKnxNetIpFrame &frame) override;
     void processTunnelingFeatureFrame(const QKnxNetIpFrame &frame) override;
 
+    void sendQueuedFrames();
+
 private:
     QKnxAddress m_address;
     QKnxNetIp::TunnelLayer m_layer { QKnxNetIp::TunnelLayer::Unknown };
+
+    // link layer frames waiting for the acknowledge of the previous request
+    QKnxNetIpSendQueue<QKnxLinkLayerFrame> m_sendQueue;
 };
 
 void QKnxNetIpTunnelPrivate::process(const QKnxLinkLayerFrame &frame)
@@ -139,10 +146,32 @@ void QKnxNetIpTunnelPrivate::processConnectResponse(const QKnxNetIpFrame &frame)
     if (q->state() != QKnxNetIpTunnel::Connected) {
         const auto &crd = response.responseData();
         m_address = QKnxNetIpCrdProxy(crd).individualAddress();
+        m_sendQueue.clear(); // do not leak frames into a new connection
     }
     QKnxNetIpEndpointConnectionPrivate::processConnectResponse(frame);
 }
 
+void QKnxNetIpTunnelPrivate::processTunnelingAcknowledge(const QKnxNetIpFrame &frame)
+{
+    QKnxNetIpEndpointConnectionPrivate::processTunnelingAcknowledge(frame);
+
+    // the previous request has been acknowledged, send the next queued frame
+    sendQueuedFrames();
+}
+
+void QKnxNetIpTunnelPrivate::sendQueuedFrames()
+{
+    while (!m_waitForAcknowledgement && !m_sendQueue.isEmpty()) {
+        if (!sendTunnelingRequest(m_sendQueue.head())) {
+            // keep the frame queued, it is retried with the next frame sent or acknowledged
+            setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Cemi,
+                QKnxNetIpTunnel::tr("Could not send queued tunneling request."));
+            return;
+        }
+        m_sendQueue.dequeue();
+    }
+}
+
 void QKnxNetIpTunnelPrivate::processTunnelingFeatureFrame(const QKnxNetIpFrame &frame)
 {
     Q_Q(QKnxNetIpTunnel);
@@ -253,7 +282,14 @@ void QKnxNetIpTunnel::setTunnelLayer(QKnxNetIp::TunnelLayer layer)
     If no connection is currently established, returns \c false and does not
     send the frame.
 
-    \sa QKnxNetIpEndpointConnection::State
+    Over UDP, only one tunneling request can wait for its acknowledge at a
+    time. Without a send queue, the function returns \c false while the
+    previous request is not yet acknowledged. With a send queue, the frame is
+    queued instead and sent in priority order once the server acknowledged the
+    previous request. If a queued frame cannot be sent, errorOccurred() is
+    emitted and the frame stays at the head of the queue.
+
+    \sa QKnxNetIpEndpointConnection::State, setSendQueueCapacity()
 */
 bool QKnxNetIpTunnel::sendFrame(const QKnxLinkLayerFrame &frame)
 {
@@ -264,9 +300,50 @@ bool QKnxNetIpTunnel::sendFrame(const QKnxLinkLayerFrame &frame)
     if (d->m_layer == QKnxNetIp::TunnelLayer::Busmonitor)
         return false; // 03_08_04 Tunneling v01.05.03, paragraph 2.4
 
+    if (d->m_udpSocket && d->m_sendQueue.capacity() > 0
+        && (d->m_waitForAcknowledgement || !d->m_sendQueue.isEmpty())) {
+        const bool queued = d->m_sendQueue.enqueue(frame.controlField().priority(), frame);
+        d->sendQueuedFrames(); // resumes a queue left behind by a failed send
+        return queued;
+    }
     return d->sendTunnelingRequest(frame);
 }
 
+/*!
+    \since 5.15
+
+    Returns the maximum number of link layer frames the tunnel queues while it
+    waits for the acknowledge of a previous tunneling request. The default
+    value is \c 0, which disables the queue.
+
+    \sa setSendQueueCapacity()
+*/
+int QKnxNetIpTunnel::sendQueueCapacity() const
+{
+    Q_D(const QKnxNetIpTunnel);
+    return d->m_sendQueue.capacity();
+}
+
+/*!
+    \since 5.15
+
+    Sets the maximum number of queued link layer frames to \a capacity.
+
+    Queued frames are sent in the order of the priority of their control
+    field: \c System and \c Urgent frames go first, \c Normal and \c Low
+    frames share the remaining bandwidth at a 3:1 ratio. A frame class is
+    never passed over more than 16 times in a row. If the queue is full, the
+    newest frame of the lowest queued priority is dropped to make room for a
+    frame of higher priority.
+
+    \sa QKnxControlField::Priority, QKnxNetIpRouter::setSendQueueCapacity()
+*/
+void QKnxNetIpTunnel::setSendQueueCapacity(int capacity)
+{
+    Q_D(QKnxNetIpTunnel);
+    d->m_sendQueue.setCapacity(capacity);
+}
+
 /*!
     \since 5.12
 
@@ -63,6 +63,9 @@ public:
 
     bool sendFrame(const QKnxLinkLayerFrame &frame);
 
+    int sendQueueCapacity() const;
+    void setSendQueueCapacity(int capacity);
+
     bool sendTunnelingFeatureGet(QKnx::InterfaceFeature feature);
     bool sendTunnelingFeatureSet(QKnx::InterfaceFeature feature, const QKnxByteArray &value);
 
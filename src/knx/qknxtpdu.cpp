@@ -161,6 +161,9 @@ QT_BEGIN_NAMESPACE
     \value DomainAddressSerialNumberResponse
     \value DomainAddressSerialNumberWrite
     \value FileStreamInfoReport
+    \value SecureService
+            KNX Data Secure service (S-A_Data and S-A_Sync). This value was
+            introduced in Qt 5.15.
     \value Invalid
 */
 
@@ -365,6 +368,10 @@ bool QKnxTpdu::isValid() const
     case ApplicationControlField::DomainAddressSerialNumberWrite: // 6 byteToTest serial number
 
         return (size() == HEADER_SIZE + 8) || (size() == HEADER_SIZE + 12); // 2 or 6 byteToTest domain tpdu
+
+    case ApplicationControlField::SecureService:
+        // AN158: SCF, 6 bytes sequence number, secured APDU, 4 bytes MAC
+        return (size() >= HEADER_SIZE + 1 + 6 + 4) && (size() <= HEADER_SIZE + L_DATA_EXTENDED_PAYLOAD);
     case ApplicationControlField::AdcRead:
     case ApplicationControlField::AdcResponse:
     case ApplicationControlField::UserMemoryRead:
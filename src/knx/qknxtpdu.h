@@ -154,6 +154,7 @@ public:
         DomainAddressSerialNumberResponse = 0x03ed,
         DomainAddressSerialNumberWrite = 0x03ee,
         FileStreamInfoReport = 0x03f0,
+        SecureService = 0x03f1,
 
         Invalid = 0x00ff
     };
@@ -0,0 +1,537 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxaes_p.h"
+
+#include <QtCore/private/qsimd_p.h>
+
+#if QT_COMPILER_SUPPORTS_HERE(AES) && defined(Q_PROCESSOR_X86)
+# define QT_KNX_AES_NI
+#endif
+
+#if defined(Q_PROCESSOR_ARM_64) && defined(__ARM_FEATURE_CRYPTO)
+# define QT_KNX_ARM_CRYPTO
+# include <arm_neon.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QKnxAes128
+
+    The QKnxAes128 class implements the AES-128 forward cipher without any
+    dependency on OpenSSL. It is used by the native backend of
+    QKnxSslBlockCipher and covers everything needed by the CCM mode of
+    KNXnet/IP secure: ECB encryption of counter blocks and the CBC-MAC.
+
+    If the CPU provides AES instructions (AES-NI on x86, the cryptographic
+    extensions on ARMv8), they are used. Otherwise a portable implementation
+    is used that computes the S-box arithmetically, without table lookups or
+    branches depending on key or data, so that its timing does not leak any
+    secret.
+*/
+
+namespace QKnxPrivate
+{
+    static const quint64 LaneLsb = Q_UINT64_C(0x0101010101010101);
+
+    // the following functions process eight independent bytes at once
+    static inline quint64 xtime8(quint64 x)
+    {
+        return ((x & Q_UINT64_C(0x7f7f7f7f7f7f7f7f)) << 1) ^ (((x >> 7) & LaneLsb) * 0x1b);
+    }
+
+    static inline quint64 multiply8(quint64 a, quint64 b)
+    {
+        quint64 r = 0;
+        for (int i = 0; i < 8; ++i) {
+            r ^= a & (((b >> i) & LaneLsb) * 0xff);
+            a = xtime8(a);
+        }
+        return r;
+    }
+
+    static inline quint64 rotate8(quint64 x, int n)
+    {
+        return ((x << n) & (LaneLsb * quint8(0xff << n)))
+            | ((x >> (8 - n)) & (LaneLsb * quint8((1 << n) - 1)));
+    }
+
+    static quint64 subBytes8(quint64 x)
+    {
+        // multiplicative inverse as x^254, mapping 0 to 0
+        const quint64 x2 = multiply8(x, x);
+        const quint64 x3 = multiply8(x2, x);
+        const quint64 x6 = multiply8(x3, x3);
+        const quint64 x12 = multiply8(x6, x6);
+        const quint64 x14 = multiply8(x12, x2);
+        quint64 y = multiply8(x12, x3); // x^15
+        for (int i = 0; i < 4; ++i)
+            y = multiply8(y, y); // x^240
+        y = multiply8(y, x14);
+
+        // affine transformation
+        return y ^ rotate8(y, 1) ^ rotate8(y, 2) ^ rotate8(y, 3) ^ rotate8(y, 4)
+            ^ (LaneLsb * 0x63);
+    }
+
+    static void subBytes(quint8 *state)
+    {
+        quint64 lanes[2];
+        memcpy(lanes, state, 16);
+        lanes[0] = subBytes8(lanes[0]);
+        lanes[1] = subBytes8(lanes[1]);
+        memcpy(state, lanes, 16);
+    }
+
+    static inline quint8 xtime(quint8 x)
+    {
+        return quint8((x << 1) ^ (((x >> 7) & 1) * 0x1b));
+    }
+
+    static void shiftRowsAndMixColumns(quint8 *state, bool mixColumns)
+    {
+        quint8 t[16];
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r)
+                t[4 * c + r] = state[4 * ((c + r) & 3) + r];
+        }
+
+        if (!mixColumns) {
+            memcpy(state, t, 16);
+            return;
+        }
+
+        for (int c = 0; c < 4; ++c) {
+            const quint8 *a = t + 4 * c;
+            const quint8 all = a[0] ^ a[1] ^ a[2] ^ a[3];
+            for (int r = 0; r < 4; ++r)
+                state[4 * c + r] = a[r] ^ all ^ xtime(a[r] ^ a[(r + 1) & 3]);
+        }
+    }
+
+    static inline void addRoundKey(quint8 *state, const quint8 *roundKey)
+    {
+        for (int i = 0; i < 16; ++i)
+            state[i] ^= roundKey[i];
+    }
+
+    static void encryptPortable(const quint8 *roundKeys, const quint8 *in, quint8 *out)
+    {
+        quint8 state[16];
+        memcpy(state, in, 16);
+        addRoundKey(state, roundKeys);
+        for (int round = 1; round <= 10; ++round) {
+            subBytes(state);
+            shiftRowsAndMixColumns(state, round != 10);
+            addRoundKey(state, roundKeys + 16 * round);
+        }
+        memcpy(out, state, 16);
+    }
+
+    static void expandKey(const quint8 *key, quint8 *roundKeys)
+    {
+        memcpy(roundKeys, key, 16);
+
+        quint8 rcon = 0x01;
+        for (int i = 16; i < 176; i += 4) {
+            quint8 word[4] = { roundKeys[i - 4], roundKeys[i - 3], roundKeys[i - 2],
+                roundKeys[i - 1] };
+            if ((i % 16) == 0) {
+                quint64 lane = quint64(word[1]) | quint64(word[2]) << 8
+                    | quint64(word[3]) << 16 | quint64(word[0]) << 24;
+                lane = subBytes8(lane);
+                word[0] = quint8(lane) ^ rcon;
+                word[1] = quint8(lane >> 8);
+                word[2] = quint8(lane >> 16);
+                word[3] = quint8(lane >> 24);
+                rcon = xtime(rcon);
+            }
+            for (int j = 0; j < 4; ++j)
+                roundKeys[i + j] = roundKeys[i - 16 + j] ^ word[j];
+        }
+    }
+
+#ifdef QT_KNX_AES_NI
+    QT_FUNCTION_TARGET(AES)
+    static void encryptAesNi(const quint8 *roundKeys, const quint8 *in, quint8 *out, int blocks)
+    {
+        __m128i k[11];
+        for (int i = 0; i < 11; ++i)
+            k[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(roundKeys) + i);
+
+        const auto src = reinterpret_cast<const __m128i *>(in);
+        const auto dst = reinterpret_cast<__m128i *>(out);
+
+        int i = 0;
+        for (; i + 4 <= blocks; i += 4) { // interleave independent blocks
+            __m128i s0 = _mm_xor_si128(_mm_loadu_si128(src + i), k[0]);
+            __m128i s1 = _mm_xor_si128(_mm_loadu_si128(src + i + 1), k[0]);
+            __m128i s2 = _mm_xor_si128(_mm_loadu_si128(src + i + 2), k[0]);
+            __m128i s3 = _mm_xor_si128(_mm_loadu_si128(src + i + 3), k[0]);
+            for (int r = 1; r < 10; ++r) {
+                s0 = _mm_aesenc_si128(s0, k[r]);
+                s1 = _mm_aesenc_si128(s1, k[r]);
+                s2 = _mm_aesenc_si128(s2, k[r]);
+                s3 = _mm_aesenc_si128(s3, k[r]);
+            }
+            _mm_storeu_si128(dst + i, _mm_aesenclast_si128(s0, k[10]));
+            _mm_storeu_si128(dst + i + 1, _mm_aesenclast_si128(s1, k[10]));
+            _mm_storeu_si128(dst + i + 2, _mm_aesenclast_si128(s2, k[10]));
+            _mm_storeu_si128(dst + i + 3, _mm_aesenclast_si128(s3, k[10]));
+        }
+        for (; i < blocks; ++i) {
+            __m128i s = _mm_xor_si128(_mm_loadu_si128(src + i), k[0]);
+            for (int r = 1; r < 10; ++r)
+                s = _mm_aesenc_si128(s, k[r]);
+            _mm_storeu_si128(dst + i, _mm_aesenclast_si128(s, k[10]));
+        }
+    }
+
+    QT_FUNCTION_TARGET(AES)
+    static inline __m128i cbcMacBlocksAesNi(const __m128i *k, const __m128i *src, int from,
+        int to, __m128i s)
+    {
+        for (int i = from; i < to; ++i) {
+            s = _mm_xor_si128(_mm_xor_si128(s, _mm_loadu_si128(src + i)), k[0]);
+            for (int r = 1; r < 10; ++r)
+                s = _mm_aesenc_si128(s, k[r]);
+            s = _mm_aesenclast_si128(s, k[10]);
+        }
+        return s;
+    }
+
+    QT_FUNCTION_TARGET(AES)
+    static void cbcMacAesNi(const quint8 *roundKeys, const quint8 *in, int blocks, quint8 *mac)
+    {
+        __m128i k[11];
+        for (int i = 0; i < 11; ++i)
+            k[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(roundKeys) + i);
+
+        const auto src = reinterpret_cast<const __m128i *>(in);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(mac),
+            cbcMacBlocksAesNi(k, src, 0, blocks, _mm_setzero_si128()));
+    }
+
+    QT_FUNCTION_TARGET(AES)
+    static void cbcMacAesNi(const quint8 *roundKeys, const quint8 *in, const int *blocks,
+        int count, quint8 *macs)
+    {
+        __m128i k[11];
+        for (int i = 0; i < 11; ++i)
+            k[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(roundKeys) + i);
+
+        auto src = reinterpret_cast<const __m128i *>(in);
+        const auto dst = reinterpret_cast<__m128i *>(macs);
+
+        int m = 0;
+        for (; m + 4 <= count; m += 4) { // interleave the chains of independent messages
+            const auto p0 = src;
+            const auto p1 = p0 + blocks[m];
+            const auto p2 = p1 + blocks[m + 1];
+            const auto p3 = p2 + blocks[m + 2];
+            src = p3 + blocks[m + 3];
+
+            const int common = qMin(qMin(blocks[m], blocks[m + 1]),
+                qMin(blocks[m + 2], blocks[m + 3]));
+
+            __m128i s0 = _mm_setzero_si128(), s1 = s0, s2 = s0, s3 = s0;
+            for (int i = 0; i < common; ++i) {
+                s0 = _mm_xor_si128(_mm_xor_si128(s0, _mm_loadu_si128(p0 + i)), k[0]);
+                s1 = _mm_xor_si128(_mm_xor_si128(s1, _mm_loadu_si128(p1 + i)), k[0]);
+                s2 = _mm_xor_si128(_mm_xor_si128(s2, _mm_loadu_si128(p2 + i)), k[0]);
+                s3 = _mm_xor_si128(_mm_xor_si128(s3, _mm_loadu_si128(p3 + i)), k[0]);
+                for (int r = 1; r < 10; ++r) {
+                    s0 = _mm_aesenc_si128(s0, k[r]);
+                    s1 = _mm_aesenc_si128(s1, k[r]);
+                    s2 = _mm_aesenc_si128(s2, k[r]);
+                    s3 = _mm_aesenc_si128(s3, k[r]);
+                }
+                s0 = _mm_aesenclast_si128(s0, k[10]);
+                s1 = _mm_aesenclast_si128(s1, k[10]);
+                s2 = _mm_aesenclast_si128(s2, k[10]);
+                s3 = _mm_aesenclast_si128(s3, k[10]);
+            }
+
+            // the remaining blocks of the longer messages are chained one by one
+            _mm_storeu_si128(dst + m, cbcMacBlocksAesNi(k, p0, common, blocks[m], s0));
+            _mm_storeu_si128(dst + m + 1, cbcMacBlocksAesNi(k, p1, common, blocks[m + 1], s1));
+            _mm_storeu_si128(dst + m + 2, cbcMacBlocksAesNi(k, p2, common, blocks[m + 2], s2));
+            _mm_storeu_si128(dst + m + 3, cbcMacBlocksAesNi(k, p3, common, blocks[m + 3], s3));
+        }
+        for (; m < count; ++m) {
+            _mm_storeu_si128(dst + m, cbcMacBlocksAesNi(k, src, 0, blocks[m], _mm_setzero_si128()));
+            src += blocks[m];
+        }
+    }
+#endif
+
+#ifdef QT_KNX_ARM_CRYPTO
+    static inline uint8x16_t encryptBlockArm(const uint8x16_t *k, uint8x16_t s)
+    {
+        for (int r = 0; r < 9; ++r)
+            s = vaesmcq_u8(vaeseq_u8(s, k[r]));
+        return veorq_u8(vaeseq_u8(s, k[9]), k[10]);
+    }
+
+    static void encryptArm(const quint8 *roundKeys, const quint8 *in, quint8 *out, int blocks)
+    {
+        uint8x16_t k[11];
+        for (int i = 0; i < 11; ++i)
+            k[i] = vld1q_u8(roundKeys + 16 * i);
+        for (int i = 0; i < blocks; ++i)
+            vst1q_u8(out + 16 * i, encryptBlockArm(k, vld1q_u8(in + 16 * i)));
+    }
+
+    static inline uint8x16_t cbcMacBlocksArm(const uint8x16_t *k, const quint8 *in, int from,
+        int to, uint8x16_t s)
+    {
+        for (int i = from; i < to; ++i)
+            s = encryptBlockArm(k, veorq_u8(s, vld1q_u8(in + 16 * i)));
+        return s;
+    }
+
+    static void cbcMacArm(const quint8 *roundKeys, const quint8 *in, int blocks, quint8 *mac)
+    {
+        uint8x16_t k[11];
+        for (int i = 0; i < 11; ++i)
+            k[i] = vld1q_u8(roundKeys + 16 * i);
+        vst1q_u8(mac, cbcMacBlocksArm(k, in, 0, blocks, vdupq_n_u8(0)));
+    }
+
+    static void cbcMacArm(const quint8 *roundKeys, const quint8 *in, const int *blocks, int count,
+        quint8 *macs)
+    {
+        uint8x16_t k[11];
+        for (int i = 0; i < 11; ++i)
+            k[i] = vld1q_u8(roundKeys + 16 * i);
+
+        int m = 0;
+        for (; m + 4 <= count; m += 4) { // interleave the chains of independent messages
+            const quint8 *p0 = in;
+            const quint8 *p1 = p0 + 16 * blocks[m];
+            const quint8 *p2 = p1 + 16 * blocks[m + 1];
+            const quint8 *p3 = p2 + 16 * blocks[m + 2];
+            in = p3 + 16 * blocks[m + 3];
+
+            const int common = qMin(qMin(blocks[m], blocks[m + 1]),
+                qMin(blocks[m + 2], blocks[m + 3]));
+
+            uint8x16_t s0 = vdupq_n_u8(0), s1 = s0, s2 = s0, s3 = s0;
+            for (int i = 0; i < common; ++i) {
+                s0 = veorq_u8(s0, vld1q_u8(p0 + 16 * i));
+                s1 = veorq_u8(s1, vld1q_u8(p1 + 16 * i));
+                s2 = veorq_u8(s2, vld1q_u8(p2 + 16 * i));
+                s3 = veorq_u8(s3, vld1q_u8(p3 + 16 * i));
+                for (int r = 0; r < 9; ++r) {
+                    s0 = vaesmcq_u8(vaeseq_u8(s0, k[r]));
+                    s1 = vaesmcq_u8(vaeseq_u8(s1, k[r]));
+                    s2 = vaesmcq_u8(vaeseq_u8(s2, k[r]));
+                    s3 = vaesmcq_u8(vaeseq_u8(s3, k[r]));
+                }
+                s0 = veorq_u8(vaeseq_u8(s0, k[9]), k[10]);
+                s1 = veorq_u8(vaeseq_u8(s1, k[9]), k[10]);
+                s2 = veorq_u8(vaeseq_u8(s2, k[9]), k[10]);
+                s3 = veorq_u8(vaeseq_u8(s3, k[9]), k[10]);
+            }
+
+            // the remaining blocks of the longer messages are chained one by one
+            vst1q_u8(macs + 16 * m, cbcMacBlocksArm(k, p0, common, blocks[m], s0));
+            vst1q_u8(macs + 16 * (m + 1), cbcMacBlocksArm(k, p1, common, blocks[m + 1], s1));
+            vst1q_u8(macs + 16 * (m + 2), cbcMacBlocksArm(k, p2, common, blocks[m + 2], s2));
+            vst1q_u8(macs + 16 * (m + 3), cbcMacBlocksArm(k, p3, common, blocks[m + 3], s3));
+        }
+        for (; m < count; ++m) {
+            vst1q_u8(macs + 16 * m, cbcMacBlocksArm(k, in, 0, blocks[m], vdupq_n_u8(0)));
+            in += 16 * blocks[m];
+        }
+    }
+#endif
+}
+
+/*!
+    \internal
+
+    Creates a cipher for the 16 byte \a key using the fastest implementation
+    supported by the CPU.
+*/
+QKnxAes128::QKnxAes128(const quint8 *key)
+    : QKnxAes128(key, bestImplementation())
+{}
+
+/*!
+    \internal
+
+    Creates a cipher for the 16 byte \a key using the given
+    \a implementation. Falls back to the portable implementation if
+    \a implementation is not supported.
+*/
+QKnxAes128::QKnxAes128(const quint8 *key, Implementation implementation)
+    : m_implementation(isSupported(implementation) ? implementation : Implementation::Portable)
+{
+    QKnxPrivate::expandKey(key, m_roundKeys);
+}
+
+/*!
+    \internal
+
+    Returns \c true if \a implementation can be used on this CPU.
+*/
+bool QKnxAes128::isSupported(Implementation implementation)
+{
+    switch (implementation) {
+    case Implementation::Portable:
+        return true;
+    case Implementation::AesNi:
+#ifdef QT_KNX_AES_NI
+        return qCpuHasFeature(AES);
+#else
+        return false;
+#endif
+    case Implementation::ArmCryptoExtensions:
+#ifdef QT_KNX_ARM_CRYPTO
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+/*!
+    \internal
+
+    Returns the fastest implementation supported by the CPU.
+*/
+QKnxAes128::Implementation QKnxAes128::bestImplementation()
+{
+    if (isSupported(Implementation::AesNi))
+        return Implementation::AesNi;
+    if (isSupported(Implementation::ArmCryptoExtensions))
+        return Implementation::ArmCryptoExtensions;
+    return Implementation::Portable;
+}
+
+/*!
+    \internal
+
+    Encrypts \a blocks 16 byte blocks from \a in into \a out. \a in and
+    \a out may point to the same buffer.
+*/
+void QKnxAes128::encrypt(const quint8 *in, quint8 *out, int blocks) const
+{
+    switch (m_implementation) {
+#ifdef QT_KNX_AES_NI
+    case Implementation::AesNi:
+        QKnxPrivate::encryptAesNi(m_roundKeys, in, out, blocks);
+        return;
+#endif
+#ifdef QT_KNX_ARM_CRYPTO
+    case Implementation::ArmCryptoExtensions:
+        QKnxPrivate::encryptArm(m_roundKeys, in, out, blocks);
+        return;
+#endif
+    default:
+        break;
+    }
+
+    for (int i = 0; i < blocks; ++i)
+        QKnxPrivate::encryptPortable(m_roundKeys, in + 16 * i, out + 16 * i);
+}
+
+/*!
+    \internal
+
+    Computes the CBC-MAC with a zero initial vector over \a blocks 16 byte
+    blocks from \a in and writes the last cipher block into \a mac.
+*/
+void QKnxAes128::cbcMac(const quint8 *in, int blocks, quint8 *mac) const
+{
+    switch (m_implementation) {
+#ifdef QT_KNX_AES_NI
+    case Implementation::AesNi:
+        QKnxPrivate::cbcMacAesNi(m_roundKeys, in, blocks, mac);
+        return;
+#endif
+#ifdef QT_KNX_ARM_CRYPTO
+    case Implementation::ArmCryptoExtensions:
+        QKnxPrivate::cbcMacArm(m_roundKeys, in, blocks, mac);
+        return;
+#endif
+    default:
+        break;
+    }
+
+    quint8 state[16] { 0x00 };
+    for (int i = 0; i < blocks; ++i) {
+        for (int j = 0; j < 16; ++j)
+            state[j] ^= in[16 * i + j];
+        QKnxPrivate::encryptPortable(m_roundKeys, state, state);
+    }
+    memcpy(mac, state, 16);
+}
+
+/*!
+    \internal
+
+    Computes the CBC-MAC with a zero initial vector for \a count independent
+    messages and writes the last cipher block of each into \a macs, which
+    must point to \c{16 * count} bytes. The messages are stored back to back
+    in \a in; the message at index \c i is \c{blocks[i]} 16 byte blocks long.
+
+    The chains of a single CBC-MAC depend on each other, so the AES
+    instructions cannot be pipelined. If the CPU provides AES instructions,
+    the chains of four messages are computed interleaved instead, which keeps
+    the pipeline filled while authenticating bursts of frames.
+*/
+void QKnxAes128::cbcMac(const quint8 *in, const int *blocks, int count, quint8 *macs) const
+{
+    switch (m_implementation) {
+#ifdef QT_KNX_AES_NI
+    case Implementation::AesNi:
+        QKnxPrivate::cbcMacAesNi(m_roundKeys, in, blocks, count, macs);
+        return;
+#endif
+#ifdef QT_KNX_ARM_CRYPTO
+    case Implementation::ArmCryptoExtensions:
+        QKnxPrivate::cbcMacArm(m_roundKeys, in, blocks, count, macs);
+        return;
+#endif
+    default:
+        break;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        cbcMac(in, blocks[i], macs + 16 * i);
+        in += 16 * blocks[i];
+    }
+}
+
+QT_END_NAMESPACE
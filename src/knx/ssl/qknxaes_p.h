@@ -0,0 +1,78 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXAES_P_H
+#define QKNXAES_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxAes128 final
+{
+public:
+    enum class Implementation : quint8
+    {
+        Portable,
+        AesNi,
+        ArmCryptoExtensions
+    };
+
+    explicit QKnxAes128(const quint8 *key);
+    QKnxAes128(const quint8 *key, Implementation implementation);
+
+    Implementation implementation() const { return m_implementation; }
+
+    static bool isSupported(Implementation implementation);
+    static Implementation bestImplementation();
+
+    void encrypt(const quint8 *in, quint8 *out, int blocks) const;
+    void cbcMac(const quint8 *in, int blocks, quint8 *mac) const;
+    void cbcMac(const quint8 *in, const int *blocks, int count, quint8 *macs) const;
+
+private:
+    // operator new before C++17 does not honor the alignment, loads must not rely on it
+    alignas(16) quint8 m_roundKeys[176];
+    Implementation m_implementation { Implementation::Portable };
+};
+
+QT_END_NAMESPACE
+
+#endif
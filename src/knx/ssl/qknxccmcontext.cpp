@@ -0,0 +1,463 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxccmcontext_p.h"
+#include "qknxnetipsecurewrapper.h"
+#include "qknxnetiptimernotify.h"
+#include "qknxssl_p.h"
+#include "qknxutils.h"
+
+#include <QtCore/qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QKnxCcmContext
+
+    The QKnxCcmContext class implements the CCM variant used by KNXnet/IP
+    secure on top of a block cipher whose key schedule is expanded only once
+    for a given key. Keeping an object around for the lifetime of a secure
+    session avoids the setup of a new cipher context for every frame and makes
+    the class suitable for the frame hot path of routers and tunnels.
+
+    Copies of an object share the same cipher. The class is not thread-safe.
+*/
+
+namespace QKnxPrivate
+{
+    static void writeB0(quint8 *out, quint48 sequence, const QKnxByteArray &serial, quint16 tag,
+        quint16 len)
+    {
+        for (int i = 0; i < 6; ++i)
+            out[i] = quint8(sequence >> (8 * (5 - i)));
+        if (serial.size() == 6)
+            memcpy(out + 6, serial.constData(), 6);
+        else
+            memset(out + 6, 0, 6);
+        out[12] = quint8(tag >> 8);
+        out[13] = quint8(tag);
+        out[14] = quint8(len >> 8);
+        out[15] = quint8(len);
+    }
+
+    template <int Prealloc>
+    static void appendUint16(QVarLengthArray<quint8, Prealloc> &out, quint16 value)
+    {
+        out.append(quint8(value >> 8));
+        out.append(quint8(value));
+    }
+
+    static void writeCounterBlocks(quint8 *out, quint48 sequence, const QKnxByteArray &serial,
+        quint16 tag, int count)
+    {
+        writeB0(out, sequence, serial, tag, 0xff00);
+        for (int i = 1; i < count; ++i) {
+            memcpy(out + 16 * i, out, 15);
+            out[16 * i + 15] = quint8(i);
+        }
+    }
+}
+
+/*!
+    \internal
+
+    Creates a CCM context for the AES-128 \a key.
+*/
+QKnxCcmContext::QKnxCcmContext(const QKnxByteArray &key)
+    : m_key(key)
+    , m_cipher(new QKnxSslBlockCipher(key))
+{}
+
+/*!
+    \internal
+
+    Returns \c true if the context holds a usable key; \c false otherwise.
+*/
+bool QKnxCcmContext::isValid() const
+{
+    return m_cipher && m_cipher->isValid();
+}
+
+/*!
+    \internal
+
+    Returns the key used by this context.
+*/
+QKnxByteArray QKnxCcmContext::key() const
+{
+    return m_key;
+}
+
+/*!
+    \internal
+
+    Computes the unencrypted message authentication code for a frame with the
+    given \a header, \a id, and \a data, using the \a sequenceNumber,
+    \a serialNumber, and \a messageTag. Follows the rules documented for
+    QKnxCryptographicEngine::computeMessageAuthenticationCode().
+*/
+QKnxByteArray QKnxCcmContext::computeMessageAuthenticationCode(const QKnxNetIpFrameHeader &header,
+    quint16 id, const QKnxByteArray &data, quint48 sequenceNumber,
+    const QKnxByteArray &serialNumber, quint16 messageTag) const
+{
+    if (!isValid() || !header.isValid())
+        return {};
+
+    const auto serviceType = header.serviceType();
+    const bool timerNotify = (serviceType == QKnxNetIp::ServiceType::TimerNotify);
+    if (!timerNotify && data.isEmpty())
+        return {};
+
+    QVarLengthArray<quint8, 256> B(16);
+    switch (serviceType) {
+    case QKnxNetIp::ServiceType::SecureWrapper:
+        QKnxPrivate::writeB0(B.data(), sequenceNumber, serialNumber, messageTag,
+            quint16(data.size()));
+        QKnxPrivate::appendUint16(B, quint16(header.size() + 2));
+        break;
+    case QKnxNetIp::ServiceType::SessionResponse:
+    case QKnxNetIp::ServiceType::SessionAuthenticate:
+        QKnxPrivate::writeB0(B.data(), sequenceNumber, serialNumber, messageTag, 0);
+        QKnxPrivate::appendUint16(B, quint16(header.size() + 2 + data.size()));
+        break;
+    case QKnxNetIp::ServiceType::TimerNotify:
+        QKnxPrivate::writeB0(B.data(), sequenceNumber, serialNumber, messageTag, 0);
+        QKnxPrivate::appendUint16(B, quint16(header.size()));
+        break;
+    default:
+        return {};
+    }
+
+    const auto headerBytes = header.bytes();
+    B.append(headerBytes.constData(), headerBytes.size());
+    if (!timerNotify) {
+        QKnxPrivate::appendUint16(B, id);
+        B.append(data.constData(), data.size());
+    }
+    while (B.size() % 16) // pad to multiple of 16
+        B.append(0x00);
+
+    QKnxByteArray mac(16, Qt::Uninitialized);
+    if (!m_cipher->cbcMac(B.constData(), B.size(), mac.data()))
+        return {};
+    return mac;
+}
+
+/*!
+    \internal
+
+    Encrypts or decrypts the \a payload in counter mode, starting with the
+    counter block following the one derived from \a sequenceNumber,
+    \a serialNumber, and \a messageTag. All key stream blocks are produced
+    with a single call into the cipher.
+*/
+QKnxByteArray QKnxCcmContext::processPayload(const QKnxByteArray &payload, quint48 sequenceNumber,
+    const QKnxByteArray &serialNumber, quint16 messageTag) const
+{
+    if (!isValid() || payload.isEmpty())
+        return {};
+
+    const int blocks = (payload.size() + 15) >> 4;
+    QVarLengthArray<quint8, 256> stream(16 * (blocks + 1));
+    if (!counterBlocks(sequenceNumber, serialNumber, messageTag, blocks + 1, stream.data()))
+        return {};
+
+    QKnxByteArray result(payload.size(), Qt::Uninitialized);
+    const quint8 *in = payload.constData();
+    quint8 *out = result.data();
+    for (int i = 0; i < payload.size(); ++i)
+        out[i] = in[i] ^ stream[16 + i];
+    return result;
+}
+
+/*!
+    \internal
+
+    Encrypts or decrypts the message authentication code \a mac with the
+    counter block derived from \a sequenceNumber, \a serialNumber, and
+    \a messageTag.
+*/
+QKnxByteArray QKnxCcmContext::processMessageAuthenticationCode(const QKnxByteArray &mac,
+    quint48 sequenceNumber, const QKnxByteArray &serialNumber, quint16 messageTag) const
+{
+    if (!isValid() || mac.size() != 16)
+        return {};
+
+    quint8 stream[16];
+    if (!counterBlocks(sequenceNumber, serialNumber, messageTag, 1, stream))
+        return {};
+
+    QKnxByteArray result(16, Qt::Uninitialized);
+    for (int i = 0; i < 16; ++i)
+        result.set(i, mac.at(i) ^ stream[i]);
+    return result;
+}
+
+/*!
+    \internal
+
+    Returns a secure wrapper frame carrying the encrypted \a frame, or an
+    invalid frame on error.
+*/
+QKnxNetIpFrame QKnxCcmContext::wrap(const QKnxNetIpFrame &frame, quint16 sessionId,
+    quint48 sequenceNumber, const QKnxByteArray &serialNumber, quint16 messageTag) const
+{
+    if (!isValid() || !frame.isValid() || sequenceNumber > Q_UINT48_MAX || serialNumber.size() != 6)
+        return {};
+
+    const auto plain = frame.bytes();
+    auto builder = QKnxNetIpSecureWrapperProxy::builder();
+    builder.setSecureSessionId(sessionId)
+        .setSequenceNumber(sequenceNumber)
+        .setSerialNumber(serialNumber)
+        .setMessageTag(messageTag)
+        .setEncapsulatedFrame(processPayload(plain, sequenceNumber, serialNumber, messageTag));
+
+    const QKnxNetIpFrameHeader header(QKnxNetIp::ServiceType::SecureWrapper,
+        quint16(2 + 6 + 6 + 2 + plain.size() + 16));
+
+    const auto mac = computeMessageAuthenticationCode(header, sessionId, plain, sequenceNumber,
+        serialNumber, messageTag);
+    return builder.setMessageAuthenticationCode(processMessageAuthenticationCode(mac,
+        sequenceNumber, serialNumber, messageTag)).create();
+}
+
+/*!
+    \internal
+
+    Decrypts the \a secureWrapper frame and returns the encapsulated frame if
+    the message authentication code matches; otherwise returns an invalid
+    frame.
+*/
+QKnxNetIpFrame QKnxCcmContext::unwrap(const QKnxNetIpFrame &secureWrapper) const
+{
+    const QKnxNetIpSecureWrapperProxy proxy(secureWrapper);
+    if (!isValid() || !proxy.isValid())
+        return {};
+
+    const auto sequence = proxy.sequenceNumber();
+    const auto serial = proxy.serialNumber();
+    const auto tag = proxy.messageTag();
+
+    const auto plain = processPayload(proxy.encapsulatedFrame(), sequence, serial, tag);
+    const auto mac = computeMessageAuthenticationCode(secureWrapper.header(),
+        proxy.secureSessionId(), plain, sequence, serial, tag);
+    if (mac.isEmpty() || mac != processMessageAuthenticationCode(proxy.messageAuthenticationCode(),
+        sequence, serial, tag)) {
+        return {};
+    }
+    return QKnxNetIpFrame::fromBytes(plain);
+}
+
+/*!
+    \internal
+
+    Decrypts the \a secureWrappers frames, which must share the key of this
+    context, and returns the encapsulated frames in the same order. Frames
+    that cannot be decrypted or whose message authentication code does not
+    match are returned as invalid frames.
+
+    The result is identical to calling unwrap() for each frame, but the key
+    streams of all frames are produced with a single call into the cipher and
+    the message authentication codes are computed by the batch CBC-MAC of the
+    cipher, which interleaves several frames if the CPU provides AES
+    instructions. Use this function to authenticate bursts of frames, for
+    example all datagrams pending on a secure routing socket.
+*/
+QVector<QKnxNetIpFrame> QKnxCcmContext::unwrap(const QVector<QKnxNetIpFrame> &secureWrappers) const
+{
+    QVector<QKnxNetIpFrame> result(secureWrappers.size());
+    if (!isValid() || secureWrappers.isEmpty())
+        return result;
+
+    struct Entry
+    {
+        int index;
+        QKnxByteArray header;
+        quint16 sessionId;
+        quint48 sequence;
+        QKnxByteArray serial;
+        quint16 tag;
+        QKnxByteArray payload;
+        QKnxByteArray mac;
+        int stream; // offset of the counter block zero
+        int input; // offset of the CBC-MAC input
+    };
+
+    QVector<Entry> entries;
+    entries.reserve(secureWrappers.size());
+
+    int streamSize = 0, inputSize = 0;
+    for (int i = 0; i < secureWrappers.size(); ++i) {
+        const auto &frame = secureWrappers.at(i);
+        const QKnxNetIpSecureWrapperProxy proxy(frame);
+        if (!proxy.isValid())
+            continue;
+
+        const auto payload = proxy.encapsulatedFrame();
+        if (payload.isEmpty())
+            continue;
+
+        const auto header = frame.header().bytes();
+        entries.append({ i, header, proxy.secureSessionId(), proxy.sequenceNumber(),
+            proxy.serialNumber(), proxy.messageTag(), payload,
+            proxy.messageAuthenticationCode(), streamSize, inputSize });
+
+        streamSize += 16 * (((payload.size() + 15) >> 4) + 1);
+        // B0, the length of A, A (header and session id), and the payload
+        inputSize += (16 + 2 + header.size() + 2 + payload.size() + 15) & ~15;
+    }
+    if (entries.isEmpty())
+        return result;
+
+    // all key streams in one go
+    QVarLengthArray<quint8, 1024> stream(streamSize);
+    for (const auto &entry : qAsConst(entries)) {
+        QKnxPrivate::writeCounterBlocks(stream.data() + entry.stream, entry.sequence,
+            entry.serial, entry.tag, ((entry.payload.size() + 15) >> 4) + 1);
+    }
+    if (!m_cipher->encrypt(stream.constData(), stream.data(), streamSize))
+        return result;
+
+    // decrypt the payloads and lay out the CBC-MAC input of all frames back to back
+    QVarLengthArray<quint8, 2048> input(inputSize);
+    QVarLengthArray<int, 32> sizes(entries.size());
+    memset(input.data(), 0, inputSize);
+
+    QVector<QKnxByteArray> plain(entries.size());
+    for (int i = 0; i < entries.size(); ++i) {
+        const auto &entry = entries.at(i);
+        const auto &payload = entry.payload;
+
+        plain[i] = QKnxByteArray(payload.size(), Qt::Uninitialized);
+        const quint8 *key = stream.constData() + entry.stream + 16;
+        const quint8 *in = payload.constData();
+        quint8 *out = plain[i].data();
+        for (int j = 0; j < payload.size(); ++j)
+            out[j] = in[j] ^ key[j];
+
+        quint8 *B = input.data() + entry.input;
+        QKnxPrivate::writeB0(B, entry.sequence, entry.serial, entry.tag, quint16(payload.size()));
+        B += 16;
+
+        const quint16 length = quint16(entry.header.size() + 2);
+        *B++ = quint8(length >> 8);
+        *B++ = quint8(length);
+        memcpy(B, entry.header.constData(), entry.header.size());
+        B += entry.header.size();
+        *B++ = quint8(entry.sessionId >> 8);
+        *B++ = quint8(entry.sessionId);
+        memcpy(B, out, payload.size());
+
+        sizes[i] = (16 + 2 + entry.header.size() + 2 + payload.size() + 15) & ~15;
+    }
+
+    QVarLengthArray<quint8, 512> macs(16 * entries.size());
+    if (!m_cipher->cbcMac(input.constData(), sizes.constData(), entries.size(), macs.data()))
+        return result;
+
+    for (int i = 0; i < entries.size(); ++i) {
+        const auto &entry = entries.at(i);
+        if (entry.mac.size() != 16)
+            continue;
+
+        // the received code is encrypted with the counter block zero
+        quint8 diff = 0;
+        const quint8 *key = stream.constData() + entry.stream;
+        const quint8 *mac = macs.constData() + 16 * i;
+        for (int j = 0; j < 16; ++j)
+            diff |= quint8(entry.mac.at(j) ^ key[j] ^ mac[j]);
+        if (diff == 0)
+            result[entry.index] = QKnxNetIpFrame::fromBytes(plain.at(i));
+    }
+    return result;
+}
+
+/*!
+    \internal
+
+    Returns an authenticated timer notify frame for \a timerValue,
+    \a serialNumber, and \a messageTag.
+*/
+QKnxNetIpFrame QKnxCcmContext::createTimerNotify(quint48 timerValue,
+    const QKnxByteArray &serialNumber, quint16 messageTag) const
+{
+    if (!isValid() || timerValue > Q_UINT48_MAX || serialNumber.size() != 6)
+        return {};
+
+    auto builder = QKnxNetIpTimerNotifyProxy::builder();
+    builder.setTimerValue(timerValue)
+        .setSerialNumber(serialNumber)
+        .setMessageTag(messageTag);
+
+    const QKnxNetIpFrameHeader header(QKnxNetIp::ServiceType::TimerNotify,
+        quint16(6 + 6 + 2 + 16));
+    const auto mac = computeMessageAuthenticationCode(header, 0, {}, timerValue, serialNumber,
+        messageTag);
+    return builder.setMessageAuthenticationCode(processMessageAuthenticationCode(mac, timerValue,
+        serialNumber, messageTag)).create();
+}
+
+/*!
+    \internal
+
+    Returns \c true if the message authentication code of the \a timerNotify
+    frame is valid for the key of this context; \c false otherwise.
+*/
+bool QKnxCcmContext::verifyTimerNotify(const QKnxNetIpFrame &timerNotify) const
+{
+    const QKnxNetIpTimerNotifyProxy proxy(timerNotify);
+    if (!isValid() || !proxy.isValid())
+        return false;
+
+    const auto timer = proxy.timerValue();
+    const auto serial = proxy.serialNumber();
+    const auto tag = proxy.messageTag();
+
+    const auto mac = computeMessageAuthenticationCode(timerNotify.header(), 0, {}, timer, serial,
+        tag);
+    return !mac.isEmpty() && mac == processMessageAuthenticationCode(
+        proxy.messageAuthenticationCode(), timer, serial, tag);
+}
+
+/*!
+    \internal
+
+    Writes \a count key stream blocks, starting with the encrypted counter
+    block zero, into \a out.
+*/
+bool QKnxCcmContext::counterBlocks(quint48 sequenceNumber, const QKnxByteArray &serialNumber,
+    quint16 messageTag, int count, quint8 *out) const
+{
+    QKnxPrivate::writeCounterBlocks(out, sequenceNumber, serialNumber, messageTag, count);
+    return m_cipher->encrypt(out, out, 16 * count);
+}
+
+QT_END_NAMESPACE
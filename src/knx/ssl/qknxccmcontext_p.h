@@ -0,0 +1,91 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXCCMCONTEXT_P_H
+#define QKNXCCMCONTEXT_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qvector.h>
+
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qknxnetipframe.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxSslBlockCipher;
+class Q_KNX_EXPORT QKnxCcmContext final
+{
+public:
+    QKnxCcmContext() = default;
+    explicit QKnxCcmContext(const QKnxByteArray &key);
+
+    bool isValid() const;
+    QKnxByteArray key() const;
+
+    QKnxByteArray computeMessageAuthenticationCode(const QKnxNetIpFrameHeader &header, quint16 id,
+        const QKnxByteArray &data, quint48 sequenceNumber, const QKnxByteArray &serialNumber,
+        quint16 messageTag) const;
+
+    QKnxByteArray processPayload(const QKnxByteArray &payload, quint48 sequenceNumber,
+        const QKnxByteArray &serialNumber, quint16 messageTag) const;
+    QKnxByteArray processMessageAuthenticationCode(const QKnxByteArray &mac, quint48 sequenceNumber,
+        const QKnxByteArray &serialNumber, quint16 messageTag) const;
+
+    QKnxNetIpFrame wrap(const QKnxNetIpFrame &frame, quint16 sessionId, quint48 sequenceNumber,
+        const QKnxByteArray &serialNumber, quint16 messageTag) const;
+    QKnxNetIpFrame unwrap(const QKnxNetIpFrame &secureWrapper) const;
+    QVector<QKnxNetIpFrame> unwrap(const QVector<QKnxNetIpFrame> &secureWrappers) const;
+
+    QKnxNetIpFrame createTimerNotify(quint48 timerValue, const QKnxByteArray &serialNumber,
+        quint16 messageTag) const;
+    bool verifyTimerNotify(const QKnxNetIpFrame &timerNotify) const;
+
+private:
+    bool counterBlocks(quint48 sequenceNumber, const QKnxByteArray &serialNumber,
+        quint16 messageTag, int count, quint8 *out) const;
+
+private:
+    QKnxByteArray m_key;
+    QSharedPointer<QKnxSslBlockCipher> m_cipher;
+};
+
+QT_END_NAMESPACE
+
+#endif
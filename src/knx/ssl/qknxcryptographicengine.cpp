@@ -35,8 +35,10 @@
 #include "qknxnetipsessionstatus.h"
 #include "qknxnetiptimernotify.h"
 
+#include "private/qknxccmcontext_p.h"
 #include "private/qknxssl_p.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcryptographichash.h>
 #include <QtCore/qmutex.h>
 
@@ -44,6 +46,52 @@
 
 QT_BEGIN_NAMESPACE
 
+class QKnxPasswordHashCache
+{
+public:
+    QKnxByteArray derive(const QByteArray &password, const QByteArray &salt)
+    {
+        // never keep the plain password around, not even as cache key
+        const auto id = QCryptographicHash::hash(salt + '\0' + password,
+            QCryptographicHash::Sha256);
+        {
+            const QMutexLocker locker(&m_mutex);
+            if (const auto hash = m_cache.object(id))
+                return *hash;
+        }
+
+        const auto hash = QKnxByteArray::fromByteArray(QPasswordDigestor::deriveKeyPbkdf2(
+            QCryptographicHash::Algorithm::Sha256, password, salt, 0x10000, 16));
+
+        const QMutexLocker locker(&m_mutex);
+        m_cache.insert(id, new QKnxByteArray(hash));
+        return hash;
+    }
+
+    int capacity()
+    {
+        const QMutexLocker locker(&m_mutex);
+        return m_cache.maxCost();
+    }
+
+    void setCapacity(int capacity)
+    {
+        const QMutexLocker locker(&m_mutex);
+        m_cache.setMaxCost(qMax(0, capacity));
+    }
+
+    void clear()
+    {
+        const QMutexLocker locker(&m_mutex);
+        m_cache.clear();
+    }
+
+private:
+    QMutex m_mutex;
+    QCache<QByteArray, QKnxByteArray> m_cache { 64 };
+};
+Q_GLOBAL_STATIC(QKnxPasswordHashCache, qt_knxPasswordHashCache)
+
 /*!
     \class QKnxCryptographicEngine
 
@@ -218,9 +266,7 @@ QKnxByteArray QKnxCryptographicEngine::sessionKey(const QKnxByteArray &sharedSec
 */
 QKnxByteArray QKnxCryptographicEngine::userPasswordHash(const QByteArray &password)
 {
-    const auto hash = QPasswordDigestor::deriveKeyPbkdf2(QCryptographicHash::Algorithm::Sha256,
-        password, QByteArray("user-password.1.secure.ip.knx.org"), 0x10000, 16);
-    return QKnxByteArray::fromByteArray(hash);
+    return qt_knxPasswordHashCache->derive(password, "user-password.1.secure.ip.knx.org");
 }
 
 /*!
@@ -232,9 +278,7 @@ QKnxByteArray QKnxCryptographicEngine::userPasswordHash(const QByteArray &passwo
 */
 QKnxByteArray QKnxCryptographicEngine::keyringPasswordHash(const QByteArray &password)
 {
-    const auto hash = QPasswordDigestor::deriveKeyPbkdf2(QCryptographicHash::Algorithm::Sha256,
-        password, "1.keyring.ets.knx.org", 0x10000, 16);
-    return QKnxByteArray::fromByteArray(hash);
+    return qt_knxPasswordHashCache->derive(password, "1.keyring.ets.knx.org");
 }
 
 /*!
@@ -246,9 +290,53 @@ QKnxByteArray QKnxCryptographicEngine::keyringPasswordHash(const QByteArray &pas
 */
 QKnxByteArray QKnxCryptographicEngine::deviceAuthenticationCodeHash(const QByteArray &password)
 {
-    const auto hash = QPasswordDigestor::deriveKeyPbkdf2(QCryptographicHash::Algorithm::Sha256,
-        password, "device-authentication-code.1.secure.ip.knx.org", 0x10000, 16);
-    return QKnxByteArray::fromByteArray(hash);
+    return qt_knxPasswordHashCache->derive(password,
+        "device-authentication-code.1.secure.ip.knx.org");
+}
+
+/*!
+    \since 5.15
+
+    Returns the maximum number of password hashes kept in the process-wide
+    cache shared by userPasswordHash(), keyringPasswordHash(), and
+    deviceAuthenticationCodeHash(). The default is \c 64.
+
+    \sa setPasswordHashCacheCapacity(), clearPasswordHashCache()
+*/
+int QKnxCryptographicEngine::passwordHashCacheCapacity()
+{
+    return qt_knxPasswordHashCache->capacity();
+}
+
+/*!
+    \since 5.15
+
+    Sets the maximum number of cached password hashes to \a capacity. The
+    least recently used hashes are dropped if the cache exceeds the new
+    capacity. A capacity of \c 0 disables caching.
+
+    Each of the hash functions runs PBKDF2 with 65536 iterations, so caching
+    avoids noticeable delays if many secure connections are set up with the
+    same credentials. The cache is keyed on a SHA-256 hash of the password
+    and salt; passwords are not stored.
+
+    \sa passwordHashCacheCapacity(), clearPasswordHashCache()
+*/
+void QKnxCryptographicEngine::setPasswordHashCacheCapacity(int capacity)
+{
+    qt_knxPasswordHashCache->setCapacity(capacity);
+}
+
+/*!
+    \since 5.15
+
+    Removes all entries from the password hash cache.
+
+    \sa passwordHashCacheCapacity()
+*/
+void QKnxCryptographicEngine::clearPasswordHashCache()
+{
+    qt_knxPasswordHashCache->clear();
 }
 
 /*!
@@ -277,30 +365,13 @@ QKnxByteArray QKnxCryptographicEngine::XOR(const QKnxByteArray &left, const QKnx
 
 namespace QKnxPrivate
 {
-    static const quint8 iv[16] { 0x00 };
-
-    static QKnxByteArray b0(quint48 sequence, const QKnxByteArray &serial, quint16 tag, quint16 len)
-    {
-        return QKnxUtils::QUint48::bytes(sequence) + serial + QKnxUtils::QUint16::bytes(tag)
-            + QKnxUtils::QUint16::bytes(len);
-    }
-
-    static QKnxByteArray ctr0(quint48 sequence, const QKnxByteArray &serial, quint16 tag)
-    {
-        return QKnxPrivate::b0(sequence, serial, tag, 0xff00);
-    }
-
     static QKnxByteArray processMAC(const QKnxByteArray &key, const QKnxByteArray &mac,
         quint48 sequenceNumber, const QKnxByteArray &serialNumber, quint16 messageTag)
     {
         if (key.isEmpty() || mac.isEmpty())
             return {};
-
-        auto Ctr0 = QKnxPrivate::ctr0(sequenceNumber,
-            (serialNumber.isEmpty() ? QKnxByteArray(6, 0x00) : serialNumber), messageTag);
-
-        return QKnxCryptographicEngine::XOR(QKnxSsl::doCrypt(key, { iv, 16 }, Ctr0,
-            QKnxSsl::Encrypt).right(16), mac);
+        return QKnxCcmContext(key).processMessageAuthenticationCode(mac, sequenceNumber,
+            serialNumber, messageTag);
     }
 
     static QKnxByteArray processPayload(const QKnxByteArray &key, const QKnxByteArray &payload,
@@ -309,16 +380,9 @@ namespace QKnxPrivate
         if (key.isEmpty() || payload.isEmpty())
             return {};
 
-        auto Ctr0 = QKnxPrivate::ctr0(sequenceNumber,
-            (serialNumber.isEmpty() ? QKnxByteArray(6, 0x00) : serialNumber), messageTag);
-
-        QKnxByteArray ctrArray;
-        for (int i = 0; i < (payload.size() + 15) >> 4; ++i) {
-            Ctr0.set(15, Ctr0.at(15) + 1);
-            ctrArray += QKnxSsl::doCrypt(key, { iv, 16 }, Ctr0, QKnxSsl::Encrypt).right(16);
-        }
-
-        return QKnxCryptographicEngine::XOR(ctrArray, payload, false);
+        // the whole key stream is produced with one cipher context and call
+        return QKnxCcmContext(key).processPayload(payload, sequenceNumber, serialNumber,
+            messageTag);
     }
 }
 
@@ -343,35 +407,8 @@ QKnxByteArray QKnxCryptographicEngine::computeMessageAuthenticationCode(const QK
     if (key.isEmpty() || !header.isValid())
         return {};
 
-    auto sn = (serialNumber.isEmpty() ? QKnxByteArray(6, 0x00) : serialNumber);
-
-    QKnxByteArray B0, B;
-    if (header.serviceType() == QKnxNetIp::ServiceType::SecureWrapper) {
-        if (data.isEmpty())
-            return {};
-
-        const auto A = header.bytes() + QKnxUtils::QUint16::bytes(id);
-        B0 = QKnxPrivate::b0(sequenceNumber, sn, messageTag, quint16(data.size()));
-        B = B0 + QKnxUtils::QUint16::bytes(quint16(A.size())) + A + data;
-    } else if (header.serviceType() == QKnxNetIp::ServiceType::SessionResponse
-        || header.serviceType() == QKnxNetIp::ServiceType::SessionAuthenticate) {
-            if (data.isEmpty())
-                return {};
-
-            const auto A = header.bytes() + QKnxUtils::QUint16::bytes(id);
-            B0 = QKnxPrivate::b0(sequenceNumber, sn, messageTag, 0);
-            B = B0 + QKnxUtils::QUint16::bytes(quint16(A.size() + data.size())) + A + data;
-    } else if (header.serviceType() == QKnxNetIp::ServiceType::TimerNotify) {
-        const auto A = header.bytes();
-        B0 = QKnxPrivate::b0(sequenceNumber, sn, messageTag, 0);
-        B = B0 + QKnxUtils::QUint16::bytes(quint16(A.size())) + A;
-    }
-
-    if (B.isEmpty())
-        return {};
-    B.resize(B.size() + (16 - (B.size() % 16))); // pad to multiple of 16
-
-    return QKnxSsl::doCrypt(key, { QKnxPrivate::iv, 16 }, B, QKnxSsl::Encrypt).right(16);
+    return QKnxCcmContext(key).computeMessageAuthenticationCode(header, id, data, sequenceNumber,
+        serialNumber, messageTag);
 }
 
 /*!
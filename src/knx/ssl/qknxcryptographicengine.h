@@ -57,6 +57,10 @@ public:
     static QKnxByteArray keyringPasswordHash(const QByteArray &password);
     static QKnxByteArray deviceAuthenticationCodeHash(const QByteArray &password);
 
+    static int passwordHashCacheCapacity();
+    static void setPasswordHashCacheCapacity(int capacity);
+    static void clearPasswordHashCache();
+
     static QKnxByteArray hashSha256(const QByteArray &data);
     static QKnxByteArray XOR(const QKnxByteArray &l, const QKnxByteArray &r, bool adjust = true);
 
@@ -0,0 +1,586 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxdatasecurelayer_p.h"
+#include "qknxkeyringstore_p.h"
+#include "qknxsequencenumberstore_p.h"
+#include "qknxssl_p.h"
+#include "qknxutils.h"
+
+#include <QtCore/qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QKnxDataSecureLayer
+
+    The QKnxDataSecureLayer class implements the KNX Data Secure service
+    S-A_Data for group communication (AN158), securing and verifying TPDUs on
+    top of a block cipher per group key.
+
+    Group keys are taken from a QKnxKeyringStore or set explicitly with
+    setGroupKey(). The AES key schedule of a group key is expanded the first
+    time the group address is used and cached for all following telegrams.
+
+    Incoming telegrams are checked against a sliding window over the last 64
+    sequence numbers seen from the sending individual address; a sequence
+    number seen before or older than the window is rejected as a replay.
+    Outgoing telegrams use and advance sequenceNumber(). With a
+    QKnxSequenceNumberStore set, the outgoing counter and the highest number
+    accepted from each source survive a restart.
+
+    The class is not thread-safe.
+*/
+
+/*!
+    \internal
+    \enum QKnxDataSecureLayer::Protection
+
+    \value Authentication
+            The APDU is transmitted in plain text, only the message
+            authentication code is appended.
+    \value AuthenticationConfidentiality
+            The APDU and the message authentication code are encrypted.
+*/
+
+/*!
+    \internal
+    \enum QKnxDataSecureLayer::Status
+
+    \value Ok                   The TPDU was secured or verified.
+    \value NotSecured           The TPDU does not carry a secure service.
+    \value NoKey                No group key is known for the destination.
+    \value InvalidFrame         The TPDU or one of the addresses is malformed.
+    \value Unsupported          The security control field requests a service
+                                other than S-A_Data for group communication.
+    \value AuthenticationFailed The message authentication code does not match.
+    \value Replayed             The sequence number was seen before or is
+                                older than the replay window.
+    \value StorageError         The sequence number could not be reserved in
+                                the sequence number store.
+*/
+
+namespace QKnxPrivate
+{
+    static const char sequenceNumberId[] = "data-secure/tx";
+
+    static QByteArray peerId(quint16 source)
+    {
+        return QByteArrayLiteral("data-secure/rx/") + QByteArray::number(source, 16);
+    }
+
+    enum : int
+    {
+        SecureApduOffset = 2 + 1 + 6, // TPCI/APCI, SCF, sequence number
+        SecureMacSize = 4
+    };
+
+    static void setStatus(QKnxDataSecureLayer::Status *status, QKnxDataSecureLayer::Status value)
+    {
+        if (status)
+            *status = value;
+    }
+
+    static quint16 rawAddress(const QKnxAddress &address)
+    {
+        return QKnxUtils::QUint16::fromBytes(address.bytes());
+    }
+
+    static void writeSequenceAndAddresses(quint8 *out, quint48 sequence, quint16 source,
+        quint16 destination)
+    {
+        for (int i = 0; i < 6; ++i)
+            out[i] = quint8(sequence >> (8 * (5 - i)));
+        out[6] = quint8(source >> 8);
+        out[7] = quint8(source);
+        out[8] = quint8(destination >> 8);
+        out[9] = quint8(destination);
+    }
+
+    static bool messageAuthenticationCode(const QKnxSslBlockCipher &cipher, const quint8 *b0,
+        const quint8 *data, int dataSize, const quint8 *payload, int payloadSize, quint8 *mac)
+    {
+        QVarLengthArray<quint8, 320> B(16);
+        memcpy(B.data(), b0, 16);
+        B.append(quint8(dataSize >> 8));
+        B.append(quint8(dataSize));
+        B.append(data, dataSize);
+        if (payloadSize > 0)
+            B.append(payload, payloadSize);
+        while (B.size() % 16) // pad to multiple of 16
+            B.append(0x00);
+
+        quint8 block[16];
+        if (!cipher.cbcMac(B.constData(), B.size(), block))
+            return false;
+        memcpy(mac, block, SecureMacSize);
+        return true;
+    }
+
+    // The key stream starts with counter block Ctr0 and runs continuously over
+    // the message authentication code followed by the APDU.
+    static bool applyKeyStream(const QKnxSslBlockCipher &cipher, const quint8 *prefix,
+        quint8 *mac, quint8 *apdu, int apduSize)
+    {
+        const int size = SecureMacSize + apduSize;
+        const int blocks = (size + 15) >> 4;
+
+        QVarLengthArray<quint8, 320> stream(16 * blocks);
+        for (int i = 0; i < blocks; ++i) {
+            quint8 *ctr = stream.data() + 16 * i;
+            memcpy(ctr, prefix, 10);
+            memset(ctr + 10, 0, 4);
+            ctr[14] = 0x01;
+            ctr[15] = quint8(i);
+        }
+        if (!cipher.encrypt(stream.constData(), stream.data(), stream.size()))
+            return false;
+
+        for (int i = 0; i < SecureMacSize; ++i)
+            mac[i] ^= stream[i];
+        for (int i = 0; i < apduSize; ++i)
+            apdu[i] ^= stream[SecureMacSize + i];
+        return true;
+    }
+}
+
+/*!
+    \internal
+
+    Returns the keyring store group keys are looked up in.
+*/
+const QKnxKeyringStore *QKnxDataSecureLayer::keyringStore() const
+{
+    return m_store;
+}
+
+/*!
+    \internal
+
+    Sets the keyring store group keys are looked up in to \a store. The store
+    is not owned and must outlive this object. Keys cached from a previous
+    store are dropped.
+*/
+void QKnxDataSecureLayer::setKeyringStore(const QKnxKeyringStore *store)
+{
+    m_store = store;
+    m_ciphers.clear();
+}
+
+/*!
+    \internal
+
+    Returns \c true if a key for the group address \a groupAddress is cached
+    or available from the keyring store; otherwise returns \c false.
+*/
+bool QKnxDataSecureLayer::hasGroupKey(quint16 groupAddress) const
+{
+    return m_ciphers.contains(groupAddress) || (m_store && m_store->hasGroupKey(groupAddress));
+}
+
+/*!
+    \internal
+
+    Sets the AES-128 \a key used for the group address \a groupAddress,
+    overriding a key found in the keyring store.
+*/
+void QKnxDataSecureLayer::setGroupKey(quint16 groupAddress, const QKnxByteArray &key)
+{
+    QSharedPointer<QKnxSslBlockCipher> cipher(new QKnxSslBlockCipher(key));
+    if (key.size() == 16 && cipher->isValid())
+        m_ciphers.insert(groupAddress, cipher);
+    else
+        m_ciphers.remove(groupAddress);
+}
+
+/*!
+    \internal
+
+    Removes the cached key of the group address \a groupAddress. A key
+    available from the keyring store is loaded again on next use.
+*/
+void QKnxDataSecureLayer::removeGroupKey(quint16 groupAddress)
+{
+    m_ciphers.remove(groupAddress);
+}
+
+/*!
+    \internal
+
+    Removes all cached keys.
+*/
+void QKnxDataSecureLayer::clearKeyCache()
+{
+    m_ciphers.clear();
+}
+
+/*!
+    \internal
+
+    Returns the store the sequence number state is persisted in.
+*/
+QKnxSequenceNumberStore *QKnxDataSecureLayer::sequenceNumberStore() const
+{
+    return m_sequenceStore;
+}
+
+/*!
+    \internal
+
+    Sets the store the sequence number state is persisted in to \a store. The
+    store is not owned and must outlive this object. The outgoing sequence
+    number continues at the number restored from the store if that is ahead.
+*/
+void QKnxDataSecureLayer::setSequenceNumberStore(QKnxSequenceNumberStore *store)
+{
+    m_sequenceStore = store;
+    m_replayWindows.clear();
+    if (m_sequenceStore) {
+        m_sequenceNumber = qMax(m_sequenceNumber,
+            m_sequenceStore->restoredSequenceNumber(QKnxPrivate::sequenceNumberId));
+    }
+}
+
+/*!
+    \internal
+
+    Returns the sequence number the next secured TPDU is sent with.
+*/
+quint48 QKnxDataSecureLayer::sequenceNumber() const
+{
+    return m_sequenceNumber;
+}
+
+/*!
+    \internal
+
+    Sets the sequence number the next secured TPDU is sent with to
+    \a sequenceNumber.
+*/
+void QKnxDataSecureLayer::setSequenceNumber(quint48 sequenceNumber)
+{
+    m_sequenceNumber = sequenceNumber;
+}
+
+/*!
+    \internal
+
+    Returns the highest sequence number accepted from the individual address
+    \a source, or \c 0 if none was accepted yet.
+*/
+quint48 QKnxDataSecureLayer::lastSequenceNumber(const QKnxAddress &source) const
+{
+    if (source.type() != QKnxAddress::Type::Individual || !source.isValid())
+        return 0;
+    return m_replayWindows.value(QKnxPrivate::rawAddress(source)).highest();
+}
+
+/*!
+    \internal
+
+    Treats all sequence numbers up to and including \a sequenceNumber from the
+    individual address \a source as received, for example to restore state
+    persisted by the application.
+*/
+void QKnxDataSecureLayer::setLastSequenceNumber(const QKnxAddress &source, quint48 sequenceNumber)
+{
+    if (source.type() == QKnxAddress::Type::Individual && source.isValid())
+        m_replayWindows[QKnxPrivate::rawAddress(source)].restore(sequenceNumber);
+}
+
+/*!
+    \internal
+
+    Returns the S-A_Data TPDU securing \a tpdu sent from \a source to the
+    group address \a destination with the given \a protection. On error, an
+    invalid TPDU is returned and \a status, if not \c nullptr, holds the
+    reason.
+*/
+QKnxTpdu QKnxDataSecureLayer::wrap(const QKnxTpdu &tpdu, const QKnxAddress &source,
+    const QKnxAddress &destination, Protection protection, Status *status)
+{
+    return wrapTpdu(tpdu, source, destination,
+        (destination.type() == QKnxAddress::Type::Group ? 0x80 : 0x00), protection, status);
+}
+
+/*!
+    \internal
+
+    Verifies the S-A_Data \a tpdu sent from \a source to the group address
+    \a destination and returns the plain TPDU. A TPDU that does not carry a
+    secure service is returned unchanged with \a status set to
+    \l {QKnxDataSecureLayer::Status} {NotSecured}. On any other error, an
+    invalid TPDU is returned.
+*/
+QKnxTpdu QKnxDataSecureLayer::unwrap(const QKnxTpdu &tpdu, const QKnxAddress &source,
+    const QKnxAddress &destination, Status *status)
+{
+    return unwrapTpdu(tpdu, source, destination,
+        (destination.type() == QKnxAddress::Type::Group ? 0x80 : 0x00), status);
+}
+
+/*!
+    \internal
+
+    Returns a copy of the link layer \a frame with its TPDU secured using the
+    given \a protection, or an invalid frame on error.
+*/
+QKnxLinkLayerFrame QKnxDataSecureLayer::wrap(const QKnxLinkLayerFrame &frame,
+    Protection protection, Status *status)
+{
+    // the hop count is not part of the authenticated data
+    const auto tpdu = wrapTpdu(frame.tpdu(), frame.sourceAddress(), frame.destinationAddress(),
+        quint8(frame.extendedControlField().byte() & 0x8f), protection, status);
+    if (tpdu.size() == 0)
+        return {};
+
+    QKnxLinkLayerFrame secured(frame);
+    secured.setTpdu(tpdu);
+    if (tpdu.size() > 16) { // 03_02_02 Paragraph 2.2.4.1, L_Data_Standard
+        auto ctrl = secured.controlField();
+        ctrl.setFrameFormat(QKnxControlField::FrameFormat::Extended);
+        secured.setControlField(ctrl);
+    }
+    return secured;
+}
+
+/*!
+    \internal
+
+    Returns a copy of the link layer \a frame with its TPDU verified and
+    decrypted. Frames without a secure service are returned unchanged. On any
+    other error, an invalid frame is returned.
+*/
+QKnxLinkLayerFrame QKnxDataSecureLayer::unwrap(const QKnxLinkLayerFrame &frame, Status *status)
+{
+    const auto tpdu = unwrapTpdu(frame.tpdu(), frame.sourceAddress(), frame.destinationAddress(),
+        quint8(frame.extendedControlField().byte() & 0x8f), status);
+    if (tpdu.size() == 0)
+        return {};
+
+    QKnxLinkLayerFrame plain(frame);
+    plain.setTpdu(tpdu);
+    return plain;
+}
+
+QSharedPointer<QKnxSslBlockCipher> QKnxDataSecureLayer::cipher(quint16 groupAddress) const
+{
+    const auto it = m_ciphers.constFind(groupAddress);
+    if (it != m_ciphers.cend())
+        return it.value();
+
+    if (!m_store)
+        return {};
+
+    auto key = m_store->groupKey(groupAddress);
+    QSharedPointer<QKnxSslBlockCipher> cipher(new QKnxSslBlockCipher(key));
+    QKnxPrivate::wipe(key.data(), key.size()); // the revealed copy is not protected
+    if (!cipher->isValid())
+        return {};
+    m_ciphers.insert(groupAddress, cipher);
+    return cipher;
+}
+
+QKnxReplayWindow &QKnxDataSecureLayer::replayWindow(quint16 source)
+{
+    auto it = m_replayWindows.find(source);
+    if (it != m_replayWindows.end())
+        return it.value();
+
+    auto &window = m_replayWindows[source];
+    if (!m_sequenceStore)
+        return window;
+
+    qint64 timestamp = 0;
+    const auto highest = m_sequenceStore->highWaterMark(QKnxPrivate::peerId(source), &timestamp);
+    if (timestamp != 0)
+        window.restore(highest);
+    return window;
+}
+
+QKnxTpdu QKnxDataSecureLayer::wrapTpdu(const QKnxTpdu &tpdu, const QKnxAddress &source,
+    const QKnxAddress &destination, quint8 frameFlags, Protection protection, Status *status)
+{
+    QKnxPrivate::setStatus(status, Status::InvalidFrame);
+    if (tpdu.size() < 2 || tpdu.transportControlField() == QKnxTpdu::TransportControlField::Invalid
+        || tpdu.applicationControlField() == QKnxTpdu::ApplicationControlField::SecureService) {
+        return {};
+    }
+
+    if (source.type() != QKnxAddress::Type::Individual || !source.isValid()
+        || !destination.isValid() || m_sequenceNumber > Q_UINT48_MAX) {
+        return {};
+    }
+
+    if (destination.type() != QKnxAddress::Type::Group) {
+        QKnxPrivate::setStatus(status, Status::Unsupported);
+        return {};
+    }
+
+    const auto dst = QKnxPrivate::rawAddress(destination);
+    const auto cipher = this->cipher(dst);
+    if (!cipher) {
+        QKnxPrivate::setStatus(status, Status::NoKey);
+        return {};
+    }
+
+    const bool confidential = (protection == Protection::AuthenticationConfidentiality);
+    const quint8 scf = quint8(quint8(protection) << 4);
+    const quint8 tpci = tpdu.bytes().at(0) & 0xfc;
+
+    auto apdu = tpdu.bytes();
+    apdu.set(0, apdu.at(0) & 0x03); // the TPCI stays outside of the secured APDU
+
+    if (m_sequenceStore && !m_sequenceStore->reserve(QKnxPrivate::sequenceNumberId,
+        m_sequenceNumber)) {
+        QKnxPrivate::setStatus(status, Status::StorageError);
+        return {};
+    }
+
+    quint8 b0[16];
+    QKnxPrivate::writeSequenceAndAddresses(b0, m_sequenceNumber,
+        QKnxPrivate::rawAddress(source), dst);
+    b0[10] = 0x00;
+    b0[11] = frameFlags;
+    b0[12] = tpci | 0x03;
+    b0[13] = 0xf1;
+    b0[14] = 0x00;
+    b0[15] = quint8(confidential ? apdu.size() : 0);
+
+    quint8 mac[QKnxPrivate::SecureMacSize];
+    bool ok;
+    if (confidential) {
+        ok = QKnxPrivate::messageAuthenticationCode(*cipher, b0, &scf, 1, apdu.constData(),
+            apdu.size(), mac);
+        ok = ok && QKnxPrivate::applyKeyStream(*cipher, b0, mac, apdu.data(), apdu.size());
+    } else {
+        const auto data = QKnxByteArray { scf } + apdu;
+        ok = QKnxPrivate::messageAuthenticationCode(*cipher, b0, data.constData(), data.size(),
+            nullptr, 0, mac);
+    }
+    if (!ok)
+        return {};
+
+    const auto bytes = QKnxByteArray { quint8(tpci | 0x03), 0xf1, scf }
+        + QKnxByteArray(b0, 6) + apdu + QKnxByteArray(mac, QKnxPrivate::SecureMacSize);
+
+    ++m_sequenceNumber;
+    QKnxPrivate::setStatus(status, Status::Ok);
+    return QKnxTpdu::fromBytes(bytes, 0, quint16(bytes.size()), tpdu.mediumType());
+}
+
+QKnxTpdu QKnxDataSecureLayer::unwrapTpdu(const QKnxTpdu &tpdu, const QKnxAddress &source,
+    const QKnxAddress &destination, quint8 frameFlags, Status *status)
+{
+    if (tpdu.applicationControlField() != QKnxTpdu::ApplicationControlField::SecureService) {
+        QKnxPrivate::setStatus(status, Status::NotSecured);
+        return tpdu;
+    }
+
+    QKnxPrivate::setStatus(status, Status::InvalidFrame);
+    const auto bytes = tpdu.bytes();
+    const int apduSize = bytes.size() - QKnxPrivate::SecureApduOffset - QKnxPrivate::SecureMacSize;
+    if (apduSize < 2 || source.type() != QKnxAddress::Type::Individual || !source.isValid()
+        || !destination.isValid()) {
+        return {};
+    }
+
+    const quint8 scf = bytes.at(2);
+    const quint8 algorithm = (scf >> 4) & 0x07;
+    const bool confidential = (algorithm == quint8(Protection::AuthenticationConfidentiality));
+    // tool access, system broadcast, S-A_Sync services and unknown algorithms
+    if ((scf & 0x8f) != 0x00 || algorithm > 0x01
+        || destination.type() != QKnxAddress::Type::Group) {
+        QKnxPrivate::setStatus(status, Status::Unsupported);
+        return {};
+    }
+
+    const auto src = QKnxPrivate::rawAddress(source);
+    const auto dst = QKnxPrivate::rawAddress(destination);
+    const auto cipher = this->cipher(dst);
+    if (!cipher) {
+        QKnxPrivate::setStatus(status, Status::NoKey);
+        return {};
+    }
+
+    quint48 sequence = 0;
+    for (int i = 3; i < QKnxPrivate::SecureApduOffset; ++i)
+        sequence = (sequence << 8) | bytes.at(i);
+
+    auto &window = replayWindow(src);
+    if (!window.check(sequence)) {
+        QKnxPrivate::setStatus(status, Status::Replayed);
+        return {};
+    }
+
+    auto apdu = bytes.mid(QKnxPrivate::SecureApduOffset, apduSize);
+    quint8 received[QKnxPrivate::SecureMacSize];
+    memcpy(received, bytes.constData() + bytes.size() - QKnxPrivate::SecureMacSize,
+        QKnxPrivate::SecureMacSize);
+
+    quint8 b0[16];
+    QKnxPrivate::writeSequenceAndAddresses(b0, sequence, src, dst);
+    b0[10] = 0x00;
+    b0[11] = frameFlags;
+    b0[12] = bytes.at(0);
+    b0[13] = bytes.at(1);
+    b0[14] = 0x00;
+    b0[15] = quint8(confidential ? apduSize : 0);
+
+    quint8 mac[QKnxPrivate::SecureMacSize];
+    bool ok;
+    if (confidential) {
+        ok = QKnxPrivate::applyKeyStream(*cipher, b0, received, apdu.data(), apdu.size());
+        ok = ok && QKnxPrivate::messageAuthenticationCode(*cipher, b0, &scf, 1, apdu.constData(),
+            apdu.size(), mac);
+    } else {
+        const auto data = QKnxByteArray { scf } + apdu;
+        ok = QKnxPrivate::messageAuthenticationCode(*cipher, b0, data.constData(), data.size(),
+            nullptr, 0, mac);
+    }
+
+    quint8 diff = 0;
+    for (int i = 0; i < QKnxPrivate::SecureMacSize; ++i)
+        diff |= quint8(mac[i] ^ received[i]);
+    if (!ok || diff != 0) {
+        QKnxPrivate::setStatus(status, Status::AuthenticationFailed);
+        return {};
+    }
+
+    window.accept(sequence);
+    if (m_sequenceStore)
+        m_sequenceStore->setHighWaterMark(QKnxPrivate::peerId(src), window.highest());
+    apdu.set(0, (bytes.at(0) & 0xfc) | (apdu.at(0) & 0x03));
+
+    QKnxPrivate::setStatus(status, Status::Ok);
+    return QKnxTpdu::fromBytes(apdu, 0, quint16(apdu.size()), tpdu.mediumType());
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,133 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXDATASECURELAYER_P_H
+#define QKNXDATASECURELAYER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qhash.h>
+#include <QtCore/qsharedpointer.h>
+
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxtpdu.h>
+#include <QtKnx/private/qknxreplaywindow_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxKeyringStore;
+class QKnxSequenceNumberStore;
+class QKnxSslBlockCipher;
+
+class Q_KNX_EXPORT QKnxDataSecureLayer final
+{
+public:
+    enum class Protection : quint8
+    {
+        Authentication = 0x00,
+        AuthenticationConfidentiality = 0x01
+    };
+
+    enum class Status : quint8
+    {
+        Ok,
+        NotSecured,
+        NoKey,
+        InvalidFrame,
+        Unsupported,
+        AuthenticationFailed,
+        Replayed,
+        StorageError
+    };
+
+    QKnxDataSecureLayer() = default;
+    ~QKnxDataSecureLayer() = default;
+
+    const QKnxKeyringStore *keyringStore() const;
+    void setKeyringStore(const QKnxKeyringStore *store);
+
+    bool hasGroupKey(quint16 groupAddress) const;
+    void setGroupKey(quint16 groupAddress, const QKnxByteArray &key);
+    void removeGroupKey(quint16 groupAddress);
+    void clearKeyCache();
+
+    QKnxSequenceNumberStore *sequenceNumberStore() const;
+    void setSequenceNumberStore(QKnxSequenceNumberStore *store);
+
+    quint48 sequenceNumber() const;
+    void setSequenceNumber(quint48 sequenceNumber);
+
+    quint48 lastSequenceNumber(const QKnxAddress &source) const;
+    void setLastSequenceNumber(const QKnxAddress &source, quint48 sequenceNumber);
+
+    QKnxTpdu wrap(const QKnxTpdu &tpdu, const QKnxAddress &source,
+        const QKnxAddress &destination,
+        Protection protection = Protection::AuthenticationConfidentiality,
+        Status *status = nullptr);
+    QKnxTpdu unwrap(const QKnxTpdu &tpdu, const QKnxAddress &source,
+        const QKnxAddress &destination, Status *status = nullptr);
+
+    QKnxLinkLayerFrame wrap(const QKnxLinkLayerFrame &frame,
+        Protection protection = Protection::AuthenticationConfidentiality,
+        Status *status = nullptr);
+    QKnxLinkLayerFrame unwrap(const QKnxLinkLayerFrame &frame, Status *status = nullptr);
+
+private:
+    Q_DISABLE_COPY(QKnxDataSecureLayer)
+
+    QSharedPointer<QKnxSslBlockCipher> cipher(quint16 groupAddress) const;
+    QKnxReplayWindow &replayWindow(quint16 source);
+    QKnxTpdu wrapTpdu(const QKnxTpdu &tpdu, const QKnxAddress &source,
+        const QKnxAddress &destination, quint8 frameFlags, Protection protection,
+        Status *status);
+    QKnxTpdu unwrapTpdu(const QKnxTpdu &tpdu, const QKnxAddress &source,
+        const QKnxAddress &destination, quint8 frameFlags, Status *status);
+
+private:
+    const QKnxKeyringStore *m_store { nullptr };
+    mutable QHash<quint16, QSharedPointer<QKnxSslBlockCipher>> m_ciphers;
+    QHash<quint16, QKnxReplayWindow> m_replayWindows;
+    QKnxSequenceNumberStore *m_sequenceStore { nullptr };
+    quint48 m_sequenceNumber { 0 };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -32,7 +32,6 @@
 #include "private/qknxssl_p.h"
 
 #include <QtCore/qcryptographichash.h>
-#include <QtCore/qregularexpression.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qxmlstream.h>
 
@@ -50,41 +49,67 @@ namespace QKnx { namespace Ets { namespace Keyring {
 
 namespace QKnxPrivate
 {
-    void writeBytes(QByteArray *dest, const QStringRef &source)
+    static void writeBytes(QCryptographicHash *hash, const QStringRef &source)
     {
-        dest->append(quint8(source.size()));
-        dest->append(source.toString().toUtf8());
+        // the length prefix is the number of UTF-16 code units, as done by ETS
+        const auto utf8 = source.toUtf8();
+        hash->addData(QByteArray(1, char(quint8(source.size()))));
+        hash->addData(utf8);
     }
 
-    void writeBytes(QByteArray *dest, const QByteArray &source)
+    static bool isBase64Character(QChar c)
     {
-        dest->append(quint8(source.size()));
-        dest->append(source);
+        const auto u = c.unicode();
+        return (u >= 'A' && u <= 'Z') || (u >= 'a' && u <= 'z') || (u >= '0' && u <= '9')
+            || u == '+' || u == '/';
     }
 
-    static void readElement(QXmlStreamReader *reader, QByteArray *bytes)
+    // pattern [A-Za-z0-9\+/]{21}[AQgw]==
+    static bool isOneBlockBase64(const QStringRef &value)
     {
-        bytes->append(0x01);
-        QKnxPrivate::writeBytes(bytes, reader->name());
-
-        auto attributes = reader->attributes();
-        std::sort(attributes.begin(), attributes.end(),
-            [](const QXmlStreamAttribute &lhs, const QXmlStreamAttribute &rhs) {
-                return lhs.name() < rhs.name();
-        });
-
-        for (auto attribute : qAsConst(attributes)) {
-            QKnxPrivate::writeBytes(bytes, attribute.name());
-            QKnxPrivate::writeBytes(bytes, attribute.value());
+        if (value.size() != 24)
+            return false;
+        for (int i = 0; i < 21; ++i) {
+            if (!isBase64Character(value.at(i)))
+                return false;
         }
+        const auto last = value.at(21).unicode();
+        return (last == 'A' || last == 'Q' || last == 'g' || last == 'w')
+            && value.at(22) == QLatin1Char('=') && value.at(23) == QLatin1Char('=');
+    }
 
-        while (!reader->atEnd()) {
-            auto token = reader->readNext();
-            if (token == QXmlStreamReader::StartElement)
-                QKnxPrivate::readElement(reader, bytes);
-            if (token == QXmlStreamReader::EndElement)
-                bytes->append(0x02);
+    // decimal number without leading zeros, as required by the XSD patterns
+    static int toDecimal(const QStringRef &value, int max)
+    {
+        if (value.isEmpty() || value.size() > 3)
+            return -1;
+        if (value.size() > 1 && value.at(0) == QLatin1Char('0'))
+            return -1;
+
+        int result = 0;
+        for (const auto c : value) {
+            if (c < QLatin1Char('0') || c > QLatin1Char('9'))
+                return -1;
+            result = result * 10 + (c.unicode() - '0');
         }
+        return result <= max ? result : -1;
+    }
+
+    static bool isMulticastAddress(const QString &value)
+    {
+        const auto parts = value.splitRef(QLatin1Char('.'));
+        if (parts.size() != 4)
+            return false;
+        const auto first = toDecimal(parts.at(0), 255);
+        return first >= 224 && first <= 239 && toDecimal(parts.at(1), 255) >= 0
+            && toDecimal(parts.at(2), 255) >= 0 && toDecimal(parts.at(3), 255) >= 0;
+    }
+
+    static bool isIndividualAddress(const QString &value)
+    {
+        const auto parts = value.splitRef(QLatin1Char('.'));
+        return parts.size() == 3 && toDecimal(parts.at(0), 15) >= 0
+            && toDecimal(parts.at(1), 15) >= 0 && toDecimal(parts.at(2), 255) >= 0;
     }
 
     static bool fetchAttr(const QXmlStreamAttributes &attributes, const QString &attrName,
@@ -130,14 +155,77 @@ namespace QKnxPrivate
     }
 }
 
-const char oneBlockBase64[29] = "^[A-Za-z0-9\\+/]{21}[AQgw]==$";
-// const char twoBlockBase64[40] = "^[A-Za-z0-9\\+/]{42}[AEIMQUYcgkosw048]=$";
+/*!
+    \internal
+    \class QKnx::Ets::Keyring::QKnxPrivate::QKnxKeyringSignature
+
+    Computes the keyring signature while the file is parsed. Every element is
+    fed as a start marker followed by its name and its attributes sorted by
+    name, every end of an element as an end marker. The hash is updated on
+    the fly, so the file has to be read only once.
+*/
+namespace QKnxPrivate
+{
+    void QKnxKeyringSignature::addRootElement(const QXmlStreamReader &reader)
+    {
+        m_hash.addData(QByteArray(1, 0x01));
+        writeBytes(&m_hash, reader.name());
 
-const char multicast[128] = "^2(2[4-9]|3[0-9])\\.((25[0-5]|2[0-4][0-9]|1[0-9][0-9]|[1-9][0-9]|"
-    "[0-9])\\.){2}(25[0-5]|2[0-4][0-9]|1[0-9][0-9]|[1-9][0-9]|[0-9])$";
+        auto attributes = reader.attributes();
+        m_signature = attributes.value(QStringLiteral("Signature")).toUtf8();
+        addAttributes(&attributes, true);
+    }
 
-const char individualAddress[74] = "^((1[0-5]|[0-9])\\.){2}(25[0-5]|2[0-4][0-9]|1[0-9][0-9]|[1-9]"
-    "[0-9]|[0-9])$";
+    void QKnxKeyringSignature::addToken(const QXmlStreamReader &reader)
+    {
+        if (reader.isStartElement()) {
+            m_content = true;
+            m_hash.addData(QByteArray(1, 0x01));
+            writeBytes(&m_hash, reader.name());
+            auto attributes = reader.attributes();
+            addAttributes(&attributes, false);
+        } else if (m_content && reader.isEndElement()) {
+            m_hash.addData(QByteArray(1, 0x02));
+        }
+    }
+
+    bool QKnxKeyringSignature::verify(const QKnxByteArray &pwHash)
+    {
+        if (m_signature.isEmpty())
+            return false;
+
+        const auto base64 = pwHash.toByteArray().toBase64();
+        m_hash.addData(QByteArray(1, char(quint8(base64.size()))));
+        m_hash.addData(base64);
+        return m_hash.result().left(16) == QByteArray::fromBase64(m_signature);
+    }
+
+    void QKnxKeyringSignature::addAttributes(QXmlStreamAttributes *attributes, bool root)
+    {
+        std::sort(attributes->begin(), attributes->end(),
+            [](const QXmlStreamAttribute &lhs, const QXmlStreamAttribute &rhs) {
+                return lhs.name() < rhs.name();
+        });
+
+        for (const auto &attribute : qAsConst(*attributes)) {
+            if (root && (attribute.name() == QLatin1String("xmlns")
+                || attribute.name() == QLatin1String("Signature"))) {
+                continue;
+            }
+            writeBytes(&m_hash, attribute.name());
+            writeBytes(&m_hash, attribute.value());
+        }
+    }
+
+    static QXmlStreamReader::TokenType readNext(QXmlStreamReader *reader,
+        QKnxKeyringSignature *signature)
+    {
+        const auto token = reader->readNext();
+        if (signature)
+            signature->addToken(*reader);
+        return token;
+    }
+}
 
 bool QKnxBackbone::parseElement(QXmlStreamReader *reader, bool pedantic)
 {
@@ -161,7 +249,7 @@ bool QKnxBackbone::parseElement(QXmlStreamReader *reader, bool pedantic)
         Key = attr.toUtf8();
 
         if (pedantic) {
-            if (!QRegularExpression(QLatin1String(multicast)).match(MulticastAddress).hasMatch()) {
+            if (!QKnxPrivate::isMulticastAddress(MulticastAddress)) {
                 reader->raiseError(tr("The 'MulticastAddress' attribute is invalid. The Pattern "
                     "constraint failed, got: '%1'.").arg(MulticastAddress));
                 return false;
@@ -173,7 +261,7 @@ bool QKnxBackbone::parseElement(QXmlStreamReader *reader, bool pedantic)
                 return false;
             }
 
-            if (!QRegularExpression(QLatin1String(oneBlockBase64)).match(attr).hasMatch()) {
+            if (!QKnxPrivate::isOneBlockBase64(attr)) {
                 reader->raiseError(tr("The 'Key' attribute is invalid. The Pattern constraint "
                     "failed, got: '%1'.").arg(QString::fromUtf8(Key)));
                 return false;
@@ -203,10 +291,8 @@ bool QKnxInterface::QKnxGroup::parseElement(QXmlStreamReader *reader, bool pedan
             return false;
         Senders = attr.toString().split(QLatin1Char(' ')).toVector();
         if (pedantic) {
-            QRegularExpression regExp;
-            regExp.setPattern(QLatin1String(individualAddress));
-            for (auto sender : qAsConst(Senders)) {
-                if (!regExp.match(sender).hasMatch()) {
+            for (const auto &sender : qAsConst(Senders)) {
+                if (!QKnxPrivate::isIndividualAddress(sender)) {
                     reader->raiseError(tr("The 'Senders' attribute is invalid. The Pattern "
                         "constraint failed, got: '%1'.").arg(sender));
                     return false;
@@ -220,7 +306,8 @@ bool QKnxInterface::QKnxGroup::parseElement(QXmlStreamReader *reader, bool pedan
     return !reader->hasError();
 }
 
-bool QKnxInterface::parseElement(QXmlStreamReader *reader, bool pedantic)
+bool QKnxInterface::parseElement(QXmlStreamReader *reader, bool pedantic,
+    QKnxPrivate::QKnxKeyringSignature *signature)
 {
     if (!reader || !reader->isStartElement())
         return false;
@@ -246,7 +333,7 @@ bool QKnxInterface::parseElement(QXmlStreamReader *reader, bool pedantic)
 
         // children
         while (!reader->atEnd() && !reader->hasError()) {
-            auto tokenType = reader->readNext();
+            auto tokenType = QKnxPrivate::readNext(reader, signature);
             if (tokenType == QXmlStreamReader::TokenType::StartElement) {
                 if (reader->name() == QStringLiteral("Group")) {
                     QKnxInterface::QKnxGroup group;
@@ -282,7 +369,7 @@ bool QKnxGroupAddresses::QKnxGroup::parseElement(QXmlStreamReader *reader, bool
         if (!QKnxPrivate::fetchAttr(attrs, QStringLiteral("Key"), &attr, reader))
             return false;
         Key = attr.toUtf8();
-        if (pedantic && !QRegularExpression(QLatin1String(oneBlockBase64)).match(attr).hasMatch()) {
+        if (pedantic && !QKnxPrivate::isOneBlockBase64(attr)) {
             reader->raiseError(tr("The 'Key' attribute is invalid. The Pattern "
                 "constraint failed, got: '%1'.").arg(QString::fromUtf8(Key)));
             return false;
@@ -294,7 +381,8 @@ bool QKnxGroupAddresses::QKnxGroup::parseElement(QXmlStreamReader *reader, bool
     return !reader->hasError();
 }
 
-bool QKnxGroupAddresses::parseElement(QXmlStreamReader *reader, bool pedantic)
+bool QKnxGroupAddresses::parseElement(QXmlStreamReader *reader, bool pedantic,
+    QKnxPrivate::QKnxKeyringSignature *signature)
 {
     if (!reader || !reader->isStartElement())
         return false;
@@ -302,7 +390,7 @@ bool QKnxGroupAddresses::parseElement(QXmlStreamReader *reader, bool pedantic)
     if (reader->name() == QStringLiteral("GroupAddresses")) {
         // children
         while (!reader->atEnd() && !reader->hasError()) {
-            auto tokenType = reader->readNext();
+            auto tokenType = QKnxPrivate::readNext(reader, signature);
             if (tokenType == QXmlStreamReader::TokenType::StartElement) {
                 if (reader->name() == QStringLiteral("Group")) {
                     QKnxGroupAddresses::QKnxGroup group;
@@ -334,8 +422,7 @@ bool QKnxDevice::parseElement(QXmlStreamReader *reader, bool pedantic)
         if (!QKnxPrivate::fetchAttr(attrs, QLatin1String("IndividualAddress"), &attr, reader))
             return false;
         IndividualAddress = attr.toString();
-        if (pedantic && !QRegularExpression(QLatin1String(individualAddress))
-            .match(IndividualAddress).hasMatch()) {
+        if (pedantic && !QKnxPrivate::isIndividualAddress(IndividualAddress)) {
                 reader->raiseError(tr("The 'IndividualAddress' attribute is invalid. The "
                     "Pattern constraint failed, got: '%1'.").arg(IndividualAddress));
                 return false;
@@ -353,7 +440,8 @@ bool QKnxDevice::parseElement(QXmlStreamReader *reader, bool pedantic)
     return !reader->hasError();
 }
 
-bool QKnxDevices::parseElement(QXmlStreamReader *reader, bool pedantic)
+bool QKnxDevices::parseElement(QXmlStreamReader *reader, bool pedantic,
+    QKnxPrivate::QKnxKeyringSignature *signature)
 {
     if (!reader || !reader->isStartElement())
         return false;
@@ -361,7 +449,7 @@ bool QKnxDevices::parseElement(QXmlStreamReader *reader, bool pedantic)
     if (reader->name() == QStringLiteral("Devices")) {
         // children
         while (!reader->atEnd() && !reader->hasError()) {
-            auto tokenType = reader->readNext();
+            auto tokenType = QKnxPrivate::readNext(reader, signature);
             if (tokenType == QXmlStreamReader::TokenType::StartElement) {
                 if (reader->name() == QStringLiteral("Device")) {
                     QKnxDevice device;
@@ -381,12 +469,16 @@ bool QKnxDevices::parseElement(QXmlStreamReader *reader, bool pedantic)
     return !reader->hasError() && Device.size() >= 1;
 }
 
-bool QKnxKeyring::parseElement(QXmlStreamReader *reader, bool pedantic)
+bool QKnxKeyring::parseElement(QXmlStreamReader *reader, bool pedantic,
+    QKnxPrivate::QKnxKeyringSignature *signature)
 {
     if (!reader || !reader->readNextStartElement())
         return false;
 
     if (reader->name() == QStringLiteral("Keyring")) {
+        if (signature)
+            signature->addRootElement(*reader);
+
         auto attrs = reader->attributes();
 
         QStringRef attr; // mandatory attributes
@@ -407,7 +499,7 @@ bool QKnxKeyring::parseElement(QXmlStreamReader *reader, bool pedantic)
             return false;
         Signature = attr.toUtf8();
         if (pedantic) {
-            if (!QRegularExpression(QLatin1String(oneBlockBase64)).match(attr).hasMatch()) {
+            if (!QKnxPrivate::isOneBlockBase64(attr)) {
                 reader->raiseError(tr("The 'Signature' attribute is invalid. The Pattern "
                     "constraint failed, got: '%1'.").arg(attr));
                 return false;
@@ -416,7 +508,7 @@ bool QKnxKeyring::parseElement(QXmlStreamReader *reader, bool pedantic)
 
         // children
         while (!reader->atEnd() && !reader->hasError()) {
-            auto tokenType = reader->readNext();
+            auto tokenType = QKnxPrivate::readNext(reader, signature);
             if (tokenType == QXmlStreamReader::TokenType::StartElement) {
                 if (reader->name() == QStringLiteral("Backbone")) {
                     if (pedantic && Backbone.size() >= 1) {
@@ -430,7 +522,7 @@ bool QKnxKeyring::parseElement(QXmlStreamReader *reader, bool pedantic)
                     Backbone.append(backbone);
                 } else if (reader->name() == QStringLiteral("Interface")) {
                     QKnxInterface interface;
-                    if (!interface.parseElement(reader, pedantic))
+                    if (!interface.parseElement(reader, pedantic, signature))
                         return false;
                     Interface.append(interface);
                 } else if (reader->name() == QStringLiteral("GroupAddresses")) {
@@ -440,7 +532,7 @@ bool QKnxKeyring::parseElement(QXmlStreamReader *reader, bool pedantic)
                         return false;
                     }
                     QKnxGroupAddresses groupAddresses;
-                    if (!groupAddresses.parseElement(reader, pedantic))
+                    if (!groupAddresses.parseElement(reader, pedantic, signature))
                         return false;
                     GroupAddresses.append(groupAddresses);
                 } else if (reader->name() == QStringLiteral("Devices")) {
@@ -450,7 +542,7 @@ bool QKnxKeyring::parseElement(QXmlStreamReader *reader, bool pedantic)
                         return false;
                     }
                     QKnxDevices devices;
-                    if (!devices.parseElement(reader, pedantic))
+                    if (!devices.parseElement(reader, pedantic, signature))
                         return false;
                     Devices.append(devices);
                 }
@@ -474,40 +566,32 @@ bool QKnxKeyring::validate(QXmlStreamReader *reader, const QKnxByteArray &pwHash
     if (reader->name() != QStringLiteral("Keyring"))
         return false;
 
-    QByteArray bytes;
-    bytes.append(0x01);
-
-    QKnxPrivate::writeBytes(&bytes, reader->name());
-
-    auto attributes = reader->attributes();
-    if (attributes.isEmpty())
-        return false;
+    QKnxPrivate::QKnxKeyringSignature signature;
+    signature.addRootElement(*reader);
+    while (!reader->atEnd())
+        QKnxPrivate::readNext(reader, &signature);
+    return !reader->hasError() && signature.verify(pwHash);
+}
 
-    auto signature = attributes.value({}, QStringLiteral("Signature")).toUtf8();
-    if (signature.isEmpty())
+bool QKnxKeyring::load(const QString &filePath, const QKnxByteArray &pwHash, bool verify)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
         return false;
 
-    std::sort(attributes.begin(), attributes.end(),
-        [](const QXmlStreamAttribute &lhs, const QXmlStreamAttribute &rhs) {
-            return lhs.name() < rhs.name();
-    });
-
-    for (auto attribute : attributes) {
-        if (attribute.name() == QStringLiteral("xmlns"))
-            continue;
-        if (attribute.name() == QStringLiteral("Signature"))
-            continue;
+    // parse and compute the signature in a single pass over the file
+    QXmlStreamReader reader(&file);
+    if (!verify)
+        return parseElement(&reader, true);
 
-        QKnxPrivate::writeBytes(&bytes, attribute.name());
-        QKnxPrivate::writeBytes(&bytes, attribute.value());
-    }
-
-    if (reader->readNextStartElement())
-        QKnxPrivate::readElement(reader, &bytes);
-    QKnxPrivate::writeBytes(&bytes, pwHash.toByteArray().toBase64());
+    QKnxPrivate::QKnxKeyringSignature signature;
+    if (!parseElement(&reader, true, &signature))
+        return false;
 
-    return QKnxCryptographicEngine::hashSha256(bytes).left(16)
-        == QKnxByteArray::fromByteArray(QByteArray::fromBase64(signature));
+    // consume whatever follows the keyring element, it takes part in the signature
+    while (!reader.atEnd())
+        QKnxPrivate::readNext(&reader, &signature);
+    return !reader.hasError() && signature.verify(pwHash);
 }
 
 }}} // QKnx::Ets::Keyring
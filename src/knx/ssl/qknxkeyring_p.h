@@ -42,15 +42,35 @@
 //
 
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qvector.h>
 #include <QtCore/qxmlstream.h>
 
+#include <QtKnx/qknxbytearray.h>
 #include <QtKnx/qtknxglobal.h>
 
 QT_BEGIN_NAMESPACE
 
 namespace QKnx { namespace Ets { namespace Keyring {
 
+namespace QKnxPrivate
+{
+    class QKnxKeyringSignature
+    {
+    public:
+        void addRootElement(const QXmlStreamReader &reader);
+        void addToken(const QXmlStreamReader &reader);
+        bool verify(const QKnxByteArray &pwHash);
+
+    private:
+        void addAttributes(QXmlStreamAttributes *attributes, bool root);
+
+        QCryptographicHash m_hash { QCryptographicHash::Sha256 };
+        QByteArray m_signature;
+        bool m_content { false };
+    };
+}
+
 struct Q_KNX_EXPORT QKnxBackbone
 {
     Q_DECLARE_TR_FUNCTIONS(QKnxBackbone)
@@ -88,7 +108,8 @@ public:
     };
     QVector<QKnxGroup> Group; // 0..n
 
-    bool parseElement(QXmlStreamReader *reader, bool pedantic);
+    bool parseElement(QXmlStreamReader *reader, bool pedantic,
+        QKnxPrivate::QKnxKeyringSignature *signature = nullptr);
 };
 
 struct Q_KNX_EXPORT QKnxGroupAddresses
@@ -108,7 +129,8 @@ public:
     };
     QVector<QKnxGroup> Group; // 1..n
 
-    bool parseElement(QXmlStreamReader *reader, bool pedantic);
+    bool parseElement(QXmlStreamReader *reader, bool pedantic,
+        QKnxPrivate::QKnxKeyringSignature *signature = nullptr);
 };
 
 struct Q_KNX_EXPORT QKnxDevice
@@ -131,7 +153,8 @@ struct Q_KNX_EXPORT QKnxDevices
 
 public:
     QVector<QKnxDevice> Device; // 0..n
-    bool parseElement(QXmlStreamReader *reader, bool pedantic);
+    bool parseElement(QXmlStreamReader *reader, bool pedantic,
+        QKnxPrivate::QKnxKeyringSignature *signature = nullptr);
 };
 
 struct Q_KNX_EXPORT QKnxKeyring
@@ -149,8 +172,11 @@ public:
     QVector<QKnxGroupAddresses> GroupAddresses; // 0..1
     QVector<QKnxDevices> Devices; // 0..1
 
-    bool parseElement(QXmlStreamReader *reader, bool pedantic);
+    bool parseElement(QXmlStreamReader *reader, bool pedantic,
+        QKnxPrivate::QKnxKeyringSignature *signature = nullptr);
     bool validate(QXmlStreamReader *reader, const QKnxByteArray &pwHash) const;
+
+    bool load(const QString &filePath, const QKnxByteArray &pwHash, bool verify);
 };
 
 }}} // QKnx::Ets::Keyring
@@ -0,0 +1,467 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxcryptographicengine.h"
+#include "qknxkeyringstore_p.h"
+#include "qknxutils.h"
+
+#if defined(Q_OS_WIN)
+#  include <QtCore/qt_windows.h>
+#elif defined(Q_OS_UNIX)
+#  include <sys/mman.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QKnxPrivate
+{
+    enum : int { LockedPageSize = 4096 };
+
+    void wipe(void *data, int size)
+    {
+        // volatile writes, so the compiler cannot drop the store of dead memory
+        auto bytes = static_cast<volatile quint8 *>(data);
+        for (int i = 0; i < size; ++i)
+            bytes[i] = 0;
+    }
+
+    static bool lockPage(void *data, int size)
+    {
+#if defined(Q_OS_WIN)
+        return VirtualLock(data, SIZE_T(size)) != 0;
+#elif defined(Q_OS_UNIX)
+        return mlock(data, size_t(size)) == 0;
+#else
+        Q_UNUSED(data)
+        Q_UNUSED(size)
+        return false;
+#endif
+    }
+
+    static void unlockPage(void *data, int size)
+    {
+#if defined(Q_OS_WIN)
+        VirtualUnlock(data, SIZE_T(size));
+#elif defined(Q_OS_UNIX)
+        munlock(data, size_t(size));
+#else
+        Q_UNUSED(data)
+        Q_UNUSED(size)
+#endif
+    }
+
+    static bool toRawAddress(const QKnxAddress &address, quint16 *raw)
+    {
+        if (!address.isValid())
+            return false;
+        *raw = QKnxUtils::QUint16::fromBytes(address.bytes());
+        return true;
+    }
+
+    QKnxLockedMemory::~QKnxLockedMemory()
+    {
+        clear();
+    }
+
+    quint8 *QKnxLockedMemory::allocate(int size)
+    {
+        if (size <= 0 || size > LockedPageSize)
+            return nullptr;
+
+        if (m_pages.isEmpty() || m_pages.constLast().used + size > LockedPageSize) {
+            Page page;
+            page.data = static_cast<quint8 *>(qMallocAligned(LockedPageSize, LockedPageSize));
+            if (!page.data)
+                return nullptr;
+            wipe(page.data, LockedPageSize);
+            // locking may fail, e.g. if RLIMIT_MEMLOCK is exhausted; the page is still wiped
+            page.locked = lockPage(page.data, LockedPageSize);
+            m_pages.append(page);
+        }
+
+        auto &page = m_pages.last();
+        auto data = page.data + page.used;
+        page.used += size;
+        return data;
+    }
+
+    void QKnxLockedMemory::clear()
+    {
+        for (const auto &page : qAsConst(m_pages)) {
+            wipe(page.data, LockedPageSize);
+            if (page.locked)
+                unlockPage(page.data, LockedPageSize);
+            qFreeAligned(page.data);
+        }
+        m_pages.clear();
+    }
+}
+
+/*!
+    \internal
+    \class QKnxKeyringStore
+
+    \brief The QKnxKeyringStore class provides indexed access to the keys and
+    passwords stored in an ETS keyring (*.knxkeys) file.
+
+    Group keys are indexed by their 16-bit group address, tunneling interfaces
+    and devices by their 16-bit individual address, so that a lookup does not
+    need to scan the keyring. The encrypted values are decrypted on first use
+    only. Decrypted values are kept in page-locked memory if the platform
+    permits it, and that memory is wiped when the store is cleared or
+    destroyed.
+
+    Only this cache is protected. The byte arrays returned by the lookup
+    functions are ordinary heap copies that are neither locked nor wiped, and
+    neither is the key schedule of a cipher created from them. Callers should
+    overwrite a returned secret with QKnxPrivate::wipe() as soon as it is no
+    longer needed.
+
+    All lookup functions are thread-safe.
+*/
+
+/*!
+    Loads the keyring file \a filePath and decrypts its content using the
+    keyring password \a password. If \a validate is \c true, the keyring
+    signature is verified.
+
+    Returns \c true on success; otherwise returns \c false and the store is
+    empty.
+*/
+bool QKnxKeyringStore::load(const QString &filePath, const QByteArray &password, bool validate)
+{
+    QKnx::Ets::Keyring::QKnxKeyring keyring;
+    const auto pwHash = QKnxCryptographicEngine::keyringPasswordHash(password);
+    if (!keyring.load(filePath, pwHash, validate)) {
+        clear();
+        return false;
+    }
+    return load(keyring, pwHash);
+}
+
+/*!
+    Indexes the already parsed \a keyring. The encrypted entries will be
+    decrypted using the keyring password hash \a passwordHash.
+
+    Returns \c true on success; otherwise returns \c false and the store is
+    empty.
+*/
+bool QKnxKeyringStore::load(const QKnx::Ets::Keyring::QKnxKeyring &keyring,
+    const QKnxByteArray &passwordHash)
+{
+    clear();
+    if (passwordHash.isEmpty())
+        return false;
+
+    auto createdHash = QKnxCryptographicEngine::hashSha256(keyring.Created.toUtf8());
+
+    QMutexLocker locker(&m_mutex);
+    auto store = [this](const QKnxByteArray &value, Secret *secret) {
+        auto data = m_memory.allocate(value.size());
+        if (!data)
+            return false;
+        memcpy(data, value.constData(), size_t(value.size()));
+        secret->plain = data;
+        secret->size = value.size();
+        return true;
+    };
+    const bool stored = store(passwordHash, &m_passwordHash) && store(createdHash, &m_createdHash);
+    QKnxPrivate::wipe(createdHash.data(), createdHash.size());
+    if (!stored) {
+        locker.unlock();
+        clear();
+        return false;
+    }
+    locker.unlock();
+
+    m_keyring = keyring;
+    if (!m_keyring.Backbone.isEmpty())
+        m_backboneKey = { m_keyring.Backbone.constFirst().Key, Secret::Kind::Key };
+
+    for (const auto &groupAddresses : qAsConst(m_keyring.GroupAddresses)) {
+        for (const auto &group : groupAddresses.Group)
+            m_groupKeys.insert(group.Address, { group.Key, Secret::Kind::Key });
+    }
+
+    quint16 address = 0;
+    for (int i = 0; i < m_keyring.Interface.size(); ++i) {
+        const auto &iface = m_keyring.Interface.at(i);
+        if (!QKnxPrivate::toRawAddress({ QKnxAddress::Type::Individual,
+            iface.IndividualAddress }, &address)) {
+            continue; // e.g. USB interfaces do not carry an individual address
+        }
+
+        InterfaceEntry entry;
+        entry.index = i;
+        entry.userPassword = { iface.Password, Secret::Kind::Password };
+        entry.authenticationCode = { iface.Authentication, Secret::Kind::Password };
+        m_interfaces.insert(address, entry);
+    }
+
+    const auto devices = m_keyring.Devices.value(0).Device;
+    for (int i = 0; i < devices.size(); ++i) {
+        const auto &device = devices.at(i);
+        if (!QKnxPrivate::toRawAddress({ QKnxAddress::Type::Individual,
+            device.IndividualAddress }, &address)) {
+            continue;
+        }
+
+        DeviceEntry entry;
+        entry.index = i;
+        entry.toolKey = { device.ToolKey, Secret::Kind::Key };
+        entry.managementPassword = { device.ManagementPassword, Secret::Kind::Password };
+        entry.authenticationCode = { device.Authentication, Secret::Kind::Password };
+        m_devices.insert(address, entry);
+    }
+    return true;
+}
+
+/*!
+    Removes all entries from the store and wipes all decrypted values.
+*/
+void QKnxKeyringStore::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_keyring = {};
+    m_backboneKey = {};
+    m_groupKeys.clear();
+    m_interfaces.clear();
+    m_devices.clear();
+    m_passwordHash = {};
+    m_createdHash = {};
+    m_memory.clear();
+}
+
+/*!
+    Returns \c true if no keyring was loaded; otherwise returns \c false.
+*/
+bool QKnxKeyringStore::isEmpty() const
+{
+    return m_passwordHash.size == 0;
+}
+
+/*!
+    Returns the keyring the store was loaded from.
+*/
+const QKnx::Ets::Keyring::QKnxKeyring &QKnxKeyringStore::keyring() const
+{
+    return m_keyring;
+}
+
+/*!
+    Returns the decrypted backbone key or an empty byte array if the keyring
+    does not contain a backbone.
+*/
+QKnxByteArray QKnxKeyringStore::backboneKey() const
+{
+    return reveal(m_backboneKey);
+}
+
+/*!
+    Returns the group addresses the keyring holds a key for.
+*/
+QVector<quint16> QKnxKeyringStore::groupAddresses() const
+{
+    return m_groupKeys.keys().toVector();
+}
+
+/*!
+    Returns \c true if the keyring holds a key for the group address
+    \a groupAddress; otherwise returns \c false.
+*/
+bool QKnxKeyringStore::hasGroupKey(quint16 groupAddress) const
+{
+    return m_groupKeys.contains(groupAddress);
+}
+
+/*!
+    Returns the decrypted key of the group address \a groupAddress or an
+    empty byte array if there is no such key.
+*/
+QKnxByteArray QKnxKeyringStore::groupKey(quint16 groupAddress) const
+{
+    const auto it = m_groupKeys.constFind(groupAddress);
+    return (it != m_groupKeys.cend() ? reveal(it.value()) : QKnxByteArray {});
+}
+
+/*!
+    \overload
+*/
+QKnxByteArray QKnxKeyringStore::groupKey(const QKnxAddress &groupAddress) const
+{
+    quint16 address = 0;
+    if (groupAddress.type() != QKnxAddress::Type::Group
+        || !QKnxPrivate::toRawAddress(groupAddress, &address)) {
+        return {};
+    }
+    return groupKey(address);
+}
+
+/*!
+    Returns the individual addresses of all indexed tunneling interfaces.
+*/
+QVector<quint16> QKnxKeyringStore::interfaceAddresses() const
+{
+    return m_interfaces.keys().toVector();
+}
+
+/*!
+    Returns the interface with the individual address \a individualAddress
+    or \c nullptr if there is no such interface. The pointer stays valid until
+    the store is cleared or reloaded.
+*/
+const QKnx::Ets::Keyring::QKnxInterface *QKnxKeyringStore::findInterface(quint16 individualAddress) const
+{
+    const auto it = m_interfaces.constFind(individualAddress);
+    return (it != m_interfaces.cend() ? &m_keyring.Interface.at(it->index) : nullptr);
+}
+
+/*!
+    Returns the decrypted user password of the interface with the individual
+    address \a individualAddress or an empty byte array if there is none.
+*/
+QKnxByteArray QKnxKeyringStore::interfaceUserPassword(quint16 individualAddress) const
+{
+    const auto it = m_interfaces.constFind(individualAddress);
+    return (it != m_interfaces.cend() ? reveal(it->userPassword) : QKnxByteArray {});
+}
+
+/*!
+    Returns the decrypted device authentication code of the interface with the
+    individual address \a individualAddress or an empty byte array if there is
+    none.
+*/
+QKnxByteArray QKnxKeyringStore::interfaceAuthenticationCode(quint16 individualAddress) const
+{
+    const auto it = m_interfaces.constFind(individualAddress);
+    return (it != m_interfaces.cend() ? reveal(it->authenticationCode) : QKnxByteArray {});
+}
+
+/*!
+    Returns the individual addresses of all indexed devices.
+*/
+QVector<quint16> QKnxKeyringStore::deviceAddresses() const
+{
+    return m_devices.keys().toVector();
+}
+
+/*!
+    Returns the device with the individual address \a individualAddress or
+    \c nullptr if there is no such device. The pointer stays valid until the
+    store is cleared or reloaded.
+*/
+const QKnx::Ets::Keyring::QKnxDevice *QKnxKeyringStore::findDevice(quint16 individualAddress) const
+{
+    const auto it = m_devices.constFind(individualAddress);
+    if (it == m_devices.cend())
+        return nullptr;
+    return &m_keyring.Devices.constFirst().Device.at(it->index);
+}
+
+/*!
+    Returns the decrypted tool key of the device with the individual address
+    \a individualAddress or an empty byte array if there is none.
+*/
+QKnxByteArray QKnxKeyringStore::deviceToolKey(quint16 individualAddress) const
+{
+    const auto it = m_devices.constFind(individualAddress);
+    return (it != m_devices.cend() ? reveal(it->toolKey) : QKnxByteArray {});
+}
+
+/*!
+    \overload
+*/
+QKnxByteArray QKnxKeyringStore::deviceToolKey(const QKnxAddress &individualAddress) const
+{
+    quint16 address = 0;
+    if (individualAddress.type() != QKnxAddress::Type::Individual
+        || !QKnxPrivate::toRawAddress(individualAddress, &address)) {
+        return {};
+    }
+    return deviceToolKey(address);
+}
+
+/*!
+    Returns the decrypted management password of the device with the
+    individual address \a individualAddress or an empty byte array if there
+    is none.
+*/
+QKnxByteArray QKnxKeyringStore::deviceManagementPassword(quint16 individualAddress) const
+{
+    const auto it = m_devices.constFind(individualAddress);
+    return (it != m_devices.cend() ? reveal(it->managementPassword) : QKnxByteArray {});
+}
+
+/*!
+    Returns the decrypted device authentication code of the device with the
+    individual address \a individualAddress or an empty byte array if there
+    is none.
+*/
+QKnxByteArray QKnxKeyringStore::deviceAuthenticationCode(quint16 individualAddress) const
+{
+    const auto it = m_devices.constFind(individualAddress);
+    return (it != m_devices.cend() ? reveal(it->authenticationCode) : QKnxByteArray {});
+}
+
+/*!
+    \internal
+
+    Returns the decrypted value of \a secret, decrypting it into locked memory
+    on first use. The returned copy is not protected, see the class
+    description.
+*/
+QKnxByteArray QKnxKeyringStore::reveal(const Secret &secret) const
+{
+    if (secret.encoded.isEmpty())
+        return {};
+
+    QMutexLocker locker(&m_mutex);
+    if (!secret.plain) {
+        QKnxByteArray pwHash(m_passwordHash.plain, m_passwordHash.size);
+        QKnxByteArray createdHash(m_createdHash.plain, m_createdHash.size);
+        auto value = (secret.kind == Secret::Kind::Key
+            ? QKnxCryptographicEngine::decodeAndDecryptToolKey(pwHash, createdHash, secret.encoded)
+            : QKnxCryptographicEngine::decodeAndDecryptPassword(pwHash, createdHash, secret.encoded));
+        QKnxPrivate::wipe(pwHash.data(), pwHash.size());
+        QKnxPrivate::wipe(createdHash.data(), createdHash.size());
+
+        auto data = m_memory.allocate(value.size());
+        if (!data)
+            return value; // empty on decryption failure, do not cache
+        memcpy(data, value.constData(), size_t(value.size()));
+        QKnxPrivate::wipe(value.data(), value.size());
+
+        secret.plain = data;
+        secret.size = value.size();
+    }
+    return { secret.plain, secret.size };
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,164 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXKEYRINGSTORE_P_H
+#define QKNXKEYRINGSTORE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qvector.h>
+
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxbytearray.h>
+#include <QtKnx/private/qknxkeyring_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QKnxPrivate
+{
+    void wipe(void *data, int size);
+
+    class QKnxLockedMemory final
+    {
+    public:
+        QKnxLockedMemory() = default;
+        ~QKnxLockedMemory();
+
+        quint8 *allocate(int size);
+        void clear();
+
+    private:
+        Q_DISABLE_COPY(QKnxLockedMemory)
+
+        struct Page
+        {
+            quint8 *data { nullptr };
+            int used { 0 };
+            bool locked { false };
+        };
+        QVector<Page> m_pages;
+    };
+}
+
+class Q_KNX_EXPORT QKnxKeyringStore final
+{
+public:
+    QKnxKeyringStore() = default;
+    ~QKnxKeyringStore() = default;
+
+    bool load(const QString &filePath, const QByteArray &password, bool validate);
+    bool load(const QKnx::Ets::Keyring::QKnxKeyring &keyring, const QKnxByteArray &passwordHash);
+    void clear();
+
+    bool isEmpty() const;
+    const QKnx::Ets::Keyring::QKnxKeyring &keyring() const;
+
+    QKnxByteArray backboneKey() const;
+
+    QVector<quint16> groupAddresses() const;
+    bool hasGroupKey(quint16 groupAddress) const;
+    QKnxByteArray groupKey(quint16 groupAddress) const;
+    QKnxByteArray groupKey(const QKnxAddress &groupAddress) const;
+
+    QVector<quint16> interfaceAddresses() const;
+    const QKnx::Ets::Keyring::QKnxInterface *findInterface(quint16 individualAddress) const;
+    QKnxByteArray interfaceUserPassword(quint16 individualAddress) const;
+    QKnxByteArray interfaceAuthenticationCode(quint16 individualAddress) const;
+
+    QVector<quint16> deviceAddresses() const;
+    const QKnx::Ets::Keyring::QKnxDevice *findDevice(quint16 individualAddress) const;
+    QKnxByteArray deviceToolKey(quint16 individualAddress) const;
+    QKnxByteArray deviceToolKey(const QKnxAddress &individualAddress) const;
+    QKnxByteArray deviceManagementPassword(quint16 individualAddress) const;
+    QKnxByteArray deviceAuthenticationCode(quint16 individualAddress) const;
+
+private:
+    Q_DISABLE_COPY(QKnxKeyringStore)
+
+    struct Secret
+    {
+        enum class Kind : quint8 { Key, Password };
+
+        Secret() = default;
+        Secret(const QByteArray &encoded, Kind kind)
+            : encoded(encoded)
+            , kind(kind)
+        {}
+
+        QByteArray encoded;
+        Kind kind { Kind::Key };
+        mutable const quint8 *plain { nullptr };
+        mutable int size { 0 };
+    };
+
+    struct InterfaceEntry
+    {
+        int index { -1 };
+        Secret userPassword;
+        Secret authenticationCode;
+    };
+
+    struct DeviceEntry
+    {
+        int index { -1 };
+        Secret toolKey;
+        Secret managementPassword;
+        Secret authenticationCode;
+    };
+
+    QKnxByteArray reveal(const Secret &secret) const;
+
+private:
+    QKnx::Ets::Keyring::QKnxKeyring m_keyring;
+
+    Secret m_backboneKey;
+    QHash<quint16, Secret> m_groupKeys;
+    QHash<quint16, InterfaceEntry> m_interfaces;
+    QHash<quint16, DeviceEntry> m_devices;
+
+    mutable QMutex m_mutex;
+    mutable QKnxPrivate::QKnxLockedMemory m_memory;
+    Secret m_passwordHash;
+    Secret m_createdHash;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,112 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXREPLAYWINDOW_P_H
+#define QKNXREPLAYWINDOW_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+// Sliding window over the last 64 sequence numbers received from one peer.
+// Numbers ahead of the window advance it, numbers inside the window are
+// accepted once, anything older is rejected. All operations are O(1).
+class QKnxReplayWindow final
+{
+public:
+    enum : int { Size = 64 };
+
+    bool isEmpty() const { return !m_initialized; }
+    quint48 highest() const { return m_highest; }
+
+    bool check(quint48 sequenceNumber) const
+    {
+        if (sequenceNumber > Q_UINT48_MAX)
+            return false;
+        if (!m_initialized || sequenceNumber > m_highest)
+            return true;
+        const quint64 offset = m_highest - sequenceNumber;
+        return offset < Size && (m_bitmap & (Q_UINT64_C(1) << offset)) == 0;
+    }
+
+    bool accept(quint48 sequenceNumber)
+    {
+        if (!check(sequenceNumber))
+            return false;
+
+        if (!m_initialized) {
+            m_initialized = true;
+            m_bitmap = 1;
+        } else if (sequenceNumber > m_highest) {
+            const quint64 shift = sequenceNumber - m_highest;
+            m_bitmap = (shift < Size ? (m_bitmap << shift) : 0) | 1;
+        } else {
+            m_bitmap |= Q_UINT64_C(1) << (m_highest - sequenceNumber);
+            return true;
+        }
+        m_highest = sequenceNumber;
+        return true;
+    }
+
+    // treats every sequence number up to and including highest as seen
+    void restore(quint48 highest)
+    {
+        m_initialized = true;
+        m_highest = highest & Q_UINT48_MAX;
+        m_bitmap = ~Q_UINT64_C(0);
+    }
+
+    void clear()
+    {
+        m_initialized = false;
+        m_highest = 0;
+        m_bitmap = 0;
+    }
+
+private:
+    quint64 m_bitmap { 0 };
+    quint48 m_highest { 0 };
+    bool m_initialized { false };
+};
+Q_DECLARE_TYPEINFO(QKnxReplayWindow, Q_MOVABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif
@@ -30,6 +30,10 @@
 #include "qknxsecurekey.h"
 #include "qknxcryptographicengine.h"
 
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvector.h>
+
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 
 #if QT_CONFIG(opensslv11)
@@ -62,6 +66,93 @@ public:
     QKnxSecureKey::Type m_type { QKnxSecureKey::Type::Invalid };
 };
 
+class QKnxSecureKeyPool
+{
+public:
+    static QKnxSecureKey generate()
+    {
+        QKnxSecureKey key;
+#if QT_CONFIG(opensslv11)
+        if (!QKnxCryptographicEngine::supportsCryptography())
+            return key;
+
+        if (auto *pctx = QKnxPrivate::q_EVP_PKEY_CTX_new_id(NID_X25519, nullptr)) {
+            QKnxPrivate::q_EVP_PKEY_keygen_init(pctx);
+            key.d_ptr->m_type = QKnxSecureKey::Type::Private;
+            QKnxPrivate::q_EVP_PKEY_keygen(pctx, &key.d_ptr->m_evpPKey);
+            QKnxPrivate::q_EVP_PKEY_CTX_free(pctx);
+        }
+#endif
+        return key;
+    }
+
+    QKnxSecureKey take()
+    {
+        QKnxSecureKey key;
+        {
+            const QMutexLocker locker(&m_mutex);
+            if (!m_keys.isEmpty())
+                key = m_keys.takeLast();
+        }
+        refill();
+
+        // the pool ran dry or is disabled, do not keep the caller waiting for a refill
+        return key.isNull() ? generate() : key;
+    }
+
+    int capacity()
+    {
+        const QMutexLocker locker(&m_mutex);
+        return m_capacity;
+    }
+
+    void setCapacity(int capacity)
+    {
+        {
+            const QMutexLocker locker(&m_mutex);
+            m_capacity = qMax(0, capacity);
+            if (m_keys.size() > m_capacity)
+                m_keys.resize(m_capacity);
+        }
+        refill();
+    }
+
+private:
+    void refill()
+    {
+        if (!QKnxCryptographicEngine::supportsCryptography())
+            return;
+
+        {
+            const QMutexLocker locker(&m_mutex);
+            if (m_refilling || m_keys.size() >= m_capacity)
+                return;
+            m_refilling = true;
+        }
+
+        QThreadPool::globalInstance()->start([this]() {
+            forever {
+                // generate outside the lock, takers must never wait for the pool
+                const auto key = generate();
+
+                const QMutexLocker locker(&m_mutex);
+                if (key.isValid() && m_keys.size() < m_capacity)
+                    m_keys.append(key);
+                if (!key.isValid() || m_keys.size() >= m_capacity) {
+                    m_refilling = false;
+                    return;
+                }
+            }
+        });
+    }
+
+    QMutex m_mutex;
+    QVector<QKnxSecureKey> m_keys;
+    int m_capacity { 4 };
+    bool m_refilling { false };
+};
+Q_GLOBAL_STATIC(QKnxSecureKeyPool, qt_knxSecureKeyPool)
+
 /*!
     \since 5.13
     \inmodule QtKnx
@@ -229,22 +320,17 @@ QKnxSecureKey QKnxSecureKey::fromBytes(QKnxSecureKey::Type type, const QKnxByteA
 
 /*!
     Returns a new valid private key if OpenSSL is available and no error occurs.
+
+    Since Qt 5.15, the key is taken from a pool of keys generated in advance on
+    the global thread pool, and the pool is refilled in the background. A key
+    is only handed out once. If the pool is empty, the key is generated on the
+    calling thread.
+
+    \sa setPrivateKeyPoolCapacity()
 */
 QKnxSecureKey QKnxSecureKey::generatePrivateKey()
 {
-    QKnxSecureKey key;
-#if QT_CONFIG(opensslv11)
-    if (!QKnxCryptographicEngine::supportsCryptography())
-        return key;
-
-    if (auto *pctx = QKnxPrivate::q_EVP_PKEY_CTX_new_id(NID_X25519, nullptr)) {
-        QKnxPrivate::q_EVP_PKEY_keygen_init(pctx);
-        key.d_ptr->m_type = Type::Private;
-        QKnxPrivate::q_EVP_PKEY_keygen(pctx, &key.d_ptr->m_evpPKey);
-        QKnxPrivate::q_EVP_PKEY_CTX_free(pctx);
-    }
-#endif
-    return key;
+    return qt_knxSecureKeyPool->take();
 }
 
 /*!
@@ -289,6 +375,38 @@ void QKnxSecureKey::generateKeys(QKnxSecureKey *privateKey, QKnxSecureKey *publi
     *publicKey = publicKeyFromPrivate(*privateKey);
 }
 
+/*!
+    \since 5.15
+
+    Returns the maximum number of private keys generated in advance. The
+    default capacity is \c 4.
+
+    \sa setPrivateKeyPoolCapacity(), generatePrivateKey()
+*/
+int QKnxSecureKey::privateKeyPoolCapacity()
+{
+    return qt_knxSecureKeyPool->capacity();
+}
+
+/*!
+    \since 5.15
+
+    Sets the maximum number of private keys generated in advance to
+    \a capacity and starts filling the pool on the global thread pool.
+
+    Generating an X25519 key pair is the only expensive step of a secure
+    session request. A pool large enough for the number of secure connections
+    opened at once, for example all tunnels reconnecting after a network
+    outage, keeps the key generation off the thread running the connections.
+    A capacity of \c 0 disables the pool.
+
+    \sa privateKeyPoolCapacity(), generatePrivateKey()
+*/
+void QKnxSecureKey::setPrivateKeyPoolCapacity(int capacity)
+{
+    qt_knxSecureKeyPool->setCapacity(capacity);
+}
+
 /*!
     Derives and returns the shared secret from the given private key
     \a privateKey and the peer's public key \a peerPublicKey if OpenSSL
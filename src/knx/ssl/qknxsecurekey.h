@@ -66,6 +66,9 @@ public:
 
     static void generateKeys(QKnxSecureKey *privateKey, QKnxSecureKey *publicKey);
 
+    static int privateKeyPoolCapacity();
+    static void setPrivateKeyPoolCapacity(int capacity);
+
     static QKnxByteArray sharedSecret(const QKnxSecureKey &privateKey,
                                       const QKnxSecureKey &peerPublicKey);
     static QKnxByteArray sharedSecret(const QKnxByteArray &privateKey,
@@ -78,6 +81,7 @@ public:
     bool operator!=(const QKnxSecureKey &other) const;
 
 private:
+    friend class QKnxSecureKeyPool;
     QSharedDataPointer<QKnxSecureKeyData> d_ptr;
 };
 
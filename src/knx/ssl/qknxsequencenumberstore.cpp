@@ -0,0 +1,361 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxsequencenumberstore_p.h"
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QKnxSequenceNumberStore
+
+    The QKnxSequenceNumberStore class persists sequence number state of KNX
+    secure communication across restarts.
+
+    Outgoing sequence numbers must never be reused. Instead of writing every
+    number to disk, the store persists a reservation limit that lies
+    reservation() numbers ahead of the current one and writes again only once
+    that limit is reached. After a restart, sending resumes at the persisted
+    limit, see restoredSequenceNumber(). The numbers skipped that way are
+    never used.
+
+    High-water marks, for example the highest sequence number accepted from a
+    peer or the last multicast timer value, are stored along with the
+    wall-clock time of their last update. They are written behind: an update
+    that follows a quiet period of maxPendingMsecs() is written at once, while
+    updates arriving in a burst are collected until maxPendingUpdates() of
+    them are pending or maxPendingMsecs() have passed since the last write.
+    A crash therefore loses at most that many recent updates, never the
+    state of an idle peer. The next reservation and sync() write pending
+    updates as well.
+
+    The file is replaced atomically with QSaveFile and carries a checksum, so
+    a crash leaves either the previous or the new state behind, never a torn
+    write. If the file path is empty, the store keeps its state in memory
+    only.
+*/
+
+namespace QKnxPrivate
+{
+    enum : quint32 { SequenceStoreMagic = 0x514b5351 }; // QKSQ
+    enum : quint16 { SequenceStoreVersion = 1 };
+}
+
+/*!
+    \internal
+
+    Creates a sequence number store backed by the file \a filePath. Call
+    load() to read previously persisted state.
+*/
+QKnxSequenceNumberStore::QKnxSequenceNumberStore(const QString &filePath)
+    : m_filePath(filePath)
+{}
+
+/*!
+    \internal
+
+    Writes pending high-water marks and destroys the store.
+*/
+QKnxSequenceNumberStore::~QKnxSequenceNumberStore()
+{
+    sync();
+}
+
+/*!
+    \internal
+
+    Returns the path of the backing file.
+*/
+QString QKnxSequenceNumberStore::filePath() const
+{
+    return m_filePath;
+}
+
+/*!
+    \internal
+
+    Returns the number of sequence numbers reserved with a single write. The
+    default value is \c 1024.
+*/
+quint48 QKnxSequenceNumberStore::reservation() const
+{
+    return m_reservation;
+}
+
+/*!
+    \internal
+
+    Sets the number of sequence numbers reserved with a single write to
+    \a reservation. Values smaller than \c 1 are ignored.
+*/
+void QKnxSequenceNumberStore::setReservation(quint48 reservation)
+{
+    if (reservation > 0)
+        m_reservation = qMin(reservation, Q_UINT48_MAX);
+}
+
+/*!
+    \internal
+
+    Returns the number of high-water mark updates that may be pending before
+    they are written. The default value is \c 16.
+*/
+int QKnxSequenceNumberStore::maxPendingUpdates() const
+{
+    return m_maxPendingUpdates;
+}
+
+/*!
+    \internal
+
+    Sets the number of high-water mark updates that may be pending before
+    they are written to \a updates. Values smaller than \c 1 are ignored, a
+    value of \c 1 writes every update.
+*/
+void QKnxSequenceNumberStore::setMaxPendingUpdates(int updates)
+{
+    if (updates > 0)
+        m_maxPendingUpdates = updates;
+}
+
+/*!
+    \internal
+
+    Returns the time in milliseconds a high-water mark update may stay
+    pending. The default value is \c 1000.
+*/
+int QKnxSequenceNumberStore::maxPendingMsecs() const
+{
+    return m_maxPendingMsecs;
+}
+
+/*!
+    \internal
+
+    Sets the time in milliseconds a high-water mark update may stay pending
+    to \a msecs. Negative values are ignored.
+*/
+void QKnxSequenceNumberStore::setMaxPendingMsecs(int msecs)
+{
+    if (msecs >= 0)
+        m_maxPendingMsecs = msecs;
+}
+
+/*!
+    \internal
+
+    Reads the persisted state from the backing file, replacing the state in
+    memory. Returns \c true on success; otherwise returns \c false and leaves
+    the state in memory untouched.
+*/
+bool QKnxSequenceNumberStore::load()
+{
+    if (m_filePath.isEmpty())
+        return false;
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const auto content = file.readAll();
+    if (content.size() < 2)
+        return false;
+
+    const auto payload = content.left(content.size() - 2);
+    const quint16 checksum = quint16((quint8(content.at(content.size() - 2)) << 8)
+        | quint8(content.at(content.size() - 1)));
+    if (qChecksum(payload.constData(), uint(payload.size())) != checksum)
+        return false;
+
+    QDataStream in(payload);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0, count = 0;
+    quint16 version = 0;
+    in >> magic >> version >> count;
+    if (magic != QKnxPrivate::SequenceStoreMagic || version != QKnxPrivate::SequenceStoreVersion)
+        return false;
+
+    QHash<QByteArray, Entry> entries;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QByteArray id;
+        Entry entry;
+        in >> id >> entry.reserved >> entry.highWaterMark >> entry.timestamp;
+        entries.insert(id, entry);
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    m_entries = entries;
+    m_dirty = false;
+    return true;
+}
+
+/*!
+    \internal
+
+    Writes the state to the backing file if anything changed since the last
+    write. Returns \c true on success; otherwise returns \c false.
+*/
+bool QKnxSequenceNumberStore::sync()
+{
+    return !m_dirty || write();
+}
+
+/*!
+    \internal
+
+    Returns \c true if there are high-water marks that have not been written
+    yet; otherwise returns \c false.
+*/
+bool QKnxSequenceNumberStore::isDirty() const
+{
+    return m_dirty;
+}
+
+/*!
+    \internal
+
+    Returns the first sequence number that is guaranteed to be unused for the
+    counter \a id, taking all reservations made before a restart into account.
+    Returns \c 0 for an unknown counter.
+*/
+quint48 QKnxSequenceNumberStore::restoredSequenceNumber(const QByteArray &id) const
+{
+    return m_entries.value(id).reserved;
+}
+
+/*!
+    \internal
+
+    Makes sure the sequence number \a sequenceNumber of the counter \a id is
+    covered by a persisted reservation, writing a new reservation limit if
+    needed. Returns \c false if the reservation could not be written, in that
+    case the sequence number must not be used.
+*/
+bool QKnxSequenceNumberStore::reserve(const QByteArray &id, quint48 sequenceNumber)
+{
+    if (sequenceNumber >= Q_UINT48_MAX)
+        return false;
+
+    auto &entry = m_entries[id];
+    if (sequenceNumber < entry.reserved)
+        return true;
+
+    const auto previous = entry;
+    entry.reserved = qMin(sequenceNumber + m_reservation, Q_UINT48_MAX);
+    entry.timestamp = QDateTime::currentMSecsSinceEpoch();
+    m_dirty = true;
+    if (write())
+        return true;
+
+    m_entries[id] = previous; // the limit must only grow once it is on disk
+    return false;
+}
+
+/*!
+    \internal
+
+    Returns the high-water mark stored for \a id, or \c 0 if there is none.
+    If \a msecsSinceEpoch is not \c nullptr, it is set to the wall-clock time
+    of the last update.
+*/
+quint48 QKnxSequenceNumberStore::highWaterMark(const QByteArray &id, qint64 *msecsSinceEpoch) const
+{
+    const auto entry = m_entries.value(id);
+    if (msecsSinceEpoch)
+        *msecsSinceEpoch = entry.timestamp;
+    return entry.highWaterMark;
+}
+
+/*!
+    \internal
+
+    Sets the high-water mark of \a id to \a value. The value is written at
+    once if the last write is older than maxPendingMsecs() or if
+    maxPendingUpdates() updates are pending; otherwise it is written with a
+    later update, the next reservation, or the next call to sync().
+*/
+void QKnxSequenceNumberStore::setHighWaterMark(const QByteArray &id, quint48 value)
+{
+    auto &entry = m_entries[id];
+    entry.highWaterMark = value & Q_UINT48_MAX;
+    entry.timestamp = QDateTime::currentMSecsSinceEpoch();
+    m_dirty = true;
+
+    // a failed write keeps the updates pending and is retried with the next one
+    if (++m_pendingUpdates >= m_maxPendingUpdates || !m_lastWrite.isValid()
+        || m_lastWrite.hasExpired(m_maxPendingMsecs)) {
+        write();
+    }
+}
+
+bool QKnxSequenceNumberStore::write()
+{
+    if (m_filePath.isEmpty()) {
+        m_dirty = false;
+        m_pendingUpdates = 0;
+        return true;
+    }
+
+    QByteArray payload;
+    {
+        QDataStream out(&payload, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_5_12);
+        out << quint32(QKnxPrivate::SequenceStoreMagic)
+            << quint16(QKnxPrivate::SequenceStoreVersion)
+            << quint32(m_entries.size());
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+            out << it.key() << it.value().reserved << it.value().highWaterMark
+                << it.value().timestamp;
+        }
+    }
+    const auto checksum = qChecksum(payload.constData(), uint(payload.size()));
+    payload.append(char(checksum >> 8));
+    payload.append(char(checksum & 0xff));
+
+    // QSaveFile writes to a temporary file, syncs it and renames it over the old one
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(payload) != payload.size()
+        || !file.commit()) {
+        return false;
+    }
+
+    m_dirty = false;
+    m_pendingUpdates = 0;
+    m_lastWrite.start();
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,105 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXSEQUENCENUMBERSTORE_P_H
+#define QKNXSEQUENCENUMBERSTORE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt KNX API.  It exists for the convenience
+// of the Qt KNX implementation.  This header file may change from version
+// to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qstring.h>
+
+#include <QtKnx/qtknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxSequenceNumberStore final
+{
+public:
+    explicit QKnxSequenceNumberStore(const QString &filePath = {});
+    ~QKnxSequenceNumberStore();
+
+    QString filePath() const;
+
+    quint48 reservation() const;
+    void setReservation(quint48 reservation);
+
+    int maxPendingUpdates() const;
+    void setMaxPendingUpdates(int updates);
+    int maxPendingMsecs() const;
+    void setMaxPendingMsecs(int msecs);
+
+    bool load();
+    bool sync();
+    bool isDirty() const;
+
+    quint48 restoredSequenceNumber(const QByteArray &id) const;
+    bool reserve(const QByteArray &id, quint48 sequenceNumber);
+
+    quint48 highWaterMark(const QByteArray &id, qint64 *msecsSinceEpoch = nullptr) const;
+    void setHighWaterMark(const QByteArray &id, quint48 value);
+
+private:
+    Q_DISABLE_COPY(QKnxSequenceNumberStore)
+
+    struct Entry
+    {
+        quint48 reserved { 0 };
+        quint48 highWaterMark { 0 };
+        qint64 timestamp { 0 };
+    };
+
+    bool write();
+
+private:
+    QString m_filePath;
+    quint48 m_reservation { 1024 };
+    QHash<QByteArray, Entry> m_entries;
+    bool m_dirty { false };
+
+    int m_maxPendingUpdates { 16 };
+    int m_maxPendingMsecs { 1000 };
+    int m_pendingUpdates { 0 };
+    QElapsedTimer m_lastWrite;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -27,6 +27,7 @@
 **
 ******************************************************************************/
 
+#include "qknxaes_p.h"
 #include "qknxssl_p.h"
 
 #include <private/qtnetworkglobal_p.h>
@@ -36,7 +37,10 @@
 # include "private/qsslsocket_openssl11_symbols_p.h"
 #endif
 
+#include <QtCore/qatomic.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qvarlengtharray.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -176,4 +180,263 @@ QKnxByteArray QKnxSsl::doCrypt(const QKnxByteArray &key, const QKnxByteArray &iv
 #endif
 }
 
+class QKnxSslBlockCipherPrivate
+{
+public:
+    ~QKnxSslBlockCipherPrivate()
+    {
+#if QT_CONFIG(opensslv11)
+        if (ecb)
+            QKnxPrivate::q_EVP_CIPHER_CTX_free(ecb);
+        if (cbc)
+            QKnxPrivate::q_EVP_CIPHER_CTX_free(cbc);
+#endif
+    }
+
+    QKnxSslBlockCipher::Backend backend { QKnxSslBlockCipher::Backend::Automatic };
+    QScopedPointer<QKnxAes128> aes;
+#if QT_CONFIG(opensslv11)
+    EVP_CIPHER_CTX *ecb { nullptr };
+    EVP_CIPHER_CTX *cbc { nullptr };
+#endif
+};
+
+static QBasicAtomicInt qt_knxDefaultCipherBackend = Q_BASIC_ATOMIC_INITIALIZER(-1);
+
+/*!
+    \internal
+    \class QKnxSslBlockCipher
+
+    Holds the expanded AES-128 key schedule for \a key, so that repeated
+    encryptions with the same key do not have to set up a new cipher context
+    and run the key expansion for every call. The object is not thread-safe.
+
+    The cipher is either provided by OpenSSL or by the native QKnxAes128
+    implementation, which does not need any external library and uses the
+    AES instructions of the CPU if available. With \l Backend::Automatic the
+    backend returned by defaultBackend() is used.
+*/
+
+/*!
+    \internal
+    \enum QKnxSslBlockCipher::Backend
+
+    \value Automatic
+            Uses the native backend if the CPU provides AES instructions or
+            OpenSSL is not available; otherwise OpenSSL.
+    \value OpenSsl
+            Uses the dynamically loaded OpenSSL library.
+    \value Native
+            Uses the built-in implementation.
+*/
+
+/*!
+    \internal
+
+    Creates a cipher for the AES-128 \a key using the given \a backend.
+*/
+QKnxSslBlockCipher::QKnxSslBlockCipher(const QKnxByteArray &key, Backend backend)
+{
+    if (key.size() != 16)
+        return;
+
+    if (backend == Backend::Automatic)
+        backend = defaultBackend();
+    if (backend == Backend::Automatic) {
+        backend = (QKnxAes128::bestImplementation() != QKnxAes128::Implementation::Portable
+            || !qt_QKnxOpenSsl->supportsSsl()) ? Backend::Native : Backend::OpenSsl;
+    }
+
+    QScopedPointer<QKnxSslBlockCipherPrivate> dd(new QKnxSslBlockCipherPrivate);
+    dd->backend = backend;
+
+    if (backend == Backend::Native) {
+        dd->aes.reset(new QKnxAes128(key.constData()));
+        d = dd.take();
+        return;
+    }
+
+#if QT_CONFIG(opensslv11)
+    if (!qt_QKnxOpenSsl->supportsSsl())
+        return;
+
+    dd->ecb = QKnxPrivate::q_EVP_CIPHER_CTX_new();
+    dd->cbc = QKnxPrivate::q_EVP_CIPHER_CTX_new();
+    if (!dd->ecb || !dd->cbc)
+        return;
+
+    static const quint8 iv[16] { 0x00 };
+    if (QKnxPrivate::q_EVP_CipherInit_ex(dd->ecb, QKnxPrivate::q_EVP_aes_128_ecb(), nullptr,
+        key.constData(), nullptr, QKnxSsl::Encrypt) <= 0) {
+        return;
+    }
+    if (QKnxPrivate::q_EVP_CipherInit_ex(dd->cbc, QKnxPrivate::q_EVP_aes_128_cbc(), nullptr,
+        key.constData(), iv, QKnxSsl::Encrypt) <= 0) {
+        return;
+    }
+
+    if (QKnxPrivate::q_EVP_CIPHER_CTX_set_padding(dd->ecb, 0) <= 0
+        || QKnxPrivate::q_EVP_CIPHER_CTX_set_padding(dd->cbc, 0) <= 0) {
+        return;
+    }
+    d = dd.take();
+#endif
+}
+
+/*!
+    \internal
+*/
+QKnxSslBlockCipher::~QKnxSslBlockCipher()
+{
+    delete d;
+}
+
+/*!
+    \internal
+*/
+bool QKnxSslBlockCipher::isValid() const
+{
+    return d != nullptr;
+}
+
+/*!
+    \internal
+
+    Returns the backend used by a valid cipher; \l Backend::Automatic
+    otherwise.
+*/
+QKnxSslBlockCipher::Backend QKnxSslBlockCipher::backend() const
+{
+    return d ? d->backend : Backend::Automatic;
+}
+
+/*!
+    \internal
+
+    Returns the backend used by ciphers created with \l Backend::Automatic.
+    Unless changed with setDefaultBackend(), the value is read from the
+    \c QT_KNX_CRYPTO_BACKEND environment variable, which may be set to
+    \c native or \c openssl.
+*/
+QKnxSslBlockCipher::Backend QKnxSslBlockCipher::defaultBackend()
+{
+    int value = qt_knxDefaultCipherBackend.loadAcquire();
+    if (value < 0) {
+        const auto env = qgetenv("QT_KNX_CRYPTO_BACKEND").toLower();
+        value = int(env == "native" ? Backend::Native
+            : (env == "openssl" ? Backend::OpenSsl : Backend::Automatic));
+        if (!qt_knxDefaultCipherBackend.testAndSetOrdered(-1, value))
+            value = qt_knxDefaultCipherBackend.loadAcquire();
+    }
+    return Backend(value);
+}
+
+/*!
+    \internal
+
+    Sets the backend used by ciphers created with \l Backend::Automatic to
+    \a backend. Existing ciphers are not affected.
+*/
+void QKnxSslBlockCipher::setDefaultBackend(Backend backend)
+{
+    qt_knxDefaultCipherBackend.storeRelease(int(backend));
+}
+
+/*!
+    \internal
+
+    Encrypts \a size bytes from \a in block by block into \a out. The
+    \a size must be a multiple of the AES block size; \a in and \a out may
+    point to the same buffer.
+*/
+bool QKnxSslBlockCipher::encrypt(const quint8 *in, quint8 *out, int size) const
+{
+    if (!d || size <= 0 || (size % 16) != 0)
+        return false;
+
+    if (d->aes) {
+        d->aes->encrypt(in, out, size / 16);
+        return true;
+    }
+
+#if QT_CONFIG(opensslv11)
+    int outl = 0;
+    return QKnxPrivate::q_EVP_CipherUpdate(d->ecb, out, &outl, in, size) > 0 && outl == size;
+#else
+    return false;
+#endif
+}
+
+/*!
+    \internal
+
+    Computes the CBC-MAC with a zero initial vector over \a size bytes from
+    \a in and writes the last cipher block into \a mac. The \a size must be a
+    multiple of the AES block size and \a mac must point to 16 bytes.
+*/
+bool QKnxSslBlockCipher::cbcMac(const quint8 *in, int size, quint8 *mac) const
+{
+    if (!d || size <= 0 || (size % 16) != 0)
+        return false;
+
+    if (d->aes) {
+        d->aes->cbcMac(in, size / 16, mac);
+        return true;
+    }
+
+#if QT_CONFIG(opensslv11)
+    // resetting only the initial vector keeps the expanded key
+    static const quint8 iv[16] { 0x00 };
+    if (QKnxPrivate::q_EVP_CipherInit_ex(d->cbc, nullptr, nullptr, nullptr, iv, -1) <= 0)
+        return false;
+
+    int outl = 0;
+    QVarLengthArray<quint8, 256> out(size);
+    if (QKnxPrivate::q_EVP_CipherUpdate(d->cbc, out.data(), &outl, in, size) <= 0 || outl != size)
+        return false;
+
+    memcpy(mac, out.constData() + size - 16, 16);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*!
+    \internal
+
+    Computes the CBC-MAC with a zero initial vector for \a count messages
+    stored back to back in \a in, the message at index \c i being
+    \c{sizes[i]} bytes long, and writes the last cipher block of each into
+    \a macs. Every size must be a multiple of the AES block size and \a macs
+    must point to \c{16 * count} bytes.
+
+    The native backend interleaves the computation of several messages;
+    with OpenSSL the messages are processed one after the other.
+*/
+bool QKnxSslBlockCipher::cbcMac(const quint8 *in, const int *sizes, int count, quint8 *macs) const
+{
+    if (!d || count <= 0)
+        return false;
+
+    QVarLengthArray<int, 32> blocks(count);
+    for (int i = 0; i < count; ++i) {
+        if (sizes[i] <= 0 || (sizes[i] % 16) != 0)
+            return false;
+        blocks[i] = sizes[i] / 16;
+    }
+
+    if (d->aes) {
+        d->aes->cbcMac(in, blocks.constData(), count, macs);
+        return true;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (!cbcMac(in, sizes[i], macs + 16 * i))
+            return false;
+        in += sizes[i];
+    }
+    return true;
+}
+
 QT_END_NAMESPACE
@@ -61,6 +61,35 @@ public:
         const QKnxByteArray &data, Mode mode);
 };
 
+class QKnxSslBlockCipherPrivate;
+class Q_KNX_EXPORT QKnxSslBlockCipher final
+{
+public:
+    enum class Backend : quint8
+    {
+        Automatic,
+        OpenSsl,
+        Native
+    };
+
+    explicit QKnxSslBlockCipher(const QKnxByteArray &key, Backend backend = Backend::Automatic);
+    ~QKnxSslBlockCipher();
+
+    bool isValid() const;
+    Backend backend() const;
+
+    static Backend defaultBackend();
+    static void setDefaultBackend(Backend backend);
+
+    bool encrypt(const quint8 *in, quint8 *out, int size) const;
+    bool cbcMac(const quint8 *in, int size, quint8 *mac) const;
+    bool cbcMac(const quint8 *in, const int *sizes, int count, quint8 *macs) const;
+
+private:
+    Q_DISABLE_COPY(QKnxSslBlockCipher)
+    QKnxSslBlockCipherPrivate *d { nullptr };
+};
+
 QT_END_NAMESPACE
 
 #endif
@@ -151,5 +151,6 @@ int q_EVP_PKEY_get_raw_private_key(const EVP_PKEY *pkey, unsigned char *priv, si
 EVP_PKEY *q_EVP_PKEY_new_raw_private_key(int type, ENGINE *e, const unsigned char *priv, size_t len);
 
 const EVP_CIPHER *q_EVP_aes_128_cbc(void);
+const EVP_CIPHER *q_EVP_aes_128_ecb(void);
 
 #endif
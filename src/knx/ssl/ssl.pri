@@ -1,12 +1,23 @@
-HEADERS += ssl/qknxcryptographicengine.h \
+HEADERS += ssl/qknxaes_p.h \
+           ssl/qknxccmcontext_p.h \
+           ssl/qknxdatasecurelayer_p.h \
+           ssl/qknxcryptographicengine.h \
            ssl/qknxsecurekey.h \
            ssl/qknxssl_p.h \
-           ssl/qknxkeyring_p.h
+           ssl/qknxkeyring_p.h \
+           ssl/qknxkeyringstore_p.h \
+           ssl/qknxreplaywindow_p.h \
+           ssl/qknxsequencenumberstore_p.h
 
-SOURCES += ssl/qknxcryptographicengine.cpp \
+SOURCES += ssl/qknxaes.cpp \
+           ssl/qknxccmcontext.cpp \
+           ssl/qknxdatasecurelayer.cpp \
+           ssl/qknxcryptographicengine.cpp \
            ssl/qknxsecurekey.cpp \
            ssl/qknxssl_openssl.cpp \
-           ssl/qknxkeyring.cpp
+           ssl/qknxkeyring.cpp \
+           ssl/qknxkeyringstore.cpp \
+           ssl/qknxsequencenumberstore.cpp
 
 qtConfig(opensslv11) { # OpenSSL 1.1 support is required.
     SOURCES += ssl/qsslsocket_openssl_symbols.cpp
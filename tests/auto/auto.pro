@@ -47,4 +47,8 @@ SUBDIRS += cmake \
     qknxnetipsessionrequest \
     qknxnetipsessionresponse \
     qknxnetiprouter \
-    qknxcryptographicengine
+    qknxnetipsimulatednetwork \
+    qknxcryptographicengine \
+    qknxkeyring \
+    qknxdatasecurelayer \
+    qknxnetipsecuretransport
@@ -1,6 +1,6 @@
 TARGET = tst_qknxcryptographicengine
 
-QT = core testlib knx network
+QT = core testlib knx network knx-private
 CONFIG += testcase c++11
 
 CONFIG -= app_bundle
@@ -36,6 +36,9 @@
 #include <QtKnx/qknxnetipsessionresponse.h>
 #include <QtKnx/qknxnetipsessionstatus.h>
 #include <QtKnx/qknxnetiptimernotify.h>
+#include <QtKnx/private/qknxaes_p.h>
+#include <QtKnx/private/qknxccmcontext_p.h>
+#include <QtKnx/private/qknxssl_p.h>
 #include <QtTest/qtest.h>
 
 QT_BEGIN_NAMESPACE
@@ -58,6 +61,11 @@ private slots:
         QLoggingCategory::setFilterRules("qt.network.ssl=false");
     }
 
+    void cleanup()
+    {
+        QKnxSslBlockCipher::setDefaultBackend(QKnxSslBlockCipher::Backend::Automatic);
+    }
+
     void testPublicKey()
     {
         QKnxSecureKey key;
@@ -131,6 +139,31 @@ private slots:
         QCOMPARE(key.type(), QKnxSecureKey::Type::Private);
     }
 
+    void testPrivateKeyPool()
+    {
+        QCOMPARE(QKnxSecureKey::privateKeyPoolCapacity(), 4);
+
+        QKnxSecureKey::setPrivateKeyPoolCapacity(-1);
+        QCOMPARE(QKnxSecureKey::privateKeyPoolCapacity(), 0);
+
+        if (QKnxCryptographicEngine::sslLibraryVersionNumber() >= 0x1010000fL) {
+            // keys are still generated with the pool disabled
+            QCOMPARE(QKnxSecureKey::generatePrivateKey().isValid(), true);
+
+            QKnxSecureKey::setPrivateKeyPoolCapacity(2);
+            QVector<QKnxSecureKey> keys;
+            for (int i = 0; i < 8; ++i) {
+                const auto key = QKnxSecureKey::generatePrivateKey();
+                QCOMPARE(key.isValid(), true);
+                QCOMPARE(key.type(), QKnxSecureKey::Type::Private);
+                if (QKnxCryptographicEngine::sslLibraryVersionNumber() >= 0x1010101fL)
+                    QCOMPARE(keys.contains(key), false); // never hand out a key twice
+                keys.append(key);
+            }
+        }
+        QKnxSecureKey::setPrivateKeyPoolCapacity(4);
+    }
+
     void testSharedSecret()
     {
         if (QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL)
@@ -178,6 +211,26 @@ private slots:
         QCOMPARE(result, QKnxByteArray::fromHex("e158e4012047bd6cc41aafbc5c04c1fc"));
     }
 
+    void testPasswordHashCache()
+    {
+        QCOMPARE(QKnxCryptographicEngine::passwordHashCacheCapacity(), 64);
+
+        // the same password used with a different salt must not hit the cache
+        const auto user = QKnxCryptographicEngine::userPasswordHash({ "secret" });
+        QCOMPARE(QKnxCryptographicEngine::deviceAuthenticationCodeHash({ "secret" })
+            == user, false);
+        QCOMPARE(QKnxCryptographicEngine::userPasswordHash({ "secret" }), user);
+
+        QKnxCryptographicEngine::setPasswordHashCacheCapacity(0);
+        QCOMPARE(QKnxCryptographicEngine::passwordHashCacheCapacity(), 0);
+        QCOMPARE(QKnxCryptographicEngine::userPasswordHash({ "secret" }), user);
+
+        QKnxCryptographicEngine::setPasswordHashCacheCapacity(64);
+        QKnxCryptographicEngine::clearPasswordHashCache();
+        QCOMPARE(QKnxCryptographicEngine::userPasswordHash({ "secret" }),
+            QKnxByteArray::fromHex("03fcedb66660251ec81a1a716901696a"));
+    }
+
     void testMessageAuthenticationCode()
     {
         if (QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL)
@@ -445,6 +498,176 @@ private slots:
         QCOMPARE(proxy2.messageAuthenticationCode(), mac);
     }
 
+    void testNativeAes()
+    {
+        const auto key = QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f");
+        QKnxByteArray data(7 * 16, Qt::Uninitialized);
+        for (int i = 0; i < data.size(); ++i)
+            data.set(i, quint8(i * 7));
+
+        const auto implementations = { QKnxAes128::Implementation::Portable,
+            QKnxAes128::Implementation::AesNi, QKnxAes128::Implementation::ArmCryptoExtensions };
+        for (auto implementation : implementations) {
+            if (!QKnxAes128::isSupported(implementation))
+                continue;
+
+            const QKnxAes128 aes(key.constData(), implementation);
+            QCOMPARE(aes.implementation(), implementation);
+
+            // FIPS-197, Appendix C.1
+            auto block = QKnxByteArray::fromHex("00112233445566778899aabbccddeeff");
+            aes.encrypt(block.constData(), block.data(), 1);
+            QCOMPARE(block, QKnxByteArray::fromHex("69c4e0d86a7b0430d8cdb78070b4c55a"));
+
+            QKnxByteArray out(data.size(), Qt::Uninitialized);
+            aes.encrypt(data.constData(), out.data(), 7);
+            QCOMPARE(out.mid(96), QKnxByteArray::fromHex("82af73e52df75e510b1a02640ae31362"));
+
+            QKnxByteArray mac(16, Qt::Uninitialized);
+            aes.cbcMac(data.constData(), 7, mac.data());
+            QCOMPARE(mac, QKnxByteArray::fromHex("727aa8fd19c45038c2ef5af378627715"));
+
+            // the batch CBC-MAC must match single calls for messages of any length
+            const int blocks[] = { 7, 1, 3, 2, 7, 4, 5 };
+            QKnxByteArray macs(7 * 16, Qt::Uninitialized);
+            QKnxByteArray messages;
+            for (int i = 0; i < 7; ++i)
+                messages += data.mid(16 * (i % 3), 16 * blocks[i]);
+            aes.cbcMac(messages.constData(), blocks, 7, macs.data());
+
+            int offset = 0;
+            for (int i = 0; i < 7; ++i) {
+                aes.cbcMac(messages.constData() + offset, blocks[i], mac.data());
+                QCOMPARE(macs.mid(16 * i, 16), mac);
+                offset += 16 * blocks[i];
+            }
+        }
+    }
+
+    void testCcmContext_data()
+    {
+        QTest::addColumn<int>("backend");
+        QTest::newRow("Native") << int(QKnxSslBlockCipher::Backend::Native);
+        QTest::newRow("OpenSsl") << int(QKnxSslBlockCipher::Backend::OpenSsl);
+    }
+
+    void testCcmContext()
+    {
+        QFETCH(int, backend);
+        if (QKnxSslBlockCipher::Backend(backend) == QKnxSslBlockCipher::Backend::OpenSsl
+            && QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL) {
+            QSKIP("OpenSSL 1.1 is not available.");
+        }
+        QKnxSslBlockCipher::setDefaultBackend(QKnxSslBlockCipher::Backend(backend));
+
+        QKnxCcmContext invalid(QKnxByteArray::fromHex("0001020304"));
+        QCOMPARE(invalid.isValid(), false);
+        QCOMPARE(invalid.createTimerNotify(0, QKnxByteArray(6, 0x00), 0).isValid(), false);
+
+        const auto backboneKey = QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f");
+        const QKnxCcmContext context(backboneKey);
+        QCOMPARE(context.isValid(), true);
+        QCOMPARE(context.key(), backboneKey);
+
+        quint48 timerValue = 211938428830917;
+        auto serialNumber = QKnxByteArray::fromHex("00fa12345678");
+        quint16 messageTag = 0xaffe;
+
+        auto frame = QKnxNetIpRoutingIndicationProxy::builder()
+            .setCemi(QKnxLinkLayerFrame::builder()
+                .setMedium(QKnx::MediumType::NetIP)
+                .setData(QKnxByteArray::fromHex("2900bcd011590ade010081"))
+                .createFrame())
+            .create();
+
+        auto mac = context.computeMessageAuthenticationCode(
+            QKnxNetIpFrameHeader::fromBytes(QKnxByteArray::fromHex("061009500037")), 0x0000,
+            frame.bytes(), timerValue, serialNumber, messageTag);
+        QCOMPARE(mac, QKnxByteArray::fromHex("bd0a294b952554b23539204c2271d26b"));
+        QCOMPARE(context.processMessageAuthenticationCode(mac, timerValue, serialNumber,
+            messageTag), QKnxByteArray::fromHex("7212a03aaae49da85689774c1d2b4da4"));
+
+        // block aligned input must not get an additional block of padding
+        const auto alignedHeader = QKnxNetIpFrameHeader::fromBytes(QKnxByteArray::fromHex(
+            "06100950002c"));
+        const auto alignedData = QKnxByteArray::fromHex("000102030405");
+        mac = context.computeMessageAuthenticationCode(alignedHeader, 0x0000, alignedData, 0,
+            serialNumber, messageTag);
+        QCOMPARE(mac, QKnxByteArray::fromHex("627105997fa9c88f3c24fecef7872718"));
+        QCOMPARE(QKnxCryptographicEngine::computeMessageAuthenticationCode(backboneKey,
+            alignedHeader, 0x0000, alignedData, 0, serialNumber, messageTag), mac);
+
+        auto secureWrapper = context.wrap(frame, 0x0000, timerValue, serialNumber, messageTag);
+        QCOMPARE(secureWrapper.bytes(), QKnxByteArray::fromHex("0610095000370000c0c1c2c3c4c5"
+            "00fa12345678affeb7ee7e8a1c2f7bbabec775fd6e10d0bc4b7212a03aaae49da85689774c1d2b4da4"));
+        QCOMPARE(context.unwrap(secureWrapper).bytes(), frame.bytes());
+
+        auto tampered = secureWrapper.bytes();
+        tampered.set(30, tampered.at(30) ^ 0x01);
+        QCOMPARE(context.unwrap(QKnxNetIpFrame::fromBytes(tampered)).isValid(), false);
+        QCOMPARE(QKnxCcmContext(QKnxByteArray(16, 0xff)).unwrap(secureWrapper).isValid(), false);
+
+        auto timerNotify = context.createTimerNotify(timerValue, serialNumber, messageTag);
+        QCOMPARE(timerNotify.bytes(), QKnxByteArray::fromHex("061009550024c0c1c2c3c4c5"
+            "00fa12345678affeee7b9b3083deb1570eb38d073adad985"));
+        QCOMPARE(context.verifyTimerNotify(timerNotify), true);
+        QCOMPARE(context.verifyTimerNotify(QKnxNetIpTimerNotifyProxy::builder()
+            .setTimerValue(timerValue + 1)
+            .setSerialNumber(serialNumber)
+            .setMessageTag(messageTag)
+            .setMessageAuthenticationCode(QKnxByteArray::fromHex("ee7b9b3083deb1570eb38d073adad985"))
+            .create()), false);
+    }
+
+    void testCcmContextBatch_data()
+    {
+        testCcmContext_data();
+    }
+
+    void testCcmContextBatch()
+    {
+        QFETCH(int, backend);
+        if (QKnxSslBlockCipher::Backend(backend) == QKnxSslBlockCipher::Backend::OpenSsl
+            && QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL) {
+            QSKIP("OpenSSL 1.1 is not available.");
+        }
+        QKnxSslBlockCipher::setDefaultBackend(QKnxSslBlockCipher::Backend(backend));
+
+        const QKnxCcmContext context(QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f"));
+        QCOMPARE(context.unwrap(QVector<QKnxNetIpFrame>()).isEmpty(), true);
+
+        const auto serialNumber = QKnxByteArray::fromHex("00fa12345678");
+
+        QVector<QKnxNetIpFrame> frames, wrappers;
+        for (int i = 0; i < 9; ++i) {
+            // payloads of different length make the frames span a different number of blocks
+            frames.append(QKnxNetIpRoutingIndicationProxy::builder()
+                .setCemi(QKnxLinkLayerFrame::builder()
+                    .setMedium(QKnx::MediumType::NetIP)
+                    .setData(QKnxByteArray::fromHex("2900bcd011590ade0100")
+                        + QKnxByteArray(1 + 5 * i, quint8(i)))
+                    .createFrame())
+                .create());
+            wrappers.append(context.wrap(frames.last(), 0x0000, 211938428830917 + i,
+                serialNumber, quint16(0xaffe + i)));
+        }
+
+        auto tampered = wrappers.at(5).bytes();
+        tampered.set(30, tampered.at(30) ^ 0x01);
+        wrappers[5] = QKnxNetIpFrame::fromBytes(tampered);
+        wrappers.append(frames.first()); // not a secure wrapper
+
+        const auto result = context.unwrap(wrappers);
+        QCOMPARE(result.size(), wrappers.size());
+        for (int i = 0; i < wrappers.size(); ++i) {
+            QCOMPARE(result.at(i).bytes(), context.unwrap(wrappers.at(i)).bytes());
+            if (i != 5 && i < frames.size())
+                QCOMPARE(result.at(i).bytes(), frames.at(i).bytes());
+        }
+        QCOMPARE(result.at(5).isValid(), false);
+        QCOMPARE(result.last().isValid(), false);
+    }
+
     void testSessionResponseFrame()
     {
         if (QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL)
@@ -28,6 +28,7 @@
 
 #include <QtCore/qvector.h>
 #include <QtCore/qmetaobject.h>
+#include <QtCore/qnumeric.h>
 #include <QtKnx/qknx1bit.h>
 #include <QtKnx/qknx1bitcontrolled.h>
 #include <QtKnx/qknx1byte.h>
@@ -45,11 +46,14 @@
 #include <QtKnx/qknx8bitunsignedvalue.h>
 #include <QtKnx/qknxchar.h>
 #include <QtKnx/qknxcharstring.h>
+#include <QtKnx/qknxcolour.h>
 #include <QtKnx/qknxdatapointtype.h>
 #include <QtKnx/qknxdatapointtypefactory.h>
 #include <QtKnx/qknxdatetime.h>
+#include <QtKnx/qknxdptcodec.h>
 #include <QtKnx/qknxelectricalenergy.h>
 #include <QtKnx/qknxentranceaccess.h>
+#include <QtKnx/qknxscalingspeed.h>
 #include <QtKnx/qknxscene.h>
 #include <QtKnx/qknxstatusmode3.h>
 #include <QtKnx/qknxtime.h>
@@ -64,6 +68,11 @@ class tst_QKnxDatapointType : public QObject
 
 private slots:
     void datapointType();
+    void metaData();
+    void codec();
+    void factoryDispatch();
+    void factoryRegistry();
+    void factoryChangeDetection();
     void dpt1_1Bit();
     void dpt2_1BitControlled();
     void dpt3_3BitControlled();
@@ -92,6 +101,9 @@ private slots:
     void dpt27_32BitSet();
     void dpt28_StringUtf8();
     void dpt29_ElectricalEnergy();
+    void dpt225_ScalingSpeed();
+    void dpt232_ColourRGB();
+    void dpt251_ColourRGBW();
 };
 
 void tst_QKnxDatapointType::datapointType()
@@ -115,6 +127,313 @@ void tst_QKnxDatapointType::datapointType()
     QCOMPARE(type.mainType(), 232);
     QCOMPARE(type.subType(), 600);
     QCOMPARE(type.type(), QKnxDatapointType::Type::DptColourRGB);
+
+    type = QKnxDatapointType("dpst-9-1", 2);
+    QCOMPARE(type.type(), QKnxDatapointType::Type::DptTemperatureCelsius);
+    type = QKnxDatapointType("9.001", 2);
+    QCOMPARE(type.type(), QKnxDatapointType::Type::DptTemperatureCelsius);
+
+    QCOMPARE(QKnxDatapointType::toType("DPT-1"), QKnxDatapointType::Type::Dpt1_1Bit);
+    QCOMPARE(QKnxDatapointType::toType("Dpt-1"), QKnxDatapointType::Type::Dpt1_1Bit);
+    QCOMPARE(QKnxDatapointType::toType("DPST-1-1"), QKnxDatapointType::Type::DptSwitch);
+    QCOMPARE(QKnxDatapointType::toType("DPST-1.1"), QKnxDatapointType::Type::DptSwitch);
+    QCOMPARE(QKnxDatapointType::toType("1-1"), QKnxDatapointType::Type::DptSwitch);
+    QCOMPARE(QKnxDatapointType::toType("00001.00001"), QKnxDatapointType::Type::DptSwitch);
+    QCOMPARE(QKnxDatapointType::toType("DPST-232-600"), QKnxDatapointType::Type::DptColourRGB);
+    QCOMPARE(quint32(QKnxDatapointType::toType("42949.67295")), quint32(0xffffffff));
+
+    for (const auto &invalid : { "", "DPT-", "DPST-", "DPST-1", "DPT-1-1", "DPT-100000",
+        "1.", ".1", "1..1", "1.1 ", " 1.1", "DPS-1-1", "DPT1", "1.000001", "42949.67296" }) {
+        QCOMPARE(QKnxDatapointType::toType(QString(invalid)), QKnxDatapointType::Type::Unknown);
+    }
+}
+
+void tst_QKnxDatapointType::metaData()
+{
+    QKnxTemperatureCelsius first(21.5f);
+    const QKnxTemperatureCelsius second(-5.f);
+    for (const QKnxDatapointType &dpt : { QKnxDatapointType(first), QKnxDatapointType(second) }) {
+        QCOMPARE(dpt.unit(), QString("degree Celsius"));
+        QCOMPARE(dpt.description(), QString("Temperature in degree Celsius"));
+        QCOMPARE(dpt.minimumText(), QString("Minimum Value, -273"));
+        QCOMPARE(dpt.maximumText(), QString("Maximum Value, 670 760"));
+        QCOMPARE(dpt.minimum().toDouble(), -273.);
+        QCOMPARE(dpt.maximum().toDouble(), 670760.);
+    }
+
+    // the base class keeps its own metadata
+    const QKnx2ByteFloat base;
+    QCOMPARE(base.unit(), QString());
+    QCOMPARE(base.description(), QString("2-byte float"));
+
+    // changing the metadata of one object must not affect the others
+    first.setUnit("K");
+    first.setRange(QVariant::fromValue(0), QVariant::fromValue(100));
+    QCOMPARE(first.unit(), QString("K"));
+    QCOMPARE(first.maximum().toInt(), 100);
+    QCOMPARE(second.unit(), QString("degree Celsius"));
+    QCOMPARE(second.maximum().toDouble(), 670760.);
+    QCOMPARE(QKnxTemperatureCelsius().unit(), QString("degree Celsius"));
+
+    QCOMPARE(QKnxTemperatureCelsius(1.f) == QKnxTemperatureCelsius(1.f), true);
+    QCOMPARE(QKnxTemperatureCelsius(1.f) == QKnxTemperatureCelsius(2.f), false);
+    QKnxTemperatureCelsius third(1.f);
+    third.setDescription("Room");
+    QCOMPARE(QKnxTemperatureCelsius(1.f) == third, false);
+
+    // the texts of the controlled types are derived from the uncontrolled ones
+    const QKnxSwitchControl switchControl;
+    QCOMPARE(switchControl.minimumText(), QString("No control, Off"));
+    QCOMPARE(switchControl.maximumText(), QString("Controlled, On"));
+    QCOMPARE(switchControl.description(), QKnxSwitchControl().description());
+}
+
+void tst_QKnxDatapointType::codec()
+{
+    quint8 data[8] = {};
+
+    QKnxTemperatureCelsius celsius;
+    for (float value : { -273.f, -30.5f, 0.f, 0.01f, 20.48f, 21.5f, 670760.f }) {
+        QVERIFY(celsius.setValue(value));
+        QCOMPARE(QKnxDptCodec<QKnxTemperatureCelsius>::decode(celsius.constData(),
+            celsius.size()), celsius.value());
+        QVERIFY(QKnxDptCodec<QKnx2ByteFloat>::encode(value, data));
+        QCOMPARE(QKnxByteArray(data, QKnx2ByteFloat::TypeSize), celsius.bytes());
+    }
+    QCOMPARE(QKnxDptCodec<QKnx2ByteFloat>::decode(data, 1), 0.f);
+    QCOMPARE(QKnxDptCodec<QKnx2ByteFloat>::decode(nullptr, 2), 0.f);
+    QCOMPARE(QKnxDptCodec<QKnx2ByteFloat>::encode(1e9f, data), false);
+
+    QKnxSwitch dptSwitch(QKnxSwitch::State::On);
+    QCOMPARE(QKnxDptCodec<QKnxSwitch>::decode(dptSwitch.constData(), dptSwitch.size()), true);
+
+    QKnxSwitchControl switchControl(QKnxSwitch::State::On, QKnxSwitchControl::Control::Control);
+    QVERIFY(QKnxDptCodec<QKnxSwitchControl>::encode({ true, true }, data));
+    QCOMPARE(QKnxByteArray(data, 1), switchControl.bytes());
+
+    QKnxControlDimming dimming(QKnxControlDimming::Increase, QKnx3BitControlled::Four);
+    auto steps = QKnxDptCodec<QKnxControlDimming>::decode(dimming.constData(), dimming.size());
+    QCOMPARE(steps.control, true);
+    QCOMPARE(steps.numberOfIntervals, quint8(4));
+    QVERIFY(QKnxDptCodec<QKnx3BitControlled>::encode({ true, 4 }, data));
+    QCOMPARE(QKnxByteArray(data, 1), dimming.bytes());
+    QCOMPARE(QKnxDptCodec<QKnx3BitControlled>::encode({ true, 3 }, data), false);
+
+    QKnxValue4Count count(-2147483647 - 1);
+    QCOMPARE(QKnxDptCodec<QKnxValue4Count>::decode(count.constData(), count.size()),
+        count.value());
+    QVERIFY(QKnxDptCodec<QKnx4ByteSignedValue>::encode(count.value(), data));
+    QCOMPARE(QKnxByteArray(data, 4), count.bytes());
+
+    QKnxActiveEnergyV64 energy(-1234567890123ll);
+    QCOMPARE(QKnxDptCodec<QKnxActiveEnergyV64>::decode(energy.constData(), energy.size()),
+        energy.value());
+    QVERIFY(QKnxDptCodec<QKnxElectricalEnergy>::encode(energy.value(), data));
+    QCOMPARE(QKnxByteArray(data, 8), energy.bytes());
+
+    QKnxTimeOfDay timeOfDay(QKnxTime(23, 59, 59, QKnxTime::DayOfWeek::Sunday));
+    QCOMPARE(QKnxDptCodec<QKnxTimeOfDay>::decode(timeOfDay.constData(), timeOfDay.size()),
+        timeOfDay.value());
+    QVERIFY(QKnxDptCodec<QKnxTimeOfDay>::encode(timeOfDay.value(), data));
+    QCOMPARE(QKnxByteArray(data, 3), timeOfDay.bytes());
+
+    QKnxDate date(QDate(2089, 12, 31));
+    QCOMPARE(QKnxDptCodec<QKnxDate>::decode(date.constData(), date.size()), date.value());
+    QVERIFY(QKnxDptCodec<QKnxDate>::encode(date.value(), data));
+    QCOMPARE(QKnxByteArray(data, 3), date.bytes());
+    QCOMPARE(QKnxDptCodec<QKnxDate>::encode(QDate(1989, 12, 31), data), false);
+
+    QKnxSceneControl scene(63, QKnxSceneControl::Control::Learn);
+    auto sceneValue = QKnxDptCodec<QKnxSceneControl>::decode(scene.constData(), scene.size());
+    QCOMPARE(sceneValue.sceneNumber, quint8(63));
+    QCOMPARE(sceneValue.learn, true);
+    QCOMPARE(QKnxDptCodec<QKnxSceneNumber>::encode(64, data), false);
+
+    // column decode, back to back and through offsets with a short payload in between
+    const quint8 column[] = { 0x0c, 0x33, 0x01, 0x0c, 0x33, 0x8a, 0x0b, 0x00, 0x01, 0x02 };
+    const int offsets[] = { 0, 2, 3, 5, 7, 10 };
+    float floats[5] = {};
+    QCOMPARE(QKnxDptCodec<QKnx2ByteFloat>::decodeColumn(column, offsets, 5, floats), 4);
+    QCOMPARE(floats[0], 21.5f);
+    QCOMPARE(floats[1], 0.f);
+    QCOMPARE(floats[2], 21.5f);
+    QCOMPARE(floats[3], -30.5f);
+    QCOMPARE(floats[4], 0.01f);
+
+    quint16 values[2] = {};
+    QCOMPARE(QKnxDptCodec<QKnxValue2Ucount>::decodeColumn(column + 3, nullptr, 2, values), 2);
+    QCOMPARE(values[0], quint16(0x0c33));
+    QCOMPARE(values[1], quint16(0x8a0b));
+
+    QDate dates[2];
+    const quint8 dateColumn[] = { 31, 12, 89, 1, 1, 90 };
+    QCOMPARE(QKnxDptCodec<QKnxDate>::decodeColumn(dateColumn, nullptr, 2, dates), 2);
+    QCOMPARE(dates[0], QDate(2089, 12, 31));
+    QCOMPARE(dates[1], QDate(1990, 1, 1));
+
+    const QKnxDptCodec<QKnxColourRGB>::ValueType colours[] = {
+        { 0xff, 0x00, 0x00 }, { 0x00, 0x80, 0xff }
+    };
+    quint8 scene[6] = {};
+    QCOMPARE(QKnxDptCodec<QKnxColourRGB>::encodeColumn(colours, 2, scene), 2);
+    QCOMPARE(QKnxByteArray(scene, 6), QKnxByteArray({ 0xff, 0x00, 0x00, 0x00, 0x80, 0xff }));
+
+    const QKnxDptCodec<QKnxColourRGBW>::ValueType rgbw[] = {
+        { 1, 2, 3, 4, 0x0f }, { 5, 6, 7, 8, 0x10 }
+    };
+    quint8 rgbwScene[12] = {};
+    QCOMPARE(QKnxDptCodec<QKnxColourRGBW>::encodeColumn(rgbw, 2, rgbwScene), 1);
+    QCOMPARE(QKnxByteArray(rgbwScene, 12), QKnxByteArray({ 0x01, 0x02, 0x03, 0x04, 0x00, 0x0f,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }));
+    QCOMPARE(QKnxDptCodec<QKnxColourRGB>::encodeColumn(colours, 2, nullptr), 0);
+
+    // variable length payloads cannot be encoded back to back with a fixed stride
+    QVERIFY(QKnxDptCodec<QKnxColourRGB>::IsFixedSize);
+    QVERIFY(QKnxDptCodec<QKnxCharString>::IsFixedSize);
+    QVERIFY(!QKnxDptCodec<QKnxVarString>::IsFixedSize);
+}
+
+void tst_QKnxDatapointType::factoryDispatch()
+{
+    const auto &factory = QKnxDatapointTypeFactory::instance();
+    quint8 data[8] = {};
+
+    QKnxTemperatureCelsius celsius(21.5f);
+    auto value = factory.decode(QKnxDatapointType::Type::DptTemperatureCelsius,
+        celsius.constData(), celsius.size());
+    QCOMPARE(value.userType(), int(QMetaType::Float));
+    QCOMPARE(value.toFloat(), celsius.value());
+    QVERIFY(factory.encode(9, 1, value, data));
+    QCOMPARE(QKnxByteArray(data, 2), celsius.bytes());
+
+    QKnxScaling scaling(50.);
+    value = factory.decode(scaling.mainType(), scaling.subType(), scaling.constData(),
+        scaling.size());
+    QCOMPARE(value.toDouble(), scaling.value());
+    QVERIFY(factory.encode(scaling.mainType(), scaling.subType(), value, data));
+    QCOMPARE(QKnxByteArray(data, 1), scaling.bytes());
+
+    QKnxTimePeriod100Msec period(1000);
+    value = factory.decode(period.mainType(), period.subType(), period.constData(),
+        period.size());
+    QCOMPARE(value.toUInt(), period.value());
+    QVERIFY(factory.encode(period.mainType(), period.subType(), value, data));
+    QCOMPARE(QKnxByteArray(data, 2), period.bytes());
+    QCOMPARE(factory.encode(period.mainType(), period.subType(), 6553600, data), false);
+
+    QKnxDate date(QDate(2019, 3, 1));
+    value = factory.decode(QKnxDatapointType::Type::DptDate, date.constData(), date.size());
+    QCOMPARE(value.toDate(), date.value());
+
+    QKnxTimeOfDay timeOfDay(QKnxTime(11, 12, 13, QKnxTime::DayOfWeek::Monday));
+    value = factory.decode(QKnxDatapointType::Type::DptTimeOfDay, timeOfDay.constData(),
+        timeOfDay.size());
+    QCOMPARE(value.value<QKnxTime>(), timeOfDay.value());
+
+    QKnxSceneControl scene(12, QKnxSceneControl::Learn);
+    value = factory.decode(scene.mainType(), scene.subType(), scene.constData(), scene.size());
+    QCOMPARE(value.value<quint8>(), scene.byte(0));
+
+    QCOMPARE(factory.decode(9, 1, data, 1).isValid(), false);
+    QCOMPARE(factory.decode(16, 0, data, 8).isValid(), false);
+    QCOMPARE(factory.decode(0, 0, data, 8).isValid(), false);
+    QCOMPARE(factory.decode(1000, 0, data, 8).isValid(), false);
+    QCOMPARE(factory.decode(QKnxDatapointType::Type::Unknown, data, 8).isValid(), false);
+    QCOMPARE(factory.encode(28, 1, QString("abc"), data), false);
+}
+
+void tst_QKnxDatapointType::factoryRegistry()
+{
+    auto &factory = QKnxDatapointTypeFactory::instance();
+
+    const auto mainTypes = factory.mainTypes();
+    QCOMPARE(mainTypes.size(), 30);
+    for (int i = 1; i < mainTypes.size(); ++i)
+        QVERIFY(mainTypes.at(i - 1) < mainTypes.at(i));
+    QCOMPARE(factory.containsMainType(22), false);
+    QCOMPARE(factory.containsMainType(25), false);
+
+    for (auto mainType : mainTypes) {
+        QVERIFY(factory.typeSize(mainType) > 0);
+        for (auto subType : factory.subTypes(mainType)) {
+            QScopedPointer<QKnxDatapointType> dpt(factory.createType(mainType, subType));
+            QVERIFY(!dpt.isNull());
+            QCOMPARE(dpt->mainType(), mainType);
+            QCOMPARE(dpt->subType(), subType);
+        }
+    }
+
+    QCOMPARE(factory.subTypes(1).size(), 24);
+    QCOMPARE(factory.subTypes(1).first(), 0);
+    QCOMPARE(factory.subTypes(1).last(), 100);
+    QCOMPARE(factory.typeSize(9), 2);
+    QCOMPARE(factory.typeSize(16), 14);
+    QCOMPARE(factory.typeSize(1000), 0);
+    QCOMPARE(factory.subTypes(1000).isEmpty(), true);
+
+    QScopedPointer<QKnxDatapointType> dpt(factory.createType(9, 999));
+    QCOMPARE(dpt->type(), QKnxDatapointType::Type::Dpt9_2ByteFloat);
+    QCOMPARE(factory.containsSubType(9, 999), false);
+    QCOMPARE(factory.createType(1000, 0), nullptr);
+    QCOMPARE(factory.createType(-1, 0), nullptr);
+
+    factory.registerType<QKnxSwitch>(1001, 1, 1);
+    QCOMPARE(factory.containsMainType(1001), true);
+    QCOMPARE(factory.containsSubType(1001, 1), true);
+    QCOMPARE(factory.typeSize(1001), 1);
+    QCOMPARE(factory.mainTypes().last(), 1001);
+    dpt.reset(factory.createType(1001, 1));
+    QCOMPARE(dpt->type(), QKnxDatapointType::Type::DptSwitch);
+}
+
+void tst_QKnxDatapointType::factoryChangeDetection()
+{
+    const auto &factory = QKnxDatapointTypeFactory::instance();
+
+    QKnxTemperatureCelsius published(21.f), received(21.3f);
+    QCOMPARE(factory.isSignificantChange(QKnxDatapointType::Type::DptTemperatureCelsius,
+        published.constData(), received.constData(), 2), true);
+    QCOMPARE(factory.isSignificantChange(QKnxDatapointType::Type::DptTemperatureCelsius,
+        published.constData(), received.constData(), 2, .5), false);
+    QCOMPARE(factory.isSignificantChange(QKnxDatapointType::Type::DptTemperatureCelsius,
+        published.constData(), received.constData(), 2, 0., .01), true);
+    QCOMPARE(factory.isSignificantChange(QKnxDatapointType::Type::DptTemperatureCelsius,
+        published.constData(), received.constData(), 2, 0., .05), false);
+    QCOMPARE(factory.isSignificantChange(QKnxDatapointType::Type::DptTemperatureCelsius,
+        published.constData(), published.constData(), 2), false);
+
+    // the deadband is applied to the scaled value
+    QKnxScaling low(10.), high(12.);
+    QCOMPARE(factory.isSignificantChange(low.mainType(), low.subType(), low.constData(),
+        high.constData(), 1, 1.5), true);
+    QCOMPARE(factory.isSignificantChange(low.mainType(), low.subType(), low.constData(),
+        high.constData(), 1, 2.5), false);
+
+    QKnxValue4Count count(-1000), nextCount(-1040);
+    QCOMPARE(factory.isSignificantChange(count.mainType(), count.subType(), count.constData(),
+        nextCount.constData(), 4, 0., .05), false);
+    QCOMPARE(factory.isSignificantChange(count.mainType(), count.subType(), count.constData(),
+        nextCount.constData(), 4, 0., .03), true);
+
+    QKnx4ByteFloat nan(qQNaN()), zero(0.f);
+    QCOMPARE(factory.isSignificantChange(nan.mainType(), nan.subType(), nan.constData(),
+        nan.constData(), 4, 1.), false);
+    QCOMPARE(factory.isSignificantChange(nan.mainType(), nan.subType(), nan.constData(),
+        zero.constData(), 4, 1.), true);
+
+    // bitsets and enumerations only compare equal if all bytes match
+    QKnxSwitch off(QKnxSwitch::State::Off), on(QKnxSwitch::State::On);
+    QCOMPARE(factory.isSignificantChange(off.mainType(), off.subType(), off.constData(),
+        on.constData(), 1, 100.), true);
+    QCOMPARE(factory.isSignificantChange(off.mainType(), off.subType(), off.constData(),
+        off.constData(), 1, 100.), false);
+
+    const quint8 first[] = { 0x41, 0x42 }, second[] = { 0x41, 0x43 };
+    QCOMPARE(factory.isSignificantChange(16, 0, first, second, 1), false);
+    QCOMPARE(factory.isSignificantChange(16, 0, first, second, 2), true);
+    QCOMPARE(factory.isSignificantChange(9, 1, first, second, 1, 1000.), false);
+    QCOMPARE(factory.isSignificantChange(9, 1, nullptr, second, 2), true);
+    QCOMPARE(factory.isSignificantChange(9, 1, nullptr, nullptr, 2), false);
 }
 
 void tst_QKnxDatapointType::dpt1_1Bit()
@@ -568,6 +887,31 @@ void tst_QKnxDatapointType::dpt9_2ByteFloat()
     dptTemp.setValue(float(670760));
     QCOMPARE(dptTemp.value(), float(670760));
 
+    // rounding the mantissa up to 2048 moves to the next exponent
+    QCOMPARE(dpt.setValue(20.48f), true);
+    QCOMPARE(dpt.bytes(), QKnxByteArray({ 0x0c, 0x00 }));
+    QCOMPARE(dpt.setValue(-20.48f), true);
+    QCOMPARE(dpt.bytes(), QKnxByteArray({ 0x80, 0x00 }));
+
+    // every encoding decodes to a value that encodes back to the same value
+    QVector<quint8> raw(2 * 0x10000);
+    for (int i = 0; i < 0x10000; ++i) {
+        raw[2 * i] = quint8(i >> 8);
+        raw[2 * i + 1] = quint8(i);
+    }
+    QVector<float> values(0x10000);
+    QKnxDptCodec<QKnx2ByteFloat>::decode(raw.constData(), values.size(), values.data());
+
+    quint8 data[2] = {};
+    for (int i = 0; i < 0x10000; ++i) {
+        const float value = QKnxDptCodec<QKnx2ByteFloat>::decode(raw.constData() + 2 * i, 2);
+        QCOMPARE(values.at(i), value);
+        QVERIFY(QKnxDptCodec<QKnx2ByteFloat>::encode(value, data));
+        QCOMPARE(QKnxDptCodec<QKnx2ByteFloat>::decode(data, 2), value);
+    }
+    QCOMPARE(QKnxDptCodec<QKnx2ByteFloat>::encode(qQNaN(), data), false);
+    QCOMPARE(QKnxDptCodec<QKnx2ByteFloat>::encode(qInf(), data), false);
+
     // TODO: Extend the auto-test.
 }
 
@@ -835,6 +1179,18 @@ void tst_QKnxDatapointType::dpt16_String()
     QCOMPARE(stringA.string(), QLatin1String("KNX is OK"));
     QCOMPARE(stringA.isValid(), true);
 
+    QCOMPARE(stringA.setString("Fourteen chars"), true);
+    QCOMPARE(stringA.string(), QLatin1String("Fourteen chars"));
+    QCOMPARE(stringA.setString("Fifteen chars!!"), false);
+    QCOMPARE(stringA.string(), QLatin1String("Fourteen chars"));
+
+    quint8 payload[QKnxCharString::TypeSize];
+    QVERIFY(QKnxDptCodec<QKnxCharString>::encode(QLatin1String("KNX"), payload));
+    QCOMPARE(QKnxByteArray(payload, 14), QKnxByteArray({ 0x4b, 0x4e, 0x58, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }));
+    QCOMPARE(QKnxDptCodec<QKnxCharString>::decode(payload, 14), QLatin1String("KNX"));
+    QCOMPARE(QKnxDptCodec<QKnxCharString>::decode(payload, 13), QLatin1String());
+
     QKnxCharString88591 string8;
     QCOMPARE(string8.mainType(), 16);
     QCOMPARE(string8.subType(), 1);
@@ -1974,6 +2330,25 @@ void tst_QKnxDatapointType::dpt24_VarString()
     QCOMPARE(string.isValid(), false);
     QCOMPARE(string.setBytes(QKnxByteArray { 0x01, 0x00 }, 0, 2), true);
     QCOMPARE(string.isValid(), true);
+
+    quint8 payload[8];
+    QKnxDptStringBuilder<QKnxVarString> builder(payload, sizeof(payload));
+    builder.append(QLatin1String("Caf")).appendUtf8("\xc3\xa9");
+    QCOMPARE(builder.isValid(), true);
+    QCOMPARE(builder.size(), 5);
+    QCOMPARE(QKnxByteArray(payload, builder.size()), QKnxByteArray({ 0x43, 0x61, 0x66, 0xe9,
+        0x00 }));
+    QCOMPARE(QKnxDptCodec<QKnxVarString>::decode(payload, builder.size()),
+        QLatin1String("Caf\xe9"));
+
+    builder.append(QStringView(u"\u20ac"));
+    QCOMPARE(builder.isValid(), false);
+    QCOMPARE(builder.size(), 0);
+    QCOMPARE(payload[4], quint8(0x00));
+    builder.clear();
+    builder.append(QLatin1String("12345678"));
+    QCOMPARE(builder.isValid(), false);
+    QCOMPARE(payload[0], quint8(0x00));
 }
 
 void tst_QKnxDatapointType::dpt26_SceneInfo()
@@ -2155,6 +2530,23 @@ void tst_QKnxDatapointType::dpt28_StringUtf8()
     QCOMPARE(utf8.string(), QString("KNX is OK"));
     QCOMPARE(string.bytes(), QKnxByteArray({ 0x4b, 0x4e, 0x58, 0x20, 0x69, 0x73, 0x20, 0x4f,
         0x4b, 0x00 }));
+
+    QCOMPARE(utf8.setString("\xc0\xaf"), false);
+    QCOMPARE(utf8.setString("\xed\xa0\x80"), false);
+    QCOMPARE(utf8.setString(QString(QChar(0xd800))), false);
+    QCOMPARE(utf8.string(), QString("KNX is OK"));
+    QCOMPARE(utf8.setString(QString::fromUtf8("21 \xc2\xb0" "C \xf0\x9f\x8c\xa1")), true);
+    QCOMPARE(utf8.bytes(), QKnxByteArray({ 0x32, 0x31, 0x20, 0xc2, 0xb0, 0x43, 0x20, 0xf0,
+        0x9f, 0x8c, 0xa1, 0x00 }));
+
+    quint8 payload[16];
+    QKnxDptStringBuilder<QKnxUtf8> builder(payload, sizeof(payload));
+    builder.append(QLatin1String("21 ")).append(QStringView(u"\u00b0C"));
+    QCOMPARE(builder.isValid(), true);
+    QCOMPARE(QKnxByteArray(payload, builder.size()), QKnxByteArray({ 0x32, 0x31, 0x20, 0xc2,
+        0xb0, 0x43, 0x00 }));
+    QCOMPARE(utf8.setString(reinterpret_cast<const char *>(builder.constData())), true);
+    QCOMPARE(utf8.string(), QString::fromUtf8("21 \xc2\xb0" "C"));
 }
 
 void tst_QKnxDatapointType::dpt29_ElectricalEnergy()
@@ -2186,6 +2578,91 @@ void tst_QKnxDatapointType::dpt29_ElectricalEnergy()
     QCOMPARE(dpt2.value(), qint64(2147483647));
 }
 
+void tst_QKnxDatapointType::dpt225_ScalingSpeed()
+{
+    QKnxScalingSpeed speed;
+    QCOMPARE(speed.mainType(), 225);
+    QCOMPARE(speed.subType(), 1);
+    QCOMPARE(speed.size(), 3);
+    QCOMPARE(speed.isValid(), true);
+    QCOMPARE(speed.type(), QKnxDatapointType::Type::DptScalingSpeed);
+    QCOMPARE(speed.bytes(), QKnxByteArray({ 0x00, 0x00, 0x00 }));
+
+    QCOMPARE(speed.setValue(1500, 100.), true);
+    QCOMPARE(speed.timePeriod(), quint16(1500));
+    QCOMPARE(speed.scaling(), 100.);
+    QCOMPARE(speed.bytes(), QKnxByteArray({ 0x05, 0xdc, 0xff }));
+
+    QCOMPARE(speed.setScaling(50.), true);
+    QCOMPARE(speed.byte(2), quint8(0x80));
+    QCOMPARE(speed.setScaling(100.1), false);
+    QCOMPARE(speed.setValue(10, -1.), false);
+    QCOMPARE(speed.timePeriod(), quint16(1500));
+    QCOMPARE(speed.setTimePeriod(65535), true);
+    QCOMPARE(speed.bytes(), QKnxByteArray({ 0xff, 0xff, 0x80 }));
+
+    QKnxScalingStepTime stepTime(200, 100.);
+    QCOMPARE(stepTime.subType(), 2);
+    QCOMPARE(stepTime.type(), QKnxDatapointType::Type::DptScalingStepTime);
+    QCOMPARE(stepTime.bytes(), QKnxByteArray({ 0x00, 0xc8, 0xff }));
+
+    QScopedPointer<QKnxDatapointType> dpt(QKnxDatapointTypeFactory::instance()
+        .createType(QKnxDatapointType::Type::DptScalingStepTime));
+    QVERIFY(dynamic_cast<QKnxScalingStepTime *> (dpt.data()) != nullptr);
+}
+
+void tst_QKnxDatapointType::dpt232_ColourRGB()
+{
+    QKnxColourRGB colour;
+    QCOMPARE(colour.mainType(), 232);
+    QCOMPARE(colour.subType(), 600);
+    QCOMPARE(colour.size(), 3);
+    QCOMPARE(colour.isValid(), true);
+    QCOMPARE(colour.type(), QKnxDatapointType::Type::DptColourRGB);
+
+    QCOMPARE(colour.setValue(0xff, 0x80, 0x00), true);
+    QCOMPARE(colour.red(), quint8(0xff));
+    QCOMPARE(colour.green(), quint8(0x80));
+    QCOMPARE(colour.blue(), quint8(0x00));
+    QCOMPARE(colour.bytes(), QKnxByteArray({ 0xff, 0x80, 0x00 }));
+
+    QCOMPARE(colour.setBlue(0x10), true);
+    QCOMPARE(colour.bytes(), QKnxByteArray({ 0xff, 0x80, 0x10 }));
+
+    QScopedPointer<QKnxDatapointType> dpt(QKnxDatapointTypeFactory::instance().createType(232,
+        600));
+    QVERIFY(dynamic_cast<QKnxColourRGB *> (dpt.data()) != nullptr);
+}
+
+void tst_QKnxDatapointType::dpt251_ColourRGBW()
+{
+    QKnxColourRGBW colour;
+    QCOMPARE(colour.mainType(), 251);
+    QCOMPARE(colour.subType(), 600);
+    QCOMPARE(colour.size(), 6);
+    QCOMPARE(colour.isValid(), true);
+    QCOMPARE(colour.type(), QKnxDatapointType::Type::DptColourRGBW);
+    QCOMPARE(colour.bytes(), QKnxByteArray({ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f }));
+
+    QCOMPARE(colour.setValue(0x10, 0x20, 0x30, 0x40, QKnxColourRGBW::Red
+        | QKnxColourRGBW::White), true);
+    QCOMPARE(colour.red(), quint8(0x10));
+    QCOMPARE(colour.green(), quint8(0x20));
+    QCOMPARE(colour.blue(), quint8(0x30));
+    QCOMPARE(colour.white(), quint8(0x40));
+    QCOMPARE(colour.validChannels(), QKnxColourRGBW::Red | QKnxColourRGBW::White);
+    QCOMPARE(colour.bytes(), QKnxByteArray({ 0x10, 0x20, 0x30, 0x40, 0x00, 0x09 }));
+
+    QCOMPARE(colour.setValidChannels(QKnxColourRGBW::Green), true);
+    QCOMPARE(colour.byte(5), quint8(0x04));
+
+    QCOMPARE(colour.setByte(4, 0x01), true);
+    QCOMPARE(colour.isValid(), false);
+    QCOMPARE(colour.setByte(4, 0x00), true);
+    QCOMPARE(colour.setByte(5, 0x10), true);
+    QCOMPARE(colour.isValid(), false);
+}
+
 QTEST_MAIN(tst_QKnxDatapointType)
 
 #include "tst_qknxdatapointtype.moc"
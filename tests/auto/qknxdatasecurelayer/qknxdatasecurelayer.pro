@@ -0,0 +1,7 @@
+TARGET = tst_qknxdatasecurelayer
+
+QT = core testlib knx network knx-private
+CONFIG += testcase c++11
+
+CONFIG -= app_bundle
+SOURCES += tst_qknxdatasecurelayer.cpp
@@ -0,0 +1,348 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qvector.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/private/qknxdatasecurelayer_p.h>
+#include <QtKnx/private/qknxreplaywindow_p.h>
+#include <QtKnx/private/qknxsequencenumberstore_p.h>
+#include <QtKnx/private/qknxtpdufactory_p.h>
+#include <QtTest/qtest.h>
+
+Q_DECLARE_METATYPE(QKnxTpdu)
+Q_DECLARE_METATYPE(QKnxDataSecureLayer::Protection)
+
+class tst_QKnxDataSecureLayer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init()
+    {
+        m_sender.setGroupKey(m_group, m_key);
+        m_sender.setSequenceNumber(5);
+        m_receiver.setGroupKey(m_group, m_key);
+        m_receiver.setLastSequenceNumber(m_source, 0);
+    }
+
+    void cleanup()
+    {
+        m_sender.clearKeyCache();
+        m_receiver.clearKeyCache();
+    }
+
+    void testWrap_data()
+    {
+        QTest::addColumn<QKnxTpdu>("tpdu");
+        QTest::addColumn<QKnxDataSecureLayer::Protection>("protection");
+        QTest::addColumn<QKnxByteArray>("expected");
+
+        QTest::newRow("GroupValueWrite, encrypted")
+            << QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 })
+            << QKnxDataSecureLayer::Protection::AuthenticationConfidentiality
+            << QKnxByteArray::fromHex("03f1100000000000054a09ade93884");
+        QTest::newRow("GroupValueWrite, authenticated")
+            << QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 })
+            << QKnxDataSecureLayer::Protection::Authentication
+            << QKnxByteArray::fromHex("03f1000000000000050081c740a3b6");
+    }
+
+    void testWrap()
+    {
+        QFETCH(QKnxTpdu, tpdu);
+        QFETCH(QKnxDataSecureLayer::Protection, protection);
+        QFETCH(QKnxByteArray, expected);
+
+        auto status = QKnxDataSecureLayer::Status::InvalidFrame;
+        const auto secured = m_sender.wrap(tpdu, m_source, m_destination, protection, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+        QCOMPARE(secured.bytes(), expected);
+        QCOMPARE(secured.applicationControlField(),
+            QKnxTpdu::ApplicationControlField::SecureService);
+        QCOMPARE(secured.isValid(), true);
+        QCOMPARE(m_sender.sequenceNumber(), quint48(6));
+
+        const auto plain = m_receiver.unwrap(secured, m_source, m_destination, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+        QCOMPARE(plain.bytes(), tpdu.bytes());
+        QCOMPARE(m_receiver.lastSequenceNumber(m_source), quint48(5));
+    }
+
+    void testMultiByteValue()
+    {
+        m_sender.setSequenceNumber(6);
+        const auto tpdu = QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x0c, 0x65 });
+        const auto secured = m_sender.wrap(tpdu, m_source, m_destination);
+        QCOMPARE(secured.bytes(), QKnxByteArray::fromHex("03f1100000000000061da6a18e7cdd6cdc"));
+        QCOMPARE(m_receiver.unwrap(secured, m_source, m_destination).bytes(), tpdu.bytes());
+    }
+
+    void testReplay()
+    {
+        const auto tpdu = QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 });
+        const auto secured = m_sender.wrap(tpdu, m_source, m_destination);
+
+        auto status = QKnxDataSecureLayer::Status::InvalidFrame;
+        m_receiver.unwrap(secured, m_source, m_destination, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+
+        QCOMPARE(m_receiver.unwrap(secured, m_source, m_destination, &status).size(), quint16(0));
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Replayed);
+
+        m_receiver.unwrap(m_sender.wrap(tpdu, m_source, m_destination), m_source, m_destination,
+            &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+        QCOMPARE(m_receiver.lastSequenceNumber(m_source), quint48(6));
+    }
+
+    void testErrors()
+    {
+        const auto tpdu = QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 });
+        auto status = QKnxDataSecureLayer::Status::Ok;
+
+        // plain TPDUs pass through unwrap
+        QCOMPARE(m_receiver.unwrap(tpdu, m_source, m_destination, &status), tpdu);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::NotSecured);
+
+        const QKnxAddress unknown = QKnxAddress::createGroup(1, 0, 2);
+        QCOMPARE(m_sender.wrap(tpdu, m_source, unknown, {}, &status).size(), quint16(0));
+        QCOMPARE(status, QKnxDataSecureLayer::Status::NoKey);
+        QCOMPARE(m_sender.hasGroupKey(m_group), true);
+        QCOMPARE(m_sender.hasGroupKey(0x0802), false);
+
+        m_sender.wrap(tpdu, m_source, QKnxAddress::createIndividual(1, 1, 2), {}, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Unsupported);
+
+        auto bytes = m_sender.wrap(tpdu, m_source, m_destination).bytes();
+        bytes.set(9, bytes.at(9) ^ 0x01);
+        const auto tampered = QKnxTpdu::fromBytes(bytes, 0, bytes.size());
+        QCOMPARE(m_receiver.unwrap(tampered, m_source, m_destination, &status).size(), quint16(0));
+        QCOMPARE(status, QKnxDataSecureLayer::Status::AuthenticationFailed);
+
+        // a failed authentication must not advance the replay window
+        QCOMPARE(m_receiver.lastSequenceNumber(m_source), quint48(0));
+
+        // the source address takes part in the authentication
+        const auto secured = m_sender.wrap(tpdu, m_source, m_destination);
+        m_receiver.unwrap(secured, QKnxAddress::createIndividual(1, 1, 3), m_destination, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::AuthenticationFailed);
+    }
+
+    void testLinkLayerFrame()
+    {
+        const auto frame = QKnxLinkLayerFrame::builder()
+            .setMessageCode(QKnxLinkLayerFrame::MessageCode::DataIndication)
+            .setSourceAddress(m_source)
+            .setDestinationAddress(m_destination)
+            .setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x0c, 0x65 }))
+            .createFrame();
+
+        auto status = QKnxDataSecureLayer::Status::InvalidFrame;
+        const auto secured = m_sender.wrap(frame, {}, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+        QCOMPARE(secured.tpdu().applicationControlField(),
+            QKnxTpdu::ApplicationControlField::SecureService);
+        QCOMPARE(secured.controlField().frameFormat(), QKnxControlField::FrameFormat::Extended);
+
+        const auto plain = m_receiver.unwrap(secured, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+        QCOMPARE(plain.tpdu(), frame.tpdu());
+        QCOMPARE(plain.sourceAddress(), frame.sourceAddress());
+    }
+
+    void testReplayWindow()
+    {
+        QKnxReplayWindow window;
+        QCOMPARE(window.isEmpty(), true);
+        QCOMPARE(window.accept(10), true);
+        QCOMPARE(window.accept(10), false);
+        QCOMPARE(window.accept(8), true); // late, but inside the window
+        QCOMPARE(window.accept(8), false);
+
+        QCOMPARE(window.accept(100), true);
+        QCOMPARE(window.highest(), quint48(100));
+        QCOMPARE(window.check(36), false); // older than the window
+        QCOMPARE(window.check(37), true);
+        QCOMPARE(window.accept(99), true);
+        QCOMPARE(window.check(99), false);
+
+        window.restore(50);
+        QCOMPARE(window.check(50), false);
+        QCOMPARE(window.check(20), false);
+        QCOMPARE(window.accept(51), true);
+        QCOMPARE(window.check(Q_UINT48_MAX + 1), false);
+
+        // out of order delivery within the window is accepted by the layer
+        const auto tpdu = QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 });
+        const auto first = m_sender.wrap(tpdu, m_source, m_destination);
+        const auto second = m_sender.wrap(tpdu, m_source, m_destination);
+
+        auto status = QKnxDataSecureLayer::Status::InvalidFrame;
+        m_receiver.unwrap(second, m_source, m_destination, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+        m_receiver.unwrap(first, m_source, m_destination, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+        m_receiver.unwrap(first, m_source, m_destination, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Replayed);
+    }
+
+    void testSequenceNumberStore()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const auto path = dir.filePath(QStringLiteral("sequence.dat"));
+
+        {
+            QKnxSequenceNumberStore store(path);
+            store.setReservation(100);
+            QCOMPARE(store.load(), false);
+
+            QCOMPARE(store.reserve("tx", 0), true);
+            QCOMPARE(QFile::exists(path), true);
+            QCOMPARE(store.restoredSequenceNumber("tx"), quint48(100));
+
+            // numbers below the reservation do not touch the file
+            QFile::remove(path);
+            QCOMPARE(store.reserve("tx", 99), true);
+            QCOMPARE(QFile::exists(path), false);
+            QCOMPARE(store.reserve("tx", 100), true);
+            QCOMPARE(QFile::exists(path), true);
+            QCOMPARE(store.restoredSequenceNumber("tx"), quint48(200));
+
+            store.setHighWaterMark("rx", 42);
+            QCOMPARE(store.isDirty(), true);
+        } // the destructor writes the pending high-water mark
+
+        QKnxSequenceNumberStore store(path);
+        QCOMPARE(store.load(), true);
+        QCOMPARE(store.restoredSequenceNumber("tx"), quint48(200));
+        qint64 timestamp = 0;
+        QCOMPARE(store.highWaterMark("rx", &timestamp), quint48(42));
+        QVERIFY(timestamp > 0);
+
+        // the layer continues behind the restored reservation
+        QKnxDataSecureLayer layer;
+        layer.setGroupKey(m_group, m_key);
+        layer.setSequenceNumberStore(&store);
+        QCOMPARE(layer.sequenceNumber(), quint48(0));
+        const auto tpdu = QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 });
+        QCOMPARE(layer.wrap(tpdu, m_source, m_destination).size(), quint16(15));
+        QCOMPARE(store.restoredSequenceNumber("data-secure/tx"), quint48(1024));
+
+        QKnxSequenceNumberStore restarted(path);
+        QCOMPARE(restarted.load(), true);
+        layer.setSequenceNumberStore(&restarted);
+        QCOMPARE(layer.sequenceNumber(), quint48(1024));
+        layer.setSequenceNumberStore(nullptr);
+
+        // a damaged file is rejected as a whole
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        file.seek(8);
+        file.write("x", 1);
+        file.close();
+        QCOMPARE(QKnxSequenceNumberStore(path).load(), false);
+    }
+
+    void testSequenceNumberStoreCrash()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const auto path = dir.filePath(QStringLiteral("sequence.dat"));
+
+        const auto tpdu = QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 });
+        QVector<QKnxTpdu> frames;
+        for (int i = 0; i < 5; ++i)
+            frames.append(m_sender.wrap(tpdu, m_source, m_destination)); // sequence 5 to 9
+
+        auto status = QKnxDataSecureLayer::Status::InvalidFrame;
+        QByteArray crashed;
+        {
+            QKnxSequenceNumberStore store(path);
+            store.setMaxPendingUpdates(3);
+            store.setMaxPendingMsecs(60 * 1000);
+
+            QKnxDataSecureLayer layer;
+            layer.setGroupKey(m_group, m_key);
+            layer.setSequenceNumberStore(&store);
+
+            // the first update after a quiet period is written at once, the following
+            // ones as soon as three of them are pending
+            layer.unwrap(frames.at(0), m_source, m_destination, &status);
+            QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+            QCOMPARE(store.isDirty(), false);
+            layer.unwrap(frames.at(1), m_source, m_destination, &status);
+            layer.unwrap(frames.at(2), m_source, m_destination, &status);
+            QCOMPARE(store.isDirty(), true);
+            layer.unwrap(frames.at(3), m_source, m_destination, &status);
+            QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+            QCOMPARE(store.isDirty(), false);
+
+            // keep what is on disk now, as if the process died without a clean shutdown
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            crashed = file.readAll();
+            layer.setSequenceNumberStore(nullptr);
+        }
+        {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            QCOMPARE(file.write(crashed), qint64(crashed.size()));
+        }
+
+        QKnxSequenceNumberStore restarted(path);
+        QCOMPARE(restarted.load(), true);
+        QKnxDataSecureLayer layer;
+        layer.setGroupKey(m_group, m_key);
+        layer.setSequenceNumberStore(&restarted);
+
+        QCOMPARE(layer.unwrap(frames.at(3), m_source, m_destination, &status).size(), quint16(0));
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Replayed);
+        layer.unwrap(frames.at(0), m_source, m_destination, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Replayed);
+        layer.unwrap(frames.at(4), m_source, m_destination, &status);
+        QCOMPARE(status, QKnxDataSecureLayer::Status::Ok);
+        layer.setSequenceNumberStore(nullptr);
+    }
+
+private:
+    const quint16 m_group { 0x0801 };
+    const QKnxByteArray m_key { QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f") };
+    const QKnxAddress m_source { QKnxAddress::createIndividual(1, 1, 1) };
+    const QKnxAddress m_destination { QKnxAddress::Type::Group, 0x0801 };
+
+    QKnxDataSecureLayer m_sender;
+    QKnxDataSecureLayer m_receiver;
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxDataSecureLayer)
+
+#include "tst_qknxdatasecurelayer.moc"
@@ -0,0 +1,193 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qtemporaryfile.h>
+#include <QtKnx/qknxcryptographicengine.h>
+#include <QtKnx/private/qknxkeyring_p.h>
+#include <QtKnx/private/qknxkeyringstore_p.h>
+#include <QtTest/qtest.h>
+
+using namespace QKnx::Ets::Keyring;
+
+static const char keyring[] = R"(<?xml version="1.0" encoding="utf-8"?>
+<Keyring Project="Test" CreatedBy="ETS 5.7" Created="2019-06-01T12:00:00" Signature="%1" xmlns="http://knx.org/xml/keyring/1">
+  <Backbone MulticastAddress="%2" Latency="1000" Key="AAECAwQFBgcICQoLDA0ODw==" />
+  <Interface Type="Tunneling" Host="1.1.0" IndividualAddress="1.1.250" UserID="2">
+    <Group Address="2049" Senders="1.1.1 1.1.2" />
+  </Interface>
+  <GroupAddresses>
+    <Group Address="2049" Key="AAECAwQFBgcICQoLDA0ODw==" />
+  </GroupAddresses>
+  <Devices>
+    <Device IndividualAddress="1.1.1" ToolKey="AAECAwQFBgcICQoLDA0ODw==" SequenceNumber="5" />
+  </Devices>
+</Keyring>
+)";
+
+class tst_QKnxKeyring : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        m_pwHash = QKnxCryptographicEngine::keyringPasswordHash("pwd");
+    }
+
+    void testLoad()
+    {
+        QTemporaryFile file;
+        QVERIFY(writeKeyring(&file));
+
+        QKnxKeyring ring;
+        QCOMPARE(ring.load(file.fileName(), m_pwHash, true), true);
+
+        QCOMPARE(ring.Project, QStringLiteral("Test"));
+        QCOMPARE(ring.Created, QStringLiteral("2019-06-01T12:00:00"));
+        QCOMPARE(ring.Backbone.size(), 1);
+        QCOMPARE(ring.Backbone.value(0).MulticastAddress, QStringLiteral("224.0.23.12"));
+        QCOMPARE(ring.Backbone.value(0).Latency, quint16(1000));
+        QCOMPARE(ring.Interface.size(), 1);
+        QCOMPARE(ring.Interface.value(0).IndividualAddress, QStringLiteral("1.1.250"));
+        QCOMPARE(ring.Interface.value(0).Group.value(0).Senders.size(), 2);
+        QCOMPARE(ring.GroupAddresses.value(0).Group.value(0).Address, quint16(2049));
+        QCOMPARE(ring.Devices.value(0).Device.value(0).SequenceNumber, quint48(5));
+
+        QFile input(file.fileName());
+        QVERIFY(input.open(QIODevice::ReadOnly));
+        QXmlStreamReader reader(&input);
+        QCOMPARE(ring.validate(&reader, m_pwHash), true);
+    }
+
+    void testSignatureMismatch()
+    {
+        QTemporaryFile file;
+        QVERIFY(writeKeyring(&file));
+
+        QKnxKeyring ring;
+        QCOMPARE(ring.load(file.fileName(),
+            QKnxCryptographicEngine::keyringPasswordHash("wrong"), true), false);
+        QCOMPARE(QKnxKeyring().load(file.fileName(),
+            QKnxCryptographicEngine::keyringPasswordHash("wrong"), false), true);
+
+        QTemporaryFile tampered;
+        QVERIFY(writeKeyring(&tampered, "224.0.23.13"));
+        QCOMPARE(QKnxKeyring().load(tampered.fileName(), m_pwHash, true), false);
+    }
+
+    void testPedanticChecks_data()
+    {
+        QTest::addColumn<QString>("multicastAddress");
+        QTest::addColumn<bool>("valid");
+
+        QTest::newRow("239.255.255.255") << QStringLiteral("239.255.255.255") << true;
+        QTest::newRow("223.0.23.12") << QStringLiteral("223.0.23.12") << false;
+        QTest::newRow("224.0.23.256") << QStringLiteral("224.0.23.256") << false;
+        QTest::newRow("224.00.23.12") << QStringLiteral("224.00.23.12") << false;
+        QTest::newRow("224.0.23") << QStringLiteral("224.0.23") << false;
+        QTest::newRow("224.0.23.x") << QStringLiteral("224.0.23.x") << false;
+    }
+
+    void testPedanticChecks()
+    {
+        QFETCH(QString, multicastAddress);
+        QFETCH(bool, valid);
+
+        QTemporaryFile file;
+        QVERIFY(writeKeyring(&file, multicastAddress));
+        QCOMPARE(QKnxKeyring().load(file.fileName(), m_pwHash, false), valid);
+    }
+
+    void testStore()
+    {
+        QTemporaryFile file;
+        QVERIFY(writeKeyring(&file));
+
+        QKnxKeyringStore store;
+        QCOMPARE(store.isEmpty(), true);
+        QCOMPARE(store.load(file.fileName(), "wrong", true), false);
+        QCOMPARE(store.isEmpty(), true);
+
+        QVERIFY(store.load(file.fileName(), "pwd", true));
+        QCOMPARE(store.isEmpty(), false);
+        QCOMPARE(store.groupAddresses(), QVector<quint16>({ 2049 }));
+        QCOMPARE(store.hasGroupKey(2049), true);
+        QCOMPARE(store.hasGroupKey(2050), false);
+        QCOMPARE(store.groupKey(2050), QKnxByteArray());
+
+        // 0x1101 -> 1.1.1, 0x11fa -> 1.1.250
+        QCOMPARE(store.interfaceAddresses(), QVector<quint16>({ 0x11fa }));
+        QVERIFY(store.findInterface(0x11fa));
+        QCOMPARE(store.findInterface(0x11fa)->UserID, quint8(2));
+        QVERIFY(!store.findInterface(0x1101));
+        QCOMPARE(store.interfaceUserPassword(0x11fa), QKnxByteArray());
+
+        QCOMPARE(store.deviceAddresses(), QVector<quint16>({ 0x1101 }));
+        QVERIFY(store.findDevice(0x1101));
+        QCOMPARE(store.findDevice(0x1101)->SequenceNumber, quint48(5));
+        QVERIFY(!store.findDevice(0x11fa));
+
+        if (QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL)
+            QSKIP("OpenSSL 1.1 is not available.");
+
+        const auto key = QKnxByteArray::fromHex("8c760fc84a07cc860b4a98f50ce0f4d8");
+        QCOMPARE(store.backboneKey(), key);
+        QCOMPARE(store.groupKey(2049), key);
+        QCOMPARE(store.groupKey({ QKnxAddress::Type::Group, 2049 }), key);
+        QCOMPARE(store.groupKey({ QKnxAddress::Type::Individual, 2049 }), QKnxByteArray());
+        QCOMPARE(store.deviceToolKey(0x1101), key);
+        QCOMPARE(store.deviceToolKey({ QKnxAddress::Type::Individual, QStringLiteral("1.1.1") }), key);
+
+        // a second lookup is served from the cache
+        QCOMPARE(store.groupKey(2049), key);
+
+        store.clear();
+        QCOMPARE(store.isEmpty(), true);
+        QCOMPARE(store.groupKey(2049), QKnxByteArray());
+    }
+
+private:
+    bool writeKeyring(QTemporaryFile *file,
+        const QString &multicastAddress = QStringLiteral("224.0.23.12"))
+    {
+        if (!file->open())
+            return false;
+        const auto content = QString::fromUtf8(keyring)
+            .arg(QStringLiteral("k2kJlgk6H3msUW+REJgWAA=="), multicastAddress);
+        file->write(content.toUtf8());
+        file->close();
+        return true;
+    }
+
+    QKnxByteArray m_pwHash;
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxKeyring)
+
+#include "tst_qknxkeyring.moc"
@@ -27,6 +27,7 @@
 **
 ******************************************************************************/
 
+#include <QtKnx/qknxcryptographicengine.h>
 #include <QtKnx/qknxnetipframe.h>
 #include <QtKnx/qknxlinklayerframebuilder.h>
 #include <QtKnx/qknxnetiprouter.h>
@@ -35,16 +36,23 @@
 #include <QtKnx/qknxnetiproutinglostmessage.h>
 #include <QtKnx/qknxnetiproutingsystembroadcast.h>
 
+#include <QtKnx/private/qknxccmcontext_p.h>
 #include <QtKnx/private/qknxnetiprouter_p.h>
+#include <QtKnx/private/qknxnetiprouterstatistics_p.h>
+#include <QtKnx/private/qknxnetipsendqueue_p.h>
+#include <QtKnx/private/qknxsequencenumberstore_p.h>
 #include <QtKnx/private/qknxnetiptestrouter_p.h>
 #include <QtKnx/private/qknxtpdufactory_p.h>
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qtemporarydir.h>
 #include <QtNetwork/qnetworkdatagram.h>
 #include <QtNetwork/qnetworkinterface.h>
 #include <QtNetwork/qudpsocket.h>
 #include <QtTest>
 
+#include <numeric>
+
 Q_DECLARE_METATYPE(QKnxAddress)
 
 #ifdef QT_BUILD_INTERNAL
@@ -62,11 +70,17 @@ private slots:
     void test_udp_sockets();
     void test_network_interface();
     void test_multicast_address();
+    void test_multicast_addresses();
+    void test_network_interfaces();
+    void test_secure_backbone();
     void test_routing();
     void test_routing_sends_indications();
     void test_routing_receives_indications();
     void test_routing_receives_busy();
+    void test_statistics();
+    void test_send_queue();
     void test_routing_busy_sent_packets_same_individual_address();
+    void test_routing_busy_secure_packets_same_individual_address();
     void test_routing_interface_sends_system_broadcast();
     void test_routing_interface_receives_system_broadcast();
     void test_routing_filter();
@@ -196,6 +210,79 @@ void tst_QKnxNetIpRouter::test_multicast_address()
     }
 }
 
+void tst_QKnxNetIpRouter::test_multicast_addresses()
+{
+    if (!runTests)
+        return;
+
+    {
+        // default multicast address list
+        QKnxNetIpRouter router;
+        QCOMPARE(router.multicastAddresses(), QList<QHostAddress>({ kMulticastAddress }));
+    }
+    {
+        // setting an invalid multicast address list shouldn't work
+        QKnxNetIpRouter router;
+        router.setMulticastAddresses({ QHostAddress("224.0.55.55"),
+            QHostAddress(QHostAddress::LocalHost) });
+        QCOMPARE(router.multicastAddresses(), QList<QHostAddress>({ kMulticastAddress }));
+
+        router.setMulticastAddresses({});
+        QCOMPARE(router.multicastAddresses(), QList<QHostAddress>({ kMulticastAddress }));
+    }
+    {
+        // setting and adding valid multicast addresses, duplicates are ignored
+        QKnxNetIpRouter router;
+        auto first = QHostAddress("224.0.55.55");
+        auto second = QHostAddress("224.0.55.56");
+        router.setMulticastAddresses({ first, first, second });
+        QCOMPARE(router.multicastAddresses(), QList<QHostAddress>({ first, second }));
+        QCOMPARE(router.multicastAddress(), first);
+
+        router.addMulticastAddress(kMulticastAddress);
+        router.addMulticastAddress(second);
+        QCOMPARE(router.multicastAddresses(),
+            QList<QHostAddress>({ first, second, kMulticastAddress }));
+
+        // the single address setter replaces the whole list
+        router.setMulticastAddress(second);
+        QCOMPARE(router.multicastAddresses(), QList<QHostAddress>({ second }));
+    }
+}
+
+void tst_QKnxNetIpRouter::test_network_interfaces()
+{
+    if (!runTests)
+        return;
+
+    QKnxNetIpRouter router;
+    QVERIFY(router.interfaceAffinities().isEmpty());
+
+    router.setInterfaceAffinities({ kIface, kIface });
+    QCOMPARE(router.interfaceAffinities().size(), 1);
+    QCOMPARE(router.interfaceAffinity().index(), kIface.index());
+
+    router.addInterfaceAffinity(kIface);
+    QCOMPARE(router.interfaceAffinities().size(), 1);
+
+    bool errorEmitted = false;
+    QObject::connect(&router, &QKnxNetIpRouter::errorOccurred,
+        [&](QKnxNetIpRouter::Error error, QString) {
+        QCOMPARE(error, QKnxNetIpRouter::Error::Network);
+        errorEmitted = true;
+    });
+
+    // an invalid interface leaves the list untouched
+    router.setInterfaceAffinities({ kIface, QNetworkInterface() });
+    QVERIFY(errorEmitted);
+    QCOMPARE(router.interfaceAffinities().size(), 1);
+
+    errorEmitted = false;
+    router.addInterfaceAffinity(QNetworkInterface());
+    QVERIFY(errorEmitted);
+    QCOMPARE(router.interfaceAffinities().size(), 1);
+}
+
 void tst_QKnxNetIpRouter::test_udp_sockets()
 {
     if (!runTests)
@@ -252,6 +339,75 @@ void tst_QKnxNetIpRouter::simulateFramesReceived(const QKnxNetIpFrame &netIpFram
     s->deleteLater();
 }
 
+void tst_QKnxNetIpRouter::test_secure_backbone()
+{
+    if (!runTests)
+        return;
+
+    QKnxNetIpRouter router;
+    QCOMPARE(router.backboneKey(), QKnxByteArray());
+    QCOMPARE(router.serialNumber(), QKnxByteArray(6, 0x00));
+    QCOMPARE(router.latencyTolerance(), quint16(2000));
+
+    // only six byte serial numbers and tolerances up to 8000 ms are accepted
+    router.setSerialNumber(QKnxByteArray::fromHex("00fa1234"));
+    QCOMPARE(router.serialNumber(), QKnxByteArray(6, 0x00));
+    router.setSerialNumber(QKnxByteArray::fromHex("00fa12345678"));
+    QCOMPARE(router.serialNumber(), QKnxByteArray::fromHex("00fa12345678"));
+
+    router.setLatencyTolerance(8001);
+    QCOMPARE(router.latencyTolerance(), quint16(2000));
+    router.setLatencyTolerance(1000);
+    QCOMPARE(router.latencyTolerance(), quint16(1000));
+
+    bool errorEmitted = false;
+    QObject::connect(&router, &QKnxNetIpRouter::errorOccurred,
+        [&](QKnxNetIpRouter::Error error, QString) {
+        QCOMPARE(error, QKnxNetIpRouter::Error::KnxRouting);
+        errorEmitted = true;
+    });
+    router.setBackboneKey(QKnxByteArray::fromHex("0001020304"));
+    QVERIFY(errorEmitted);
+    QCOMPARE(router.backboneKey(), QKnxByteArray());
+
+    QVERIFY(!router.setBackboneFromKeyring(QStringLiteral("does-not-exist.knxkeys"),
+        "secret", true));
+
+    // the multicast timer only ever moves forward, stale values are rejected
+    auto d = static_cast<QKnxNetIpRouterPrivate *>(QObjectPrivate::get(&router));
+    d->setTimerValue(100000);
+    QVERIFY(d->checkTimerValue(200000, router.serialNumber(), 0x0000));
+    QVERIFY(router.timerValue() >= 200000);
+    QVERIFY(d->checkTimerValue(router.timerValue() - 500, router.serialNumber(), 0x0000));
+    QVERIFY(!d->checkTimerValue(router.timerValue() - 1500, router.serialNumber(), 0x0000));
+
+    // a persisted timer value is resumed, including the time that passed since
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto path = dir.filePath(QStringLiteral("timer.dat"));
+    {
+        QKnxSequenceNumberStore store(path);
+        store.setHighWaterMark("routing/timer", 5000000);
+    }
+    QCOMPARE(router.timerStateFile(), QString());
+    router.setTimerStateFile(path);
+    QCOMPARE(router.timerStateFile(), path);
+    d->restoreTimerValue();
+    QVERIFY(router.timerValue() >= 5000000);
+    router.setTimerStateFile({});
+    QCOMPARE(router.timerStateFile(), QString());
+
+    if (QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL)
+        return;
+
+    auto key = QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f");
+    router.setBackboneKey(key);
+    QCOMPARE(router.backboneKey(), key);
+
+    router.setBackboneKey({});
+    QCOMPARE(router.backboneKey(), QKnxByteArray());
+}
+
 void tst_QKnxNetIpRouter::test_routing()
 {
     if (!runTests)
@@ -346,8 +502,19 @@ void tst_QKnxNetIpRouter::test_routing_receives_indications()
             QVERIFY(indicationRcv.isValid());
             QCOMPARE(routingAction, QKnxNetIpRouter::FilterAction::RouteDecremented);
     });
+
+    bool ingressIndicationRcvEmitted = false;
+    QObject::connect(&m_router, &QKnxNetIpRouter::routingIndicationReceivedOnInterface,
+        [&](QKnxNetIpFrame frame, QKnxNetIpRouter::FilterAction routingAction,
+            QNetworkInterface) {
+            ingressIndicationRcvEmitted = true;
+            QVERIFY(QKnxNetIpRoutingIndicationProxy(frame).isValid());
+            QCOMPARE(routingAction, QKnxNetIpRouter::FilterAction::RouteDecremented);
+    });
+
     simulateFramesReceived(dummyRoutingIndication(QKnxAddress::createIndividual(1, 1, 1)));
     QVERIFY(indicationRcvEmitted);
+    QVERIFY(ingressIndicationRcvEmitted);
 }
 
 void tst_QKnxNetIpRouter::test_routing_receives_busy()
@@ -374,6 +541,118 @@ void tst_QKnxNetIpRouter::test_routing_receives_busy()
     QVERIFY(indicationRcvEmitted);
 }
 
+void tst_QKnxNetIpRouter::test_statistics()
+{
+    if (!runTests)
+        return;
+
+    {
+        // live counters and snapshots without network traffic
+        QKnxNetIpRouterCounters counters;
+        const QHostAddress peer("10.0.0.1");
+        for (int i = 0; i < 4; ++i)
+            counters.frameArrived(peer);
+        counters.frameArrived(QHostAddress("10.0.0.2"));
+        counters.add(QKnxNetIpRouterStatisticsPrivate::LostMessages, 3);
+
+        auto statistics = counters.snapshot();
+        QCOMPARE(statistics.lostMessages(), quint64(3));
+        QCOMPARE(statistics.peers().size(), 2);
+        QCOMPARE(statistics.framesReceived(peer), quint64(4));
+        QCOMPARE(statistics.framesReceived(QHostAddress("10.0.0.3")), quint64(0));
+
+        const auto histogram = statistics.interArrivalHistogram(peer);
+        QCOMPARE(histogram.size(),
+            QKnxNetIpRouterStatistics::interArrivalBucketBounds().size() + 1);
+        QCOMPARE(std::accumulate(histogram.cbegin(), histogram.cend(), quint64(0)), quint64(3));
+
+        counters.reset();
+        statistics = counters.snapshot();
+        QCOMPARE(statistics.lostMessages(), quint64(0));
+        QVERIFY(statistics.peers().isEmpty());
+    }
+
+    m_router.start();
+    m_router.resetStatistics();
+
+    auto routingBusyFrame = QKnxNetIpRoutingBusyProxy::builder()
+        .setDeviceState(QKnxNetIp::DeviceState::IpFault)
+        .setRoutingBusyWaitTime(50)
+        .setRoutingBusyControl(0)
+        .create();
+    simulateFramesReceived(routingBusyFrame);
+
+    auto lostMessageFrame = QKnxNetIpRoutingLostMessageProxy::builder()
+        .setDeviceState(QKnxNetIp::DeviceState::IpFault)
+        .setLostMessageCount(5)
+        .create();
+    simulateFramesReceived(lostMessageFrame);
+
+    const auto statistics = m_router.statistics();
+    QCOMPARE(statistics.framesReceived(), quint64(2));
+    QCOMPARE(statistics.routingBusyReceived(), quint64(1));
+    QCOMPARE(statistics.lostMessages(), quint64(5));
+    QCOMPARE(statistics.framesDiscardedMalformed(), quint64(0));
+    QCOMPARE(statistics.peers().size(), 1);
+}
+
+void tst_QKnxNetIpRouter::test_send_queue()
+{
+    using Priority = QKnxControlField::Priority;
+
+    QKnxNetIpSendQueue<int> queue;
+    QCOMPARE(queue.enqueue(Priority::Normal, 1), false); // disabled by default
+
+    queue.setCapacity(8);
+    QCOMPARE(queue.enqueue(Priority::Low, 1), true);
+    QCOMPARE(queue.enqueue(Priority::Normal, 2), true);
+    QCOMPARE(queue.enqueue(Priority::Urgent, 3), true);
+    QCOMPARE(queue.enqueue(Priority::System, 4), true);
+    QCOMPARE(queue.size(), 4);
+
+    QCOMPARE(queue.head(), 4);
+    QCOMPARE(queue.size(), 4);
+    QCOMPARE(queue.dequeue(), 4);
+    QCOMPARE(queue.dequeue(), 3);
+    QCOMPARE(queue.dequeue(), 2);
+    QCOMPARE(queue.dequeue(), 1);
+    QVERIFY(queue.isEmpty());
+
+    // normal and low priority share the bandwidth 3:1
+    for (int i = 0; i < 4; ++i)
+        queue.enqueue(Priority::Normal, 10 + i);
+    for (int i = 0; i < 2; ++i)
+        queue.enqueue(Priority::Low, 20 + i);
+    QVector<int> order;
+    while (!queue.isEmpty())
+        order.append(queue.dequeue());
+    QCOMPARE(order, QVector<int>({ 10, 11, 12, 20, 13, 21 }));
+
+    // a full queue drops the newest low priority frame for an urgent one
+    queue.setCapacity(2);
+    queue.enqueue(Priority::Low, 1);
+    queue.enqueue(Priority::Low, 2);
+    QCOMPARE(queue.dropped(), quint64(0));
+    QCOMPARE(queue.enqueue(Priority::Low, 3), false);
+    QCOMPARE(queue.dropped(), quint64(1));
+    QCOMPARE(queue.enqueue(Priority::Urgent, 4), true);
+    QCOMPARE(queue.dropped(), quint64(2)); // the evicted low priority frame
+    QCOMPARE(queue.dequeue(), 4);
+    QCOMPARE(queue.dequeue(), 1);
+    QVERIFY(queue.isEmpty());
+
+    // low priority frames are not starved by a constant urgent stream
+    queue.setCapacity(64);
+    queue.enqueue(Priority::Low, 0);
+    int served = 0;
+    for (; served < 64; ++served) {
+        queue.enqueue(Priority::Urgent, 1);
+        if (queue.dequeue() == 0)
+            break;
+    }
+    QVERIFY(served <= QKnxNetIpSendQueue<int>::StarvationLimit);
+}
+
 void tst_QKnxNetIpRouter::test_routing_busy_sent_packets_same_individual_address()
 {
     if (!runTests)
@@ -402,6 +681,43 @@ void tst_QKnxNetIpRouter::test_routing_busy_sent_packets_same_individual_address
     QCOMPARE(m_router.state(), QKnxNetIpRouter::State::NeighborBusy);
 }
 
+void tst_QKnxNetIpRouter::test_routing_busy_secure_packets_same_individual_address()
+{
+    if (!runTests)
+        return;
+
+    if (QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL)
+        return;
+
+    const auto key = QKnxByteArray::fromHex("000102030405060708090a0b0c0d0e0f");
+    m_router.setBackboneKey(key);
+    m_router.start();
+
+    int indRecvCount = 0;
+    QObject::connect(&m_router, &QKnxNetIpRouter::routingIndicationReceived,
+        [&](QKnxNetIpFrame frame, QKnxNetIpRouter::FilterAction) {
+            QVERIFY(QKnxNetIpRoutingIndicationProxy(frame).isValid());
+            indRecvCount++;
+    });
+
+    const auto indication = dummyRoutingIndication(QKnxAddress::createIndividual(1, 1, 1));
+    const auto secureFrame = QKnxCcmContext(key).wrap(indication, 0x0000, m_router.timerValue(),
+        QKnxByteArray::fromHex("00fa12345678"), 0x0000);
+    simulateFramesReceived(secureFrame, 7);
+
+    // authenticated indications count towards the flow control limit before the
+    // next packet is read, the 7th packet is ignored just like on a plain backbone
+    QCOMPARE(indRecvCount, 6);
+
+    QCOMPARE(QKnxNetIpTestRouter::instance()->routerInstance()->m_framesReadCount, 6);
+    QCOMPARE(QKnxNetIpTestRouter::instance()->routerInstance()->m_sameKnxDstAddressIndicationCount, 5);
+
+    QCOMPARE(m_router.state(), QKnxNetIpRouter::State::NeighborBusy);
+
+    m_router.stop();
+    m_router.setBackboneKey({});
+}
+
 QKnxLinkLayerFrame generateDummySbcFrame()
 {
     auto dst = QKnxAddress::createGroup(1, 1, 1);
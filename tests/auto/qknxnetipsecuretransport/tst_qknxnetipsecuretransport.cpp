@@ -0,0 +1,357 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qvector.h>
+#include <QtKnx/qknxcryptographicengine.h>
+#include <QtKnx/qknxlinklayerframebuilder.h>
+#include <QtKnx/qknxnetipconnectresponse.h>
+#include <QtKnx/qknxnetipcrd.h>
+#include <QtKnx/qknxnetipframe.h>
+#include <QtKnx/qknxnetiphpai.h>
+#include <QtKnx/qknxnetipsecureconfiguration.h>
+#include <QtKnx/qknxnetipsecurewrapper.h>
+#include <QtKnx/qknxnetipsecuretransport.h>
+#include <QtKnx/qknxnetipsessionauthenticate.h>
+#include <QtKnx/qknxnetipsessionrequest.h>
+#include <QtKnx/qknxnetipsessionresponse.h>
+#include <QtKnx/qknxnetipsessionstatus.h>
+#include <QtKnx/qknxnetiptunnel.h>
+#include <QtKnx/qknxnetiptunnelingrequest.h>
+#include <QtKnx/private/qknxccmcontext_p.h>
+#include <QtKnx/private/qknxnetipsecurehandshake_p.h>
+#include <QtKnx/private/qknxtpdufactory_p.h>
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxNetIpSecureTransport : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDefaultConstructor()
+    {
+        QKnxNetIpSecureTransport transport;
+        QCOMPARE(transport.isConnected(), false);
+        QCOMPARE(transport.remoteAddress(), QHostAddress());
+        QCOMPARE(transport.remotePort(), quint16(0));
+        QCOMPARE(transport.sessionCount(), 0);
+        QCOMPARE(transport.connectionCount(), 0);
+
+        QKnxNetIpTunnel tunnel;
+        QVERIFY(!tunnel.secureTransport());
+        tunnel.setSecureTransport(&transport);
+        QCOMPARE(tunnel.secureTransport(), &transport);
+
+        // a transport can only be used by secure connections
+        tunnel.connectToHost(QHostAddress::LocalHost, 3671, QKnxNetIp::HostProtocol::TCP_IPv4);
+        QCOMPARE(tunnel.error(), QKnxNetIpEndpointConnection::Error::Network);
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Disconnected);
+        QCOMPARE(transport.connectionCount(), 0);
+    }
+
+    void testHandshake()
+    {
+        if (QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010101fL)
+            QSKIP("OpenSSL 1.1.1 is not available.");
+
+        QKnxNetIpSecureConfiguration config;
+        config.setPrivateKey(QKnxSecureKey::fromBytes(QKnxSecureKey::Type::Private,
+            QKnxByteArray::fromHex("b8fabd62665d8b9e8a9d8b1f4bca42c8"
+                "c2789a6110f50e9dd785b3ede883f378")));
+        config.setUserId(QKnxNetIp::SecureUserId::Management);
+        config.setUserPassword("secret");
+        config.setDeviceAuthenticationCode("trustme");
+
+        const auto serverPublicKey = QKnxByteArray::fromHex("bdf099909923143ef0a5de0b3be3687b"
+            "c5bd3cf5f9e6f901699cd870ec1ff824");
+        const auto response = QKnxNetIpSessionResponseProxy::secureBuilder()
+            .setSecureSessionId(0x0001)
+            .setPublicKey(serverPublicKey)
+            .create("trustme", config.publicKey().bytes());
+
+        auto result = QKnxNetIpSecureHandshake::process(config, response);
+        QCOMPARE(result.isValid(), true);
+        QCOMPARE(result.sessionId, quint16(0x0001));
+        QCOMPARE(result.sessionKey, QKnxByteArray::fromHex("289426c2912535ba98279a4d1843c487"));
+        const QKnxNetIpSessionAuthenticateProxy authenticate(result.sessionAuthenticate);
+        QCOMPARE(authenticate.messageAuthenticationCode(),
+            QKnxByteArray::fromHex("1f1d59ea9f12a152e5d9727f08462cde"));
+
+        // a response authenticated with a different device code is rejected
+        auto forged = QKnxNetIpSessionResponseProxy::secureBuilder()
+            .setSecureSessionId(0x0001)
+            .setPublicKey(serverPublicKey)
+            .create("guessed", config.publicKey().bytes());
+        QCOMPARE(QKnxNetIpSecureHandshake::process(config, forged).isValid(), false);
+
+        // the asynchronous variant delivers the same result on this thread
+        QKnxNetIpSecureHandshake handshake;
+        int calls = 0;
+        connect(&handshake, &QKnxNetIpSecureHandshake::finished, this,
+            [&](const QKnxNetIpSecureHandshake::Result &asyncResult) {
+                ++calls;
+                result = asyncResult;
+        });
+
+        handshake.start(config, forged);
+        handshake.cancel();
+        handshake.start(config, response);
+        QCOMPARE(handshake.isRunning(), true);
+        QTRY_COMPARE(calls, 1);
+        QCOMPARE(handshake.isRunning(), false);
+        QCOMPARE(result.sessionKey, QKnxByteArray::fromHex("289426c2912535ba98279a4d1843c487"));
+
+        // a canceled step never reports back
+        handshake.start(config, response);
+        handshake.cancel();
+        QTest::qWait(200);
+        QCOMPARE(calls, 1);
+    }
+
+    void testSessionSharing()
+    {
+        if (QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL)
+            QSKIP("OpenSSL 1.1 is not available.");
+
+        QTcpServer server;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        QKnxNetIpSecureTransport transport;
+        QKnxNetIpTunnel first, second, third;
+        for (auto tunnel : { &first, &second, &third })
+            tunnel->setSecureTransport(&transport);
+
+        first.setSecureConfiguration(config("user password"));
+        second.setSecureConfiguration(config("user password"));
+        third.setSecureConfiguration(config("other password"));
+
+        first.connectToHostEncrypted(QHostAddress::LocalHost, server.serverPort());
+        second.connectToHostEncrypted(QHostAddress::LocalHost, server.serverPort());
+        third.connectToHostEncrypted(QHostAddress::LocalHost, server.serverPort());
+
+        // the first two tunnels use the same credentials and share a session
+        QCOMPARE(transport.connectionCount(), 3);
+        QCOMPARE(transport.sessionCount(), 2);
+        QCOMPARE(transport.remoteAddress(), QHostAddress(QHostAddress::LocalHost));
+        QCOMPARE(transport.remotePort(), server.serverPort());
+
+        QVERIFY(server.waitForNewConnection(5000));
+        QScopedPointer<QTcpSocket> peer(server.nextPendingConnection());
+        QTRY_VERIFY(transport.isConnected());
+
+        // only one session request is outstanding at a time
+        QTRY_VERIFY(peer->bytesAvailable() > 0);
+        QTest::qWait(100);
+        const auto bytes = QKnxByteArray::fromByteArray(peer->readAll());
+        const auto request = QKnxNetIpFrame::fromBytes(bytes);
+        QCOMPARE(request.serviceType(), QKnxNetIp::ServiceType::SessionRequest);
+        QCOMPARE(int(request.size()), bytes.size());
+        QVERIFY(!server.hasPendingConnections());
+
+        // the transport is bound to the host it is connected to
+        QKnxNetIpTunnel other;
+        other.setSecureTransport(&transport);
+        other.setSecureConfiguration(config("user password"));
+        other.connectToHostEncrypted(QHostAddress::LocalHost, server.serverPort() + 1);
+        QCOMPARE(other.error(), QKnxNetIpEndpointConnection::Error::Network);
+        QCOMPARE(other.state(), QKnxNetIpEndpointConnection::State::Disconnected);
+        QCOMPARE(transport.connectionCount(), 3);
+
+        first.disconnectFromHost();
+        QCOMPARE(transport.connectionCount(), 2);
+        QCOMPARE(transport.sessionCount(), 2);
+
+        second.disconnectFromHost();
+        QCOMPARE(transport.connectionCount(), 1);
+        QCOMPARE(transport.sessionCount(), 1);
+
+        third.disconnectFromHost();
+        QCOMPARE(transport.connectionCount(), 0);
+        QCOMPARE(transport.sessionCount(), 0);
+        QCOMPARE(transport.isConnected(), false);
+    }
+
+    void testDemultiplexing()
+    {
+        if (QKnxCryptographicEngine::sslLibraryVersionNumber() < 0x1010000fL)
+            QSKIP("OpenSSL 1.1 is not available.");
+
+        QTcpServer server;
+        QVERIFY(server.listen(QHostAddress::LocalHost));
+
+        QKnxNetIpSecureTransport transport;
+        QKnxNetIpTunnel first, second;
+        QVector<QKnxAddress> firstReceived, secondReceived;
+        for (auto tunnel : { &first, &second }) {
+            tunnel->setSecureTransport(&transport);
+            tunnel->setSecureConfiguration(config("user password"));
+        }
+        connect(&first, &QKnxNetIpTunnel::frameReceived, this,
+            [&](QKnxLinkLayerFrame frame) { firstReceived.append(frame.destinationAddress()); });
+        connect(&second, &QKnxNetIpTunnel::frameReceived, this,
+            [&](QKnxLinkLayerFrame frame) { secondReceived.append(frame.destinationAddress()); });
+
+        first.connectToHostEncrypted(QHostAddress::LocalHost, server.serverPort());
+        second.connectToHostEncrypted(QHostAddress::LocalHost, server.serverPort());
+        QCOMPARE(transport.sessionCount(), 1);
+
+        QVERIFY(server.waitForNewConnection(5000));
+        QScopedPointer<QTcpSocket> peer(server.nextPendingConnection());
+        QKnxByteArray buffer;
+
+        // act as the server side of the secure session handshake
+        auto frames = readFrames(peer.data(), &buffer, 1);
+        QCOMPARE(frames.size(), 1);
+        const QKnxNetIpSessionRequestProxy request(frames.first());
+        QVERIFY(request.isValid());
+
+        QKnxSecureKey serverPrivateKey, serverPublicKey;
+        QKnxSecureKey::generateKeys(&serverPrivateKey, &serverPublicKey);
+        const quint16 sessionId = 0x0001;
+        peer->write(QKnxNetIpSessionResponseProxy::secureBuilder()
+            .setSecureSessionId(sessionId)
+            .setPublicKey(serverPublicKey.bytes())
+            .create("trustme", request.publicKey())
+            .bytes().toByteArray());
+
+        const QKnxCcmContext context(QKnxCryptographicEngine::sessionKey(serverPrivateKey,
+            QKnxSecureKey::fromBytes(QKnxSecureKey::Type::Public, request.publicKey())));
+        QVERIFY(context.isValid());
+        quint48 sequenceNumber = 0;
+        const auto serialNumber = QKnxByteArray(6, 0x00);
+        auto send = [&](const QKnxNetIpFrame &frame, quint16 id) {
+            peer->write(context.wrap(frame, id, sequenceNumber++, serialNumber, 0x0000).bytes()
+                .toByteArray());
+        };
+
+        frames = readFrames(peer.data(), &buffer, 1);
+        QCOMPARE(frames.size(), 1);
+        QCOMPARE(context.unwrap(frames.first()).serviceType(),
+            QKnxNetIp::ServiceType::SessionAuthenticate);
+        send(QKnxNetIpSessionStatusProxy::builder()
+            .setStatus(QKnxNetIp::SecureSessionStatus::AuthenticationSuccess)
+            .create(), sessionId);
+
+        // both tunnels connect at once over the shared session
+        frames = readFrames(peer.data(), &buffer, 2);
+        QCOMPARE(frames.size(), 2);
+        for (const auto &frame : qAsConst(frames)) {
+            QCOMPARE(QKnxNetIpSecureWrapperProxy(frame).secureSessionId(), sessionId);
+            QCOMPARE(context.unwrap(frame).serviceType(), QKnxNetIp::ServiceType::ConnectRequest);
+        }
+
+        // connect responses are matched in request order, data frames by channel ID
+        send(connectResponse(7), sessionId);
+        send(tunnelingRequest(7, 0, QKnxAddress::createGroup(1, 0, 7)), sessionId);
+        send(connectResponse(9), sessionId);
+        send(tunnelingRequest(9, 0, QKnxAddress::createGroup(1, 0, 9)), sessionId);
+        send(tunnelingRequest(7, 1, QKnxAddress::createGroup(1, 1, 7)), sessionId);
+
+        // frames for an unknown channel or an unknown session are discarded
+        send(tunnelingRequest(5, 0, QKnxAddress::createGroup(1, 0, 5)), sessionId);
+        send(tunnelingRequest(7, 2, QKnxAddress::createGroup(1, 2, 7)), quint16(sessionId + 1));
+
+        QTRY_COMPARE(first.state(), QKnxNetIpEndpointConnection::State::Connected);
+        QTRY_COMPARE(second.state(), QKnxNetIpEndpointConnection::State::Connected);
+        QTRY_COMPARE(firstReceived.size() + secondReceived.size(), 3);
+        QTest::qWait(100);
+
+        QCOMPARE(firstReceived, QVector<QKnxAddress>({ QKnxAddress::createGroup(1, 0, 7),
+            QKnxAddress::createGroup(1, 1, 7) }));
+        QCOMPARE(secondReceived, QVector<QKnxAddress>({ QKnxAddress::createGroup(1, 0, 9) }));
+
+        first.disconnectFromHost();
+        second.disconnectFromHost();
+        QCOMPARE(transport.sessionCount(), 0);
+    }
+
+private:
+    static QVector<QKnxNetIpFrame> readFrames(QTcpSocket *peer, QKnxByteArray *buffer, int count)
+    {
+        QVector<QKnxNetIpFrame> frames;
+        QTest::qWaitFor([&]() {
+            *buffer += QKnxByteArray::fromByteArray(peer->readAll());
+            while (frames.size() < count
+                && buffer->size() >= QKnxNetIpFrameHeader::HeaderSize10) {
+                const auto header = QKnxNetIpFrameHeader::fromBytes(*buffer);
+                if (!header.isValid() || buffer->size() < header.totalSize())
+                    break;
+                frames.append(QKnxNetIpFrame::fromBytes(*buffer));
+                buffer->remove(0, header.totalSize());
+            }
+            return frames.size() >= count;
+        }, 5000);
+        return frames;
+    }
+
+    static QKnxNetIpFrame connectResponse(quint8 channelId)
+    {
+        return QKnxNetIpConnectResponseProxy::builder()
+            .setChannelId(channelId)
+            .setStatus(QKnxNetIp::Error::None)
+            .setDataEndpoint(QKnxNetIpHpaiProxy::builder()
+                .setHostProtocol(QKnxNetIp::HostProtocol::TCP_IPv4)
+                .create())
+            .setResponseData(QKnxNetIpCrdProxy::builder()
+                .setConnectionType(QKnxNetIp::ConnectionType::Tunnel)
+                .setIndividualAddress(QKnxAddress::createIndividual(1, 1, channelId))
+                .create())
+            .create();
+    }
+
+    static QKnxNetIpFrame tunnelingRequest(quint8 channelId, quint8 sequenceNumber,
+        const QKnxAddress &destination)
+    {
+        return QKnxNetIpTunnelingRequestProxy::builder()
+            .setChannelId(channelId)
+            .setSequenceNumber(sequenceNumber)
+            .setCemi(QKnxLinkLayerFrame::builder()
+                .setMessageCode(QKnxLinkLayerFrame::MessageCode::DataIndication)
+                .setSourceAddress(QKnxAddress::createIndividual(1, 1, 1))
+                .setDestinationAddress(destination)
+                .setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 }))
+                .createFrame())
+            .create();
+    }
+
+    static QKnxNetIpSecureConfiguration config(const QByteArray &password)
+    {
+        QKnxNetIpSecureConfiguration config;
+        config.setPrivateKey(QKnxSecureKey::generatePrivateKey());
+        config.setUserId(QKnxNetIp::SecureUserId::UserRole);
+        config.setUserPassword(password);
+        config.setDeviceAuthenticationCode("trustme");
+        return config;
+    }
+};
+
+QTEST_MAIN(tst_QKnxNetIpSecureTransport)
+
+#include "tst_qknxnetipsecuretransport.moc"
@@ -0,0 +1,313 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtKnx/qknxlinklayerframebuilder.h>
+#include <QtKnx/qknxnetiprouter.h>
+#include <QtKnx/qknxnetiproutingbusy.h>
+#include <QtKnx/qknxnetiproutingindication.h>
+#include <QtKnx/qknxnetiptunnel.h>
+#include <QtKnx/private/qknxnetipsimulatednetwork_p.h>
+#include <QtKnx/private/qknxtpdufactory_p.h>
+
+#include <QtTest>
+
+class tst_QKnxNetIpSimulatedNetwork : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDelivery();
+    void testLoss();
+    void testReorder();
+    void testSoak();
+    void testRouting();
+    void testRoutingBusy();
+    void testTunneling();
+
+private:
+    const QHostAddress m_group { QLatin1String("224.0.23.12") };
+};
+
+void tst_QKnxNetIpSimulatedNetwork::testDelivery()
+{
+    QKnxNetIpSimulatedNetwork network;
+
+    QScopedPointer<QKnxNetIpDatagramSocket> a(network.createSocket(QHostAddress(0x0a000001)));
+    QScopedPointer<QKnxNetIpDatagramSocket> b(network.createSocket(QHostAddress(0x0a000002)));
+    QScopedPointer<QKnxNetIpDatagramSocket> c(network.createSocket(QHostAddress(0x0a000003)));
+
+    QVERIFY(a->bind(QHostAddress::AnyIPv4, 3671));
+    QVERIFY(b->bind(QHostAddress::AnyIPv4, 3671));
+    QVERIFY(c->bind(QHostAddress::LocalHost, 0));
+    QCOMPARE(b->localAddress(), QHostAddress(0x0a000002));
+    QVERIFY(c->localPort() != 0);
+
+    // unicast
+    QCOMPARE(c->writeDatagram("hello", QHostAddress(0x0a000002), 3671), qint64(5));
+    QVERIFY(!b->hasPendingDatagrams());
+    QTRY_VERIFY(b->hasPendingDatagrams());
+    auto datagram = b->receiveDatagram();
+    QCOMPARE(datagram.data(), QByteArray("hello"));
+    QCOMPARE(datagram.senderAddress(), QHostAddress(0x0a000003));
+    QCOMPARE(quint16(datagram.senderPort()), c->localPort());
+    QVERIFY(!a->hasPendingDatagrams());
+
+    // multicast, looped back to the sender as well
+    QVERIFY(a->joinMulticastGroup(m_group, {}));
+    QVERIFY(b->joinMulticastGroup(m_group, {}));
+    a->writeDatagram("all", m_group, 3671);
+    network.flush();
+    QVERIFY(a->hasPendingDatagrams());
+    QVERIFY(b->hasPendingDatagrams());
+    QVERIFY(!c->hasPendingDatagrams());
+
+    QCOMPARE(network.datagramsSent(), quint64(2));
+    QCOMPARE(network.datagramsDelivered(), quint64(3));
+    QCOMPARE(network.datagramsLost(), quint64(0));
+}
+
+void tst_QKnxNetIpSimulatedNetwork::testLoss()
+{
+    auto lost = [](quint32 seed) {
+        QKnxNetIpSimulatedNetwork network;
+        network.setSeed(seed);
+        network.setLossRate(0.25);
+
+        QScopedPointer<QKnxNetIpDatagramSocket> socket(network
+            .createSocket(QHostAddress(0x0a000001)));
+        socket->bind(QHostAddress::AnyIPv4, 3671);
+        for (int i = 0; i < 1000; ++i)
+            socket->writeDatagram(QByteArray::number(i), QHostAddress(0x0a000001), 3671);
+        network.flush();
+
+        return qMakePair(network.datagramsLost(), network.datagramsDelivered());
+    };
+
+    // the same seed loses the same datagrams
+    const auto first = lost(42);
+    QCOMPARE(first.first + first.second, quint64(1000));
+    QCOMPARE(lost(42), first);
+    QVERIFY(first.first > 150 && first.first < 350);
+}
+
+void tst_QKnxNetIpSimulatedNetwork::testReorder()
+{
+    QKnxNetIpSimulatedNetwork network;
+    network.setLatency(1, 5);
+
+    QScopedPointer<QKnxNetIpDatagramSocket> a(network.createSocket(QHostAddress(0x0a000001)));
+    QScopedPointer<QKnxNetIpDatagramSocket> b(network.createSocket(QHostAddress(0x0a000002)));
+    a->bind(QHostAddress::AnyIPv4, 3671);
+    b->bind(QHostAddress::AnyIPv4, 3671);
+
+    network.setReorderRate(1.);
+    a->writeDatagram("first", QHostAddress(0x0a000002), 3671);
+    network.setReorderRate(0.);
+    a->writeDatagram("second", QHostAddress(0x0a000002), 3671);
+
+    QByteArrayList received;
+    connect(b.data(), &QKnxNetIpDatagramSocket::readyRead, this, [&]() {
+        while (b->hasPendingDatagrams())
+            received.append(b->receiveDatagram().data());
+    });
+    QTRY_COMPARE(received.size(), 2);
+    QCOMPARE(received, QByteArrayList({ "second", "first" }));
+}
+
+void tst_QKnxNetIpSimulatedNetwork::testSoak()
+{
+    // 10000 datagrams to a group of three, drained in bursts of 100; the loss
+    // decisions come from the seeded generator only, so the counts are exact
+    auto run = [this](quint32 seed, double lossRate, QVector<int> *order) {
+        QKnxNetIpSimulatedNetwork network;
+        network.setSeed(seed);
+        network.setLossRate(lossRate);
+
+        QVector<QKnxNetIpDatagramSocket *> sockets;
+        for (quint32 i = 1; i <= 3; ++i) {
+            sockets.append(network.createSocket(QHostAddress(0x0a000000 + i)));
+            sockets.last()->bind(QHostAddress::AnyIPv4, 3671);
+            sockets.last()->joinMulticastGroup(m_group, {});
+        }
+
+        int received = 0;
+        for (int i = 0; i < 10000; ++i) {
+            sockets.first()->writeDatagram(QByteArray::number(i), m_group, 3671);
+            if ((i + 1) % 100 != 0)
+                continue;
+
+            network.flush();
+            for (auto *socket : qAsConst(sockets)) {
+                while (socket->hasPendingDatagrams()) {
+                    const auto data = socket->receiveDatagram().data();
+                    if (order && socket == sockets.last())
+                        order->append(data.toInt());
+                    ++received;
+                }
+            }
+        }
+        qDeleteAll(sockets);
+
+        return QVector<quint64> { network.datagramsSent(), network.datagramsDelivered(),
+            network.datagramsLost(), quint64(received) };
+    };
+
+    // sent, delivered, lost, received
+    QVector<int> order;
+    QCOMPARE(run(42, 0., &order), QVector<quint64>({ 10000, 30000, 0, 30000 }));
+    QCOMPARE(order.size(), 10000);
+    QVERIFY(std::is_sorted(order.cbegin(), order.cend()));
+
+    const QVector<quint64> lossy { 10000, 3 * (10000 - 977), 977, 3 * (10000 - 977) };
+    QCOMPARE(run(42, 0.1, nullptr), lossy);
+    QCOMPARE(run(42, 0.1, nullptr), lossy);
+}
+
+void tst_QKnxNetIpSimulatedNetwork::testRouting()
+{
+    QKnxNetIpSimulatedNetwork network;
+    network.setLatency(0, 2);
+
+    QKnxNetIpSimulatedLine line1, line2;
+    QKnxNetIpSimulatedRouter router1(QHostAddress(0x0a000001), &network, &line1);
+    QKnxNetIpSimulatedRouter router2(QHostAddress(0x0a000002), &network, &line2);
+    router1.router()->setIndividualAddress(QKnxAddress::createIndividual(1, 1, 0));
+    router2.router()->setIndividualAddress(QKnxAddress::createIndividual(1, 2, 0));
+
+    router1.start();
+    router2.start();
+    QCOMPARE(router1.router()->state(), QKnxNetIpRouter::State::Routing);
+    QCOMPARE(router2.router()->state(), QKnxNetIpRouter::State::Routing);
+
+    const auto group = QKnxAddress::createGroup(1, 2, 3);
+    QKnxNetIpSimulatedDevice sender(QKnxAddress::createIndividual(1, 1, 1), &line1);
+    QKnxNetIpSimulatedDevice receiver(QKnxAddress::createIndividual(1, 2, 1), &line2);
+    receiver.setGroupValue(group, { 0x00 });
+
+    int changed = 0;
+    connect(&receiver, &QKnxNetIpSimulatedDevice::groupValueChanged, this, [&]() { ++changed; });
+    sender.writeGroupValue(group, { 0x01 });
+    QTRY_COMPARE(changed, 1);
+    QCOMPARE(receiver.groupValue(group), QKnxByteArray({ 0x01 }));
+
+    // a read from line 1 is answered by the device on line 2
+    sender.setGroupValue(group, { 0x00 });
+    int senderChanged = 0;
+    connect(&sender, &QKnxNetIpSimulatedDevice::groupValueChanged, this,
+        [&]() { ++senderChanged; });
+    sender.readGroupValue(group);
+    QTRY_COMPARE(senderChanged, 1);
+    QCOMPARE(sender.groupValue(group), QKnxByteArray({ 0x01 }));
+
+    QCOMPARE(router1.router()->statistics().framesDiscardedOwn(), quint64(2));
+}
+
+void tst_QKnxNetIpSimulatedNetwork::testRoutingBusy()
+{
+    QKnxNetIpSimulatedNetwork network;
+
+    QKnxNetIpSimulatedLine line;
+    QKnxNetIpSimulatedRouter busyRouter(QHostAddress(0x0a000001), &network, &line);
+    busyRouter.setBusy(true, 50);
+    busyRouter.start();
+
+    QKnxNetIpRouter router;
+    network.attach(&router, QHostAddress(0x0a000002));
+    router.start();
+    QCOMPARE(router.state(), QKnxNetIpRouter::State::Routing);
+
+    int busy = 0;
+    connect(&router, &QKnxNetIpRouter::routingBusyReceived, this, [&]() { ++busy; });
+    router.sendRoutingIndication(QKnxNetIpRoutingIndicationProxy::builder()
+        .setCemi(QKnxLinkLayerFrame::builder()
+            .setMessageCode(QKnxLinkLayerFrame::MessageCode::DataIndication)
+            .setSourceAddress(QKnxAddress::createIndividual(1, 1, 1))
+            .setDestinationAddress(QKnxAddress::createGroup(1, 2, 3))
+            .setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 }))
+            .createFrame())
+        .create());
+
+    QTRY_COMPARE(busy, 1);
+    QCOMPARE(router.statistics().routingBusyReceived(), quint64(1));
+    QCOMPARE(line.framesTransmitted(), quint64(0));
+}
+
+void tst_QKnxNetIpSimulatedNetwork::testTunneling()
+{
+    QKnxNetIpSimulatedNetwork network;
+    network.setLatency(0, 2);
+
+    QKnxNetIpSimulatedLine line;
+    QKnxNetIpSimulatedTunnelingServer server(QHostAddress(0x0a000001), 3671, &network, &line);
+    server.setTunnelAddresses({ QKnxAddress::createIndividual(1, 1, 250) });
+
+    const auto group = QKnxAddress::createGroup(1, 2, 3);
+    QKnxNetIpSimulatedDevice device(QKnxAddress::createIndividual(1, 1, 1), &line);
+    device.setGroupValue(group, { 0x00 });
+
+    QKnxNetIpTunnel tunnel;
+    network.attach(&tunnel, QHostAddress(0x0a000002));
+    tunnel.connectToHost(QHostAddress(0x0a000001), 3671);
+    QTRY_COMPARE(tunnel.state(), QKnxNetIpEndpointConnection::State::Connected);
+    QCOMPARE(tunnel.individualAddress(), QKnxAddress::createIndividual(1, 1, 250));
+    QCOMPARE(server.connectionCount(), 1);
+
+    // a second client finds no free tunnel address
+    QKnxNetIpTunnel other;
+    network.attach(&other, QHostAddress(0x0a000003));
+    QSignalSpy errorSpy(&other, &QKnxNetIpEndpointConnection::errorOccurred);
+    other.connectToHost(QHostAddress(0x0a000001), 3671);
+    QTRY_COMPARE(errorSpy.count(), 1);
+
+    int changed = 0;
+    connect(&device, &QKnxNetIpSimulatedDevice::groupValueChanged, this, [&]() { ++changed; });
+    QVERIFY(tunnel.sendFrame(QKnxLinkLayerFrame::builder()
+        .setDestinationAddress(group)
+        .setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu({ 0x01 }))
+        .createFrame()));
+    QTRY_COMPARE(changed, 1);
+    QCOMPARE(device.groupValue(group), QKnxByteArray({ 0x01 }));
+
+    QList<QKnxLinkLayerFrame> frames;
+    connect(&tunnel, &QKnxNetIpTunnel::frameReceived, this, [&](QKnxLinkLayerFrame frame) {
+        if (frame.messageCode() == QKnxLinkLayerFrame::MessageCode::DataIndication)
+            frames.append(frame);
+    });
+    device.writeGroupValue(group, { 0x02 });
+    QTRY_COMPARE(frames.size(), 1);
+    QCOMPARE(frames.first().sourceAddress(), device.individualAddress());
+    QCOMPARE(frames.first().tpdu().data(), QKnxByteArray({ 0x02 }));
+
+    tunnel.disconnectFromHost();
+    QTRY_COMPARE(server.connectionCount(), 0);
+}
+
+QTEST_MAIN(tst_QKnxNetIpSimulatedNetwork)
+
+#include "tst_qknxnetipsimulatednetwork.moc"
@@ -0,0 +1,7 @@
+TARGET = tst_bench_qknxdptcodec
+
+QT = core testlib knx
+CONFIG += c++11
+
+CONFIG -= app_bundle
+SOURCES += tst_bench_qknxdptcodec.cpp
@@ -0,0 +1,169 @@
+/******************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qvector.h>
+#include <QtKnx/qknx2bytefloat.h>
+#include <QtKnx/qknx2bytesignedvalue.h>
+#include <QtKnx/qknx2byteunsignedvalue.h>
+#include <QtKnx/qknx4bytefloat.h>
+#include <QtKnx/qknx4bytesignedvalue.h>
+#include <QtKnx/qknx4byteunsignedvalue.h>
+#include <QtKnx/qknx8bitsignedvalue.h>
+#include <QtKnx/qknx8bitunsignedvalue.h>
+#include <QtKnx/qknxdptcodec.h>
+#include <QtTest/qtest.h>
+
+static const int Samples = 10000000;
+
+class tst_bench_QKnxDptCodec : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void objectDecode2ByteFloat();
+    void decode2ByteFloat();
+    void decodeColumn2ByteFloat();
+    void decodeColumnWithOffsets2ByteFloat();
+
+    void decodeColumn8BitUnsignedValue();
+    void decodeColumn8BitSignedValue();
+    void decodeColumn2ByteUnsignedValue();
+    void decodeColumn2ByteSignedValue();
+    void decodeColumn4ByteUnsignedValue();
+    void decodeColumn4ByteSignedValue();
+    void decodeColumn4ByteFloat();
+
+private:
+    template <typename T> void decodeColumn()
+    {
+        QVector<typename QKnxDptCodec<T>::Codec::ValueType> values(Samples);
+        QBENCHMARK {
+            QKnxDptCodec<T>::decodeColumn(m_raw.constData(), nullptr, Samples, values.data());
+        }
+    }
+
+    QVector<quint8> m_raw;
+    QVector<int> m_offsets;
+};
+
+void tst_bench_QKnxDptCodec::initTestCase()
+{
+    // enough bytes for the widest value type, filled with a cheap pseudo random sequence
+    m_raw.resize(Samples * 4);
+    quint32 seed = 0x9e3779b9;
+    for (auto &byte : m_raw) {
+        seed = seed * 1664525u + 1013904223u;
+        byte = quint8(seed >> 24);
+    }
+
+    // 2-byte payloads stored with a one byte gap after every 16th sample
+    m_offsets.resize(Samples + 1);
+    int offset = 0;
+    for (int i = 0; i <= Samples; ++i) {
+        m_offsets[i] = offset;
+        offset += (i % 16 == 15) ? 3 : 2;
+    }
+    m_raw.resize(qMax(m_raw.size(), offset));
+}
+
+void tst_bench_QKnxDptCodec::objectDecode2ByteFloat()
+{
+    QVector<float> values(Samples);
+    QKnx2ByteFloat dpt;
+    QBENCHMARK {
+        for (int i = 0; i < Samples; ++i) {
+            dpt.setBytes(QKnxByteArray(m_raw.constData() + 2 * i, 2), 0, 2);
+            values[i] = dpt.value();
+        }
+    }
+}
+
+void tst_bench_QKnxDptCodec::decode2ByteFloat()
+{
+    QVector<float> values(Samples);
+    QBENCHMARK {
+        for (int i = 0; i < Samples; ++i)
+            values[i] = QKnxDptCodec<QKnx2ByteFloat>::decode(m_raw.constData() + 2 * i, 2);
+    }
+}
+
+void tst_bench_QKnxDptCodec::decodeColumn2ByteFloat()
+{
+    decodeColumn<QKnx2ByteFloat>();
+}
+
+void tst_bench_QKnxDptCodec::decodeColumnWithOffsets2ByteFloat()
+{
+    QVector<float> values(Samples);
+    QBENCHMARK {
+        QKnxDptCodec<QKnx2ByteFloat>::decodeColumn(m_raw.constData(), m_offsets.constData(),
+            Samples, values.data());
+    }
+}
+
+void tst_bench_QKnxDptCodec::decodeColumn8BitUnsignedValue()
+{
+    decodeColumn<QKnx8BitUnsignedValue>();
+}
+
+void tst_bench_QKnxDptCodec::decodeColumn8BitSignedValue()
+{
+    decodeColumn<QKnx8BitSignedValue>();
+}
+
+void tst_bench_QKnxDptCodec::decodeColumn2ByteUnsignedValue()
+{
+    decodeColumn<QKnx2ByteUnsignedValue>();
+}
+
+void tst_bench_QKnxDptCodec::decodeColumn2ByteSignedValue()
+{
+    decodeColumn<QKnx2ByteSignedValue>();
+}
+
+void tst_bench_QKnxDptCodec::decodeColumn4ByteUnsignedValue()
+{
+    decodeColumn<QKnx4ByteUnsignedValue>();
+}
+
+void tst_bench_QKnxDptCodec::decodeColumn4ByteSignedValue()
+{
+    decodeColumn<QKnx4ByteSignedValue>();
+}
+
+void tst_bench_QKnxDptCodec::decodeColumn4ByteFloat()
+{
+    decodeColumn<QKnx4ByteFloat>();
+}
+
+QTEST_APPLESS_MAIN(tst_bench_QKnxDptCodec)
+
+#include "tst_bench_qknxdptcodec.moc"